@@ -59,9 +59,11 @@ BEGIN_VISP_NAMESPACE
  * It is possible to use a boolean mask to ignore some pixels of
  * the input gray-scale image.
  *
- * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
- * are really over-exposed.
- * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
+ *
+ * When several threads are used (see setNbThread()), the image is split in horizontal tiles. The edge thinning,
+ * the hysteresis thresholding and the tracking of the edges whose pixels all lie inside a tile are done
+ * in parallel, tile by tile. The edges that cross the border between two tiles are tracked afterwards. The
+ * edge map and the list of edge points are the same whatever the number of threads.
 */
 class VISP_EXPORT vpCannyEdgeDetection
 {
@@ -332,8 +334,8 @@ public:
    * \note On Windows, the minimum stack size is defined at compilation time
    * and cannot be changed during runtime.
    * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
+   * \note The edge tracking uses an explicit stack instead of recursive calls, so that increasing the stack size
+   * is no longer needed, even on over-exposed images. This function is kept for compatibility.
    *
    * \param[in] requiredStackSize The required stack size, in bytes.
    */
@@ -495,6 +497,7 @@ private:
   std::vector<unsigned int> m_activeEdgeCandidates; /*!< Vector that contains only the IDs of the edge candidates.*/
   static vpImage<EdgeType> m_edgePointsCandidates; /*!< Map that contains the strong edge points, i.e. the points for which we know for sure they are edge points,
                                                 and the weak edge points, i.e. the points for which we still must determine if they are actual edge points.*/
+  vpImage<bool> m_seamEdgeCandidates; /*!< Weak edge points connected to the border of their tile, that are tracked once all the tiles have been processed.*/
   vpImage<unsigned char> m_edgeMap; /*!< Final edge map that results from the whole Canny algorithm.*/
   std::vector<vpImagePoint> m_edgePointsList; /*!< List of the edge points that belong to the final edge map.*/
   const vpImage<bool> *mp_mask; /*!< Mask that permits to consider only the pixels for which the mask is true.*/
@@ -506,6 +509,11 @@ private:
 
   float getManhattanGradient(const vpImage<float> &dIx, const vpImage<float> &dIy, const int &iter);
 
+  /**
+   * \brief Number of horizontal tiles in which the image is split, one if a single thread is used.
+   */
+  unsigned int getNbTiles(const unsigned int &nbRows) const;
+
   /** @name Constructors and initialization */
   //@{
   /**
@@ -564,19 +572,40 @@ private:
   void performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold);
 
   /**
-   * \brief Search recursively for a strong edge in the neighborhood of a weak edge.
+   * \brief Search for a strong edge in the neighborhood of a weak edge, going through the weak edges
+   * that are 8-connected to it. The depth-first search uses an explicit stack, and visits the points in the same
+   * order as a recursive search would do.
    *
    * \param[in] coordinates : The coordinates we are checking.
+   * \param[out] edgePoints : The weak edge points that become strong edge points are appended to this list, if
+   * the list of edge points must be stored.
+   * \param[in] stack : Buffer used for the search, reused from one call to the next one.
    * \return true We found a strong edge point in its 8-connected neighborhood.
    * \return false We did not found a strong edge point in its 8-connected neighborhood.
    */
-  bool recursiveSearchForStrongEdge(const unsigned int &coordinates);
+  bool searchForStrongEdge(const unsigned int &coordinates, std::vector<vpImagePoint> &edgePoints,
+                           std::vector<std::pair<unsigned int, int> > &stack);
+
+  /**
+   * \brief Mark as seam edge candidates the weak edge points that are 8-connected to the weak edge point
+   * \b coordinates by a path that stays in the rows [\b rowMin, \b rowMax].
+   */
+  void markSeamEdgeCandidates(const unsigned int &coordinates, const unsigned int &rowMin, const unsigned int &rowMax,
+                              std::vector<unsigned int> &stack);
+
+  /**
+   * \brief Edge tracking of a single edge candidate, see performEdgeTracking().
+   */
+  void trackEdgeCandidate(const unsigned int &coordinates, std::vector<vpImagePoint> &edgePoints,
+                          std::vector<std::pair<unsigned int, int> > &stack);
 
   /**
    * \brief Perform edge tracking.
-   * \details For each weak edge, we will recursively check if they are 8-connected to a strong edge point.
+   * \details For each weak edge, we will check if they are 8-connected to a strong edge point.
    * If so, the weak edge will be saved in \b m_strongEdgePoints and will be kept in the final edge map.
    * Otherwise, the edge point will be discarded.
+   * When several tiles are used, the edge candidates of each tile are processed in parallel, except the weak
+   * edges connected to the border of their tile, that are processed once all the tiles are done.
    */
   void performEdgeTracking();
   //@}
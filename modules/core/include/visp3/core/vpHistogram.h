@@ -51,6 +51,7 @@
 
 #include <list>
 #if defined(VISP_HAVE_THREADS)
+#include <functional>
 #include <thread>
 #endif
 
@@ -302,7 +303,7 @@ public:
     else {
 #if defined(VISP_HAVE_THREADS)
       // Multi-threads
-      std::vector<std::thread *> threadpool;
+      vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
       std::vector<vpHistogramFloatingPoints_Param_t<ArithmeticType> *> histogramParams;
 
       unsigned int image_size = I.getSize();
@@ -324,15 +325,12 @@ public:
 
         histogramParams.push_back(histogram_param);
 
-        // Start the threads
-        std::thread *histogram_thread = new std::thread(&computeHistogramFloatingPointThread<ArithmeticType>, histogram_param);
-        threadpool.push_back(histogram_thread);
+        // Start the tasks
+        group.run(std::bind(&computeHistogramFloatingPointThread<ArithmeticType>, histogram_param));
       }
 
-      for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-        // Wait until thread ends up
-        threadpool[cpt]->join();
-      }
+      // Wait until the tasks end up
+      group.wait();
 
       m_total = 0;
       for (unsigned int cpt1 = 0; cpt1 < m_size; ++cpt1) {
@@ -347,10 +345,6 @@ public:
       }
 
       // Delete
-      for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-        delete threadpool[cpt];
-      }
-
       for (size_t cpt = 0; cpt < histogramParams.size(); ++cpt) {
         delete histogramParams[cpt];
       }
@@ -43,18 +43,23 @@
 #include <visp3/core/vpEndian.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImagePool.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpRGBf.h>
+#include <visp3/core/vpThreadPool.h>
 
 #if defined(VISP_HAVE_THREADS)
+#include <functional>
 #include <thread>
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip> // std::setw
 #include <iostream>
 #include <math.h>
+#include <new>
 #include <string.h>
 
 // Visual Studio 2010 or previous is missing inttypes.h
@@ -102,6 +107,14 @@ std::ostream &operator<<(std::ostream &s, const vpImage<double> &I);
   if i is the ith rows and j the jth columns the value of this pixel
   is given by I[i][j] (that is equivalent to row[i][j]).
 
+  By default the bitmap is allocated with `new Type[width*height]` and has
+  no particular alignment. Calling setMemoryAlignment() with 32 or 64
+  allows to get a bitmap whose first pixel is aligned on a SIMD register
+  or cache line boundary. The bitmap remains continuous, which means that
+  rows are aligned only when `width*sizeof(Type)` is a multiple of the
+  alignment. To process a region of interest without copying it, see
+  vpImageView.
+
   <h3>Example</h3>
   The following example available in tutorial-image-manipulation.cpp shows how
   to create gray level and color images and how to access to the pixels.
@@ -225,6 +238,16 @@ public:
 
   double getSum(const vpImage<bool> *p_mask = nullptr, unsigned int *nbValidPoints = nullptr) const;
 
+  /*!
+    Get the alignment in bytes of the bitmap allocated by this image.
+
+    \return The alignment set by setMemoryAlignment(), or 0 when the
+    default allocator is used.
+
+    \sa setMemoryAlignment()
+  */
+  inline unsigned int getMemoryAlignment() const { return memAlignment; }
+
   // Gets the value of a pixel at a location.
   Type getValue(unsigned int i, unsigned int j) const;
   // Gets the value of a pixel at a location with bilinear interpolation.
@@ -342,6 +365,9 @@ public:
   // set the size of the image and initialize it.
   void resize(unsigned int h, unsigned int w, const Type &val);
 
+  // Set the alignment used to allocate the bitmap
+  void setMemoryAlignment(unsigned int alignment);
+
   void sub(const vpImage<Type> &B, vpImage<Type> &C) const;
   void sub(const vpImage<Type> &A, const vpImage<Type> &B, vpImage<Type> &C) const;
   void subsample(unsigned int v_scale, unsigned int h_scale, vpImage<Type> &sampled) const;
@@ -356,16 +382,28 @@ public:
     swap(first.width, second.width);
     swap(first.height, second.height);
     swap(first.row, second.row);
+    swap(first.hasOwnership, second.hasOwnership);
+    swap(first.memAlignment, second.memAlignment);
+    swap(first.memPooled, second.memPooled);
+    swap(first.rowPooled, second.rowPooled);
   }
 
   //@}
 
 private:
-  unsigned int npixels; ///! number of pixel in the image
-  unsigned int width;   ///! number of columns
-  unsigned int height;  ///! number of rows
-  Type **row;           ///! points the row pointer array
-  bool hasOwnership;    ///! true if this instance owns the bitmap, false otherwise (e.g. copyData=false)
+  static Type *allocateBitmap(unsigned int n, unsigned int alignment, bool &pooled);
+  static void releaseBitmap(Type *ptr, unsigned int n, unsigned int alignment, bool pooled);
+  static Type **allocateRow(unsigned int n, bool &pooled);
+  static void releaseRow(Type **ptr, unsigned int n, bool pooled);
+
+  unsigned int npixels;      ///! number of pixel in the image
+  unsigned int width;        ///! number of columns
+  unsigned int height;       ///! number of rows
+  Type **row;                ///! points the row pointer array
+  bool hasOwnership;         ///! true if this instance owns the bitmap, false otherwise (e.g. copyData=false)
+  unsigned int memAlignment; ///! alignment in bytes of the owned bitmap, 0 for the default allocator
+  bool memPooled;            ///! true if the owned bitmap comes from vpImagePool
+  bool rowPooled;            ///! true if the row pointer array comes from vpImagePool
 };
 
 #include <visp3/core/vpImage_operators.h>
@@ -388,7 +426,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
 {
   if (h != this->height) {
     if (row != nullptr) {
-      delete[] row;
+      releaseRow(row, this->height, rowPooled);
       row = nullptr;
     }
   }
@@ -396,7 +434,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   if ((h != this->height) || (w != this->width)) {
     if (bitmap != nullptr) {
       if (hasOwnership) {
-        delete[] bitmap;
+        releaseBitmap(bitmap, npixels, memAlignment, memPooled);
       }
       bitmap = nullptr;
     }
@@ -408,14 +446,14 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   npixels = width * height;
 
   if (bitmap == nullptr) {
-    bitmap = new Type[npixels];
+    bitmap = allocateBitmap(npixels, memAlignment, memPooled);
     hasOwnership = true;
   }
   if (bitmap == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
   }
   if (row == nullptr) {
-    row = new Type *[height];
+    row = allocateRow(height, rowPooled);
   }
   if (row == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
@@ -433,7 +471,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
 {
   if (h != this->height) {
     if (row != nullptr) {
-      delete[] row;
+      releaseRow(row, this->height, rowPooled);
       row = nullptr;
     }
   }
@@ -442,7 +480,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
   if ((copyData && ((h != this->height) || (w != this->width))) || (!copyData)) {
     if (bitmap != nullptr) {
       if (hasOwnership) {
-        delete[] bitmap;
+        releaseBitmap(bitmap, npixels, memAlignment, memPooled);
       }
       bitmap = nullptr;
     }
@@ -456,7 +494,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
 
   if (copyData) {
     if (bitmap == nullptr) {
-      bitmap = new Type[npixels];
+      bitmap = allocateBitmap(npixels, memAlignment, memPooled);
     }
 
     if (bitmap == nullptr) {
@@ -472,7 +510,7 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
   }
 
   if (row == nullptr) {
-    row = new Type *[height];
+    row = allocateRow(height, rowPooled);
   }
   if (row == nullptr) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
@@ -488,7 +526,8 @@ template <class Type> void vpImage<Type>::init(Type *const array, unsigned int h
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true)
+  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true),
+  memAlignment(0), memPooled(false), rowPooled(false)
 {
   Type val(0);
   init(h, w, val);
@@ -499,7 +538,8 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
-  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true)
+  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true),
+  memAlignment(0), memPooled(false), rowPooled(false)
 {
   init(h, w, value);
 }
@@ -509,7 +549,8 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
 */
 template <class Type>
 vpImage<Type>::vpImage(Type *const array, unsigned int h, unsigned int w, bool copyData)
-  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true)
+  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true),
+  memAlignment(0), memPooled(false), rowPooled(false)
 {
   init(array, h, w, copyData);
 }
@@ -518,7 +559,8 @@ vpImage<Type>::vpImage(Type *const array, unsigned int h, unsigned int w, bool c
   \relates vpImage
 */
 template <class Type>
-vpImage<Type>::vpImage() : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true)
+vpImage<Type>::vpImage() : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true),
+  memAlignment(0), memPooled(false), rowPooled(false)
 { }
 
 /*!
@@ -574,13 +616,13 @@ template <class Type> void vpImage<Type>::destroy()
 {
   if (bitmap != nullptr) {
     if (hasOwnership) {
-      delete[] bitmap;
+      releaseBitmap(bitmap, npixels, memAlignment, memPooled);
     }
     bitmap = nullptr;
   }
 
   if (row != nullptr) {
-    delete[] row;
+    releaseRow(row, height, rowPooled);
     row = nullptr;
   }
 }
@@ -598,7 +640,8 @@ template <class Type> vpImage<Type>::~vpImage() { destroy(); }
 */
 template <class Type>
 vpImage<Type>::vpImage(const vpImage<Type> &I)
-  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true)
+  : bitmap(nullptr), display(nullptr), npixels(0), width(0), height(0), row(nullptr), hasOwnership(true),
+  memAlignment(I.memAlignment), memPooled(false), rowPooled(false)
 {
   resize(I.getHeight(), I.getWidth());
   if (bitmap) {
@@ -613,7 +656,7 @@ vpImage<Type>::vpImage(const vpImage<Type> &I)
 template <class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
   : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row),
-  hasOwnership(I.hasOwnership)
+  hasOwnership(I.hasOwnership), memAlignment(I.memAlignment), memPooled(I.memPooled), rowPooled(I.rowPooled)
 {
   I.bitmap = nullptr;
   I.display = nullptr;
@@ -622,9 +665,145 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.height = 0;
   I.row = nullptr;
   I.hasOwnership = false;
+  I.memAlignment = 0;
+  I.memPooled = false;
+  I.rowPooled = false;
 }
 #endif
 
+/*!
+  Set the alignment in bytes of the bitmap.
+
+  When \e alignment is different from 0, the bitmap is allocated such as
+  its address is a multiple of \e alignment, which allows to use aligned
+  SIMD loads on the first pixel of the image and on every row whose offset
+  is a multiple of the alignment. Typical values are 32 (AVX registers)
+  and 64 (cache line). Setting 0 restores the default `new Type[]`
+  allocator.
+
+  If the image already owns a bitmap allocated with a different alignment,
+  a new bitmap is allocated and the pixel values are kept. The alignment is
+  then used by all the subsequent allocations done by init() or resize(),
+  and is propagated to the copies of this image.
+
+  \param alignment : Alignment in bytes. Must be 0 or a power of two.
+
+  \exception vpException::badValue If \e alignment is not a power of two.
+
+  \sa getMemoryAlignment()
+*/
+template <class Type> void vpImage<Type>::setMemoryAlignment(unsigned int alignment)
+{
+  if ((alignment & (alignment - 1)) != 0) {
+    throw(vpException(vpException::badValue, "Image memory alignment (%u) is not a power of two", alignment));
+  }
+  if (alignment == memAlignment) {
+    return;
+  }
+
+  if ((bitmap != nullptr) && hasOwnership) {
+    bool pooled = false;
+    Type *aligned_bitmap = allocateBitmap(npixels, alignment, pooled);
+    memcpy(static_cast<void *>(aligned_bitmap), static_cast<void *>(bitmap), static_cast<size_t>(npixels) * sizeof(Type));
+    releaseBitmap(bitmap, npixels, memAlignment, memPooled);
+    bitmap = aligned_bitmap;
+    memPooled = pooled;
+    for (unsigned int i = 0; i < height; ++i) {
+      row[i] = bitmap + (i * width);
+    }
+  }
+  memAlignment = alignment;
+}
+
+/*!
+  Allocate a bitmap of \e n elements.
+
+  When vpImagePool is enabled and \e alignment is not greater than the
+  alignment of the pool buffers (64 bytes), the bitmap is drawn from the pool
+  and \e pooled is set to true. Otherwise, when \e alignment is 0 the default
+  `new Type[]` allocator is used, else the raw memory is over-allocated and
+  the address of the allocated block is stored just before the first element,
+  so that releaseBitmap() can retrieve it.
+*/
+template <class Type> Type *vpImage<Type>::allocateBitmap(unsigned int n, unsigned int alignment, bool &pooled)
+{
+  pooled = false;
+  vpImagePool &pool = vpImagePool::getInstance();
+  if ((alignment <= 64) && pool.isEnabled()) {
+    Type *ptr = static_cast<Type *>(pool.allocate(static_cast<size_t>(n) * sizeof(Type)));
+    for (unsigned int i = 0; i < n; ++i) {
+      new (ptr + i) Type;
+    }
+    pooled = true;
+    return ptr;
+  }
+
+  if (alignment == 0) {
+    return new Type[n];
+  }
+
+  const size_t align = std::max<size_t>(alignment, sizeof(void *));
+  unsigned char *raw =
+    static_cast<unsigned char *>(::operator new((static_cast<size_t>(n) * sizeof(Type)) + align + sizeof(void *)));
+  size_t offset = static_cast<size_t>(reinterpret_cast<uintptr_t>(raw + sizeof(void *)) & (align - 1));
+  unsigned char *aligned = raw + sizeof(void *) + (offset == 0 ? 0 : (align - offset));
+  reinterpret_cast<void **>(aligned)[-1] = raw;
+
+  Type *ptr = reinterpret_cast<Type *>(aligned);
+  for (unsigned int i = 0; i < n; ++i) {
+    new (ptr + i) Type;
+  }
+  return ptr;
+}
+
+/*!
+  Release a bitmap of \e n elements previously obtained with allocateBitmap()
+  using the same \e alignment.
+*/
+template <class Type> void vpImage<Type>::releaseBitmap(Type *ptr, unsigned int n, unsigned int alignment, bool pooled)
+{
+  if ((alignment == 0) && (!pooled)) {
+    delete[] ptr;
+    return;
+  }
+
+  for (unsigned int i = 0; i < n; ++i) {
+    ptr[i].~Type();
+  }
+  if (pooled) {
+    vpImagePool::getInstance().release(ptr, static_cast<size_t>(n) * sizeof(Type));
+  }
+  else {
+    ::operator delete(reinterpret_cast<void **>(ptr)[-1]);
+  }
+}
+
+/*!
+  Allocate the array of \e n row pointers, from vpImagePool when it is enabled.
+*/
+template <class Type> Type **vpImage<Type>::allocateRow(unsigned int n, bool &pooled)
+{
+  vpImagePool &pool = vpImagePool::getInstance();
+  pooled = pool.isEnabled();
+  if (pooled) {
+    return static_cast<Type **>(pool.allocate(static_cast<size_t>(n) * sizeof(Type *)));
+  }
+  return new Type *[n];
+}
+
+/*!
+  Release an array of \e n row pointers previously obtained with allocateRow().
+*/
+template <class Type> void vpImage<Type>::releaseRow(Type **ptr, unsigned int n, bool pooled)
+{
+  if (pooled) {
+    vpImagePool::getInstance().release(ptr, static_cast<size_t>(n) * sizeof(Type *));
+  }
+  else {
+    delete[] ptr;
+  }
+}
+
 /*!
   Insert an image into another one.
 
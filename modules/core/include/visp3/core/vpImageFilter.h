@@ -52,9 +52,11 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpThreadPool.h>
 
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC)
 #include <opencv2/imgproc/imgproc.hpp>
@@ -555,7 +557,7 @@ public:
 
     // Compute the histogram
 #ifdef VISP_HAVE_THREADS
-    nbThread = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1); // The method can return 0 when it is not able to detect the supported number of threads.
+    nbThread = static_cast<int>(vpThreadPool::getInstance().getNbThreads());
 #endif
     const unsigned int nbBins = 1024;
     vpHistogram hist(nbBins);
@@ -894,10 +896,16 @@ public:
    * \param filter : The separable filter.
    * \param size : The size of the filter.
    * \param p_mask : If different from nullptr, mask indicating which points to consider (true) or to ignore(false).
+   *
+   * For `unsigned char`, `float` and `double` input images, the two passes are vectorized (SSE2, AVX2 or NEON,
+   * chosen at runtime) and interleaved row by row, so that the intermediate rows stay in cache.
    */
   template <typename ImageType, typename FilterType>
   static void filter(const vpImage<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+    if (filterSeparableSimd(I, GI, filter, size, p_mask)) {
+      return;
+    }
     vpImage<FilterType> GIx;
     filterX<ImageType, FilterType>(I, GIx, filter, size, p_mask);
     filterY<FilterType, FilterType>(GIx, GI, filter, size, p_mask);
@@ -1097,6 +1105,9 @@ public:
   static void filterX(const vpImage<ImageType> &I, vpImage<OutputType> &dIx, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if (filterXSimd(I, dIx, filter, size, p_mask)) {
+      return;
+    }
     const unsigned int height = I.getHeight();
     const unsigned int width = I.getWidth();
     const unsigned int stop1J = (size - 1) / 2;
@@ -1488,6 +1499,9 @@ public:
   static void filterY(const vpImage<ImageType> &I, vpImage<OutputType> &dIy, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if (filterYSimd(I, dIy, filter, size, p_mask)) {
+      return;
+    }
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1I = (size - 1) / 2;
     const unsigned int stop2I = height - ((size - 1) / 2);
@@ -1780,6 +1794,10 @@ public:
 
     FilterType *fg = new FilterType[(size + 1) / 2];
     vpImageFilter::getGaussianKernel<FilterType>(fg, size, sigma, normalize);
+    if (filterSeparableSimd(I, GI, fg, size, p_mask)) {
+      delete[] fg;
+      return;
+    }
     vpImage<OutputType> GIx;
     vpImageFilter::filterX<ImageType, OutputType>(I, GIx, fg, size, p_mask);
     vpImageFilter::filterY<OutputType, OutputType>(GIx, GI, fg, size, p_mask);
@@ -1822,6 +1840,163 @@ public:
                       const vpImage<bool> *p_mask = nullptr);
 #endif
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  /**
+   * \brief Filter along the horizontal direction a region of interest given as an image view.
+   *
+   * The view is considered as an image on its own: the borders are handled by mirroring the pixels of the view
+   * exactly as filterX(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int, const vpImage<bool> *)
+   * does. The result is thus the same as cropping the region of interest and filtering the cropped image, without
+   * copying the region of interest.
+   *
+   * \tparam ImageType The type of pixels. It must be an arithmetic type.
+   * \tparam OutputType The type of pixels in the resulting image. It must be an arithmetic type.
+   * \tparam FilterType An arithmetic type.
+   * \param[in] I The view that must be filtered.
+   * \param[out] dIx The filtered image, which has the size of the view.
+   * \param[in] filter The coefficients of the filter.
+   * \param[in] size The size of the filter.
+   * \param[in] p_mask A boolean mask, of the size of the view, that permits to select the pixels that must be
+   * filtered if different from nullptr, unused otherwise.
+   */
+  template<typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value, void>::type
+    filterX(const vpImageView<ImageType> &I, vpImage<OutputType> &dIx, const FilterType *filter, unsigned int size,
+            const vpImage<bool> *p_mask = nullptr)
+  {
+    const unsigned int height = I.getHeight();
+    const unsigned int width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    const unsigned int twiceWidth = 2 * width;
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIx);
+
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int r = 0; r < nbRows; ++r) {
+      const unsigned int i = static_cast<unsigned int>(r);
+      const ImageType *src = I[i];
+      OutputType *dst = dIx[i];
+      for (unsigned int j = 0; j < width; ++j) {
+        if (checkBooleanMask(p_mask, i, j)) {
+          FilterType res = filter[0] * static_cast<FilterType>(src[j]);
+          for (unsigned int k = 1; k <= stop; ++k) {
+            const unsigned int jl = (j > k) ? (j - k) : (k - j);
+            const unsigned int jr = ((j + k) < width) ? (j + k) : (((twiceWidth - j) - k) - 1);
+            res += filter[k] * static_cast<FilterType>(src[jr] + src[jl]);
+          }
+          dst[j] = static_cast<OutputType>(res);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Filter along the vertical direction a region of interest given as an image view.
+   *
+   * The view is considered as an image on its own, see filterX(const vpImageView<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int, const vpImage<bool> *).
+   *
+   * \tparam ImageType The type of pixels. It must be an arithmetic type.
+   * \tparam OutputType The type of pixels in the resulting image. It must be an arithmetic type.
+   * \tparam FilterType An arithmetic type.
+   * \param[in] I The view that must be filtered.
+   * \param[out] dIy The filtered image, which has the size of the view.
+   * \param[in] filter The coefficients of the filter.
+   * \param[in] size The size of the filter.
+   * \param[in] p_mask A boolean mask, of the size of the view, that permits to select the pixels that must be
+   * filtered if different from nullptr, unused otherwise.
+   */
+  template<typename ImageType, typename OutputType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value, void>::type
+    filterY(const vpImageView<ImageType> &I, vpImage<OutputType> &dIy, const FilterType *filter, unsigned int size,
+            const vpImage<bool> *p_mask = nullptr)
+  {
+    const unsigned int height = I.getHeight();
+    const unsigned int width = I.getWidth();
+    const unsigned int stop = (size - 1) / 2;
+    const unsigned int twiceHeight = 2 * height;
+    resizeAndInitializeIfNeeded(p_mask, height, width, dIy);
+
+    const int nbRows = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int r = 0; r < nbRows; ++r) {
+      const unsigned int i = static_cast<unsigned int>(r);
+      const ImageType *src = I[i];
+      OutputType *dst = dIy[i];
+      for (unsigned int j = 0; j < width; ++j) {
+        if (checkBooleanMask(p_mask, i, j)) {
+          FilterType res = filter[0] * static_cast<FilterType>(src[j]);
+          for (unsigned int k = 1; k <= stop; ++k) {
+            const unsigned int iu = (i > k) ? (i - k) : (k - i);
+            const unsigned int id = ((i + k) < height) ? (i + k) : (((twiceHeight - i) - k) - 1);
+            res += filter[k] * static_cast<FilterType>(I[id][j] + I[iu][j]);
+          }
+          dst[j] = static_cast<OutputType>(res);
+        }
+      }
+    }
+  }
+
+  /*!
+   * Apply a separable filter to a region of interest given as an image view.
+   * \tparam FilterType : Either float, to accelerate the computation time, or double, to have greater precision.
+   * \param I : The view on the original image.
+   * \param GI : The filtered image, which has the size of the view.
+   * \param filter : The separable filter.
+   * \param size : The size of the filter.
+   * \param p_mask : If different from nullptr, mask of the size of the view indicating which points to consider (true)
+   * or to ignore(false).
+   */
+  template <typename ImageType, typename FilterType>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value, void>::type
+    filter(const vpImageView<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter, unsigned int size,
+           const vpImage<bool> *p_mask = nullptr)
+  {
+    vpImage<FilterType> GIx;
+    filterX<ImageType, FilterType, FilterType>(I, GIx, filter, size, p_mask);
+    filterY<FilterType, FilterType, FilterType>(vpImageView<FilterType>(GIx), GI, filter, size, p_mask);
+  }
+
+  /*!
+   * Apply a Gaussian blur to a region of interest given as an image view, without copying it.
+   * The result is the same as applying gaussianBlur() on the cropped region of interest.
+   * \tparam ImageType : An arithmetic type.
+   * \tparam OutputType : An arithmetic type.
+   * \tparam FilterType : Either float, to accelerate the computation time, or double, to have greater precision.
+   * \param I : View on the input image.
+   * \param GI : Filtered image, which has the size of the view.
+   * \param size : Filter size. This value should be odd.
+   * \param sigma : Gaussian standard deviation. If it is equal to zero or
+   * negative, it is computed from filter size as sigma = (size-1)/6.
+   * \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+   * \param p_mask : If different from nullptr, mask of the size of the view indicating which points to consider (true)
+   * or to ignore(false).
+   *
+   * \sa getGaussianKernel() to know which kernel is used.
+   */
+  template <typename ImageType, typename OutputType, typename FilterType = float>
+  static typename std::enable_if<std::is_arithmetic<ImageType>::value, void>::type
+    gaussianBlur(const vpImageView<ImageType> &I, vpImage<OutputType> &GI, unsigned int size = 7, FilterType sigma = 0.,
+                 bool normalize = true, const vpImage<bool> *p_mask = nullptr)
+  {
+    if (size == 0 || size-1 > I.getWidth() || size-1 > I.getHeight()) {
+      std::ostringstream oss;
+      oss << "Image view size (" << I.getWidth() << "x" << I.getHeight() << ") is too small for the Gaussian kernel ("
+        << "size=" << size << "), min size is " << (size-1);
+      throw vpException(vpException::dimensionError, oss.str());
+    }
+
+    std::vector<FilterType> fg((size + 1) / 2);
+    vpImageFilter::getGaussianKernel<FilterType>(fg.data(), size, sigma, normalize);
+    vpImage<OutputType> GIx;
+    vpImageFilter::filterX<ImageType, OutputType, FilterType>(I, GIx, fg.data(), size, p_mask);
+    vpImageFilter::filterY<OutputType, OutputType, FilterType>(vpImageView<OutputType>(GIx), GI, fg.data(), size, p_mask);
+  }
+#endif
+
   /*!
   * Apply a 5x5 Gaussian filter to an image pixel.
   *
@@ -2425,6 +2600,59 @@ public:
 #endif
 
 private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  /*
+   * Vectorized backend of filterX(), filterY() and filter(), implemented in vpImageFilter_separable.cpp for the
+   * unsigned char, float and double input images filtered with a kernel of the output type. They return false when
+   * there is no optimized implementation for the given types or when the kernel is larger than the image, in which
+   * case the caller uses the generic implementation.
+   */
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static bool filterXSimd(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                          const vpImage<bool> *)
+  {
+    return false;
+  }
+  static bool filterXSimd(const vpImage<unsigned char> &I, vpImage<float> &dIx, const float *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+  static bool filterXSimd(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                          unsigned int size, const vpImage<bool> *p_mask);
+  static bool filterXSimd(const vpImage<float> &I, vpImage<float> &dIx, const float *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+  static bool filterXSimd(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static bool filterYSimd(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                          const vpImage<bool> *)
+  {
+    return false;
+  }
+  static bool filterYSimd(const vpImage<unsigned char> &I, vpImage<float> &dIy, const float *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+  static bool filterYSimd(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                          unsigned int size, const vpImage<bool> *p_mask);
+  static bool filterYSimd(const vpImage<float> &I, vpImage<float> &dIy, const float *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+  static bool filterYSimd(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size,
+                          const vpImage<bool> *p_mask);
+
+  template <typename ImageType, typename OutputType, typename FilterType>
+  static bool filterSeparableSimd(const vpImage<ImageType> &, vpImage<OutputType> &, const FilterType *, unsigned int,
+                                  const vpImage<bool> *)
+  {
+    return false;
+  }
+  static bool filterSeparableSimd(const vpImage<unsigned char> &I, vpImage<float> &GI, const float *filter,
+                                  unsigned int size, const vpImage<bool> *p_mask);
+  static bool filterSeparableSimd(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter,
+                                  unsigned int size, const vpImage<bool> *p_mask);
+  static bool filterSeparableSimd(const vpImage<float> &I, vpImage<float> &GI, const float *filter,
+                                  unsigned int size, const vpImage<bool> *p_mask);
+  static bool filterSeparableSimd(const vpImage<double> &I, vpImage<double> &GI, const double *filter,
+                                  unsigned int size, const vpImage<bool> *p_mask);
+#endif
+
   /**
    * \brief Resize the image \b I to the desired size and, if \b p_mask is different from nullptr, initialize
    * \b I with 0s.
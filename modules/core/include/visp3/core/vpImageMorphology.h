@@ -45,10 +45,13 @@
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpMatrix.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
+#include <memory>
 #include <string.h>
+#include <vector>
 
 #if defined(__clang__)
 // Mute warning : '\tparam' command used in a comment that is not attached to a template declaration [-Wdocumentation]
@@ -98,6 +101,21 @@ public:
   template <typename T>
   static void dilatation(vpImage<T> &I, const int &size);
 
+  template <typename T>
+  static void erosion(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void dilatation(vpImage<T> &I, const int &width, const int &height);
+
+  template <typename T>
+  static void opening(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void closing(vpImage<T> &I, const int &size);
+
+  template <typename T>
+  static void gradient(vpImage<T> &I, const int &size);
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
     @name Deprecated functions
@@ -176,6 +194,64 @@ private:
     }
   };
 
+  template <typename T>
+  class vpRectangularMin
+  {
+  public:
+    static T apply(const T &a, const T &b) { return std::min<T>(a, b); }
+    static void apply(const T *a, const T *b, T *dst, unsigned int n) { vpImageMorphology::minRow(a, b, dst, n); }
+  };
+
+  template <typename T>
+  class vpRectangularMax
+  {
+  public:
+    static T apply(const T &a, const T &b) { return std::max<T>(a, b); }
+    static void apply(const T *a, const T *b, T *dst, unsigned int n) { vpImageMorphology::maxRow(a, b, dst, n); }
+  };
+
+  //! Element-wise minimum of two rows. The unsigned char overload is vectorized.
+  template <typename T>
+  static void minRow(const T *a, const T *b, T *dst, unsigned int n)
+  {
+    for (unsigned int i = 0; i < n; ++i) {
+      dst[i] = std::min<T>(a[i], b[i]);
+    }
+  }
+
+  //! Element-wise maximum of two rows. The unsigned char overload is vectorized.
+  template <typename T>
+  static void maxRow(const T *a, const T *b, T *dst, unsigned int n)
+  {
+    for (unsigned int i = 0; i < n; ++i) {
+      dst[i] = std::max<T>(a[i], b[i]);
+    }
+  }
+
+  static void minRow(const unsigned char *a, const unsigned char *b, unsigned char *dst, unsigned int n);
+  static void maxRow(const unsigned char *a, const unsigned char *b, unsigned char *dst, unsigned int n);
+
+  static void checkKernelSize(const int &width, const int &height);
+
+  /**
+   * \brief Apply the \b Operation (min or max) on a \b width x \b height rectangle centered on each pixel, with the
+   * van Herk/Gil-Werman algorithm whose cost does not depend on the size of the rectangle.
+   *
+   * The rectangle being separable, a 1D pass is done along the rows, then along the columns. Along a line split
+   * in blocks of \e k pixels, the running operation from the start of each block \e g and from the end of each
+   * block \e h are computed, and the result on the window [x, x + k - 1] is Operation(h[x], g[x + k - 1]): three
+   * operations per pixel whatever \e k. Pixels outside the image are replaced by the closest border pixel, which
+   * gives the same result as restricting the window to the image.
+   *
+   * \tparam T Any type such as double, unsigned char ...
+   * \tparam Operation vpRectangularMin or vpRectangularMax.
+   * \param[out] I The image we want to modify.
+   * \param[in] width Width of the rectangle, odd.
+   * \param[in] height Height of the rectangle, odd.
+   */
+  template <typename T, typename Operation>
+  static void rectangularOperation(vpImage<T> &I, unsigned int width, unsigned int height);
+
   /**
    * \brief Modify the image by applying the \b operation on each of its elements on a 3x3
    * grid.
@@ -189,19 +265,6 @@ private:
    */
   template <typename T>
   static void imageOperation(vpImage<T> &I, const T &null_value, vpPixelOperation<T> *operation, const vpConnexityType &connexity = CONNEXITY_4);
-
-  /**
-   * \brief Modify the image by applying the \b operation on each of its elements on a \b size x \b size
-   * grid.
-   *
-   * \tparam T Any type such as double, unsigned char ...
-   * \param[out] I The image we want to modify.
-   * \param[in] operation The operation to apply to its elements on a the grid.
-   * \param[in] size Size of the kernel of the operation.
-   */
-  template <typename T>
-  static void imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size = 3);
-
 };
 
 /*!
@@ -467,47 +530,6 @@ void vpImageMorphology::dilatation(vpImage<T> &I, const vpConnexityType &connexi
   vpImageMorphology::imageOperation(I, std::numeric_limits<T>::min(), &operation, connexity);
 }
 
-template<typename T>
-void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size)
-{
-  if ((size % 2) != 1) {
-    throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
-  }
-
-  const int width_in = I.getWidth();
-  const int height_in = I.getHeight();
-  int halfKernelSize = size / 2;
-  vpImage<T> J = I;
-
-  for (int r = 0; r < height_in; ++r) {
-    // Computing the rows we can explore without going outside the limits of the image
-    int r_iterator_start = -halfKernelSize, r_iterator_stop = halfKernelSize + 1;
-    if ((r - halfKernelSize) < 0) {
-      r_iterator_start = -r;
-    }
-    else if ((r + halfKernelSize) >= height_in) {
-      r_iterator_stop = height_in - r;
-    }
-    for (int c = 0; c < width_in; ++c) {
-      T value = I[r][c];
-      // Computing the columns we can explore without going outside the limits of the image
-      int c_iterator_start = -halfKernelSize, c_iterator_stop = halfKernelSize + 1;
-      if ((c - halfKernelSize) < 0) {
-        c_iterator_start = -c;
-      }
-      else if ((c + halfKernelSize) >= width_in) {
-        c_iterator_stop = width_in - c;
-      }
-      for (int r_iterator = r_iterator_start; r_iterator < r_iterator_stop; ++r_iterator) {
-        for (int c_iterator = c_iterator_start; c_iterator < c_iterator_stop; ++c_iterator) {
-          value = (*operation)(value, J[r + r_iterator][c + c_iterator]);
-        }
-      }
-      I[r][c] = value;
-    }
-  }
-}
-
 /*!
  * \brief Erosion of \b size >=3 with 8-connectivity.
   Erode an image using the given structuring element.
@@ -537,8 +559,7 @@ void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *opera
 template <typename T>
 void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
 {
-  vpPixelOperationMin<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  vpImageMorphology::erosion(I, size, size);
 }
 
 /**
@@ -569,8 +590,191 @@ void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
 template<typename T>
 void vpImageMorphology::dilatation(vpImage<T> &I, const int &size)
 {
-  vpPixelOperationMax<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  vpImageMorphology::dilatation(I, size, size);
+}
+
+/*!
+ * \brief Erosion with a \b width x \b height rectangular structuring element, i.e. a min operator on the
+ * rectangle centered on each pixel. The cost per pixel does not depend on the size of the rectangle.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to which the erosion must be applied.
+ * \param[in] width The width of the rectangle, odd.
+ * \param[in] height The height of the rectangle, odd.
+ * \exception vpException::badValue If \b width or \b height is not a positive odd number.
+ *
+ * \sa dilatation(vpImage<T> &, const int &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::erosion(vpImage<T> &I, const int &width, const int &height)
+{
+  checkKernelSize(width, height);
+  vpImageMorphology::rectangularOperation<T, vpRectangularMin<T> >(I, static_cast<unsigned int>(width),
+                                                                   static_cast<unsigned int>(height));
+}
+
+/*!
+ * \brief Dilatation with a \b width x \b height rectangular structuring element, i.e. a max operator on the
+ * rectangle centered on each pixel. The cost per pixel does not depend on the size of the rectangle.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to which the dilatation must be applied.
+ * \param[in] width The width of the rectangle, odd.
+ * \param[in] height The height of the rectangle, odd.
+ * \exception vpException::badValue If \b width or \b height is not a positive odd number.
+ *
+ * \sa erosion(vpImage<T> &, const int &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::dilatation(vpImage<T> &I, const int &width, const int &height)
+{
+  checkKernelSize(width, height);
+  vpImageMorphology::rectangularOperation<T, vpRectangularMax<T> >(I, static_cast<unsigned int>(width),
+                                                                   static_cast<unsigned int>(height));
+}
+
+/*!
+ * \brief Opening, i.e. an erosion followed by a dilatation, with a \b size x \b size square structuring element.
+ * It removes the bright structures smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size The size of the structuring element, odd.
+ *
+ * \sa closing(), erosion(vpImage<T> &, const int &), dilatation(vpImage<T> &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::opening(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::erosion(I, size, size);
+  vpImageMorphology::dilatation(I, size, size);
+}
+
+/*!
+ * \brief Closing, i.e. a dilatation followed by an erosion, with a \b size x \b size square structuring element.
+ * It fills the dark structures smaller than the structuring element.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size The size of the structuring element, odd.
+ *
+ * \sa opening(), erosion(vpImage<T> &, const int &), dilatation(vpImage<T> &, const int &)
+ */
+template <typename T>
+void vpImageMorphology::closing(vpImage<T> &I, const int &size)
+{
+  vpImageMorphology::dilatation(I, size, size);
+  vpImageMorphology::erosion(I, size, size);
+}
+
+/*!
+ * \brief Morphological gradient, i.e. the difference between the dilatation and the erosion of the image with a
+ * \b size x \b size square structuring element. It highlights the edges of the objects.
+ *
+ * \tparam T Any type of image, except vpRGBa .
+ * \param[out] I The image to process.
+ * \param[in] size The size of the structuring element, odd.
+ */
+template <typename T>
+void vpImageMorphology::gradient(vpImage<T> &I, const int &size)
+{
+  vpImage<T> I_erosion = I;
+  vpImageMorphology::erosion(I_erosion, size, size);
+  vpImageMorphology::dilatation(I, size, size);
+  const unsigned int npixels = I.getSize();
+  for (unsigned int i = 0; i < npixels; ++i) {
+    I.bitmap[i] = static_cast<T>(I.bitmap[i] - I_erosion.bitmap[i]);
+  }
+}
+
+template <typename T, typename Operation>
+void vpImageMorphology::rectangularOperation(vpImage<T> &I, unsigned int width, unsigned int height)
+{
+  const unsigned int nbRows = I.getHeight();
+  const unsigned int nbCols = I.getWidth();
+  if ((nbRows == 0) || (nbCols == 0)) {
+    return;
+  }
+
+  // Horizontal pass, row by row
+  if (width > 1) {
+    const unsigned int half = width / 2;
+    const unsigned int length = nbCols + (2 * half);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      // Raw buffers rather than std::vector, whose bool specialization does not give the address of its elements
+      std::unique_ptr<T[]> padded(new T[length]), g(new T[length]), h(new T[length]);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+      for (int r = 0; r < static_cast<int>(nbRows); ++r) {
+        T *row = I[r];
+        std::fill(padded.get(), padded.get() + half, row[0]);
+        std::copy(row, row + nbCols, padded.get() + half);
+        std::fill(padded.get() + half + nbCols, padded.get() + length, row[nbCols - 1]);
+        // Running operation from the start and from the end of each block
+        for (unsigned int start = 0; start < length; start += width) {
+          const unsigned int end = std::min<unsigned int>(start + width, length);
+          g[start] = padded[start];
+          for (unsigned int p = start + 1; p < end; ++p) {
+            g[p] = Operation::apply(g[p - 1], padded[p]);
+          }
+          h[end - 1] = padded[end - 1];
+          for (unsigned int p = end - 1; p > start; --p) {
+            h[p - 1] = Operation::apply(h[p], padded[p - 1]);
+          }
+        }
+        Operation::apply(h.get(), g.get() + (width - 1), row, nbCols);
+      }
+    }
+  }
+
+  // Vertical pass, by strips of columns so that the rows of the strip stay in cache
+  if (height > 1) {
+    const unsigned int half = height / 2;
+    const unsigned int length = nbRows + (2 * half);
+    const unsigned int stripBytes = 256;
+    const unsigned int stripWidth = std::max<unsigned int>(1, stripBytes / static_cast<unsigned int>(sizeof(T)));
+    const int nbStrips = static_cast<int>((nbCols + stripWidth - 1) / stripWidth);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::unique_ptr<T[]> g(new T[length * stripWidth]), h(new T[length * stripWidth]);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+      for (int s = 0; s < nbStrips; ++s) {
+        const unsigned int c0 = static_cast<unsigned int>(s) * stripWidth;
+        const unsigned int w = std::min<unsigned int>(stripWidth, nbCols - c0);
+        for (unsigned int p = 0; p < length; ++p) {
+          const T *src = I[std::min<unsigned int>(std::max<unsigned int>(p, half) - half, nbRows - 1)] + c0;
+          T *dst = g.get() + (p * stripWidth);
+          if ((p % height) == 0) {
+            std::copy(src, src + w, dst);
+          }
+          else {
+            Operation::apply(dst - stripWidth, src, dst, w);
+          }
+        }
+        for (unsigned int p = length; p-- > 0;) {
+          const T *src = I[std::min<unsigned int>(std::max<unsigned int>(p, half) - half, nbRows - 1)] + c0;
+          T *dst = h.get() + (p * stripWidth);
+          if (((p % height) == (height - 1)) || (p == (length - 1))) {
+            std::copy(src, src + w, dst);
+          }
+          else {
+            Operation::apply(dst + stripWidth, src, dst, w);
+          }
+        }
+        for (unsigned int r = 0; r < nbRows; ++r) {
+          Operation::apply(h.get() + (r * stripWidth), g.get() + ((r + height - 1) * stripWidth), I[r] + c0, w);
+        }
+      }
+    }
+  }
 }
 END_VISP_NAMESPACE
 
@@ -0,0 +1,125 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pool of image buffers.
+ */
+
+/*!
+ * \file vpImagePool.h
+ * \brief Pool of image buffers.
+ */
+
+#ifndef VP_IMAGE_POOL_H
+#define VP_IMAGE_POOL_H
+
+#include <stddef.h>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImagePool
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Thread-safe pool of image buffers, shared by all the vpImage instances of the process.
+ *
+ * When the pool is enabled, vpImage draws its bitmap from the pool instead of calling `new[]`, and gives it back to
+ * the pool instead of calling `delete[]`. Buffers are grouped by size buckets whose granularity is 64 bytes for small
+ * buffers and 4 kB for larger ones, so that an image of a given size can reuse the buffer released by any other image
+ * of the same size. In a tracking loop where temporary images are created and destroyed at each iteration, the
+ * steady state does not perform any heap allocation for these images anymore.
+ *
+ * All the buffers returned by the pool are aligned on 64 bytes.
+ *
+ * The pool is disabled by default. Images allocated while the pool was enabled are given back to the pool when they
+ * are destroyed, even if the pool has been disabled in the meantime.
+ *
+ * \code
+ * #include <visp3/core/vpImageFilter.h>
+ * #include <visp3/core/vpImagePool.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpImagePool::getInstance().setEnabled(true);
+ *   vpImage<unsigned char> I(1080, 1920, 0);
+ *   vpImage<float> Iblur;
+ *   for (unsigned int iter = 0; iter < 100; ++iter) {
+ *     vpImageFilter::gaussianBlur(I, Iblur, 7); // Temporary image reused after the first iteration
+ *   }
+ *   vpImagePool::vpStatistics stats = vpImagePool::getInstance().getStatistics();
+ *   std::cout << "Hits: " << stats.hits << " misses: " << stats.misses << std::endl;
+ * }
+ * \endcode
+ */
+class VISP_EXPORT vpImagePool
+{
+public:
+  /*!
+   * Statistics about the use of the pool.
+   */
+  struct vpStatistics
+  {
+    unsigned long long hits;   //!< Number of allocations served by a cached buffer
+    unsigned long long misses; //!< Number of allocations that required a heap allocation
+    size_t usedBytes;          //!< Number of bytes currently handed out to images
+    size_t cachedBytes;        //!< Number of bytes currently kept in the pool for reuse
+    size_t peakBytes;          //!< Maximum of usedBytes + cachedBytes since the last reset
+  };
+
+  static vpImagePool &getInstance();
+
+  void *allocate(size_t bytes);
+  void clear();
+  size_t getMaxCachedBytes() const;
+  vpStatistics getStatistics() const;
+  bool isEnabled() const;
+  void release(void *ptr, size_t bytes);
+  void resetStatistics();
+  void setEnabled(bool enable);
+  void setMaxCachedBytes(size_t maxBytes);
+
+  static size_t getBucketSize(size_t bytes);
+
+private:
+  vpImagePool();
+  ~vpImagePool();
+  vpImagePool(const vpImagePool &);
+  vpImagePool &operator=(const vpImagePool &);
+
+  class Impl;
+  Impl *m_impl;
+};
+END_VISP_NAMESPACE
+#endif
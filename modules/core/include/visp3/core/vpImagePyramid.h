@@ -0,0 +1,138 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-resolution image pyramid.
+ */
+
+/*!
+ * \file vpImagePyramid.h
+ * \brief Multi-resolution image pyramid.
+ */
+
+#ifndef VP_IMAGE_PYRAMID_H
+#define VP_IMAGE_PYRAMID_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImagePyramid
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Pyramid of grayscale images, where each level is half the size of the previous one.
+ *
+ * The level 0 is the image given to build(), which is not copied: the pyramid keeps a pointer to it, so the image
+ * must outlive the use of the pyramid. The other levels are owned by the pyramid and their buffers are reused from
+ * one call to build() to the next one, so that building the pyramid of a video stream does not allocate memory
+ * once the first frame has been processed.
+ *
+ * Two kinds of decimation are available:
+ * - vpImagePyramid::PYRAMID_GAUSSIAN: each level is obtained by smoothing the previous one with the 5x5 kernel
+ *   built from the 1-4-6-4-1 binomial filter and by keeping one pixel out of two. The filter is computed with 16-bit
+ *   integer arithmetic in a single pass over the previous level, the borders being reflected (BORDER_REFLECT_101).
+ *   The size of level \e l is ((w+1)/2, (h+1)/2) where (w, h) is the size of level \e l-1. The result is the same as
+ *   the one of `cv::pyrDown()` with the default parameters.
+ * - vpImagePyramid::PYRAMID_SUBSAMPLING: the level \e l is obtained by keeping one pixel out of 2^l of the base image,
+ *   without smoothing. This is the decimation used by the model-based edge tracker for its scales.
+ *
+ * A pyramid built once per frame can be shared between several consumers, e.g. given to
+ * vpMbEdgeTracker::setImagePyramid(), so that a camera frame is decimated only once.
+ *
+ * \code
+ * #include <visp3/core/vpImagePyramid.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpImage<unsigned char> I(480, 640, 128);
+ *   vpImagePyramid pyramid(4);
+ *   pyramid.build(I);
+ *   const vpImage<unsigned char> &I2 = pyramid[2]; // 120 x 160
+ * }
+ * \endcode
+ */
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  /*!
+   * Decimation used to compute a level from the previous one.
+   */
+  typedef enum
+  {
+    PYRAMID_GAUSSIAN,   /*!< 5x5 binomial smoothing followed by a decimation by 2. */
+    PYRAMID_SUBSAMPLING /*!< Decimation by 2 without smoothing. */
+  } vpPyramidType;
+
+  explicit vpImagePyramid(unsigned int nbLevels = 1, const vpPyramidType &type = PYRAMID_GAUSSIAN);
+
+  void build(const vpImage<unsigned char> &I);
+
+  //! Image given to the last call to build(), nullptr if the pyramid has never been built.
+  inline const vpImage<unsigned char> *getBaseImage() const { return m_base; }
+
+  const vpImage<unsigned char> &getLevel(unsigned int level) const;
+
+  //! Number of levels, including the base image.
+  inline unsigned int getNbLevels() const { return m_nbLevels; }
+
+  //! Decimation used to compute the levels.
+  inline vpPyramidType getType() const { return m_type; }
+
+  //! Return true if build() has been called since the last change of the parameters of the pyramid.
+  inline bool isBuilt() const { return m_base != nullptr; }
+
+  void setNbLevels(unsigned int nbLevels);
+
+  void setType(const vpPyramidType &type);
+
+  //! Get the image at the given level, see getLevel().
+  inline const vpImage<unsigned char> &operator[](unsigned int level) const { return getLevel(level); }
+
+  static void pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI);
+
+private:
+  static void pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, std::vector<unsigned short> &buffer);
+  static void subsample(const vpImage<unsigned char> &I, unsigned int factor, vpImage<unsigned char> &GI);
+
+  const vpImage<unsigned char> *m_base;       //!< Level 0, not owned
+  std::vector<vpImage<unsigned char> > m_levels; //!< Levels 1 to nbLevels - 1
+  std::vector<unsigned short> m_buffer;        //!< Rows of the horizontal pass, reused between calls
+  unsigned int m_nbLevels;                     //!< Number of levels, including the base image
+  vpPyramidType m_type;                        //!< Decimation used to compute the levels
+};
+END_VISP_NAMESPACE
+#endif
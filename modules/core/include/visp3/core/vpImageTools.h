@@ -42,7 +42,7 @@
 #define VP_IMAGE_TOOLS_H
 
 #ifdef VISP_HAVE_THREADS
-#include <thread>
+#include <functional>
 #endif
 
 #include <visp3/core/vpConfig.h>
@@ -50,9 +50,11 @@
 #include <visp3/core/vpHSV.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
+#include <visp3/core/vpThreadPool.h>
 
 #include <fstream>
 #include <iostream>
@@ -106,6 +108,11 @@ public:
   static void crop(const unsigned char *bitmap, unsigned int width, unsigned int height, const vpRect &roi,
                    vpImage<Type> &crop, unsigned int v_scale = 1, unsigned int h_scale = 1);
 
+  template <class Type>
+  static void crop(const vpImage<Type> &I, const vpRect &roi, vpImageView<const Type> &crop);
+  template <class Type>
+  static void crop(vpImage<Type> &I, const vpRect &roi, vpImageView<Type> &crop);
+
   static void extract(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst, const vpRectOriented &r);
   static void extract(const vpImage<unsigned char> &src, vpImage<double> &dst, const vpRectOriented &r);
 
@@ -659,6 +666,42 @@ void vpImageTools::crop(const vpImage<Type> &I, const vpRect &roi, vpImage<Type>
                      v_scale, h_scale);
 }
 
+/*!
+  Crop a region of interest (ROI) in an image without copying it. The ROI
+  coordinates and dimension are defined in the original image, and the ROI is
+  clipped to the image the same way crop(const vpImage<Type> &, const vpRect &, vpImage<Type> &, unsigned int, unsigned int)
+  does.
+
+  \param[in] I : Input image. It must outlive the view and must not be resized
+  while the view is used.
+  \param[in] roi : Region of interest in image \e I.
+  \param[out] crop : Read-only view on the ROI, which shares the pixels of \e I.
+
+  \sa vpImageView
+*/
+template <class Type>
+void vpImageTools::crop(const vpImage<Type> &I, const vpRect &roi, vpImageView<const Type> &crop)
+{
+  crop = vpImageView<const Type>(I, roi);
+}
+
+/*!
+  Crop a region of interest (ROI) in an image without copying it, the pixels
+  of the ROI being writable through the view. See
+  crop(const vpImage<Type> &, const vpRect &, vpImageView<const Type> &).
+
+  \param[in] I : Input image. It must outlive the view and must not be resized
+  while the view is used.
+  \param[in] roi : Region of interest in image \e I.
+  \param[out] crop : View on the ROI, which shares the pixels of \e I.
+
+  \sa vpImageView
+*/
+template <class Type> void vpImageTools::crop(vpImage<Type> &I, const vpRect &roi, vpImageView<Type> &crop)
+{
+  crop = vpImageView<Type>(I, roi);
+}
+
 /*!
   Crop a region of interest (ROI) in an image. The ROI coordinates and
   dimension are defined in the original image.
@@ -945,7 +988,7 @@ void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &c
   }
 
   unsigned int nthreads = nThreads;
-  std::vector<std::thread *> threadpool;
+  vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
 
   vpUndistortInternalType<Type> *undistortSharedData = new vpUndistortInternalType<Type>[nthreads];
 
@@ -958,18 +1001,10 @@ void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &c
     undistortSharedData[i].cam = cam;
     undistortSharedData[i].nthreads = nthreads;
     undistortSharedData[i].threadid = i;
-    std::thread *undistort_thread = new std::thread(&vpUndistortInternalType<Type>::vpUndistort_threaded, std::ref(undistortSharedData[i]));
-    threadpool.push_back(undistort_thread);
-  }
-  /* Wait on the other threads */
-
-  for (unsigned int i = 0; i < nthreads; ++i) {
-    threadpool[i]->join();
-  }
-
-  for (unsigned int i = 0; i < nthreads; ++i) {
-    delete threadpool[i];
+    group.run(std::bind(&vpUndistortInternalType<Type>::vpUndistort_threaded, std::ref(undistortSharedData[i])));
   }
+  /* Wait on the other tasks */
+  group.wait();
 
   delete[] undistortSharedData;
 #else  // VISP_HAVE_THREADS
@@ -0,0 +1,272 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Non-owning strided view on image data.
+ */
+
+/*!
+ * \file vpImageView.h
+ * \brief Non-owning strided view on image data.
+ */
+
+#ifndef VP_IMAGE_VIEW_H
+#define VP_IMAGE_VIEW_H
+
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+#include <type_traits>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpImageView
+ *
+ * \ingroup group_core_image
+ *
+ * \brief Non-owning view on a rectangular region of an image.
+ *
+ * A view references pixels owned by someone else (usually a vpImage) through a pointer to its first pixel, its
+ * dimensions and a row stride expressed in number of elements. Creating a view on a region of interest (ROI) is
+ * therefore a zero-copy operation: consecutive rows of the view are separated by the width of the parent image.
+ *
+ * The view does not manage the lifetime of the data. It must not outlive the image it was created from, and it is
+ * invalidated as soon as the parent image is resized or destroyed.
+ *
+ * A view on a const image has to be a read-only view whose pixel type is const, e.g. `vpImageView<const unsigned
+ * char>`. A writable view converts implicitly to a read-only one.
+ *
+ * \code
+ * #include <visp3/core/vpImageFilter.h>
+ * #include <visp3/core/vpImageView.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   const vpImage<unsigned char> I(480, 640, 128);
+ *   vpImageView<const unsigned char> roi(I, vpRect(100, 50, 200, 120)); // No copy
+ *   vpImage<float> Iblur;
+ *   vpImageFilter::gaussianBlur(roi, Iblur, 7); // Iblur is 120 x 200
+ * }
+ * \endcode
+ *
+ * \sa vpImageTools::crop(const vpImage<Type> &, const vpRect &, vpImageView<const Type> &)
+ */
+template <class Type> class vpImageView
+{
+public:
+  //! Pixel type without the const qualifier, i.e. the type of the pixels of the viewed vpImage.
+  typedef typename std::remove_const<Type>::type vpPixelType;
+
+  /*!
+   * Default constructor that creates an empty view.
+   */
+  vpImageView() : m_data(nullptr), m_height(0), m_width(0), m_stride(0) { }
+
+  /*!
+   * Create a view on the whole image \e I.
+   *
+   * \param[in] I : Image to view.
+   */
+  explicit vpImageView(vpImage<vpPixelType> &I)
+    : m_data(I.bitmap), m_height(I.getHeight()), m_width(I.getWidth()), m_stride(I.getWidth())
+  { }
+
+  /*!
+   * Create a read-only view on the whole const image \e I. Only available when \e Type is const.
+   *
+   * \param[in] I : Image to view.
+   */
+  template <class OtherType = Type, typename = typename std::enable_if<std::is_const<OtherType>::value>::type>
+  explicit vpImageView(const vpImage<vpPixelType> &I)
+    : m_data(static_cast<const vpPixelType *>(I.bitmap)), m_height(I.getHeight()), m_width(I.getWidth()),
+    m_stride(I.getWidth())
+  { }
+
+  /*!
+   * Create a view on the region of interest \e roi of image \e I.
+   * The ROI is clipped to the image boundaries the same way vpImageTools::crop() does.
+   *
+   * \param[in] I : Image to view.
+   * \param[in] roi : Region of interest in image \e I.
+   */
+  vpImageView(vpImage<vpPixelType> &I, const vpRect &roi)
+    : m_data(nullptr), m_height(0), m_width(0), m_stride(I.getWidth())
+  {
+    setRoi(I.bitmap, I.getHeight(), I.getWidth(), roi);
+  }
+
+  /*!
+   * Create a read-only view on the region of interest \e roi of the const image \e I. Only available when \e Type
+   * is const. The ROI is clipped to the image boundaries the same way vpImageTools::crop() does.
+   *
+   * \param[in] I : Image to view.
+   * \param[in] roi : Region of interest in image \e I.
+   */
+  template <class OtherType = Type, typename = typename std::enable_if<std::is_const<OtherType>::value>::type>
+  vpImageView(const vpImage<vpPixelType> &I, const vpRect &roi)
+    : m_data(nullptr), m_height(0), m_width(0), m_stride(I.getWidth())
+  {
+    setRoi(static_cast<const vpPixelType *>(I.bitmap), I.getHeight(), I.getWidth(), roi);
+  }
+
+  /*!
+   * Create a read-only view from a writable view on the same pixels.
+   *
+   * \param[in] view : Writable view.
+   */
+  template <class OtherType, typename = typename std::enable_if<std::is_same<const OtherType, Type>::value>::type>
+  vpImageView(const vpImageView<OtherType> &view)
+    : m_data(view.data()), m_height(view.getHeight()), m_width(view.getWidth()), m_stride(view.getStride())
+  { }
+
+  /*!
+   * Create a view on externally managed data.
+   *
+   * \param[in] data : Pointer to the first pixel of the view.
+   * \param[in] height : Number of rows.
+   * \param[in] width : Number of columns.
+   * \param[in] stride : Number of elements between the beginning of two consecutive rows. When equal to 0, the
+   * stride is set to \e width.
+   */
+  vpImageView(Type *data, unsigned int height, unsigned int width, unsigned int stride = 0)
+    : m_data(data), m_height(height), m_width(width), m_stride(stride == 0 ? width : stride)
+  {
+    if (m_stride < m_width) {
+      throw(vpException(vpException::dimensionError, "Image view stride (%u) lower than its width (%u)", m_stride,
+                        m_width));
+    }
+  }
+
+  /*!
+   * Copy the viewed pixels into the contiguous image \e I, which is resized if needed.
+   */
+  void copyTo(vpImage<vpPixelType> &I) const
+  {
+    I.resize(m_height, m_width);
+    for (unsigned int i = 0; i < m_height; ++i) {
+      memcpy(static_cast<void *>(I[i]), static_cast<const void *>((*this)[i]), m_width * sizeof(Type));
+    }
+  }
+
+  //! Pointer to the first pixel of the view.
+  inline Type *data() const { return m_data; }
+
+  //! Number of columns of the view.
+  inline unsigned int getCols() const { return m_width; }
+
+  //! Number of rows of the view.
+  inline unsigned int getHeight() const { return m_height; }
+
+  //! Number of rows of the view.
+  inline unsigned int getRows() const { return m_height; }
+
+  //! Number of pixels of the view.
+  inline unsigned int getSize() const { return m_width * m_height; }
+
+  //! Number of elements between the beginning of two consecutive rows.
+  inline unsigned int getStride() const { return m_stride; }
+
+  //! Number of columns of the view.
+  inline unsigned int getWidth() const { return m_width; }
+
+  //! Return true when the rows of the view are stored one after the other without gap.
+  inline bool isContiguous() const { return m_stride == m_width; }
+
+  //! Return true when the view does not reference any pixel.
+  inline bool isEmpty() const { return (m_data == nullptr) || (m_width == 0) || (m_height == 0); }
+
+  /*!
+   * Create a view on a region of interest of this view, expressed in the view coordinates.
+   * The ROI is clipped to the view boundaries.
+   */
+  vpImageView<Type> subView(const vpRect &roi) const
+  {
+    int i_min = std::max<int>(static_cast<int>(ceil(roi.getTop())), 0);
+    int j_min = std::max<int>(static_cast<int>(ceil(roi.getLeft())), 0);
+    int i_max = std::min<int>(static_cast<int>(ceil(roi.getTop() + roi.getHeight())), static_cast<int>(m_height));
+    int j_max = std::min<int>(static_cast<int>(ceil(roi.getLeft() + roi.getWidth())), static_cast<int>(m_width));
+
+    if ((i_max <= i_min) || (j_max <= j_min)) {
+      return vpImageView<Type>();
+    }
+    Type *first = m_data + ((static_cast<size_t>(i_min) * m_stride) + static_cast<size_t>(j_min));
+    return vpImageView<Type>(first, static_cast<unsigned int>(i_max - i_min),
+                             static_cast<unsigned int>(j_max - j_min), m_stride);
+  }
+
+  //! operator[] allows operation like I[i] = x.
+  inline Type *operator[](unsigned int i) { return m_data + (static_cast<size_t>(i) * m_stride); }
+  inline Type *operator[](int i) { return m_data + (static_cast<size_t>(i) * m_stride); }
+
+  //! operator[] allows operation like x = I[i]
+  inline const Type *operator[](unsigned int i) const { return m_data + (static_cast<size_t>(i) * m_stride); }
+  inline const Type *operator[](int i) const { return m_data + (static_cast<size_t>(i) * m_stride); }
+
+  /*!
+   * Get the value of the pixel with coordinates (i, j), with i the row position and j the column position.
+   */
+  inline Type operator()(unsigned int i, unsigned int j) const { return m_data[(static_cast<size_t>(i) * m_stride) + j]; }
+
+  /*!
+   * Set the value \e v of the pixel with coordinates (i, j), with i the row position and j the column position.
+   */
+  inline void operator()(unsigned int i, unsigned int j, const Type &v) { m_data[(static_cast<size_t>(i) * m_stride) + j] = v; }
+
+private:
+  // Point the view on the part of roi that lies inside the image of size height x width whose first pixel is bitmap
+  void setRoi(Type *bitmap, unsigned int height, unsigned int width, const vpRect &roi)
+  {
+    int i_min = std::max<int>(static_cast<int>(ceil(roi.getTop())), 0);
+    int j_min = std::max<int>(static_cast<int>(ceil(roi.getLeft())), 0);
+    int i_max = std::min<int>(static_cast<int>(ceil(roi.getTop() + roi.getHeight())), static_cast<int>(height));
+    int j_max = std::min<int>(static_cast<int>(ceil(roi.getLeft() + roi.getWidth())), static_cast<int>(width));
+
+    if ((i_max > i_min) && (j_max > j_min)) {
+      m_data = bitmap + ((static_cast<unsigned int>(i_min) * m_stride) + static_cast<unsigned int>(j_min));
+      m_height = static_cast<unsigned int>(i_max - i_min);
+      m_width = static_cast<unsigned int>(j_max - j_min);
+    }
+  }
+
+  Type *m_data;          //!< Pointer to the first pixel of the view
+  unsigned int m_height; //!< Number of rows
+  unsigned int m_width;  //!< Number of columns
+  unsigned int m_stride; //!< Number of elements between two consecutive rows
+};
+END_VISP_NAMESPACE
+#endif
@@ -211,7 +211,7 @@ template <> inline void vpImage<unsigned char>::performLut(const unsigned char(&
   else {
 #if defined(VISP_HAVE_THREADS)
     // Multi-threads
-    std::vector<std::thread *> threadpool;
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
     std::vector<vpImageLut_Param_t *> imageLutParams;
 
     unsigned int image_size = getSize();
@@ -231,21 +231,14 @@ template <> inline void vpImage<unsigned char>::performLut(const unsigned char(&
 
       imageLutParams.push_back(imageLut_param);
 
-      // Start the threads
-      std::thread *imageLut_thread = new std::thread(&performLutThread, imageLut_param);
-      threadpool.push_back(imageLut_thread);
+      // Start the tasks
+      group.run(std::bind(&performLutThread, imageLut_param));
     }
 
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
+    // Wait until the tasks end up
+    group.wait();
 
     // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      delete threadpool[cpt];
-    }
-
     for (size_t cpt = 0; cpt < imageLutParams.size(); ++cpt) {
       delete imageLutParams[cpt];
     }
@@ -298,7 +291,7 @@ template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa(&lut)[256], uns
   else {
 #if defined(VISP_HAVE_THREADS)
     // Multi-threads
-    std::vector<std::thread *> threadpool;
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
     std::vector<vpImageLutRGBa_Param_t *> imageLutParams;
 
     unsigned int image_size = getSize();
@@ -318,21 +311,14 @@ template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa(&lut)[256], uns
 
       imageLutParams.push_back(imageLut_param);
 
-      // Start the threads
-      std::thread *imageLut_thread = new std::thread(&performLutRGBaThread, imageLut_param);
-      threadpool.push_back(imageLut_thread);
+      // Start the tasks
+      group.run(std::bind(&performLutRGBaThread, imageLut_param));
     }
 
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
+    // Wait until the tasks end up
+    group.wait();
 
     // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      delete threadpool[cpt];
-    }
-
     for (size_t cpt = 0; cpt < imageLutParams.size(); ++cpt) {
       delete imageLutParams[cpt];
     }
@@ -213,11 +213,11 @@ template <class Type> vpImage<Type> &vpImage<Type>::operator=(const vpImage<Type
 template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> &&other)
 {
   if (row != nullptr) {
-    delete[] row;
+    releaseRow(row, height, rowPooled);
   }
   row = other.row;
   if (bitmap != nullptr && hasOwnership) {
-    delete[] bitmap;
+    releaseBitmap(bitmap, npixels, memAlignment, memPooled);
   }
   bitmap = other.bitmap;
 
@@ -235,6 +235,9 @@ template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> &&ot
   width = other.width;
   npixels = other.npixels;
   hasOwnership = other.hasOwnership;
+  memAlignment = other.memAlignment;
+  memPooled = other.memPooled;
+  rowPooled = other.rowPooled;
 
   other.bitmap = nullptr;
   other.display = nullptr;
@@ -243,6 +246,9 @@ template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> &&ot
   other.height = 0;
   other.row = nullptr;
   other.hasOwnership = false;
+  other.memAlignment = 0;
+  other.memPooled = false;
+  other.rowPooled = false;
 
   return *this;
 }
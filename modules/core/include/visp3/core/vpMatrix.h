@@ -503,6 +503,14 @@ public:
 
   vpMatrix AtA() const;
   void AtA(vpMatrix &B) const;
+
+  vpMatrix AtB(const vpMatrix &B) const;
+  void AtB(const vpMatrix &B, vpMatrix &C) const;
+  vpColVector AtB(const vpColVector &b) const;
+  void AtB(const vpColVector &b, vpColVector &c) const;
+
+  vpMatrix AtWA(const vpColVector &w) const;
+  void AtWA(const vpColVector &w, vpMatrix &B) const;
   //@}
 
   //-------------------------------------------------
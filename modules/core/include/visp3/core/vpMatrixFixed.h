@@ -0,0 +1,233 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Matrix whose size is known at compile time.
+ */
+
+/*!
+ * \file vpMatrixFixed.h
+ * \brief Matrix whose size is known at compile time.
+ */
+
+#ifndef VP_MATRIX_FIXED_H
+#define VP_MATRIX_FIXED_H
+
+#include <algorithm>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpException.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMatrixFixed
+ *
+ * \ingroup group_core_matrices
+ *
+ * \brief Matrix of doubles with \e R rows and \e C columns known at compile time.
+ *
+ * The elements are stored row by row in the object itself, so that a vpMatrixFixed lives on the stack and
+ * no memory is allocated when it is created, copied or returned. The loops of the operators have a constant trip
+ * count, which lets the compiler unroll and vectorize them. This makes it well suited to the small products
+ * (3x3, 4x4, 6x6) computed at each iteration of a virtual visual servoing loop.
+ *
+ * The products accumulate the terms in the same order as vpMatrix, so that the results are identical to
+ * the ones of vpMatrix::mult2Matrices() without Blas.
+ *
+ * A vpMatrixFixed can be built from any vpArray2D<double> with the right size, i.e. a vpMatrix, a vpColVector, a
+ * vpRotationMatrix, a vpHomogeneousMatrix or a vpVelocityTwistMatrix, and copied back with copyTo().
+ *
+ * \code
+ * #include <visp3/core/vpHomogeneousMatrix.h>
+ * #include <visp3/core/vpMatrixFixed.h>
+ * #include <visp3/core/vpVelocityTwistMatrix.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpHomogeneousMatrix cMo(0.1, 0.2, 0.5, 0.1, 0.2, 0.3);
+ *   vpVelocityTwistMatrix cVo(cMo);
+ *
+ *   vpMatrixFixed<6, 6> V(cVo);
+ *   vpMatrixFixed<6, 6> VtV = V.t() * V;
+ *
+ *   vpMatrix M;
+ *   VtV.copyTo(M);
+ * }
+ * \endcode
+ */
+template <unsigned int R, unsigned int C>
+class vpMatrixFixed
+{
+public:
+  //! Matrix whose elements are all set to zero.
+  vpMatrixFixed() { std::fill(data, data + (R * C), 0.); }
+
+  /*!
+   * Copy the elements of \e A.
+   * \exception vpException::dimensionError If \e A is not a R x C array.
+   */
+  explicit vpMatrixFixed(const vpArray2D<double> &A)
+  {
+    if ((A.getRows() != R) || (A.getCols() != C)) {
+      throw(vpException(vpException::dimensionError, "Cannot build a (%dx%d) fixed size matrix from a (%dx%d) array", R,
+                        C, A.getRows(), A.getCols()));
+    }
+    std::copy(A.data, A.data + (R * C), data);
+  }
+
+  //! Number of rows.
+  static unsigned int getRows() { return R; }
+  //! Number of columns.
+  static unsigned int getCols() { return C; }
+
+  /*!
+   * Copy the elements to \e A, that is resized if it is not a R x C array.
+   */
+  void copyTo(vpArray2D<double> &A) const
+  {
+    if ((A.getRows() != R) || (A.getCols() != C)) {
+      A.resize(R, C, false, false);
+    }
+    std::copy(data, data + (R * C), A.data);
+  }
+
+  //! Identity matrix, or the identity completed with zeros if the matrix is not square.
+  static vpMatrixFixed eye()
+  {
+    vpMatrixFixed I;
+    for (unsigned int i = 0; (i < R) && (i < C); ++i) {
+      I.data[(i * C) + i] = 1.;
+    }
+    return I;
+  }
+
+  /*!
+   * Compute the product AB = A * B of a R x C matrix by a C x K matrix, the three matrices being stored row
+   * by row. \e AB must not overlap \e A or \e B.
+   */
+  template <unsigned int K> static void mult(const double *A, const double *B, double *AB)
+  {
+    for (unsigned int i = 0; i < R; ++i) {
+      double *ab = AB + (i * K);
+      std::fill(ab, ab + K, 0.);
+      // The columns of a row of AB are accumulated together, in the same order as the dot products of vpMatrix
+      for (unsigned int k = 0; k < C; ++k) {
+        const double a = A[(i * C) + k];
+        const double *b = B + (k * K);
+        for (unsigned int j = 0; j < K; ++j) {
+          ab[j] += a * b[j];
+        }
+      }
+    }
+  }
+
+  //! Transpose of the matrix.
+  vpMatrixFixed<C, R> t() const
+  {
+    vpMatrixFixed<C, R> At;
+    for (unsigned int i = 0; i < R; ++i) {
+      for (unsigned int j = 0; j < C; ++j) {
+        At.data[(j * R) + i] = data[(i * C) + j];
+      }
+    }
+    return At;
+  }
+
+  //! Element at row \e i and column \e j.
+  inline double &operator()(unsigned int i, unsigned int j) { return data[(i * C) + j]; }
+  //! Element at row \e i and column \e j.
+  inline const double &operator()(unsigned int i, unsigned int j) const { return data[(i * C) + j]; }
+
+  //! Pointer to the first element of row \e i.
+  inline double *operator[](unsigned int i) { return data + (i * C); }
+  //! Pointer to the first element of row \e i.
+  inline const double *operator[](unsigned int i) const { return data + (i * C); }
+
+  //! Product of the matrix by a C x K matrix.
+  template <unsigned int K> vpMatrixFixed<R, K> operator*(const vpMatrixFixed<C, K> &B) const
+  {
+    vpMatrixFixed<R, K> AB;
+    mult<K>(data, B.data, AB.data);
+    return AB;
+  }
+
+  //! Product of each element by \e x.
+  vpMatrixFixed operator*(double x) const
+  {
+    vpMatrixFixed Ax;
+    for (unsigned int i = 0; i < (R * C); ++i) {
+      Ax.data[i] = data[i] * x;
+    }
+    return Ax;
+  }
+
+  //! Element-wise sum.
+  vpMatrixFixed operator+(const vpMatrixFixed &B) const
+  {
+    vpMatrixFixed AB = *this;
+    AB += B;
+    return AB;
+  }
+
+  //! Element-wise difference.
+  vpMatrixFixed operator-(const vpMatrixFixed &B) const
+  {
+    vpMatrixFixed AB = *this;
+    AB -= B;
+    return AB;
+  }
+
+  //! Element-wise sum.
+  vpMatrixFixed &operator+=(const vpMatrixFixed &B)
+  {
+    for (unsigned int i = 0; i < (R * C); ++i) {
+      data[i] += B.data[i];
+    }
+    return *this;
+  }
+
+  //! Element-wise difference.
+  vpMatrixFixed &operator-=(const vpMatrixFixed &B)
+  {
+    for (unsigned int i = 0; i < (R * C); ++i) {
+      data[i] -= B.data[i];
+    }
+    return *this;
+  }
+
+  //! Elements stored row by row.
+  double data[R * C];
+};
+END_VISP_NAMESPACE
+#endif
@@ -0,0 +1,124 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read-only memory-mapped file.
+ */
+
+/*!
+ * \file vpMemoryMappedFile.h
+ * \brief Read-only memory-mapped file.
+ */
+
+#ifndef VP_MEMORY_MAPPED_FILE_H
+#define VP_MEMORY_MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMemoryMappedFile
+ *
+ * \ingroup group_core_files_io
+ *
+ * \brief Read-only view of the content of a file, mapped in memory.
+ *
+ * The pages of the file are loaded by the operating system when they are first accessed, so that opening a large
+ * file is immediate and only the parts that are read are loaded. The content can be used in place, e.g. to wrap
+ * arrays stored in the file without copying them. On the platforms that do not support memory mapping, the file
+ * is read in a buffer when it is opened.
+ *
+ * The pointer returned by data() is valid until the file is closed or the object is destroyed. It is aligned on a
+ * page boundary, so that the arrays stored in the file at an offset aligned on their size can be used directly.
+ *
+ * \code
+ * #include <visp3/core/vpMemoryMappedFile.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpMemoryMappedFile file("data.bin");
+ *   const unsigned char *data = file.data();
+ *   size_t size = file.size();
+ *   // ...
+ * }
+ * \endcode
+ */
+class VISP_EXPORT vpMemoryMappedFile
+{
+public:
+  vpMemoryMappedFile();
+  explicit vpMemoryMappedFile(const std::string &filename);
+  vpMemoryMappedFile(const vpMemoryMappedFile &) = delete; // non construction-copyable
+  vpMemoryMappedFile &operator=(const vpMemoryMappedFile &) = delete; // non copyable
+  virtual ~vpMemoryMappedFile();
+
+  void close();
+
+  /*!
+   * Return a pointer to the content of the file, or nullptr if no file is opened or if the file is empty.
+   */
+  const unsigned char *data() const { return m_data; }
+
+  //! Return the name of the opened file.
+  std::string getFilename() const { return m_filename; }
+
+  /*!
+   * Return true if the file is mapped in memory, false if it has been read in a buffer, when memory mapping is not
+   * available, or if no file is opened.
+   */
+  bool isMapped() const { return m_mapped; }
+
+  //! Return true if a file is opened.
+  bool isOpen() const { return m_isOpen; }
+
+  void open(const std::string &filename);
+
+  //! Return the size of the file in bytes.
+  size_t size() const { return m_size; }
+
+private:
+  std::string m_filename;
+  const unsigned char *m_data;
+  size_t m_size;
+  bool m_isOpen;
+  bool m_mapped;
+  std::vector<unsigned char> m_buffer; //!< Content of the file, when it cannot be mapped
+  void *m_fileHandle; //!< Handle of the file (Windows only)
+  void *m_mappingHandle; //!< Handle of the file mapping (Windows only)
+};
+END_VISP_NAMESPACE
+
+#endif
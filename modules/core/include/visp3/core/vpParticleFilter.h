@@ -43,9 +43,7 @@
 
 #include <functional> // std::function
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
+#include <visp3/core/vpThreadPool.h>
 
 #if defined(__clang__)
 // Mute warning : '\tparam' command used in a comment that is not attached to a template declaration [-Wdocumentation]
@@ -173,8 +171,9 @@ public:
    * \param[in] stdev The standard deviations of the noise, each item correspond to one component of the state.
    * \param[in] seed The seed to use to create the noise generators. A negative value makes the seed to
    * be based on the current time.
-   * \param[in] nbThreads The number of threads the user would like to use. Negative value to set the maximum number
-   * of threads available when using OpenMP.
+   * \param[in] nbThreads The number of tasks the particles are split into, each task having its own noise generator
+   * so that the result does not depend on the scheduling of the tasks. Negative value to use the number of threads of
+   * vpThreadPool::getInstance().
    */
   VP_EXPLICIT vpParticleFilter(const unsigned int &N, const std::vector<double> &stdev, const long &seed = -1, const int &nbThreads = -1);
 
@@ -384,7 +383,7 @@ public:
 
 private:
   void initParticles(const vpColVector &x0);
-#ifdef VISP_HAVE_OPENMP
+#if defined(VISP_HAVE_THREADS)
   void predictMultithread(const double &dt, const vpColVector &u);
   void updateMultithread(const MeasurementsType &z);
 #endif
@@ -429,24 +428,17 @@ vpParticleFilter<MeasurementsType>::vpParticleFilter(const unsigned int &N, cons
   , m_useProcessFunction(false)
   , m_useCommandStateFunction(false)
 {
-#ifndef VISP_HAVE_OPENMP
+#if !defined(VISP_HAVE_THREADS)
   m_nbMaxThreads = 1;
   if (nbThreads > 1) {
-    std::cout << "[vpParticleFilter::vpParticleFilter] WARNING: OpenMP is not available, maximum number of threads to use clamped to 1" << std::endl;
+    std::cout << "[vpParticleFilter::vpParticleFilter] WARNING: threads are not available, maximum number of threads to use clamped to 1" << std::endl;
   }
 #else
-  int maxThreads = omp_get_max_threads();
   if (nbThreads <= 0) {
-    m_nbMaxThreads = maxThreads;
-  }
-  else if (nbThreads > maxThreads) {
-    m_nbMaxThreads = maxThreads;
-    std::cout << "[vpParticleFilter::vpParticleFilter] WARNING: maximum number of threads to use clamped to "
-      << maxThreads << " instead of " << nbThreads << " due to OpenMP restrictions." << std::endl;
-    std::cout << "[vpParticleFilter::vpParticleFilter] If you want more, consider to use omp_set_num_threads before." << std::endl;
+    m_nbMaxThreads = vpThreadPool::getInstance().getNbThreads();
   }
   else {
-    m_nbMaxThreads = nbThreads;
+    m_nbMaxThreads = static_cast<unsigned int>(nbThreads);
   }
 #endif
   // Generating the random generators
@@ -529,7 +521,7 @@ void vpParticleFilter<MeasurementsType>::predict(const double &dt, const vpColVe
   if (m_nbMaxThreads == 1) {
     predictMonothread(dt, u);
   }
-#ifdef VISP_HAVE_OPENMP
+#if defined(VISP_HAVE_THREADS)
   else {
     predictMultithread(dt, u);
   }
@@ -542,7 +534,7 @@ void vpParticleFilter<MeasurementsType>::update(const MeasurementsType &z)
   if (m_nbMaxThreads == 1) {
     updateMonothread(z);
   }
-#ifdef VISP_HAVE_OPENMP
+#if defined(VISP_HAVE_THREADS)
   else {
     updateMultithread(z);
   }
@@ -653,98 +645,75 @@ void vpParticleFilter<MeasurementsType>::initParticles(const vpColVector &x0)
   }
 }
 
-#ifdef VISP_HAVE_OPENMP
+#if defined(VISP_HAVE_THREADS)
 template <typename MeasurementsType>
 void vpParticleFilter<MeasurementsType>::predictMultithread(const double &dt, const vpColVector &u)
 {
-  int iam, nt, ipoints, istart, npoints(m_N);
   unsigned int sizeState = m_particles[0].size();
+  unsigned int chunkSize = m_N / m_nbMaxThreads;
 
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart) num_threads(m_nbMaxThreads)
-  {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
-    }
-
-    for (int i = istart; i< istart + ipoints; ++i) {
-      // Updating the particles following the process (or command) function
-      if (m_useCommandStateFunction) {
-        m_particles[i] = m_bx(u, m_particles[i], dt);
-      }
-      else if (m_useProcessFunction) {
-        m_particles[i] = m_f(m_particles[i], dt);
-      }
-
-      // Generating noise to add to the particle
-      vpColVector noise(sizeState);
-      for (unsigned int j = 0; j < sizeState; ++j) {
-        noise[j] = m_noiseGenerators[iam][j]();
+  // One task per noise generator, the last task doing the remaining particles
+  vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
+  for (unsigned int iam = 0; iam < m_nbMaxThreads; ++iam) {
+    unsigned int istart = iam * chunkSize;
+    unsigned int istop = (iam == m_nbMaxThreads - 1) ? m_N : (istart + chunkSize);
+    group.run([this, &dt, &u, sizeState, iam, istart, istop]() {
+      for (unsigned int i = istart; i < istop; ++i) {
+        // Updating the particles following the process (or command) function
+        if (m_useCommandStateFunction) {
+          m_particles[i] = m_bx(u, m_particles[i], dt);
+        }
+        else if (m_useProcessFunction) {
+          m_particles[i] = m_f(m_particles[i], dt);
+        }
+
+        // Generating noise to add to the particle
+        vpColVector noise(sizeState);
+        for (unsigned int j = 0; j < sizeState; ++j) {
+          noise[j] = m_noiseGenerators[iam][j]();
+        }
+
+        // Adding the noise to the particle
+        m_particles[i] = m_stateAdd(m_particles[i], noise);
       }
-
-      // Adding the noise to the particle
-      m_particles[i] = m_stateAdd(m_particles[i], noise);
-    }
-  }
-}
-
-template <typename MeasurementsType>
-double threadLikelihood(const typename vpParticleFilter<MeasurementsType>::vpLikelihoodFunction &likelihood, const std::vector<vpColVector> &v_particles,
-                        const MeasurementsType &z, std::vector<double> &w, const int &istart, const int &ipoints)
-{
-  double sum(0.0);
-  for (int i = istart; i< istart + ipoints; ++i) {
-    w[i] = w[i] * likelihood(v_particles[i], z);
-    sum += w[i];
+    });
   }
-  return sum;
+  group.wait();
 }
 
 template <typename MeasurementsType>
 void vpParticleFilter<MeasurementsType>::updateMultithread(const MeasurementsType &z)
 {
-  double sumWeights = 0.0;
-  int iam, nt, ipoints, istart, npoints(m_N);
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  unsigned int chunkSize = m_N / m_nbMaxThreads;
   vpColVector tempSums(m_nbMaxThreads, 0.0);
+
   // Compute the weights depending on the likelihood of a particle with regard to the measurements
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart) num_threads(m_nbMaxThreads)
   {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
+    vpThreadPool::vpTaskGroup group(pool);
+    for (unsigned int iam = 0; iam < m_nbMaxThreads; ++iam) {
+      unsigned int istart = iam * chunkSize;
+      unsigned int istop = (iam == m_nbMaxThreads - 1) ? m_N : (istart + chunkSize);
+      group.run([this, &z, &tempSums, iam, istart, istop]() {
+        double sum = 0.0;
+        for (unsigned int i = istart; i < istop; ++i) {
+          m_w[i] = m_w[i] * m_likelihood(m_particles[i], z);
+          sum += m_w[i];
+        }
+        tempSums[iam] = sum;
+      });
     }
-    tempSums[iam] = threadLikelihood<MeasurementsType>(m_likelihood, m_particles, z, m_w, istart, ipoints);
+    group.wait();
   }
-  sumWeights = tempSums.sum();
+  double sumWeights = tempSums.sum();
 
   if (sumWeights > std::numeric_limits<double>::epsilon()) {
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart)
-    {
-      iam = omp_get_thread_num();
-      nt = omp_get_num_threads();
-      ipoints = npoints / nt;
-      // size of partition
-      istart = iam * ipoints; // starting array index
-      if (iam == nt-1) {
-        // last thread may do more
-        ipoints = npoints - istart;
-      }
-
-      // Normalize the weights
-      for (int i = istart; i < istart + ipoints; ++i) {
+    // Normalize the weights
+    pool.parallelFor(0, m_N, [this, sumWeights](unsigned int istart, unsigned int istop) {
+      for (unsigned int i = istart; i < istop; ++i) {
         m_w[i] = m_w[i] / sumWeights;
       }
-    }
+    });
   }
 }
 #endif
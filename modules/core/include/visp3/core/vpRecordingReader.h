@@ -0,0 +1,174 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reader of synchronized recordings of images, point clouds and poses.
+ */
+
+/*!
+ * \file vpRecordingReader.h
+ * \brief Reader of synchronized recordings of images, point clouds and poses.
+ */
+
+#ifndef VP_RECORDING_READER_H
+#define VP_RECORDING_READER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpMemoryMappedFile.h>
+#include <visp3/core/vpRecordingWriter.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpRecordingReader
+ *
+ * \ingroup group_core_files_io
+ *
+ * \brief Read the frames of the streams of a recording written by vpRecordingWriter.
+ *
+ * The file is mapped in memory, so that opening a recording is immediate and reading a frame does not open a file.
+ * The frames of a stream are accessed by their index, and the frames of other streams acquired at the same time
+ * are found with getFrameIndex() from their timestamps.
+ *
+ * The images of the uncompressed streams can be accessed without copy with getView(), as read-only views on the
+ * mapped file. The images returned by read() are copies that can be modified, converted to the type of the image
+ * when possible, e.g. a color stream read in a grayscale image.
+ *
+ * \code
+ * #include <visp3/core/vpRecordingReader.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpRecordingReader reader("recording.vprec");
+ *   int color = reader.findStream("color");
+ *   int depth = reader.findStream("depth");
+ *   vpImageView<const vpRGBa> I_color;
+ *   vpImage<uint16_t> I_depth;
+ *   for (unsigned int i = 0; i < reader.getNbFrames(color); ++i) {
+ *     if (reader.getView(color, i, I_color)) {
+ *       // Use the pixels of the recording without copy
+ *     }
+ *     // Depth image acquired at the same time, copied to be modified
+ *     reader.read(depth, reader.getFrameIndex(depth, reader.getTimestamp(color, i)), I_depth);
+ *   }
+ * }
+ * \endcode
+ *
+ * \sa vpRecordingWriter
+ */
+class VISP_EXPORT vpRecordingReader
+{
+public:
+  vpRecordingReader();
+  explicit vpRecordingReader(const std::string &filename);
+  vpRecordingReader(const vpRecordingReader &) = delete; // non construction-copyable
+  vpRecordingReader &operator=(const vpRecordingReader &) = delete; // non copyable
+  virtual ~vpRecordingReader();
+
+  void close();
+  int findStream(const std::string &name) const;
+  int findStream(vpRecordingWriter::vpStreamType type) const;
+
+  //! Return the name of the opened file.
+  std::string getFilename() const { return m_file.getFilename(); }
+
+  unsigned int getFrameIndex(unsigned int stream, double timestamp) const;
+  unsigned int getNbFrames(unsigned int stream) const;
+
+  //! Return the number of streams.
+  unsigned int getNbStreams() const { return static_cast<unsigned int>(m_streams.size()); }
+
+  std::string getStreamName(unsigned int stream) const;
+  vpRecordingWriter::vpStreamType getStreamType(unsigned int stream) const;
+  double getTimestamp(unsigned int stream, unsigned int index) const;
+
+  bool getView(unsigned int stream, unsigned int index, vpImageView<const unsigned char> &view) const;
+  bool getView(unsigned int stream, unsigned int index, vpImageView<const vpRGBa> &view) const;
+  bool getView(unsigned int stream, unsigned int index, vpImageView<const uint16_t> &view) const;
+  bool getView(unsigned int stream, unsigned int index, vpImageView<const float> &view) const;
+
+  bool isStreamCompressed(unsigned int stream) const;
+
+  //! Return true if a file is opened.
+  bool isOpen() const { return m_file.isOpen(); }
+
+  void open(const std::string &filename);
+
+  void read(unsigned int stream, unsigned int index, vpImage<unsigned char> &I) const;
+  void read(unsigned int stream, unsigned int index, vpImage<vpRGBa> &I) const;
+  void read(unsigned int stream, unsigned int index, vpImage<uint16_t> &I) const;
+  void read(unsigned int stream, unsigned int index, vpImage<float> &I) const;
+  void read(unsigned int stream, unsigned int index, std::vector<vpColVector> &pointcloud) const;
+  void read(unsigned int stream, unsigned int index, vpHomogeneousMatrix &M) const;
+
+private:
+  struct vpFrame
+  {
+    uint64_t offset; //!< Offset of the payload
+    uint64_t size;
+    uint64_t rawSize;
+    double timestamp;
+    unsigned int width;
+    unsigned int height;
+    bool compressed;
+  };
+
+  struct vpStream
+  {
+    std::string name;
+    vpRecordingWriter::vpStreamType type;
+    bool compressed;
+    std::vector<vpFrame> frames;
+  };
+
+  const vpFrame &getFrame(unsigned int stream, unsigned int index, vpRecordingWriter::vpStreamType type,
+                          size_t elemSize) const;
+  bool readChunk(uint64_t offset, uint64_t &next);
+  void readPayload(const vpFrame &frame, size_t elemSize, bool swap, unsigned char *data) const;
+  template <typename Type>
+  bool getImageView(unsigned int stream, unsigned int index, vpRecordingWriter::vpStreamType type,
+                    vpImageView<const Type> &view) const;
+  template <typename Type>
+  void readImage(unsigned int stream, unsigned int index, vpRecordingWriter::vpStreamType type,
+                 vpImage<Type> &I) const;
+
+  vpMemoryMappedFile m_file;
+  std::vector<vpStream> m_streams;
+};
+END_VISP_NAMESPACE
+
+#endif
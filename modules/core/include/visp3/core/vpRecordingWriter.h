@@ -0,0 +1,159 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Writer of synchronized recordings of images, point clouds and poses.
+ */
+
+/*!
+ * \file vpRecordingWriter.h
+ * \brief Writer of synchronized recordings of images, point clouds and poses.
+ */
+
+#ifndef VP_RECORDING_WRITER_H
+#define VP_RECORDING_WRITER_H
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpRecordingWriter
+ *
+ * \ingroup group_core_files_io
+ *
+ * \brief Write the frames of several synchronized streams, e.g. the color and depth images, the point clouds and
+ * the poses acquired by a RGB-D camera, in a single file.
+ *
+ * Each frame is stored with a timestamp, in a chunk appended to the file, so that no frame already written is
+ * rewritten. The pixels are aligned in the file, and vpRecordingReader maps the file in memory to read the images
+ * without opening a file per frame and, for the uncompressed streams, without copy. The streams storing 16-bit depth
+ * images or float images can be compressed without loss, which is slower to write but gives smaller files. When the
+ * writer is closed, an index of the frames is appended; a recording that was not closed, e.g. after a crash, is
+ * still readable.
+ *
+ * \code
+ * #include <visp3/core/vpRecordingWriter.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   vpImage<vpRGBa> I_color(480, 640);
+ *   vpImage<uint16_t> I_depth(480, 640);
+ *   vpRecordingWriter writer("recording.vprec");
+ *   unsigned int color = writer.addStream("color", vpRecordingWriter::STREAM_RGBA);
+ *   unsigned int depth = writer.addStream("depth", vpRecordingWriter::STREAM_DEPTH, true);
+ *   for (unsigned int i = 0; i < 100; ++i) {
+ *     // Acquire the images...
+ *     double t = vpTime::measureTimeSecond();
+ *     writer.write(color, I_color, t);
+ *     writer.write(depth, I_depth, t);
+ *   }
+ *   writer.close();
+ * }
+ * \endcode
+ *
+ * \sa vpRecordingReader
+ */
+class VISP_EXPORT vpRecordingWriter
+{
+public:
+  //! Type of the frames of a stream
+  typedef enum
+  {
+    STREAM_GRAY,        //!< vpImage<unsigned char>
+    STREAM_RGBA,        //!< vpImage<vpRGBa>
+    STREAM_DEPTH,       //!< vpImage<uint16_t>, e.g. raw depth images
+    STREAM_FLOAT,       //!< vpImage<float>, e.g. depth images in meters
+    STREAM_POINT_CLOUD, //!< Vector of 3D points, stored in single precision
+    STREAM_POSE         //!< vpHomogeneousMatrix
+  } vpStreamType;
+
+  vpRecordingWriter();
+  explicit vpRecordingWriter(const std::string &filename);
+  vpRecordingWriter(const vpRecordingWriter &) = delete; // non construction-copyable
+  vpRecordingWriter &operator=(const vpRecordingWriter &) = delete; // non copyable
+  virtual ~vpRecordingWriter();
+
+  unsigned int addStream(const std::string &name, vpStreamType type, bool compressed = false);
+  void close();
+
+  unsigned int getNbFrames(unsigned int stream) const;
+
+  //! Return the number of streams.
+  unsigned int getNbStreams() const { return static_cast<unsigned int>(m_streams.size()); }
+
+  //! Return true if a file is opened.
+  bool isOpen() const { return m_file.is_open(); }
+
+  void open(const std::string &filename);
+
+  void write(unsigned int stream, const vpImage<unsigned char> &I, double timestamp);
+  void write(unsigned int stream, const vpImage<vpRGBa> &I, double timestamp);
+  void write(unsigned int stream, const vpImage<uint16_t> &I, double timestamp);
+  void write(unsigned int stream, const vpImage<float> &I, double timestamp);
+  void write(unsigned int stream, const std::vector<vpColVector> &pointcloud, double timestamp);
+  void write(unsigned int stream, const vpHomogeneousMatrix &M, double timestamp);
+
+private:
+  struct vpStream
+  {
+    vpStreamType type;
+    bool compressed;
+    unsigned int nbFrames;
+  };
+
+  void checkStream(unsigned int stream, vpStreamType type) const;
+  void writeChunk(uint32_t kind, uint32_t stream, uint32_t flags, uint32_t width, uint32_t height, double timestamp,
+                  const unsigned char *payload, uint64_t payloadSize, uint64_t rawSize);
+  void writeFrame(unsigned int stream, unsigned int width, unsigned int height, double timestamp,
+                  const unsigned char *data, size_t size, size_t elemSize);
+
+  std::ofstream m_file;
+  std::string m_filename;
+  std::vector<vpStream> m_streams;
+  std::vector<uint64_t> m_offsets; //!< Offsets of the chunks, written in the index
+  uint64_t m_offset;               //!< Size of the file
+  std::vector<unsigned char> m_buffer;
+  std::vector<unsigned char> m_compressed;
+};
+END_VISP_NAMESPACE
+
+#endif
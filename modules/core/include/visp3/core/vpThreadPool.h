@@ -0,0 +1,151 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide work-stealing thread pool.
+ */
+
+/*!
+ * \file vpThreadPool.h
+ * \brief Process-wide work-stealing thread pool.
+ */
+
+#ifndef VP_THREAD_POOL_H
+#define VP_THREAD_POOL_H
+
+#include <functional>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpThreadPool
+ *
+ * \ingroup group_core_threading
+ *
+ * \brief Work-stealing thread pool, shared by the parallel algorithms of ViSP.
+ *
+ * Each worker thread owns a queue of tasks. A worker pushes the tasks it creates in its own queue and executes them
+ * in last-in first-out order, and takes the oldest tasks of the other queues when its own queue is empty. The thread
+ * that waits for the end of a group of tasks executes pending tasks instead of sleeping, so that a parallel loop
+ * started from a task of another parallel loop does not create any thread nor block a worker.
+ *
+ * A pool of \e n threads starts \e n - 1 worker threads, the thread that waits for the tasks being the \e n-th one.
+ * With a single thread, the tasks are executed by the waiting thread, in order.
+ *
+ * The pool returned by getInstance() is shared by the whole process, and is used by ViSP where it previously
+ * created its own threads, e.g. by the lookup table transformations of vpImage, vpHistogram, the undistortion of
+ * vpImageTools, vpParticleFilter and the parallel Ransac of vpPose. Its number of threads is by default the number
+ * of hardware threads.
+ *
+ * When ViSP is built without thread support, the tasks are executed sequentially by the calling thread.
+ *
+ * \code
+ * #include <visp3/core/vpThreadPool.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   std::vector<double> v(1000000, 1.);
+ *   vpThreadPool &pool = vpThreadPool::getInstance();
+ *   pool.parallelFor(0, static_cast<unsigned int>(v.size()), [&v](unsigned int begin, unsigned int end) {
+ *     for (unsigned int i = begin; i < end; ++i) {
+ *       v[i] *= 2.;
+ *     }
+ *   });
+ *
+ *   vpThreadPool::vpTaskGroup group(pool);
+ *   double sum1 = 0., sum2 = 0.;
+ *   group.run([&]() { sum1 = v[0] + v[1]; });
+ *   group.run([&]() { sum2 = v[2] + v[3]; });
+ *   group.wait();
+ * }
+ * \endcode
+ */
+class VISP_EXPORT vpThreadPool
+{
+public:
+  //! Task executed by the pool.
+  typedef std::function<void()> vpTask;
+  //! Body of a parallel loop, called on the sub-ranges [begin, end[ of the loop.
+  typedef std::function<void(unsigned int, unsigned int)> vpRangeTask;
+
+  /*!
+   * Group of tasks whose end can be waited for.
+   *
+   * The exception thrown by a task, if any, is rethrown by wait(). The destructor waits for the tasks that are
+   * still pending.
+   */
+  class VISP_EXPORT vpTaskGroup
+  {
+  public:
+    explicit vpTaskGroup(vpThreadPool &pool);
+    ~vpTaskGroup();
+
+    void run(const vpTask &task);
+    void wait();
+
+  private:
+    vpTaskGroup(const vpTaskGroup &);
+    vpTaskGroup &operator=(const vpTaskGroup &);
+
+    class Impl;
+    vpThreadPool &m_pool;
+    Impl *m_impl;
+  };
+
+  explicit vpThreadPool(unsigned int nbThreads = 0);
+  ~vpThreadPool();
+
+  static vpThreadPool &getInstance();
+
+  std::vector<unsigned int> getCpuAffinity() const;
+  unsigned int getNbThreads() const;
+  void parallelFor(unsigned int begin, unsigned int end, const vpRangeTask &func, unsigned int grainSize = 0);
+  void setCpuAffinity(const std::vector<unsigned int> &cpus);
+  void setNbThreads(unsigned int nbThreads);
+
+  static unsigned int getHardwareConcurrency();
+
+private:
+  vpThreadPool(const vpThreadPool &);
+  vpThreadPool &operator=(const vpThreadPool &);
+
+  void submit(const vpTask &task);
+  bool runPendingTask();
+
+  class Impl;
+  Impl *m_impl;
+};
+END_VISP_NAMESPACE
+#endif
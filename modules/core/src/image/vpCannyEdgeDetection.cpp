@@ -32,14 +32,12 @@
 
 #include <visp3/core/vpImageConvert.h>
 
+#include <algorithm>
+
 #ifdef VISP_HAVE_OPENMP
 #include <omp.h>
 #endif
 
-#ifdef VISP_USE_MSVC
-#pragma comment(linker, "/STACK:65532000") // Increase max recursion depth
-#endif
-
 #if (VISP_CXX_STANDARD == VISP_CXX_STANDARD_98) // Check if cxx98
 namespace
 {
@@ -462,29 +460,56 @@ vpCannyEdgeDetection::getGradientOrientation(const vpImage<float> &dIx, const vp
   return gradientOrientation;
 }
 
+namespace
+{
+// Rows [getTileFirstRow(tile), getTileFirstRow(tile + 1)) belong to the tile
+unsigned int getTileFirstRow(const unsigned int &tile, const unsigned int &nbTiles, const unsigned int &nbRows)
+{
+  return static_cast<unsigned int>((static_cast<unsigned long long>(tile) * nbRows) / nbTiles);
+}
+
+// Append the results of the tiles in the order of the tiles, so that the result does not depend on the number of
+// threads nor on their scheduling
+template <typename Type> void concatenate(const std::vector<std::vector<Type> > &parts, std::vector<Type> &dst)
+{
+  size_t size = dst.size();
+  for (size_t i = 0; i < parts.size(); ++i) {
+    size += parts[i].size();
+  }
+  dst.reserve(size);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    dst.insert(dst.end(), parts[i].begin(), parts[i].end());
+  }
+}
+}
+
+unsigned int
+vpCannyEdgeDetection::getNbTiles(const unsigned int &nbRows) const
+{
+  // Tiles of a few rows would mostly be made of seams
+  const unsigned int minRowsPerTile = 16;
+  unsigned int nbTiles = 1;
+  if (m_nbThread > 1) {
+    nbTiles = std::min<unsigned int>(static_cast<unsigned int>(m_nbThread), nbRows / minRowsPerTile);
+  }
+  return std::max<unsigned int>(nbTiles, 1);
+}
+
 void
 vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 {
   const int nbCols = static_cast<int>(m_dIx.getCols());
-  const int size = static_cast<int>(m_dIx.getSize());
+  const unsigned int nbRows = m_dIx.getRows();
+  const int nbTiles = static_cast<int>(getNbTiles(nbRows));
+  std::vector<std::vector<std::pair<unsigned int, float> > > tileEdgeCandidates(nbTiles);
 
-  int istart = 0, istop = size;
 #ifdef VISP_HAVE_OPENMP
-  int iam, nt, ipoints, npoints(size);
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart, istop) num_threads(m_nbThread)
-  {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
-    }
-    istop = istart + ipoints;
-    std::vector<std::pair<unsigned int, float> > localMemoryEdgeCandidates;
+#pragma omp parallel for schedule(static, 1) num_threads(m_nbThread)
 #endif
+  for (int tile = 0; tile < nbTiles; ++tile) {
+    std::vector<std::pair<unsigned int, float> > &edgeCandidates = tileEdgeCandidates[tile];
+    const int istart = static_cast<int>(getTileFirstRow(tile, nbTiles, nbRows)) * nbCols;
+    const int istop = static_cast<int>(getTileFirstRow(tile + 1, nbTiles, nbRows)) * nbCols;
     bool ignore_current_pixel = false;
     bool grad_lower_threshold = false;
     for (int iter = istart; iter < istop; ++iter) {
@@ -530,191 +555,246 @@ vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 
           if ((grad >= gradPlus) && (grad >= gradMinus)) {
             // Keeping the edge point that has the highest gradient
-#ifdef VISP_HAVE_OPENMP
-            localMemoryEdgeCandidates.push_back(std::pair<unsigned int, float>(iter, grad));
-#else
-            m_edgeCandidateAndGradient.push_back(std::pair<unsigned int, float>(iter, grad));
-#endif
+            edgeCandidates.push_back(std::pair<unsigned int, float>(iter, grad));
           }
         }
       }
     }
-#ifdef VISP_HAVE_OPENMP
-#pragma omp critical
-    {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-      m_edgeCandidateAndGradient.insert(
-        m_edgeCandidateAndGradient.end(),
-        std::make_move_iterator(localMemoryEdgeCandidates.begin()),
-        std::make_move_iterator(localMemoryEdgeCandidates.end())
-      );
-#else
-      m_edgeCandidateAndGradient.insert(
-        m_edgeCandidateAndGradient.end(),
-        localMemoryEdgeCandidates.begin(),
-        localMemoryEdgeCandidates.end()
-      );
-#endif
-    }
-#endif
-#ifdef VISP_HAVE_OPENMP
   }
-#endif
+
+  concatenate(tileEdgeCandidates, m_edgeCandidateAndGradient);
 }
 
 void
 vpCannyEdgeDetection::performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold)
 {
-  const int size = static_cast<int>(m_edgeCandidateAndGradient.size());
-  int istart = 0;
-  int istop = size;
+  const unsigned int size = static_cast<unsigned int>(m_edgeCandidateAndGradient.size());
+  const int nbTiles = static_cast<int>(getNbTiles(m_dIx.getRows()));
+  std::vector<std::vector<unsigned int> > tileActiveEdgeCandidates(nbTiles);
 
 #ifdef VISP_HAVE_OPENMP
-  int iam, nt, ipoints, npoints(size);
-#pragma omp parallel default(shared) private(iam, nt, ipoints, istart, istop) num_threads(m_nbThread)
-  {
-    iam = omp_get_thread_num();
-    nt = omp_get_num_threads();
-    ipoints = npoints / nt;
-    // size of partition
-    istart = iam * ipoints; // starting array index
-    if (iam == nt-1) {
-      // last thread may do more
-      ipoints = npoints - istart;
-    }
-    istop = istart + ipoints;
-    std::vector<unsigned int> localMemoryEdgeCandidates;
+#pragma omp parallel for schedule(static, 1) num_threads(m_nbThread)
 #endif
-    for (int id = istart; id < istop; ++id) {
+  for (int tile = 0; tile < nbTiles; ++tile) {
+    std::vector<unsigned int> &activeEdgeCandidates = tileActiveEdgeCandidates[tile];
+    const unsigned int istop = getTileFirstRow(tile + 1, nbTiles, size);
+    for (unsigned int id = getTileFirstRow(tile, nbTiles, size); id < istop; ++id) {
       const std::pair<unsigned int, float> &candidate = m_edgeCandidateAndGradient[id];
       if (candidate.second >= upperThreshold) {
-#ifdef VISP_HAVE_OPENMP
-        localMemoryEdgeCandidates.push_back(candidate.first);
-#else
-        m_activeEdgeCandidates.push_back(candidate.first);
-#endif
+        activeEdgeCandidates.push_back(candidate.first);
         m_edgePointsCandidates.bitmap[candidate.first] = STRONG_EDGE;
       }
       else if ((candidate.second >= lowerThreshold) && (candidate.second < upperThreshold)) {
-#ifdef VISP_HAVE_OPENMP
-        localMemoryEdgeCandidates.push_back(candidate.first);
-#else
-        m_activeEdgeCandidates.push_back(candidate.first);
-#endif
+        activeEdgeCandidates.push_back(candidate.first);
         m_edgePointsCandidates.bitmap[candidate.first] = WEAK_EDGE;
       }
     }
+  }
+
+  concatenate(tileActiveEdgeCandidates, m_activeEdgeCandidates);
+}
+
+void
+vpCannyEdgeDetection::performEdgeTracking()
+{
+  const unsigned int nbRows = m_edgeMap.getRows();
+  const unsigned int nbCols = m_edgeMap.getCols();
+  const unsigned int nbCandidates = static_cast<unsigned int>(m_activeEdgeCandidates.size());
+  const unsigned int nbTiles = getNbTiles(nbRows);
+  std::vector<std::pair<unsigned int, int> > stack;
+
+  if (nbTiles == 1) {
+    for (unsigned int i = 0; i < nbCandidates; ++i) {
+      trackEdgeCandidate(m_activeEdgeCandidates[i], m_edgePointsList, stack);
+    }
+    return;
+  }
+
+  // The active edge candidates are sorted, look for the ones of each tile
+  std::vector<unsigned int> firstCandidate(nbTiles + 1, nbCandidates);
+  for (unsigned int tile = 0; tile < nbTiles; ++tile) {
+    firstCandidate[tile] = static_cast<unsigned int>(std::lower_bound(m_activeEdgeCandidates.begin(), m_activeEdgeCandidates.end(),
+                                                                      getTileFirstRow(tile, nbTiles, nbRows) * nbCols) - m_activeEdgeCandidates.begin());
+  }
+
+  // The edge points found for each candidate are appended to the list of its tile, or to the last list for the
+  // seam candidates. lastEdgePoint[i] is the size of that list once candidate i has been processed.
+  std::vector<std::vector<vpImagePoint> > edgePoints(nbTiles + 1);
+  std::vector<unsigned int> lastEdgePoint(m_storeListEdgePoints ? nbCandidates : 0);
+  m_seamEdgeCandidates.resize(nbRows, nbCols, false);
 
 #ifdef VISP_HAVE_OPENMP
-#pragma omp critical
-    {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-      m_activeEdgeCandidates.insert(
-        m_activeEdgeCandidates.end(),
-        std::make_move_iterator(localMemoryEdgeCandidates.begin()),
-        std::make_move_iterator(localMemoryEdgeCandidates.end())
-      );
-#else
-      m_activeEdgeCandidates.insert(
-        m_activeEdgeCandidates.end(),
-        localMemoryEdgeCandidates.begin(),
-        localMemoryEdgeCandidates.end()
-      );
+#pragma omp parallel for schedule(static, 1) num_threads(m_nbThread)
 #endif
+  for (int tile = 0; tile < static_cast<int>(nbTiles); ++tile) {
+    const unsigned int rowMin = getTileFirstRow(tile, nbTiles, nbRows);
+    const unsigned int rowMax = getTileFirstRow(tile + 1, nbTiles, nbRows) - 1;
+    std::vector<unsigned int> seamStack;
+    std::vector<std::pair<unsigned int, int> > tileStack;
+
+    // A weak edge point in the first or last row of the tile may be connected to weak edge points of the
+    // neighbor tile, its tracking is postponed with all the weak edge points it is connected to
+    for (unsigned int i = firstCandidate[tile]; i < firstCandidate[tile + 1]; ++i) {
+      const unsigned int coordinates = m_activeEdgeCandidates[i];
+      const unsigned int row = coordinates / nbCols;
+      const bool isSeamRow = ((row == rowMin) && (tile > 0)) || ((row == rowMax) && (tile < static_cast<int>(nbTiles) - 1));
+      if (isSeamRow && (m_edgePointsCandidates.bitmap[coordinates] == WEAK_EDGE) && (!m_seamEdgeCandidates.bitmap[coordinates])) {
+        markSeamEdgeCandidates(coordinates, rowMin, rowMax, seamStack);
+      }
+    }
+
+    // The other edge candidates only depend on the points of the tile
+    for (unsigned int i = firstCandidate[tile]; i < firstCandidate[tile + 1]; ++i) {
+      const unsigned int coordinates = m_activeEdgeCandidates[i];
+      if (!m_seamEdgeCandidates.bitmap[coordinates]) {
+        trackEdgeCandidate(coordinates, edgePoints[tile], tileStack);
+        if (m_storeListEdgePoints) {
+          lastEdgePoint[i] = static_cast<unsigned int>(edgePoints[tile].size());
+        }
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < nbCandidates; ++i) {
+    const unsigned int coordinates = m_activeEdgeCandidates[i];
+    if (m_seamEdgeCandidates.bitmap[coordinates]) {
+      trackEdgeCandidate(coordinates, edgePoints[nbTiles], stack);
+      if (m_storeListEdgePoints) {
+        lastEdgePoint[i] = static_cast<unsigned int>(edgePoints[nbTiles].size());
+      }
+    }
+  }
+
+  if (m_storeListEdgePoints) {
+    // Reorder the edge points as if the candidates were processed one after the other
+    std::vector<unsigned int> firstEdgePoint(nbTiles + 1, 0);
+    unsigned int tile = 0;
+    for (unsigned int i = 0; i < nbCandidates; ++i) {
+      while (i >= firstCandidate[tile + 1]) {
+        ++tile;
+      }
+      const unsigned int list = m_seamEdgeCandidates.bitmap[m_activeEdgeCandidates[i]] ? nbTiles : tile;
+      m_edgePointsList.insert(m_edgePointsList.end(), edgePoints[list].begin() + firstEdgePoint[list],
+                              edgePoints[list].begin() + lastEdgePoint[i]);
+      firstEdgePoint[list] = lastEdgePoint[i];
     }
   }
-#endif
 }
 
 void
-vpCannyEdgeDetection::performEdgeTracking()
+vpCannyEdgeDetection::trackEdgeCandidate(const unsigned int &coordinates, std::vector<vpImagePoint> &edgePoints,
+                                         std::vector<std::pair<unsigned int, int> > &stack)
 {
   const unsigned char var_uc_255 = 255;
   const unsigned int nbCols = m_edgeMap.getCols();
+  if (m_edgePointsCandidates.bitmap[coordinates] == STRONG_EDGE) {
+    if (m_storeListEdgePoints) {
+      if (m_edgeMap.bitmap[coordinates] != var_uc_255) {
+        // Edge point not added yet to the edge list
+        unsigned int row = coordinates / nbCols;
+        unsigned int col = coordinates % nbCols;
+        edgePoints.push_back(vpImagePoint(row, col));
+      }
+    }
+    m_edgeMap.bitmap[coordinates] = var_uc_255;
+  }
+  else if (m_edgePointsCandidates.bitmap[coordinates] == WEAK_EDGE) {
+    searchForStrongEdge(coordinates, edgePoints, stack);
+  }
+}
 
-  std::vector<unsigned int>::iterator it;
-  std::vector<unsigned int>::iterator m_edgePointsCandidates_end = m_activeEdgeCandidates.end();
-  for (it = m_activeEdgeCandidates.begin(); it != m_edgePointsCandidates_end; ++it) {
-    if (m_edgePointsCandidates.bitmap[*it] == STRONG_EDGE) {
-      if (m_storeListEdgePoints) {
-        if (m_edgeMap.bitmap[*it] != var_uc_255) {
-          // Edge point not added yet to the edge list
-          unsigned int row = *it / nbCols;
-          unsigned int col = *it % nbCols;
-          m_edgePointsList.push_back(vpImagePoint(row, col));
+void
+vpCannyEdgeDetection::markSeamEdgeCandidates(const unsigned int &coordinates, const unsigned int &rowMin,
+                                             const unsigned int &rowMax, std::vector<unsigned int> &stack)
+{
+  const int nbCols = static_cast<int>(m_edgeMap.getCols());
+  stack.clear();
+  stack.push_back(coordinates);
+  m_seamEdgeCandidates.bitmap[coordinates] = true;
+  while (!stack.empty()) {
+    const int current = static_cast<int>(stack.back());
+    stack.pop_back();
+    const int row = current / nbCols;
+    const int col = current % nbCols;
+    for (int r = std::max<int>(row - 1, static_cast<int>(rowMin)); r <= std::min<int>(row + 1, static_cast<int>(rowMax)); ++r) {
+      for (int c = std::max<int>(col - 1, 0); c <= std::min<int>(col + 1, nbCols - 1); ++c) {
+        const unsigned int neighbor = static_cast<unsigned int>((r * nbCols) + c);
+        if ((m_edgePointsCandidates.bitmap[neighbor] == WEAK_EDGE) && (!m_seamEdgeCandidates.bitmap[neighbor])) {
+          m_seamEdgeCandidates.bitmap[neighbor] = true;
+          stack.push_back(neighbor);
         }
       }
-      m_edgeMap.bitmap[*it] = var_uc_255;
-    }
-    else if (m_edgePointsCandidates.bitmap[*it] == WEAK_EDGE) {
-      recursiveSearchForStrongEdge(*it);
     }
   }
 }
 
 bool
-vpCannyEdgeDetection::recursiveSearchForStrongEdge(const unsigned int &coordinates)
+vpCannyEdgeDetection::searchForStrongEdge(const unsigned int &coordinates, std::vector<vpImagePoint> &edgePoints,
+                                          std::vector<std::pair<unsigned int, int> > &stack)
 {
   const int nbCols = static_cast<int>(m_dIx.getCols());
   const int size = static_cast<int>(m_dIx.getSize());
-  const int coordAsInt = static_cast<int>(coordinates);
-  bool hasFoundStrongEdge = false;
-  m_edgePointsCandidates.bitmap[coordinates] = ON_CHECK;
-  bool test_row = false;
-  bool test_col = false;
-  bool test_drdc = false;
-  bool edge_in_image_limit = false;
-  int dr = -1;
-  while ((dr <= 1) && (!hasFoundStrongEdge)) {
-    int dc = -1;
-    while ((dc <= 1) && (!hasFoundStrongEdge)) {
-      // reset the check for the edge on image limit
-      edge_in_image_limit = false;
+  const int nbNeighbors = 9;
+  const unsigned char var_uc_255 = 255;
 
+  // Each element of the stack is a point being checked and the index of the next of its 8-neighbors to check,
+  // from the top-left one to the bottom-right one
+  stack.clear();
+  stack.push_back(std::pair<unsigned int, int>(coordinates, 0));
+  m_edgePointsCandidates.bitmap[coordinates] = ON_CHECK;
+  bool hasFoundStrongEdge = false;
+  bool isReturning = false;
+  while (!stack.empty()) {
+    const unsigned int current = stack.back().first;
+    const int coordAsInt = static_cast<int>(current);
+    bool hasFoundStrongNeighbor = isReturning && hasFoundStrongEdge;
+    bool isGoingDeeper = false;
+    isReturning = false;
+    while ((stack.back().second < nbNeighbors) && (!hasFoundStrongNeighbor) && (!isGoingDeeper)) {
+      const int neighbor = stack.back().second;
+      ++stack.back().second;
+      const int dr = (neighbor / 3) - 1;
+      const int dc = (neighbor % 3) - 1;
       int iterTest = coordAsInt + dr * nbCols + dc;
 
       // Checking if we are still looking for an edge in the limit of the image
-      test_row = (iterTest < 0) || (iterTest >= size);
-      test_col = ((iterTest - dc) / nbCols) != (iterTest / nbCols);
-      test_drdc = (dr == 0) && (dc == 0);
-      if (test_row || test_col || test_drdc) {
-        edge_in_image_limit = true;
-        // the continue is replaced by the test
-      }
-      if (edge_in_image_limit == false) {
-
-        try {
-          // Checking if the 8-neighbor point is in the list of edge candidates
-          EdgeType type_candidate = m_edgePointsCandidates.bitmap[iterTest];
-          if (type_candidate == STRONG_EDGE) {
-            // The 8-neighbor point is a strong edge => the weak edge becomes a strong edge
-            hasFoundStrongEdge = true;
-          }
-          else if (type_candidate == WEAK_EDGE) {
-            // Checking if the WEAK_EDGE neighbor has a STRONG_EDGE neighbor
-            hasFoundStrongEdge = recursiveSearchForStrongEdge(iterTest);
-          }
+      bool test_row = (iterTest < 0) || (iterTest >= size);
+      bool test_col = ((iterTest - dc) / nbCols) != (iterTest / nbCols);
+      bool test_drdc = (dr == 0) && (dc == 0);
+      if (!(test_row || test_col || test_drdc)) {
+        // Checking if the 8-neighbor point is in the list of edge candidates
+        EdgeType type_candidate = m_edgePointsCandidates.bitmap[iterTest];
+        if (type_candidate == STRONG_EDGE) {
+          // The 8-neighbor point is a strong edge => the weak edge becomes a strong edge
+          hasFoundStrongNeighbor = true;
         }
-        catch (...) {
-          // continue - nothing to do
+        else if (type_candidate == WEAK_EDGE) {
+          // Checking if the WEAK_EDGE neighbor has a STRONG_EDGE neighbor
+          m_edgePointsCandidates.bitmap[iterTest] = ON_CHECK;
+          stack.push_back(std::pair<unsigned int, int>(static_cast<unsigned int>(iterTest), 0));
+          isGoingDeeper = true;
         }
       }
-      ++dc;
     }
-    ++dr;
-  }
-  const unsigned char var_uc_255 = 255;
-  if (hasFoundStrongEdge) {
-    if (m_storeListEdgePoints) {
-      if (m_edgeMap.bitmap[coordinates] != var_uc_255) {
-        // Edge point not added yet to the edge list
-        unsigned int row = coordinates / nbCols;
-        unsigned int col = coordinates % nbCols;
-        m_edgePointsList.push_back(vpImagePoint(row, col));
+
+    if (!isGoingDeeper) {
+      // All the neighbors of the current point have been checked, or one of them is a strong edge
+      if (hasFoundStrongNeighbor) {
+        if (m_storeListEdgePoints) {
+          if (m_edgeMap.bitmap[current] != var_uc_255) {
+            // Edge point not added yet to the edge list
+            unsigned int row = current / nbCols;
+            unsigned int col = current % nbCols;
+            edgePoints.push_back(vpImagePoint(row, col));
+          }
+        }
+        m_edgePointsCandidates.bitmap[current] = STRONG_EDGE;
+        m_edgeMap.bitmap[current] = var_uc_255;
       }
+      hasFoundStrongEdge = hasFoundStrongNeighbor;
+      isReturning = true;
+      stack.pop_back();
     }
-    m_edgePointsCandidates.bitmap[coordinates] = STRONG_EDGE;
-    m_edgeMap.bitmap[coordinates] = var_uc_255;
   }
   return hasFoundStrongEdge;
 }
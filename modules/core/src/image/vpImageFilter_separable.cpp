@@ -0,0 +1,669 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Vectorized separable filtering.
+ */
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageFilter.h>
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+// AVX2 code is compiled with a function level target attribute, so that the library does not need to be built with
+// -mavx2. FMA is intentionally not enabled to get the same rounding as the scalar code.
+#if VISP_HAVE_SSE2 && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define VISP_HAVE_AVX2_TARGET 1
+#define VP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VISP_HAVE_AVX2_TARGET 0
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+#define USE_SIMD_CODE 1
+
+#if VISP_HAVE_SSE2 && USE_SIMD_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
+#if VISP_HAVE_AVX2_TARGET && USE_SIMD_CODE
+#define USE_AVX2 1
+#else
+#define USE_AVX2 0
+#endif
+
+#if VISP_HAVE_NEON && USE_SIMD_CODE
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+ * The vectorized kernels evaluate, for each lane, exactly the same sequence of operations as the scalar
+ * vpImageFilter::filterX() and vpImageFilter::filterY() functions:
+ *   res = filter[0] * I[c];
+ *   res += filter[i] * (I[c + i] + I[c - i]), for i = 1 .. (size - 1) / 2
+ * where the sum of the two pixels is done in the promoted pixel type before the conversion to the filter type.
+ * Multiplications and additions are never fused, so that the results are identical to the scalar ones.
+ */
+enum vpSimdLevel
+{
+  SIMD_NONE,
+  SIMD_SSE2,
+  SIMD_AVX2,
+  SIMD_NEON
+};
+
+vpSimdLevel getSimdLevel()
+{
+#if USE_AVX2
+  if (vpCPUFeatures::checkAVX2()) {
+    return SIMD_AVX2;
+  }
+#endif
+#if USE_SSE
+  if (vpCPUFeatures::checkSSE2()) {
+    return SIMD_SSE2;
+  }
+#endif
+#if USE_NEON
+  return SIMD_NEON;
+#else
+  return SIMD_NONE;
+#endif
+}
+
+template <typename ImageType, typename FilterType>
+inline FilterType filterPixel(const ImageType *const *taps, unsigned int j, const FilterType *filter, unsigned int stop)
+{
+  FilterType res = filter[0] * static_cast<FilterType>(taps[stop][j]);
+  for (unsigned int i = 1; i <= stop; ++i) {
+    res += filter[i] * static_cast<FilterType>(taps[stop + i][j] + taps[stop - i][j]);
+  }
+  return res;
+}
+
+// Index of the pixel mirrored with respect to the image borders, as done by filterXLeftBorder() and
+// filterXRightBorder().
+inline unsigned int mirrorLow(unsigned int c, unsigned int i) { return (c > i) ? (c - i) : (i - c); }
+
+inline unsigned int mirrorHigh(unsigned int c, unsigned int i, unsigned int n)
+{
+  return ((c + i) < n) ? (c + i) : (((2 * n) - c) - i - 1);
+}
+
+template <typename ImageType, typename FilterType>
+inline FilterType filterBorderPixelX(const ImageType *src, unsigned int c, unsigned int width, const FilterType *filter,
+                                     unsigned int stop)
+{
+  FilterType res = filter[0] * static_cast<FilterType>(src[c]);
+  for (unsigned int i = 1; i <= stop; ++i) {
+    res += filter[i] * static_cast<FilterType>(src[mirrorHigh(c, i, width)] + src[mirrorLow(c, i)]);
+  }
+  return res;
+}
+
+#if USE_SSE
+struct vpSse2Float
+{
+  typedef __m128 Vec;
+  static const unsigned int lanes = 4;
+  static inline Vec set1(float v) { return _mm_set1_ps(v); }
+  static inline Vec add(const Vec &a, const Vec &b) { return _mm_add_ps(a, b); }
+  static inline Vec mul(const Vec &a, const Vec &b) { return _mm_mul_ps(a, b); }
+  static inline void store(float *p, const Vec &v) { _mm_storeu_ps(p, v); }
+  static inline Vec load(const float *p) { return _mm_loadu_ps(p); }
+  static inline Vec loadSum(const float *a, const float *b) { return _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)); }
+  static inline __m128i loadU8(const unsigned char *p)
+  {
+    int v;
+    memcpy(&v, p, sizeof(int));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+  }
+  static inline Vec load(const unsigned char *p) { return _mm_cvtepi32_ps(loadU8(p)); }
+  static inline Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return _mm_cvtepi32_ps(_mm_add_epi32(loadU8(a), loadU8(b)));
+  }
+};
+
+struct vpSse2Double
+{
+  typedef __m128d Vec;
+  static const unsigned int lanes = 2;
+  static inline Vec set1(double v) { return _mm_set1_pd(v); }
+  static inline Vec add(const Vec &a, const Vec &b) { return _mm_add_pd(a, b); }
+  static inline Vec mul(const Vec &a, const Vec &b) { return _mm_mul_pd(a, b); }
+  static inline void store(double *p, const Vec &v) { _mm_storeu_pd(p, v); }
+  static inline Vec load(const double *p) { return _mm_loadu_pd(p); }
+  static inline Vec loadSum(const double *a, const double *b) { return _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)); }
+  static inline __m128i loadU8(const unsigned char *p)
+  {
+    unsigned short v;
+    memcpy(&v, p, sizeof(unsigned short));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+  }
+  static inline Vec load(const unsigned char *p) { return _mm_cvtepi32_pd(loadU8(p)); }
+  static inline Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return _mm_cvtepi32_pd(_mm_add_epi32(loadU8(a), loadU8(b)));
+  }
+};
+
+template <typename Ops, typename ImageType, typename FilterType>
+unsigned int filterSpanSse2(const ImageType *const *taps, FilterType *dst, unsigned int n, const FilterType *filter,
+                            unsigned int stop)
+{
+  unsigned int j = 0;
+  for (; (j + Ops::lanes) <= n; j += Ops::lanes) {
+    typename Ops::Vec res = Ops::mul(Ops::set1(filter[0]), Ops::load(taps[stop] + j));
+    for (unsigned int i = 1; i <= stop; ++i) {
+      res = Ops::add(res, Ops::mul(Ops::set1(filter[i]), Ops::loadSum(taps[stop + i] + j, taps[stop - i] + j)));
+    }
+    Ops::store(dst + j, res);
+  }
+  return j;
+}
+#endif
+
+#if USE_AVX2
+struct vpAvx2Float
+{
+  typedef __m256 Vec;
+  static const unsigned int lanes = 8;
+  static inline VP_TARGET_AVX2 Vec set1(float v) { return _mm256_set1_ps(v); }
+  static inline VP_TARGET_AVX2 Vec add(const Vec &a, const Vec &b) { return _mm256_add_ps(a, b); }
+  static inline VP_TARGET_AVX2 Vec mul(const Vec &a, const Vec &b) { return _mm256_mul_ps(a, b); }
+  static inline VP_TARGET_AVX2 void store(float *p, const Vec &v) { _mm256_storeu_ps(p, v); }
+  static inline VP_TARGET_AVX2 Vec load(const float *p) { return _mm256_loadu_ps(p); }
+  static inline VP_TARGET_AVX2 Vec loadSum(const float *a, const float *b)
+  {
+    return _mm256_add_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b));
+  }
+  static inline VP_TARGET_AVX2 __m256i loadU8(const unsigned char *p)
+  {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+  static inline VP_TARGET_AVX2 Vec load(const unsigned char *p) { return _mm256_cvtepi32_ps(loadU8(p)); }
+  static inline VP_TARGET_AVX2 Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return _mm256_cvtepi32_ps(_mm256_add_epi32(loadU8(a), loadU8(b)));
+  }
+};
+
+struct vpAvx2Double
+{
+  typedef __m256d Vec;
+  static const unsigned int lanes = 4;
+  static inline VP_TARGET_AVX2 Vec set1(double v) { return _mm256_set1_pd(v); }
+  static inline VP_TARGET_AVX2 Vec add(const Vec &a, const Vec &b) { return _mm256_add_pd(a, b); }
+  static inline VP_TARGET_AVX2 Vec mul(const Vec &a, const Vec &b) { return _mm256_mul_pd(a, b); }
+  static inline VP_TARGET_AVX2 void store(double *p, const Vec &v) { _mm256_storeu_pd(p, v); }
+  static inline VP_TARGET_AVX2 Vec load(const double *p) { return _mm256_loadu_pd(p); }
+  static inline VP_TARGET_AVX2 Vec loadSum(const double *a, const double *b)
+  {
+    return _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+  }
+  static inline VP_TARGET_AVX2 __m128i loadU8(const unsigned char *p)
+  {
+    int v;
+    memcpy(&v, p, sizeof(int));
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(v));
+  }
+  static inline VP_TARGET_AVX2 Vec load(const unsigned char *p) { return _mm256_cvtepi32_pd(loadU8(p)); }
+  static inline VP_TARGET_AVX2 Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return _mm256_cvtepi32_pd(_mm_add_epi32(loadU8(a), loadU8(b)));
+  }
+};
+
+template <typename Ops, typename ImageType, typename FilterType>
+VP_TARGET_AVX2 unsigned int filterSpanAvx2(const ImageType *const *taps, FilterType *dst, unsigned int n, const FilterType *filter,
+                                           unsigned int stop)
+{
+  unsigned int j = 0;
+  for (; (j + Ops::lanes) <= n; j += Ops::lanes) {
+    typename Ops::Vec res = Ops::mul(Ops::set1(filter[0]), Ops::load(taps[stop] + j));
+    for (unsigned int i = 1; i <= stop; ++i) {
+      res = Ops::add(res, Ops::mul(Ops::set1(filter[i]), Ops::loadSum(taps[stop + i] + j, taps[stop - i] + j)));
+    }
+    Ops::store(dst + j, res);
+  }
+  return j;
+}
+#endif
+
+#if USE_NEON
+struct vpNeonFloat
+{
+  typedef float32x4_t Vec;
+  static const unsigned int lanes = 4;
+  static inline Vec set1(float v) { return vdupq_n_f32(v); }
+  static inline Vec add(const Vec &a, const Vec &b) { return vaddq_f32(a, b); }
+  static inline Vec mul(const Vec &a, const Vec &b) { return vmulq_f32(a, b); }
+  static inline void store(float *p, const Vec &v) { vst1q_f32(p, v); }
+  static inline Vec load(const float *p) { return vld1q_f32(p); }
+  static inline Vec loadSum(const float *a, const float *b) { return vaddq_f32(vld1q_f32(a), vld1q_f32(b)); }
+  static inline uint32x4_t loadU8(const unsigned char *p)
+  {
+    uint32_t v;
+    memcpy(&v, p, sizeof(uint32_t));
+    return vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v)))));
+  }
+  static inline Vec load(const unsigned char *p) { return vcvtq_f32_u32(loadU8(p)); }
+  static inline Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return vcvtq_f32_u32(vaddq_u32(loadU8(a), loadU8(b)));
+  }
+};
+
+struct vpNeonDouble
+{
+  typedef float64x2_t Vec;
+  static const unsigned int lanes = 2;
+  static inline Vec set1(double v) { return vdupq_n_f64(v); }
+  static inline Vec add(const Vec &a, const Vec &b) { return vaddq_f64(a, b); }
+  static inline Vec mul(const Vec &a, const Vec &b) { return vmulq_f64(a, b); }
+  static inline void store(double *p, const Vec &v) { vst1q_f64(p, v); }
+  static inline Vec load(const double *p) { return vld1q_f64(p); }
+  static inline Vec loadSum(const double *a, const double *b) { return vaddq_f64(vld1q_f64(a), vld1q_f64(b)); }
+  static inline uint64x2_t loadU8(const unsigned char *p)
+  {
+    const uint64_t v[2] = { p[0], p[1] };
+    return vld1q_u64(v);
+  }
+  static inline Vec load(const unsigned char *p) { return vcvtq_f64_u64(loadU8(p)); }
+  static inline Vec loadSum(const unsigned char *a, const unsigned char *b)
+  {
+    return vcvtq_f64_u64(vaddq_u64(loadU8(a), loadU8(b)));
+  }
+};
+
+template <typename Ops, typename ImageType, typename FilterType>
+unsigned int filterSpanNeon(const ImageType *const *taps, FilterType *dst, unsigned int n, const FilterType *filter,
+                            unsigned int stop)
+{
+  unsigned int j = 0;
+  for (; (j + Ops::lanes) <= n; j += Ops::lanes) {
+    typename Ops::Vec res = Ops::mul(Ops::set1(filter[0]), Ops::load(taps[stop] + j));
+    for (unsigned int i = 1; i <= stop; ++i) {
+      res = Ops::add(res, Ops::mul(Ops::set1(filter[i]), Ops::loadSum(taps[stop + i] + j, taps[stop - i] + j)));
+    }
+    Ops::store(dst + j, res);
+  }
+  return j;
+}
+#endif
+
+template <typename FilterType> struct vpSimdOps;
+
+template <> struct vpSimdOps<float>
+{
+#if USE_SSE
+  typedef vpSse2Float Sse2;
+#endif
+#if USE_AVX2
+  typedef vpAvx2Float Avx2;
+#endif
+#if USE_NEON
+  typedef vpNeonFloat Neon;
+#endif
+};
+
+template <> struct vpSimdOps<double>
+{
+#if USE_SSE
+  typedef vpSse2Double Sse2;
+#endif
+#if USE_AVX2
+  typedef vpAvx2Double Avx2;
+#endif
+#if USE_NEON
+  typedef vpNeonDouble Neon;
+#endif
+};
+
+/*
+ * Filter n consecutive pixels. taps[stop + k] points to the first source element multiplied by the coefficient of
+ * offset k, for k in [-stop, stop], so that the same code filters along a row (taps[t] = src + t) or along a column
+ * (taps[t] = row t of the source). The pixels that do not fill a SIMD register are filtered with the scalar code.
+ */
+template <typename ImageType, typename FilterType>
+void filterSpan(vpSimdLevel level, const ImageType *const *taps, FilterType *dst, unsigned int n,
+                const FilterType *filter, unsigned int stop)
+{
+  unsigned int j = 0;
+  switch (level) {
+#if USE_AVX2
+  case SIMD_AVX2:
+    j = filterSpanAvx2<typename vpSimdOps<FilterType>::Avx2>(taps, dst, n, filter, stop);
+    break;
+#endif
+#if USE_SSE
+  case SIMD_SSE2:
+    j = filterSpanSse2<typename vpSimdOps<FilterType>::Sse2>(taps, dst, n, filter, stop);
+    break;
+#endif
+#if USE_NEON
+  case SIMD_NEON:
+    j = filterSpanNeon<typename vpSimdOps<FilterType>::Neon>(taps, dst, n, filter, stop);
+    break;
+#endif
+  default:
+    break;
+  }
+  for (; j < n; ++j) {
+    dst[j] = filterPixel(taps, j, filter, stop);
+  }
+}
+
+// Set to 0 the pixels that are not in the mask, as the scalar code leaves them to their initial value
+template <typename FilterType> inline void applyMask(FilterType *dst, unsigned int width, const bool *mask)
+{
+  if (mask != nullptr) {
+    for (unsigned int j = 0; j < width; ++j) {
+      if (!mask[j]) {
+        dst[j] = 0;
+      }
+    }
+  }
+}
+
+/*
+ * Horizontal pass on one row, the borders being mirrored. The width must be at least the size of the kernel and taps
+ * must have room for size pointers.
+ */
+template <typename ImageType, typename FilterType>
+void filterRowX(vpSimdLevel level, const ImageType *src, FilterType *dst, unsigned int width, const FilterType *filter,
+                unsigned int stop, const ImageType **taps, const bool *mask)
+{
+  for (unsigned int j = 0; j < stop; ++j) {
+    dst[j] = filterBorderPixelX(src, j, width, filter, stop);
+  }
+  for (unsigned int t = 0; t <= (2 * stop); ++t) {
+    taps[t] = src + t;
+  }
+  filterSpan(level, taps, dst + stop, width - (2 * stop), filter, stop);
+  for (unsigned int j = width - stop; j < width; ++j) {
+    dst[j] = filterBorderPixelX(src, j, width, filter, stop);
+  }
+  applyMask(dst, width, mask);
+}
+
+/*
+ * Vertical pass for one output row. rows[k] points to the row r + k - stop of the source, the borders being already
+ * mirrored by the caller, so that all the columns are processed with the same code whatever the position of the rows
+ * in memory.
+ */
+template <typename ImageType, typename FilterType>
+void filterRowY(vpSimdLevel level, const ImageType *const *rows, FilterType *dst, unsigned int width,
+                const FilterType *filter, unsigned int stop, const bool *mask)
+{
+  filterSpan(level, rows, dst, width, filter, stop);
+  applyMask(dst, width, mask);
+}
+
+int getNbStrips(unsigned int height)
+{
+#ifdef VISP_HAVE_OPENMP
+  const unsigned int minRowsPerStrip = 32;
+  int nbStrips = std::min<int>(omp_get_max_threads(), static_cast<int>(height / minRowsPerStrip));
+  return std::max<int>(nbStrips, 1);
+#else
+  (void)height;
+  return 1;
+#endif
+}
+
+// The kernel must be odd and not larger than the image, to be able to mirror the borders as the scalar code does
+bool isSupportedSize(unsigned int length, unsigned int size) { return ((size % 2) == 1) && (length >= size); }
+
+template <typename ImageType, typename FilterType>
+bool filterXImpl(const vpImage<ImageType> &I, vpImage<FilterType> &dIx, const FilterType *filter, unsigned int size,
+                 const vpImage<bool> *p_mask)
+{
+  const unsigned int height = I.getHeight();
+  const unsigned int width = I.getWidth();
+  if (!isSupportedSize(width, size)) {
+    return false;
+  }
+  const unsigned int stop = (size - 1) / 2;
+  const vpSimdLevel level = getSimdLevel();
+  dIx.resize(height, width);
+
+  const int iheight = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<const ImageType *> taps(size);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int i = 0; i < iheight; ++i) {
+      const bool *mask = (p_mask != nullptr) ? (*p_mask)[i] : nullptr;
+      filterRowX(level, I[i], dIx[i], width, filter, stop, &taps[0], mask);
+    }
+  }
+  return true;
+}
+
+template <typename ImageType, typename FilterType>
+bool filterYImpl(const vpImage<ImageType> &I, vpImage<FilterType> &dIy, const FilterType *filter, unsigned int size,
+                 const vpImage<bool> *p_mask)
+{
+  const unsigned int height = I.getHeight();
+  const unsigned int width = I.getWidth();
+  if (!isSupportedSize(height, size)) {
+    return false;
+  }
+  const unsigned int stop = (size - 1) / 2;
+  const vpSimdLevel level = getSimdLevel();
+  dIy.resize(height, width);
+
+  const int iheight = static_cast<int>(height);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<const ImageType *> rows(size);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int i = 0; i < iheight; ++i) {
+      const unsigned int r = static_cast<unsigned int>(i);
+      rows[stop] = I[r];
+      for (unsigned int k = 1; k <= stop; ++k) {
+        rows[stop + k] = I[mirrorHigh(r, k, height)];
+        rows[stop - k] = I[mirrorLow(r, k)];
+      }
+      const bool *mask = (p_mask != nullptr) ? (*p_mask)[r] : nullptr;
+      filterRowY(level, &rows[0], dIy[r], width, filter, stop, mask);
+    }
+  }
+  return true;
+}
+
+/*
+ * Two-pass separable filtering. The image is split into horizontal strips, one per thread. Each strip is processed
+ * top to bottom with a ring buffer of size rows holding the result of the horizontal pass: a row of the source is
+ * filtered horizontally once, when it enters the ring, and the vertical pass reads the rows of the ring while they are
+ * still in cache. The ring is (size x width) elements, e.g. 54 kB for a 7 taps kernel on a 1920 px wide float image,
+ * which fits in L2. Only the size - 1 rows of the halo of each strip are filtered twice.
+ */
+template <typename ImageType, typename FilterType>
+bool filterSeparableImpl(const vpImage<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter,
+                         unsigned int size, const vpImage<bool> *p_mask)
+{
+  const unsigned int height = I.getHeight();
+  const unsigned int width = I.getWidth();
+  if ((!isSupportedSize(width, size)) || (!isSupportedSize(height, size))) {
+    return false;
+  }
+  const unsigned int stop = (size - 1) / 2;
+  const vpSimdLevel level = getSimdLevel();
+  GI.resize(height, width);
+
+  const int nbStrips = getNbStrips(height);
+  const unsigned int stripHeight = (height + static_cast<unsigned int>(nbStrips) - 1) / static_cast<unsigned int>(nbStrips);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbStrips)
+#endif
+  for (int strip = 0; strip < nbStrips; ++strip) {
+    const unsigned int rbegin = static_cast<unsigned int>(strip) * stripHeight;
+    const unsigned int rend = std::min<unsigned int>(rbegin + stripHeight, height);
+    std::vector<FilterType> ring(static_cast<size_t>(size) * width);
+    std::vector<const FilterType *> rows(size);
+    std::vector<const ImageType *> taps(size);
+
+    // Next source row to filter horizontally
+    unsigned int next = (rbegin > stop) ? (rbegin - stop) : 0;
+    for (unsigned int r = rbegin; r < rend; ++r) {
+      const unsigned int last = std::min<unsigned int>(r + stop, height - 1);
+      for (; next <= last; ++next) {
+        const bool *mask = (p_mask != nullptr) ? (*p_mask)[next] : nullptr;
+        filterRowX(level, I[next], &ring[(next % size) * width], width, filter, stop, &taps[0], mask);
+      }
+      rows[stop] = &ring[(r % size) * width];
+      for (unsigned int k = 1; k <= stop; ++k) {
+        rows[stop + k] = &ring[(mirrorHigh(r, k, height) % size) * width];
+        rows[stop - k] = &ring[(mirrorLow(r, k) % size) * width];
+      }
+      const bool *mask = (p_mask != nullptr) ? (*p_mask)[r] : nullptr;
+      filterRowY(level, &rows[0], GI[r], width, filter, stop, mask);
+    }
+  }
+  return true;
+}
+}
+
+bool vpImageFilter::filterXSimd(const vpImage<unsigned char> &I, vpImage<float> &dIx, const float *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterXImpl(I, dIx, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterXSimd(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterXImpl(I, dIx, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterXSimd(const vpImage<float> &I, vpImage<float> &dIx, const float *filter, unsigned int size,
+                                const vpImage<bool> *p_mask)
+{
+  return filterXImpl(I, dIx, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterXSimd(const vpImage<double> &I, vpImage<double> &dIx, const double *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterXImpl(I, dIx, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterYSimd(const vpImage<unsigned char> &I, vpImage<float> &dIy, const float *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterYImpl(I, dIy, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterYSimd(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterYImpl(I, dIy, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterYSimd(const vpImage<float> &I, vpImage<float> &dIy, const float *filter, unsigned int size,
+                                const vpImage<bool> *p_mask)
+{
+  return filterYImpl(I, dIy, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterYSimd(const vpImage<double> &I, vpImage<double> &dIy, const double *filter,
+                                unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterYImpl(I, dIy, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterSeparableSimd(const vpImage<unsigned char> &I, vpImage<float> &GI, const float *filter,
+                                        unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterSeparableImpl(I, GI, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterSeparableSimd(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter,
+                                        unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterSeparableImpl(I, GI, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterSeparableSimd(const vpImage<float> &I, vpImage<float> &GI, const float *filter,
+                                        unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterSeparableImpl(I, GI, filter, size, p_mask);
+}
+
+bool vpImageFilter::filterSeparableSimd(const vpImage<double> &I, vpImage<double> &GI, const double *filter,
+                                        unsigned int size, const vpImage<bool> *p_mask)
+{
+  return filterSeparableImpl(I, GI, filter, size, p_mask);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+END_VISP_NAMESPACE
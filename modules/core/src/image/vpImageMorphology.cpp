@@ -0,0 +1,122 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Morphology tools.
+ */
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageMorphology.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+#define USE_SIMD_CODE 1
+
+#if VISP_HAVE_SSE2 && USE_SIMD_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
+#if VISP_HAVE_NEON && USE_SIMD_CODE
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+void vpImageMorphology::minRow(const unsigned char *a, const unsigned char *b, unsigned char *dst, unsigned int n)
+{
+  unsigned int i = 0;
+#if USE_SSE
+  if (vpCPUFeatures::checkSSE2()) {
+    for (; (i + 16) <= n; i += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_min_epu8(va, vb));
+    }
+  }
+#elif USE_NEON
+  for (; (i + 16) <= n; i += 16) {
+    vst1q_u8(dst + i, vminq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = std::min<unsigned char>(a[i], b[i]);
+  }
+}
+
+void vpImageMorphology::maxRow(const unsigned char *a, const unsigned char *b, unsigned char *dst, unsigned int n)
+{
+  unsigned int i = 0;
+#if USE_SSE
+  if (vpCPUFeatures::checkSSE2()) {
+    for (; (i + 16) <= n; i += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_max_epu8(va, vb));
+    }
+  }
+#elif USE_NEON
+  for (; (i + 16) <= n; i += 16) {
+    vst1q_u8(dst + i, vmaxq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = std::max<unsigned char>(a[i], b[i]);
+  }
+}
+
+void vpImageMorphology::checkKernelSize(const int &width, const int &height)
+{
+  if ((width <= 0) || (height <= 0) || ((width % 2) != 1) || ((height % 2) != 1)) {
+    throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
+  }
+}
+#endif
+
+END_VISP_NAMESPACE
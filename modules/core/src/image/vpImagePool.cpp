@@ -0,0 +1,297 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pool of image buffers.
+ */
+
+#include <visp3/core/vpImagePool.h>
+
+#include <algorithm>
+#include <map>
+#include <new>
+#include <vector>
+
+#include <inttypes.h>
+
+#if defined(VISP_HAVE_THREADS)
+#include <atomic>
+#include <mutex>
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+namespace
+{
+const size_t g_poolAlignment = 64;
+const size_t g_smallGranularity = 64;
+const size_t g_largeGranularity = 4096;
+const size_t g_defaultMaxCachedBytes = static_cast<size_t>(512) * 1024 * 1024;
+
+void *alignedAllocate(size_t bytes)
+{
+  unsigned char *raw = static_cast<unsigned char *>(::operator new(bytes + g_poolAlignment + sizeof(void *)));
+  size_t offset = static_cast<size_t>(reinterpret_cast<uintptr_t>(raw + sizeof(void *)) & (g_poolAlignment - 1));
+  unsigned char *aligned = raw + sizeof(void *) + (offset == 0 ? 0 : (g_poolAlignment - offset));
+  reinterpret_cast<void **>(aligned)[-1] = raw;
+  return aligned;
+}
+
+void alignedRelease(void *ptr) { ::operator delete(reinterpret_cast<void **>(ptr)[-1]); }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpImagePool::Impl
+{
+public:
+  Impl() : m_enabled(false), m_buckets(), m_maxCachedBytes(g_defaultMaxCachedBytes), m_stats()
+  {
+    resetStatistics();
+  }
+
+  ~Impl() { clear(); }
+
+  void clear()
+  {
+    for (std::map<size_t, std::vector<void *> >::iterator it = m_buckets.begin(); it != m_buckets.end(); ++it) {
+      for (size_t i = 0; i < it->second.size(); ++i) {
+        alignedRelease(it->second[i]);
+      }
+    }
+    m_buckets.clear();
+    m_stats.cachedBytes = 0;
+  }
+
+  void resetStatistics()
+  {
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.peakBytes = m_stats.usedBytes + m_stats.cachedBytes;
+  }
+
+  void trim(size_t maxBytes)
+  {
+    // Release the largest buffers first since they are the most expensive to keep
+    std::map<size_t, std::vector<void *> >::reverse_iterator it = m_buckets.rbegin();
+    while ((m_stats.cachedBytes > maxBytes) && (it != m_buckets.rend())) {
+      while ((m_stats.cachedBytes > maxBytes) && (!it->second.empty())) {
+        alignedRelease(it->second.back());
+        it->second.pop_back();
+        m_stats.cachedBytes -= it->first;
+      }
+      ++it;
+    }
+  }
+
+  void updatePeak() { m_stats.peakBytes = std::max<size_t>(m_stats.peakBytes, m_stats.usedBytes + m_stats.cachedBytes); }
+
+#if defined(VISP_HAVE_THREADS)
+  std::mutex m_mutex;
+  std::atomic<bool> m_enabled; //!< Read without the lock since it is checked by every vpImage allocation
+#else
+  bool m_enabled;
+#endif
+  std::map<size_t, std::vector<void *> > m_buckets; //!< Cached buffers indexed by bucket size
+  size_t m_maxCachedBytes;
+  vpImagePool::vpStatistics m_stats;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+vpImagePool::vpImagePool() : m_impl(new Impl()) { }
+
+vpImagePool::~vpImagePool() { delete m_impl; }
+
+/*!
+ * Get the pool shared by all the images of the process.
+ *
+ * The pool is intentionally never destroyed, so that images with static storage duration can still give their
+ * buffer back to the pool when they are destroyed at program exit.
+ */
+vpImagePool &vpImagePool::getInstance()
+{
+  static vpImagePool *instance = new vpImagePool();
+  return *instance;
+}
+
+/*!
+ * Get a buffer of at least \e bytes bytes, aligned on 64 bytes.
+ *
+ * A cached buffer of the same bucket is returned if available, otherwise a new buffer is allocated on the heap. The
+ * buffer must be given back with release() using the same \e bytes value.
+ *
+ * \param[in] bytes : Requested size in bytes.
+ * \return Pointer to the buffer.
+ */
+void *vpImagePool::allocate(size_t bytes)
+{
+  const size_t bucket = getBucketSize(bytes);
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+    std::map<size_t, std::vector<void *> >::iterator it = m_impl->m_buckets.find(bucket);
+    if ((it != m_impl->m_buckets.end()) && (!it->second.empty())) {
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      ++m_impl->m_stats.hits;
+      m_impl->m_stats.cachedBytes -= bucket;
+      m_impl->m_stats.usedBytes += bucket;
+      return ptr;
+    }
+    ++m_impl->m_stats.misses;
+    m_impl->m_stats.usedBytes += bucket;
+    m_impl->updatePeak();
+  }
+
+  // The heap allocation is done outside of the lock
+  return alignedAllocate(bucket);
+}
+
+/*!
+ * Release all the cached buffers. Buffers currently used by images are not affected.
+ */
+void vpImagePool::clear()
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  m_impl->clear();
+}
+
+/*!
+ * Get the size in bytes of the bucket used to serve an allocation of \e bytes bytes.
+ */
+size_t vpImagePool::getBucketSize(size_t bytes)
+{
+  const size_t granularity = (bytes < g_largeGranularity) ? g_smallGranularity : g_largeGranularity;
+  const size_t nbChunks = (bytes + granularity - 1) / granularity;
+  return std::max<size_t>(nbChunks, 1) * granularity;
+}
+
+/*!
+ * Get the maximum number of bytes kept in the pool for reuse.
+ */
+size_t vpImagePool::getMaxCachedBytes() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_maxCachedBytes;
+}
+
+/*!
+ * Get a snapshot of the pool statistics.
+ */
+vpImagePool::vpStatistics vpImagePool::getStatistics() const
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_stats;
+}
+
+/*!
+ * Return true when vpImage allocates its bitmap from the pool. The flag is read without taking the pool lock, so
+ * that the images allocated while the pool is disabled do not contend on it.
+ */
+bool vpImagePool::isEnabled() const
+{
+#if defined(VISP_HAVE_THREADS)
+  return m_impl->m_enabled.load(std::memory_order_acquire);
+#else
+  return m_impl->m_enabled;
+#endif
+}
+
+/*!
+ * Give back a buffer obtained with allocate(). The buffer is kept for reuse unless this would exceed the maximum
+ * number of cached bytes, in which case it is released to the heap.
+ *
+ * \param[in] ptr : Pointer returned by allocate().
+ * \param[in] bytes : Size that was passed to allocate().
+ */
+void vpImagePool::release(void *ptr, size_t bytes)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+  const size_t bucket = getBucketSize(bytes);
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+    m_impl->m_stats.usedBytes -= bucket;
+    if ((m_impl->m_stats.cachedBytes + bucket) <= m_impl->m_maxCachedBytes) {
+      m_impl->m_buckets[bucket].push_back(ptr);
+      m_impl->m_stats.cachedBytes += bucket;
+      m_impl->updatePeak();
+      return;
+    }
+  }
+  alignedRelease(ptr);
+}
+
+/*!
+ * Reset the hit and miss counters and set the peak to the current memory footprint of the pool.
+ */
+void vpImagePool::resetStatistics()
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  m_impl->resetStatistics();
+}
+
+/*!
+ * Enable or disable the allocation of the vpImage bitmaps from the pool.
+ * Disabling the pool does not release the cached buffers, see clear().
+ */
+void vpImagePool::setEnabled(bool enable)
+{
+#if defined(VISP_HAVE_THREADS)
+  m_impl->m_enabled.store(enable, std::memory_order_release);
+#else
+  m_impl->m_enabled = enable;
+#endif
+}
+
+/*!
+ * Set the maximum number of bytes kept in the pool for reuse. Default value is 512 MB.
+ * Cached buffers exceeding the new limit are released.
+ */
+void vpImagePool::setMaxCachedBytes(size_t maxBytes)
+{
+#if defined(VISP_HAVE_THREADS)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  m_impl->m_maxCachedBytes = maxBytes;
+  m_impl->trim(maxBytes);
+}
+
+END_VISP_NAMESPACE
@@ -0,0 +1,362 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-resolution image pyramid.
+ */
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImagePyramid.h>
+
+#include <algorithm>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#else
+#define VISP_HAVE_NEON 0
+#endif
+
+#define USE_SIMD_CODE 1
+
+#if VISP_HAVE_SSE2 && USE_SIMD_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
+#if VISP_HAVE_NEON && USE_SIMD_CODE
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+namespace
+{
+// Index of the pixel in [0, n-1] reflected with respect to the border without repeating the border pixel
+// (BORDER_REFLECT_101)
+inline unsigned int reflect101(int k, unsigned int n)
+{
+  if (n == 1) {
+    return 0;
+  }
+  const int last = static_cast<int>(n) - 1;
+  while ((k < 0) || (k > last)) {
+    k = (k < 0) ? -k : ((2 * last) - k);
+  }
+  return static_cast<unsigned int>(k);
+}
+
+inline unsigned short filterBorderPixelDown(const unsigned char *src, unsigned int width, unsigned int x)
+{
+  const int c = static_cast<int>(2 * x);
+  return static_cast<unsigned short>(src[reflect101(c - 2, width)] + src[reflect101(c + 2, width)] +
+                                     (4 * (src[reflect101(c - 1, width)] + src[reflect101(c + 1, width)])) +
+                                     (6 * src[c]));
+}
+
+/*
+ * Horizontal 1-4-6-4-1 filter of a source row, keeping one column out of two. The sums are at most 16 * 255 and fit
+ * in 16 bits.
+ */
+void filterRowDown(const unsigned char *src, unsigned int width, unsigned short *dst, unsigned int dstWidth)
+{
+  // Left border, the first column needs the columns -2 and -1
+  dst[0] = filterBorderPixelDown(src, width, 0);
+  unsigned int x = 1;
+
+#if USE_SSE
+  const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+  for (; ((2 * x) + 18) <= width; x += 8) {
+    const unsigned char *p = src + (2 * x);
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p - 2));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 2));
+    const __m128i e0 = _mm_and_si128(b, lowBytes);
+    const __m128i outer = _mm_add_epi16(_mm_and_si128(a, lowBytes), _mm_and_si128(c, lowBytes));
+    const __m128i inner = _mm_add_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+    const __m128i center = _mm_add_epi16(_mm_slli_epi16(e0, 2), _mm_slli_epi16(e0, 1));
+    const __m128i sum = _mm_add_epi16(_mm_add_epi16(outer, _mm_slli_epi16(inner, 2)), center);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), sum);
+  }
+#elif USE_NEON
+  for (; ((2 * x) + 34) <= width; x += 16) {
+    const unsigned char *p = src + (2 * x);
+    const uint8x16x2_t a = vld2q_u8(p - 2);
+    const uint8x16x2_t b = vld2q_u8(p);
+    const uint8x16x2_t c = vld2q_u8(p + 2);
+    uint16x8_t sumLow = vaddl_u8(vget_low_u8(a.val[0]), vget_low_u8(c.val[0]));
+    uint16x8_t sumHigh = vaddl_u8(vget_high_u8(a.val[0]), vget_high_u8(c.val[0]));
+    sumLow = vaddq_u16(sumLow, vshlq_n_u16(vaddl_u8(vget_low_u8(a.val[1]), vget_low_u8(b.val[1])), 2));
+    sumHigh = vaddq_u16(sumHigh, vshlq_n_u16(vaddl_u8(vget_high_u8(a.val[1]), vget_high_u8(b.val[1])), 2));
+    sumLow = vmlaq_n_u16(sumLow, vmovl_u8(vget_low_u8(b.val[0])), 6);
+    sumHigh = vmlaq_n_u16(sumHigh, vmovl_u8(vget_high_u8(b.val[0])), 6);
+    vst1q_u16(dst + x, sumLow);
+    vst1q_u16(dst + x + 8, sumHigh);
+  }
+#endif
+
+  // Interior columns that do not fill a register
+  for (; (x < dstWidth) && (((2 * x) + 2) < width); ++x) {
+    const unsigned char *p = src + (2 * x);
+    dst[x] = static_cast<unsigned short>(p[-2] + p[2] + (4 * (p[-1] + p[1])) + (6 * p[0]));
+  }
+
+  // Right border
+  for (; x < dstWidth; ++x) {
+    dst[x] = filterBorderPixelDown(src, width, x);
+  }
+}
+
+/*
+ * Vertical 1-4-6-4-1 filter of five rows produced by filterRowDown(), with rounding. The weighted sum is at most
+ * 256 * 255 + 128 and fits in 16 bits.
+ */
+void filterColumnDown(const unsigned short *const *rows, unsigned char *dst, unsigned int width)
+{
+  const unsigned short *r0 = rows[0], *r1 = rows[1], *r2 = rows[2], *r3 = rows[3], *r4 = rows[4];
+  unsigned int x = 0;
+#if USE_SSE
+  const __m128i half = _mm_set1_epi16(128);
+  for (; (x + 16) <= width; x += 16) {
+    __m128i res[2];
+    for (unsigned int k = 0; k < 2; ++k) {
+      const unsigned int o = x + (8 * k);
+      const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r2 + o));
+      const __m128i outer = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + o)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(r4 + o)));
+      const __m128i inner = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + o)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(r3 + o)));
+      const __m128i center = _mm_add_epi16(_mm_slli_epi16(c, 2), _mm_slli_epi16(c, 1));
+      const __m128i sum = _mm_add_epi16(_mm_add_epi16(outer, _mm_slli_epi16(inner, 2)), _mm_add_epi16(center, half));
+      res[k] = _mm_srli_epi16(sum, 8);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(res[0], res[1]));
+  }
+#elif USE_NEON
+  for (; (x + 8) <= width; x += 8) {
+    uint16x8_t sum = vaddq_u16(vld1q_u16(r0 + x), vld1q_u16(r4 + x));
+    sum = vaddq_u16(sum, vshlq_n_u16(vaddq_u16(vld1q_u16(r1 + x), vld1q_u16(r3 + x)), 2));
+    sum = vmlaq_n_u16(sum, vld1q_u16(r2 + x), 6);
+    vst1_u8(dst + x, vrshrn_n_u16(sum, 8));
+  }
+#endif
+  for (; x < width; ++x) {
+    const unsigned int sum = r0[x] + r4[x] + (4u * (r1[x] + r3[x])) + (6u * r2[x]) + 128u;
+    dst[x] = static_cast<unsigned char>(sum >> 8);
+  }
+}
+
+int getNbStrips(unsigned int height)
+{
+#ifdef VISP_HAVE_OPENMP
+  const unsigned int minRowsPerStrip = 16;
+  int nbStrips = std::min<int>(omp_get_max_threads(), static_cast<int>(height / minRowsPerStrip));
+  return std::max<int>(nbStrips, 1);
+#else
+  (void)height;
+  return 1;
+#endif
+}
+}
+
+/*!
+ * Create a pyramid.
+ *
+ * \param[in] nbLevels : Number of levels, including the base image. Must be at least 1.
+ * \param[in] type : Decimation used to compute a level from the previous one.
+ */
+vpImagePyramid::vpImagePyramid(unsigned int nbLevels, const vpPyramidType &type)
+  : m_base(nullptr), m_levels(), m_buffer(), m_nbLevels(1), m_type(type)
+{
+  setNbLevels(nbLevels);
+}
+
+/*!
+ * Compute all the levels of the pyramid of image \e I. The buffers of the levels are kept from one call to the next,
+ * and are only reallocated when the size of \e I changes.
+ *
+ * \param[in] I : Base image of the pyramid. It is not copied and must outlive the use of the pyramid.
+ */
+void vpImagePyramid::build(const vpImage<unsigned char> &I)
+{
+  m_base = &I;
+  for (unsigned int level = 1; level < m_nbLevels; ++level) {
+    if (m_type == PYRAMID_GAUSSIAN) {
+      pyrDown(getLevel(level - 1), m_levels[level - 1], m_buffer);
+    }
+    else {
+      subsample(I, 1u << level, m_levels[level - 1]);
+    }
+  }
+}
+
+/*!
+ * Get the image at a given level of the pyramid.
+ *
+ * \param[in] level : Level index, 0 being the base image.
+ * \exception vpException::dimensionError If \e level is not lower than getNbLevels().
+ * \exception vpException::notInitialized If build() has not been called.
+ */
+const vpImage<unsigned char> &vpImagePyramid::getLevel(unsigned int level) const
+{
+  if (level >= m_nbLevels) {
+    throw(vpException(vpException::dimensionError, "Pyramid level %u does not exist, the pyramid has %u levels", level,
+                      m_nbLevels));
+  }
+  if (m_base == nullptr) {
+    throw(vpException(vpException::notInitialized, "The pyramid has not been built"));
+  }
+  return (level == 0) ? *m_base : m_levels[level - 1];
+}
+
+/*!
+ * Set the number of levels of the pyramid, including the base image. The pyramid must be built again.
+ *
+ * \param[in] nbLevels : Number of levels. Must be at least 1 and lower than 32.
+ * \exception vpException::badValue If \e nbLevels is out of range.
+ */
+void vpImagePyramid::setNbLevels(unsigned int nbLevels)
+{
+  const unsigned int maxLevels = 32;
+  if ((nbLevels == 0) || (nbLevels >= maxLevels)) {
+    throw(vpException(vpException::badValue, "Wrong number of pyramid levels: %u", nbLevels));
+  }
+  m_nbLevels = nbLevels;
+  m_levels.resize(nbLevels - 1);
+  m_base = nullptr;
+}
+
+/*!
+ * Set the decimation used to compute a level from the previous one. The pyramid must be built again.
+ */
+void vpImagePyramid::setType(const vpPyramidType &type)
+{
+  m_type = type;
+  m_base = nullptr;
+}
+
+/*!
+ * Smooth image \e I with the 5x5 binomial kernel and remove every second row and column.
+ * The output image has ((w+1)/2, (h+1)/2) pixels, where (w, h) is the size of \e I. The result is the same as
+ * `cv::pyrDown()` with the default parameters.
+ *
+ * \param[in] I : Input image.
+ * \param[out] GI : Decimated image, resized if needed.
+ */
+void vpImagePyramid::pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  std::vector<unsigned short> buffer;
+  pyrDown(I, GI, buffer);
+}
+
+/*
+ * The output rows are processed top to bottom, one strip per thread. Each strip keeps a ring of the five horizontally
+ * filtered source rows needed by the vertical filter, so that each source row is read once and the intermediate sums
+ * stay in cache.
+ */
+void vpImagePyramid::pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI,
+                             std::vector<unsigned short> &buffer)
+{
+  const unsigned int width = I.getWidth();
+  const unsigned int height = I.getHeight();
+  if ((width == 0) || (height == 0)) {
+    GI.resize(0, 0);
+    return;
+  }
+  const unsigned int dstWidth = (width + 1) / 2;
+  const unsigned int dstHeight = (height + 1) / 2;
+  const unsigned int nbTaps = 5;
+  GI.resize(dstHeight, dstWidth);
+
+  const int nbStrips = getNbStrips(dstHeight);
+  const unsigned int stripHeight =
+    (dstHeight + static_cast<unsigned int>(nbStrips) - 1) / static_cast<unsigned int>(nbStrips);
+  const size_t ringSize = static_cast<size_t>(nbTaps) * dstWidth;
+  if (buffer.size() < (static_cast<size_t>(nbStrips) * ringSize)) {
+    buffer.resize(static_cast<size_t>(nbStrips) * ringSize);
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbStrips)
+#endif
+  for (int strip = 0; strip < nbStrips; ++strip) {
+    unsigned short *ring = &buffer[static_cast<size_t>(strip) * ringSize];
+    const int ybegin = strip * static_cast<int>(stripHeight);
+    const int yend = std::min<int>(ybegin + static_cast<int>(stripHeight), static_cast<int>(dstHeight));
+    // The source rows are stored in the ring by their index before reflection, that is in [-2, height + 1]
+    int next = (2 * ybegin) - 2;
+    for (int y = ybegin; y < yend; ++y) {
+      const int last = (2 * y) + 2;
+      for (; next <= last; ++next) {
+        filterRowDown(I[reflect101(next, height)], width, ring + (((next + 5) % 5) * dstWidth), dstWidth);
+      }
+      const unsigned short *rows[5];
+      for (int k = 0; k < 5; ++k) {
+        rows[k] = ring + (((((2 * y) - 2) + k + 5) % 5) * dstWidth);
+      }
+      filterColumnDown(rows, GI[y], dstWidth);
+    }
+  }
+}
+
+/*
+ * Keep one pixel out of factor along each direction.
+ */
+void vpImagePyramid::subsample(const vpImage<unsigned char> &I, unsigned int factor, vpImage<unsigned char> &GI)
+{
+  const unsigned int height = I.getHeight() / factor;
+  const unsigned int width = I.getWidth() / factor;
+  GI.resize(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    const unsigned char *src = I[i * factor];
+    unsigned char *dst = GI[i];
+    for (unsigned int j = 0; j < width; ++j) {
+      dst[j] = src[j * factor];
+    }
+  }
+}
+
+END_VISP_NAMESPACE
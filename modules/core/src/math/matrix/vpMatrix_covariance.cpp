@@ -42,6 +42,32 @@
 #include <visp3/core/vpTranslationVector.h>
 
 BEGIN_VISP_NAMESPACE
+namespace
+{
+// Sum of the squares of the residuals b - A x, weighted by w if not null, computed row by row without any temporary
+double sumSquareResidual(const vpMatrix &A, const vpColVector &x, const vpColVector &b, const vpColVector *w)
+{
+  if ((A.getCols() != x.getRows()) || (A.getRows() != b.getRows()) || ((w != nullptr) && (w->getRows() != b.getRows()))) {
+    throw vpMatrixException(vpMatrixException::incorrectMatrixSizeError,
+                            "Impossible to compute covariance matrix: incorrect matrices size");
+  }
+  double sum = 0.;
+  for (unsigned int i = 0; i < A.getRows(); ++i) {
+    const double *Ai = A[i];
+    double Aix = 0.;
+    for (unsigned int j = 0; j < A.getCols(); ++j) {
+      Aix += Ai[j] * x[j];
+    }
+    double r = b[i] - Aix;
+    if (w != nullptr) {
+      r *= (*w)[i];
+    }
+    sum += r * r;
+  }
+  return sum;
+}
+}
+
 /*!
   Compute the covariance matrix of the parameters x from a least squares
   minimization defined as: Ax = b
@@ -61,11 +87,11 @@ vpMatrix vpMatrix::computeCovarianceMatrix(const vpMatrix &A, const vpColVector
                             "Impossible to compute covariance matrix: not enough data");
   }
 
-  double sigma2 = (b - (A * x)).t() * (b - (A * x));
+  double sigma2 = sumSquareResidual(A, x, b, nullptr);
 
   sigma2 /= denom;
 
-  return (A.t() * A).pseudoInverse(A.getCols() * std::numeric_limits<double>::epsilon()) * sigma2;
+  return A.AtA().pseudoInverse(A.getCols() * std::numeric_limits<double>::epsilon()) * sigma2;
 }
 
 /*!
@@ -85,11 +111,12 @@ vpMatrix vpMatrix::computeCovarianceMatrix(const vpMatrix &A, const vpColVector
                                            const vpMatrix &W)
 {
   double denom = 0.0;
-  vpMatrix W2(W.getCols(), W.getCols());
   unsigned int w_cols = W.getCols();
+  vpColVector w(w_cols), w2(w_cols);
   for (unsigned int i = 0; i < w_cols; ++i) {
     denom += W[i][i];
-    W2[i][i] = W[i][i] * W[i][i];
+    w[i] = W[i][i];
+    w2[i] = W[i][i] * W[i][i];
   }
 
   if (denom <= std::numeric_limits<double>::epsilon()) {
@@ -97,12 +124,11 @@ vpMatrix vpMatrix::computeCovarianceMatrix(const vpMatrix &A, const vpColVector
                             "Impossible to compute covariance matrix: not enough data");
   }
 
-  //  double sigma2 = ( ((W*b).t())*W*b - ( ((W*b).t())*W*A*x ) ); // Should
-  //  be equivalent to line bellow.
-  double sigma2 = ((W * b) - (W * A * x)).t() * ((W * b) - (W * A * x));
+  // Equivalent to ((W * b) - (W * A * x)).t() * ((W * b) - (W * A * x)) since W is diagonal
+  double sigma2 = sumSquareResidual(A, x, b, &w);
   sigma2 /= denom;
 
-  return (A.t() * W2 * A).pseudoInverse(A.getCols() * std::numeric_limits<double>::epsilon()) * sigma2;
+  return A.AtWA(w2).pseudoInverse(A.getCols() * std::numeric_limits<double>::epsilon()) * sigma2;
 }
 
 /*!
@@ -33,6 +33,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
 
 #if defined(VISP_HAVE_SIMDLIB)
 #include <Simd/SimdLib.h>
@@ -141,6 +142,15 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
 // Matrix operations.
 //---------------------------------
 
+namespace
+{
+// Products of small square matrices are computed by the unrolled kernels of vpMatrixFixed
+bool isSquareProduct(const vpMatrix &A, const vpMatrix &B, unsigned int n)
+{
+  return (A.getRows() == n) && (A.getCols() == n) && (B.getCols() == n);
+}
+}
+
 /*!
   Operation C = A * B.
 
@@ -161,6 +171,20 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
                       A.getCols(), B.getRows(), B.getCols()));
   }
 
+  // Small square products are faster with the unrolled kernels than with Lapack
+  if (isSquareProduct(A, B, 3)) {
+    vpMatrixFixed<3, 3>::mult<3>(A.data, B.data, C.data);
+    return;
+  }
+  if (isSquareProduct(A, B, 4)) {
+    vpMatrixFixed<4, 4>::mult<4>(A.data, B.data, C.data);
+    return;
+  }
+  if (isSquareProduct(A, B, 6)) {
+    vpMatrixFixed<6, 6>::mult<6>(A.data, B.data, C.data);
+    return;
+  }
+
   // If available use Lapack only for large matrices
   bool useLapack = ((A.getRows() > vpMatrix::m_lapack_min_size) || (A.getCols() > vpMatrix::m_lapack_min_size) ||
                     (B.getCols() > vpMatrix::m_lapack_min_size));
@@ -719,25 +743,23 @@ void vpMatrix::AtA(vpMatrix &B) const
 #endif
   }
   else {
-    for (unsigned int i = 0; i < colNum; ++i) {
-      double *Bi = B[i];
-      for (unsigned int j = 0; j < i; ++j) {
-        double *ptr = data;
-        double s = 0;
-        for (unsigned int k = 0; k < rowNum; ++k) {
-          s += (*(ptr + i)) * (*(ptr + j));
-          ptr += colNum;
+    // The rows of A are read only once, the products being accumulated in the upper triangle of B in the same
+    // order as a dot product of two columns of A
+    B = 0.;
+    for (unsigned int k = 0; k < rowNum; ++k) {
+      const double *Ak = rowPtrs[k];
+      for (unsigned int i = 0; i < colNum; ++i) {
+        const double Aki = Ak[i];
+        double *Bi = B.rowPtrs[i];
+        for (unsigned int j = i; j < colNum; ++j) {
+          Bi[j] += Aki * Ak[j];
         }
-        *Bi++ = s;
-        B[j][i] = s;
       }
-      double *ptr = data;
-      double s = 0;
-      for (unsigned int k = 0; k < rowNum; ++k) {
-        s += (*(ptr + i)) * (*(ptr + i));
-        ptr += colNum;
+    }
+    for (unsigned int i = 1; i < colNum; ++i) {
+      for (unsigned int j = 0; j < i; ++j) {
+        B.rowPtrs[i][j] = B.rowPtrs[j][i];
       }
-      *Bi = s;
     }
   }
 }
@@ -756,6 +778,198 @@ vpMatrix vpMatrix::AtA() const
   return B;
 }
 
+/*!
+  Compute the AtB operation such as \f$C = A^T*B\f$, without computing the transpose of A.
+
+  The result is placed in the parameter \e C and not returned. \e C must be a different matrix from A and \e B.
+
+  A new matrix won't be allocated for every use of the function. This
+  results in a speed gain if used many times with the same result matrix
+  size.
+
+  \param B : Matrix with the same number of rows as A.
+  \param C : Resulting matrix, of size A.getCols() x B.getCols().
+
+  \sa AtB(const vpMatrix &) const, AtA()
+*/
+void vpMatrix::AtB(const vpMatrix &B, vpMatrix &C) const
+{
+  if (rowNum != B.rowNum) {
+    throw(vpException(vpException::dimensionError, "Cannot compute AtB with a (%dx%d) matrix A and a (%dx%d) matrix B",
+                      rowNum, colNum, B.getRows(), B.getCols()));
+  }
+
+  if ((C.rowNum != colNum) || (C.colNum != B.colNum)) {
+    C.resize(colNum, B.colNum, false, false);
+  }
+
+  // If available use Lapack only for large matrices
+  bool useLapack = ((rowNum > vpMatrix::m_lapack_min_size) || (colNum > vpMatrix::m_lapack_min_size) ||
+                    (B.colNum > vpMatrix::m_lapack_min_size));
+#if !(defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL))
+  useLapack = false;
+#endif
+
+  if (useLapack) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL)
+    const double alpha = 1.0;
+    const double beta = 0.0;
+    const char transa = 'n';
+    const char transb = 't';
+
+    vpMatrix::blas_dgemm(transa, transb, B.colNum, colNum, rowNum, alpha, B.data, B.colNum, data, colNum, beta, C.data,
+                         B.colNum);
+#endif
+  }
+  else {
+    // Rows of A and B are read together, each one only once
+    C = 0.;
+    for (unsigned int k = 0; k < rowNum; ++k) {
+      const double *Ak = rowPtrs[k];
+      const double *Bk = B.rowPtrs[k];
+      for (unsigned int i = 0; i < colNum; ++i) {
+        const double Aki = Ak[i];
+        double *Ci = C.rowPtrs[i];
+        for (unsigned int j = 0; j < B.colNum; ++j) {
+          Ci[j] += Aki * Bk[j];
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Compute the AtB operation such as \f$ C = A^T*B \f$, without computing the transpose of A.
+  \return The product \f$ A^T*B \f$.
+  \sa AtB(const vpMatrix &, vpMatrix &) const
+*/
+vpMatrix vpMatrix::AtB(const vpMatrix &B) const
+{
+  vpMatrix C;
+
+  AtB(B, C);
+
+  return C;
+}
+
+/*!
+  Compute the product \f$c = A^T*b\f$ of the transpose of A by a column vector, without computing the transpose of A.
+
+  The result is placed in the parameter \e c and not returned. \e c must be a different vector from \e b.
+
+  \param b : Column vector with as many rows as A.
+  \param c : Resulting vector, of size A.getCols().
+
+  \sa AtB(const vpColVector &) const
+*/
+void vpMatrix::AtB(const vpColVector &b, vpColVector &c) const
+{
+  if (rowNum != b.getRows()) {
+    throw(vpException(vpException::dimensionError, "Cannot multiply the transpose of a (%dx%d) matrix by a (%d) column vector",
+                      rowNum, colNum, b.getRows()));
+  }
+
+  if (c.getRows() != colNum) {
+    c.resize(colNum, false);
+  }
+
+  // If available use Lapack only for large matrices
+  bool useLapack = ((rowNum > vpMatrix::m_lapack_min_size) || (colNum > vpMatrix::m_lapack_min_size));
+#if !(defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL))
+  useLapack = false;
+#endif
+
+  if (useLapack) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL)
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 'n';
+    int incr = 1;
+
+    vpMatrix::blas_dgemv(trans, colNum, rowNum, alpha, data, colNum, b.data, incr, beta, c.data, incr);
+#endif
+  }
+  else {
+    c = 0.;
+    for (unsigned int k = 0; k < rowNum; ++k) {
+      const double *Ak = rowPtrs[k];
+      const double bk = b[k];
+      for (unsigned int i = 0; i < colNum; ++i) {
+        c[i] += Ak[i] * bk;
+      }
+    }
+  }
+}
+
+/*!
+  Compute the product \f$ c = A^T*b \f$ of the transpose of A by a column vector.
+  \return The product \f$ A^T*b \f$.
+  \sa AtB(const vpColVector &, vpColVector &) const
+*/
+vpColVector vpMatrix::AtB(const vpColVector &b) const
+{
+  vpColVector c;
+
+  AtB(b, c);
+
+  return c;
+}
+
+/*!
+  Compute the AtWA operation such as \f$B = A^T*W*A\f$ where \f$W = diag(w)\f$ is a diagonal weight matrix, as
+  in a weighted least squares problem. Neither the transpose of A nor W are computed.
+
+  The result is placed in the parameter \e B and not returned.
+
+  \param w : Vector of the diagonal elements of W, with as many rows as A.
+  \param B : Resulting matrix, of size A.getCols() x A.getCols().
+
+  \sa AtWA(const vpColVector &) const, AtA()
+*/
+void vpMatrix::AtWA(const vpColVector &w, vpMatrix &B) const
+{
+  if (rowNum != w.getRows()) {
+    throw(vpException(vpException::dimensionError, "Cannot compute AtWA with a (%dx%d) matrix A and (%d) weights",
+                      rowNum, colNum, w.getRows()));
+  }
+
+  if ((B.rowNum != colNum) || (B.colNum != colNum)) {
+    B.resize(colNum, colNum, false, false);
+  }
+
+  B = 0.;
+  for (unsigned int k = 0; k < rowNum; ++k) {
+    const double *Ak = rowPtrs[k];
+    const double wk = w[k];
+    for (unsigned int i = 0; i < colNum; ++i) {
+      const double wAki = wk * Ak[i];
+      double *Bi = B.rowPtrs[i];
+      for (unsigned int j = i; j < colNum; ++j) {
+        Bi[j] += wAki * Ak[j];
+      }
+    }
+  }
+  for (unsigned int i = 1; i < colNum; ++i) {
+    for (unsigned int j = 0; j < i; ++j) {
+      B.rowPtrs[i][j] = B.rowPtrs[j][i];
+    }
+  }
+}
+
+/*!
+  Compute the AtWA operation such as \f$ B = A^T*W*A \f$ where \f$W = diag(w)\f$.
+  \return The product \f$ A^T*W*A \f$.
+  \sa AtWA(const vpColVector &, vpMatrix &) const
+*/
+vpMatrix vpMatrix::AtWA(const vpColVector &w) const
+{
+  vpMatrix B;
+
+  AtWA(w, B);
+
+  return B;
+}
+
 /*!
   Create a diagonal matrix with the element of a vector.
 
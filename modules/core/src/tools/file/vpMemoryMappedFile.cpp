@@ -0,0 +1,205 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read-only memory-mapped file.
+ */
+
+/*!
+  \file vpMemoryMappedFile.cpp
+  \brief Read-only memory-mapped file.
+*/
+
+#include <fstream>
+
+#include <visp3/core/vpIoException.h>
+#include <visp3/core/vpMemoryMappedFile.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#define VP_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define VP_HAVE_MAP_VIEW_OF_FILE
+// Mute warning with clang-cl
+// warning : non-portable path to file '<Windows.h>'; specified path differs in case from file name on disk [-Wnonportable-system-include-path]
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wnonportable-system-include-path"
+#endif
+
+#include <windows.h>
+
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+#endif
+
+BEGIN_VISP_NAMESPACE
+/*!
+  Default constructor, no file is opened.
+*/
+vpMemoryMappedFile::vpMemoryMappedFile()
+  : m_filename(), m_data(nullptr), m_size(0), m_isOpen(false), m_mapped(false), m_buffer(), m_fileHandle(nullptr),
+  m_mappingHandle(nullptr)
+{ }
+
+/*!
+  Open and map a file in memory.
+
+  \param filename : Name of the file.
+
+  \sa open()
+*/
+vpMemoryMappedFile::vpMemoryMappedFile(const std::string &filename)
+  : m_filename(), m_data(nullptr), m_size(0), m_isOpen(false), m_mapped(false), m_buffer(), m_fileHandle(nullptr),
+  m_mappingHandle(nullptr)
+{
+  open(filename);
+}
+
+/*!
+  Destructor, unmap the file.
+*/
+vpMemoryMappedFile::~vpMemoryMappedFile() { close(); }
+
+/*!
+  Unmap the file. The pointer returned by data() becomes invalid.
+*/
+void vpMemoryMappedFile::close()
+{
+  if (m_mapped) {
+#if defined(VP_HAVE_MMAP)
+    munmap(const_cast<unsigned char *>(m_data), m_size);
+#elif defined(VP_HAVE_MAP_VIEW_OF_FILE)
+    UnmapViewOfFile(m_data);
+#endif
+  }
+#if defined(VP_HAVE_MAP_VIEW_OF_FILE)
+  if (m_mappingHandle != nullptr) {
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+  }
+  if (m_fileHandle != nullptr) {
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+  }
+#endif
+  m_fileHandle = nullptr;
+  m_mappingHandle = nullptr;
+  m_buffer.clear();
+  m_data = nullptr;
+  m_size = 0;
+  m_mapped = false;
+  m_isOpen = false;
+  m_filename.clear();
+}
+
+/*!
+  Open a file and map its content in memory. A previously opened file is closed first.
+
+  \param filename : Name of the file.
+
+  \exception vpIoException::ioError : If the file cannot be opened or mapped.
+*/
+void vpMemoryMappedFile::open(const std::string &filename)
+{
+  close();
+
+#if defined(VP_HAVE_MMAP)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw vpIoException(vpIoException::ioError, "Cannot open file %s", filename.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw vpIoException(vpIoException::ioError, "Cannot get the size of file %s", filename.c_str());
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size > 0) {
+    void *ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      ::close(fd);
+      m_size = 0;
+      throw vpIoException(vpIoException::ioError, "Cannot map file %s in memory", filename.c_str());
+    }
+    m_data = static_cast<const unsigned char *>(ptr);
+    m_mapped = true;
+  }
+  // The mapping stays valid after the file is closed
+  ::close(fd);
+#elif defined(VP_HAVE_MAP_VIEW_OF_FILE)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw vpIoException(vpIoException::ioError, "Cannot open file %s", filename.c_str());
+  }
+  m_fileHandle = file;
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    close();
+    throw vpIoException(vpIoException::ioError, "Cannot get the size of file %s", filename.c_str());
+  }
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+  if (m_size > 0) {
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+      close();
+      throw vpIoException(vpIoException::ioError, "Cannot map file %s in memory", filename.c_str());
+    }
+    m_mappingHandle = mapping;
+    void *ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (ptr == nullptr) {
+      close();
+      throw vpIoException(vpIoException::ioError, "Cannot map file %s in memory", filename.c_str());
+    }
+    m_data = static_cast<const unsigned char *>(ptr);
+    m_mapped = true;
+  }
+#else
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw vpIoException(vpIoException::ioError, "Cannot open file %s", filename.c_str());
+  }
+  file.seekg(0, std::ios::end);
+  m_size = static_cast<size_t>(file.tellg());
+  file.seekg(0, std::ios::beg);
+  m_buffer.resize(m_size);
+  if ((m_size > 0) && !file.read(reinterpret_cast<char *>(&m_buffer[0]), static_cast<std::streamsize>(m_size))) {
+    close();
+    throw vpIoException(vpIoException::ioError, "Cannot read file %s", filename.c_str());
+  }
+  m_data = m_size > 0 ? &m_buffer[0] : nullptr;
+#endif
+
+  m_filename = filename;
+  m_isOpen = true;
+}
+END_VISP_NAMESPACE
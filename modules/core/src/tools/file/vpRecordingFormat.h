@@ -0,0 +1,139 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Layout of the files written by vpRecordingWriter.
+ */
+
+#ifndef VP_RECORDING_FORMAT_H
+#define VP_RECORDING_FORMAT_H
+
+#include <cstring>
+#include <stdint.h>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpEndian.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+BEGIN_VISP_NAMESPACE
+namespace vpRecordingFormat
+{
+/*
+ * A recording is a header of 64 bytes followed by chunks. Each chunk is a header of 64 bytes followed by its
+ * payload, padded with zeros to a multiple of 64 bytes, so that the pixels of the frames are aligned in the file.
+ * The chunks are only appended: a stream is declared by a chunk before its first frame. When the recording is
+ * closed, an index chunk with the offsets of all the chunks and an end chunk are appended. Without them, e.g. after
+ * a crash, the chunks are found by reading their headers one after the other. All the values are little-endian.
+ *
+ * Chunk header:
+ *  0  magic "VPCK"
+ *  4  uint32 kind
+ *  8  uint32 stream id
+ * 12  uint32 flags
+ * 16  uint64 size of the payload in the file
+ * 24  uint64 size of the uncompressed payload
+ * 32  double timestamp of a frame
+ * 40  uint32 width of a frame, or type of a stream
+ * 44  uint32 height of a frame
+ */
+const char fileMagic[8] = { 'V', 'P', 'R', 'E', 'C', '\0', '\0', '\0' };
+const char chunkMagic[4] = { 'V', 'P', 'C', 'K' };
+const uint32_t version = 1;
+const size_t alignment = 64;
+const size_t headerSize = 64;
+
+const uint32_t chunkStream = 1; //!< Declaration of a stream, the payload is its name
+const uint32_t chunkFrame = 2;  //!< Frame of a stream
+const uint32_t chunkIndex = 3;  //!< uint64 offsets of the stream and frame chunks
+const uint32_t chunkEnd = 4;    //!< Last chunk, the uncompressed size is the offset of the index chunk
+
+const uint32_t flagCompressed = 1; //!< The payload is deflated, after its bytes were grouped by significance
+
+inline size_t alignSize(size_t size) { return ((size + alignment - 1) / alignment) * alignment; }
+
+inline uint32_t readUInt32(const unsigned char *data)
+{
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+#ifdef VISP_BIG_ENDIAN
+  value = vpEndian::swap32bits(value);
+#endif
+  return value;
+}
+
+inline uint64_t readUInt64(const unsigned char *data)
+{
+  return static_cast<uint64_t>(readUInt32(data)) | (static_cast<uint64_t>(readUInt32(data + 4)) << 32);
+}
+
+inline double readDouble(const unsigned char *data)
+{
+  const uint64_t bits = readUInt64(data);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+inline void writeUInt32(unsigned char *data, uint32_t value)
+{
+#ifdef VISP_BIG_ENDIAN
+  value = vpEndian::swap32bits(value);
+#endif
+  memcpy(data, &value, sizeof(value));
+}
+
+inline void writeUInt64(unsigned char *data, uint64_t value)
+{
+  writeUInt32(data, static_cast<uint32_t>(value & 0xFFFFFFFFULL));
+  writeUInt32(data + 4, static_cast<uint32_t>(value >> 32));
+}
+
+inline void writeDouble(unsigned char *data, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  writeUInt64(data, bits);
+}
+
+//! Reverse the bytes of the elements of an array, to convert them between the native and little-endian orders
+inline void swapBytes(unsigned char *data, size_t size, size_t elemSize)
+{
+  for (size_t i = 0; (i + elemSize) <= size; i += elemSize) {
+    for (size_t j = 0; j < elemSize / 2; ++j) {
+      const unsigned char tmp = data[i + j];
+      data[i + j] = data[(i + elemSize) - 1 - j];
+      data[(i + elemSize) - 1 - j] = tmp;
+    }
+  }
+}
+} // namespace vpRecordingFormat
+END_VISP_NAMESPACE
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
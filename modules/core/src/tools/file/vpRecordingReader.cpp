@@ -0,0 +1,525 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reader of synchronized recordings of images, point clouds and poses.
+ */
+
+#include <algorithm>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpRecordingReader.h>
+
+#include "vpRecordingFormat.h"
+
+#if defined(VISP_HAVE_MINIZ) && defined(VISP_HAVE_WORKING_REGEX)
+// The implementation of miniz is compiled with the npy functions of vpIoTools
+#define MINIZ_HEADER_FILE_ONLY
+#include "basisu_miniz.h"
+#define VISP_RECORDING_HAVE_COMPRESSION
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+/*!
+ * Default constructor. Use open() to read a recording.
+ */
+vpRecordingReader::vpRecordingReader() : m_file(), m_streams() { }
+
+/*!
+ * Open a recording.
+ *
+ * \param filename : Name of the file written by vpRecordingWriter.
+ */
+vpRecordingReader::vpRecordingReader(const std::string &filename) : m_file(), m_streams() { open(filename); }
+
+/*!
+ * Destructor. The views returned by getView() are no longer valid.
+ */
+vpRecordingReader::~vpRecordingReader() { }
+
+/*!
+ * Close the recording. The views returned by getView() are no longer valid.
+ */
+void vpRecordingReader::close()
+{
+  m_file.close();
+  m_streams.clear();
+}
+
+/*!
+ * Return the id of the stream with the given name, or -1 if there is no such stream.
+ */
+int vpRecordingReader::findStream(const std::string &name) const
+{
+  for (size_t i = 0; i < m_streams.size(); ++i) {
+    if (m_streams[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/*!
+ * Return the id of the first stream of the given type, or -1 if there is no such stream.
+ */
+int vpRecordingReader::findStream(vpRecordingWriter::vpStreamType type) const
+{
+  for (size_t i = 0; i < m_streams.size(); ++i) {
+    if (m_streams[i].type == type) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/*!
+ * Return the index of the frame of a stream whose timestamp is the closest to the given one. This is used to find
+ * the frames of different streams acquired at the same time. The timestamps of the frames of the stream are
+ * supposed to increase.
+ *
+ * \param stream : Id of the stream.
+ * \param timestamp : Timestamp of the frame to find.
+ *
+ * \exception vpException::badValue If the stream is unknown or has no frame.
+ */
+unsigned int vpRecordingReader::getFrameIndex(unsigned int stream, double timestamp) const
+{
+  if (getNbFrames(stream) == 0) {
+    throw(vpException(vpException::badValue, "The stream %u has no frame", stream));
+  }
+  const std::vector<vpFrame> &frames = m_streams[stream].frames;
+  std::vector<vpFrame>::const_iterator it = std::lower_bound(
+    frames.begin(), frames.end(), timestamp, [](const vpFrame &frame, double t) { return frame.timestamp < t; });
+  if (it == frames.end()) {
+    return static_cast<unsigned int>(frames.size() - 1);
+  }
+  if ((it != frames.begin()) && ((timestamp - (it - 1)->timestamp) <= (it->timestamp - timestamp))) {
+    --it;
+  }
+  return static_cast<unsigned int>(it - frames.begin());
+}
+
+/*!
+ * Return the number of frames of a stream.
+ */
+unsigned int vpRecordingReader::getNbFrames(unsigned int stream) const
+{
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  return static_cast<unsigned int>(m_streams[stream].frames.size());
+}
+
+/*!
+ * Return the name of a stream.
+ */
+std::string vpRecordingReader::getStreamName(unsigned int stream) const
+{
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  return m_streams[stream].name;
+}
+
+/*!
+ * Return the type of the frames of a stream.
+ */
+vpRecordingWriter::vpStreamType vpRecordingReader::getStreamType(unsigned int stream) const
+{
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  return m_streams[stream].type;
+}
+
+/*!
+ * Return the timestamp of a frame.
+ */
+double vpRecordingReader::getTimestamp(unsigned int stream, unsigned int index) const
+{
+  if (index >= getNbFrames(stream)) {
+    throw(vpException(vpException::badValue, "Unknown frame %u of the stream %u", index, stream));
+  }
+  return m_streams[stream].frames[index].timestamp;
+}
+
+template <typename Type>
+bool vpRecordingReader::getImageView(unsigned int stream, unsigned int index, vpRecordingWriter::vpStreamType type,
+                                     vpImageView<const Type> &view) const
+{
+  const vpFrame &frame = getFrame(stream, index, type, sizeof(Type));
+#if defined(VISP_BIG_ENDIAN)
+  const bool inPlace = !frame.compressed && ((sizeof(Type) == 1) || (type == vpRecordingWriter::STREAM_RGBA));
+#else
+  const bool inPlace = !frame.compressed;
+#endif
+  if (!inPlace) {
+    view = vpImageView<const Type>();
+    return false;
+  }
+  // The payloads are aligned on 64 bytes in the file, that is aligned on a page
+  const Type *pixels = reinterpret_cast<const Type *>(m_file.data() + frame.offset);
+  view = vpImageView<const Type>(pixels, frame.height, frame.width);
+  return true;
+}
+
+template <typename Type>
+void vpRecordingReader::readImage(unsigned int stream, unsigned int index, vpRecordingWriter::vpStreamType type,
+                                  vpImage<Type> &I) const
+{
+  const vpFrame &frame = getFrame(stream, index, type, sizeof(Type));
+  const bool swap = (sizeof(Type) > 1) && (type != vpRecordingWriter::STREAM_RGBA);
+  I.resize(frame.height, frame.width);
+  readPayload(frame, sizeof(Type), swap, reinterpret_cast<unsigned char *>(I.bitmap));
+}
+
+/*!
+ * Get a read-only view on a grayscale image of a stream of type vpRecordingWriter::STREAM_GRAY, without copy.
+ *
+ * The view points to the pixels in the recording, that is mapped in memory read-only, and is valid until the reader
+ * is closed. When the frame is compressed, it cannot be accessed without copy: the view is emptied and the image
+ * should be read with read().
+ *
+ * \return true if `view` points to the pixels in the recording, false if the frame has to be read with read().
+ */
+bool vpRecordingReader::getView(unsigned int stream, unsigned int index, vpImageView<const unsigned char> &view) const
+{
+  return getImageView(stream, index, vpRecordingWriter::STREAM_GRAY, view);
+}
+
+/*!
+ * Get a read-only view on a color image of a stream of type vpRecordingWriter::STREAM_RGBA, without copy.
+ * See getView(unsigned int, unsigned int, vpImageView<const unsigned char> &) const.
+ */
+bool vpRecordingReader::getView(unsigned int stream, unsigned int index, vpImageView<const vpRGBa> &view) const
+{
+  return getImageView(stream, index, vpRecordingWriter::STREAM_RGBA, view);
+}
+
+/*!
+ * Get a read-only view on a 16-bit image of a stream of type vpRecordingWriter::STREAM_DEPTH, without copy.
+ * See getView(unsigned int, unsigned int, vpImageView<const unsigned char> &) const.
+ */
+bool vpRecordingReader::getView(unsigned int stream, unsigned int index, vpImageView<const uint16_t> &view) const
+{
+  return getImageView(stream, index, vpRecordingWriter::STREAM_DEPTH, view);
+}
+
+/*!
+ * Get a read-only view on a float image of a stream of type vpRecordingWriter::STREAM_FLOAT, without copy.
+ * See getView(unsigned int, unsigned int, vpImageView<const unsigned char> &) const.
+ */
+bool vpRecordingReader::getView(unsigned int stream, unsigned int index, vpImageView<const float> &view) const
+{
+  return getImageView(stream, index, vpRecordingWriter::STREAM_FLOAT, view);
+}
+
+/*!
+ * Return true if the frames of a stream are compressed.
+ */
+bool vpRecordingReader::isStreamCompressed(unsigned int stream) const
+{
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  return m_streams[stream].compressed;
+}
+
+/*!
+ * Open a recording. A recording previously opened is closed.
+ *
+ * \param filename : Name of the file written by vpRecordingWriter.
+ *
+ * \exception vpException::ioError If the file cannot be read or is not a recording.
+ */
+void vpRecordingReader::open(const std::string &filename)
+{
+  close();
+  m_file.open(filename);
+  const unsigned char *data = m_file.data();
+  const uint64_t size = m_file.size();
+  if ((size < vpRecordingFormat::headerSize) ||
+      (memcmp(data, vpRecordingFormat::fileMagic, sizeof(vpRecordingFormat::fileMagic)) != 0)) {
+    close();
+    throw(vpException(vpException::ioError, "%s is not a recording", filename.c_str()));
+  }
+  if (vpRecordingFormat::readUInt32(data + 8) != vpRecordingFormat::version) {
+    close();
+    throw(vpException(vpException::ioError, "Unsupported version of the recording %s", filename.c_str()));
+  }
+
+  // Use the index when the recording was closed, otherwise read the chunks one after the other
+  bool indexed = false;
+  const uint64_t endOffset = size - vpRecordingFormat::headerSize;
+  uint64_t next;
+  if ((size >= (3 * vpRecordingFormat::headerSize)) &&
+      (memcmp(data + endOffset, vpRecordingFormat::chunkMagic, sizeof(vpRecordingFormat::chunkMagic)) == 0) &&
+      (vpRecordingFormat::readUInt32(data + endOffset + 4) == vpRecordingFormat::chunkEnd)) {
+    const uint64_t indexOffset = vpRecordingFormat::readUInt64(data + endOffset + 24);
+    if (((indexOffset + vpRecordingFormat::headerSize) <= endOffset) &&
+        (vpRecordingFormat::readUInt32(data + indexOffset + 4) == vpRecordingFormat::chunkIndex)) {
+      const uint64_t nbChunks = vpRecordingFormat::readUInt64(data + indexOffset + 16) / 8;
+      if ((indexOffset + vpRecordingFormat::headerSize + (nbChunks * 8)) <= endOffset) {
+        indexed = true;
+        for (uint64_t i = 0; (i < nbChunks) && indexed; ++i) {
+          const uint64_t offset = vpRecordingFormat::readUInt64(data + indexOffset + vpRecordingFormat::headerSize +
+                                                                (i * 8));
+          indexed = (offset < indexOffset) && readChunk(offset, next);
+        }
+      }
+    }
+    if (!indexed) {
+      m_streams.clear();
+    }
+  }
+  if (!indexed) {
+    uint64_t offset = vpRecordingFormat::headerSize;
+    while (((offset + vpRecordingFormat::headerSize) <= size) && readChunk(offset, next)) {
+      offset = next;
+    }
+  }
+}
+
+/*!
+ * Read a grayscale image of a stream of type vpRecordingWriter::STREAM_GRAY or vpRecordingWriter::STREAM_RGBA.
+ * The color images are converted.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param I : Image to fill.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, vpImage<unsigned char> &I) const
+{
+  if (getStreamType(stream) == vpRecordingWriter::STREAM_RGBA) {
+    vpImage<vpRGBa> I_color;
+    readImage(stream, index, vpRecordingWriter::STREAM_RGBA, I_color);
+    vpImageConvert::convert(I_color, I);
+  }
+  else {
+    readImage(stream, index, vpRecordingWriter::STREAM_GRAY, I);
+  }
+}
+
+/*!
+ * Read a color image of a stream of type vpRecordingWriter::STREAM_RGBA or vpRecordingWriter::STREAM_GRAY.
+ * The grayscale images are converted.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param I : Image to fill.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, vpImage<vpRGBa> &I) const
+{
+  if (getStreamType(stream) == vpRecordingWriter::STREAM_GRAY) {
+    vpImage<unsigned char> I_gray;
+    readImage(stream, index, vpRecordingWriter::STREAM_GRAY, I_gray);
+    vpImageConvert::convert(I_gray, I);
+  }
+  else {
+    readImage(stream, index, vpRecordingWriter::STREAM_RGBA, I);
+  }
+}
+
+/*!
+ * Read a 16-bit image of a stream of type vpRecordingWriter::STREAM_DEPTH.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param I : Image to fill.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, vpImage<uint16_t> &I) const
+{
+  readImage(stream, index, vpRecordingWriter::STREAM_DEPTH, I);
+}
+
+/*!
+ * Read a float image of a stream of type vpRecordingWriter::STREAM_FLOAT.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param I : Image to fill.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, vpImage<float> &I) const
+{
+  readImage(stream, index, vpRecordingWriter::STREAM_FLOAT, I);
+}
+
+/*!
+ * Read a point cloud of a stream of type vpRecordingWriter::STREAM_POINT_CLOUD.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param pointcloud : Vector of 3D points X, Y, Z.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, std::vector<vpColVector> &pointcloud) const
+{
+  const vpFrame &frame = getFrame(stream, index, vpRecordingWriter::STREAM_POINT_CLOUD, 3 * sizeof(float));
+  std::vector<float> points(static_cast<size_t>(frame.width) * 3);
+  readPayload(frame, sizeof(float), true, reinterpret_cast<unsigned char *>(points.data()));
+  pointcloud.resize(frame.width);
+  for (size_t i = 0; i < pointcloud.size(); ++i) {
+    pointcloud[i].resize(3, false);
+    for (unsigned int j = 0; j < 3; ++j) {
+      pointcloud[i][j] = points[(i * 3) + j];
+    }
+  }
+}
+
+/*!
+ * Read a pose of a stream of type vpRecordingWriter::STREAM_POSE.
+ *
+ * \param stream : Id of the stream.
+ * \param index : Index of the frame in the stream.
+ * \param M : Pose.
+ */
+void vpRecordingReader::read(unsigned int stream, unsigned int index, vpHomogeneousMatrix &M) const
+{
+  const vpFrame &frame = getFrame(stream, index, vpRecordingWriter::STREAM_POSE, sizeof(double));
+  readPayload(frame, sizeof(double), true, reinterpret_cast<unsigned char *>(M.data));
+}
+
+const vpRecordingReader::vpFrame &vpRecordingReader::getFrame(unsigned int stream, unsigned int index,
+                                                              vpRecordingWriter::vpStreamType type,
+                                                              size_t elemSize) const
+{
+  if (index >= getNbFrames(stream)) {
+    throw(vpException(vpException::badValue, "Unknown frame %u of the stream %u", index, stream));
+  }
+  if (m_streams[stream].type != type) {
+    throw(vpException(vpException::badValue, "The type of the stream %s does not match the frame to read",
+                      m_streams[stream].name.c_str()));
+  }
+  const vpFrame &frame = m_streams[stream].frames[index];
+  if (frame.rawSize != (static_cast<uint64_t>(frame.width) * frame.height * elemSize)) {
+    throw(vpException(vpException::ioError, "Corrupted frame %u of the stream %s in the recording %s", index,
+                      m_streams[stream].name.c_str(), m_file.getFilename().c_str()));
+  }
+  return frame;
+}
+
+/*
+ * Read the header of the chunk at the given offset, and the offset of the next chunk. Return false if the chunk is
+ * not valid or truncated.
+ */
+bool vpRecordingReader::readChunk(uint64_t offset, uint64_t &next)
+{
+  const unsigned char *data = m_file.data();
+  const uint64_t size = m_file.size();
+  if (((offset + vpRecordingFormat::headerSize) > size) ||
+      (memcmp(data + offset, vpRecordingFormat::chunkMagic, sizeof(vpRecordingFormat::chunkMagic)) != 0)) {
+    return false;
+  }
+  const unsigned char *header = data + offset;
+  const uint32_t kind = vpRecordingFormat::readUInt32(header + 4);
+  const uint32_t stream = vpRecordingFormat::readUInt32(header + 8);
+  const uint32_t flags = vpRecordingFormat::readUInt32(header + 12);
+  const uint64_t payloadSize = vpRecordingFormat::readUInt64(header + 16);
+  const uint64_t payloadOffset = offset + vpRecordingFormat::headerSize;
+  if ((payloadSize > size) || ((payloadOffset + payloadSize) > size)) {
+    return false;
+  }
+  next = payloadOffset + vpRecordingFormat::alignSize(static_cast<size_t>(payloadSize));
+
+  if (kind == vpRecordingFormat::chunkStream) {
+    const uint32_t type = vpRecordingFormat::readUInt32(header + 40);
+    if ((stream != m_streams.size()) || (type > static_cast<uint32_t>(vpRecordingWriter::STREAM_POSE))) {
+      return false;
+    }
+    vpStream s;
+    s.name.assign(reinterpret_cast<const char *>(data + payloadOffset), static_cast<size_t>(payloadSize));
+    s.type = static_cast<vpRecordingWriter::vpStreamType>(type);
+    s.compressed = (flags & vpRecordingFormat::flagCompressed) != 0;
+    m_streams.push_back(s);
+  }
+  else if (kind == vpRecordingFormat::chunkFrame) {
+    if (stream >= m_streams.size()) {
+      return false;
+    }
+    vpFrame frame;
+    frame.offset = payloadOffset;
+    frame.size = payloadSize;
+    frame.rawSize = vpRecordingFormat::readUInt64(header + 24);
+    frame.timestamp = vpRecordingFormat::readDouble(header + 32);
+    frame.width = vpRecordingFormat::readUInt32(header + 40);
+    frame.height = vpRecordingFormat::readUInt32(header + 44);
+    frame.compressed = (flags & vpRecordingFormat::flagCompressed) != 0;
+    if (!frame.compressed && (frame.rawSize != frame.size)) {
+      return false;
+    }
+    m_streams[stream].frames.push_back(frame);
+  }
+  return true;
+}
+
+/*
+ * Copy the content of a frame, inflated if needed, in native byte order. When swap is false, the elements are
+ * arrays of bytes, e.g. vpRGBa, that are not swapped on big-endian platforms.
+ */
+void vpRecordingReader::readPayload(const vpFrame &frame, size_t elemSize, bool swap, unsigned char *data) const
+{
+  const unsigned char *payload = m_file.data() + frame.offset;
+  const size_t rawSize = static_cast<size_t>(frame.rawSize);
+  if (frame.compressed) {
+#if defined(VISP_RECORDING_HAVE_COMPRESSION)
+    std::vector<unsigned char> shuffled(rawSize);
+    buminiz::mz_ulong inflatedSize = static_cast<buminiz::mz_ulong>(rawSize);
+    if ((rawSize > 0) &&
+        ((buminiz::mz_uncompress(shuffled.data(), &inflatedSize, payload,
+                                 static_cast<buminiz::mz_ulong>(frame.size)) != buminiz::MZ_OK) ||
+         (inflatedSize != rawSize))) {
+      throw(vpException(vpException::ioError, "Corrupted compressed frame in the recording %s",
+                        m_file.getFilename().c_str()));
+    }
+    const size_t nbElements = rawSize / elemSize;
+    for (size_t i = 0; i < nbElements; ++i) {
+      for (size_t j = 0; j < elemSize; ++j) {
+        data[(i * elemSize) + j] = shuffled[(j * nbElements) + i];
+      }
+    }
+#else
+    throw(vpException(vpException::functionNotImplementedError,
+                      "Cannot read the compressed frames of %s, ViSP is built without miniz",
+                      m_file.getFilename().c_str()));
+#endif
+  }
+  else if (rawSize > 0) {
+    memcpy(data, payload, rawSize);
+  }
+#if defined(VISP_BIG_ENDIAN)
+  if (swap) {
+    vpRecordingFormat::swapBytes(data, rawSize, elemSize);
+  }
+#else
+  (void)swap;
+#endif
+}
+
+END_VISP_NAMESPACE
@@ -0,0 +1,371 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Writer of synchronized recordings of images, point clouds and poses.
+ */
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRecordingWriter.h>
+
+#include "vpRecordingFormat.h"
+
+#if defined(VISP_HAVE_MINIZ) && defined(VISP_HAVE_WORKING_REGEX)
+// The implementation of miniz is compiled with the npy functions of vpIoTools
+#define MINIZ_HEADER_FILE_ONLY
+#include "basisu_miniz.h"
+#define VISP_RECORDING_HAVE_COMPRESSION
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+/*!
+ * Default constructor. Use open() to create the file.
+ */
+vpRecordingWriter::vpRecordingWriter()
+  : m_file(), m_filename(), m_streams(), m_offsets(), m_offset(0), m_buffer(), m_compressed()
+{ }
+
+/*!
+ * Create a recording.
+ *
+ * \param filename : Name of the file, usually with the `.vprec` extension. An existing file is replaced.
+ */
+vpRecordingWriter::vpRecordingWriter(const std::string &filename)
+  : m_file(), m_filename(), m_streams(), m_offsets(), m_offset(0), m_buffer(), m_compressed()
+{
+  open(filename);
+}
+
+/*!
+ * Destructor, that closes the file.
+ */
+vpRecordingWriter::~vpRecordingWriter()
+{
+  try {
+    close();
+  }
+  catch (...) {
+    // The destructor should not throw
+  }
+}
+
+/*!
+ * Declare a new stream. The streams can be added at any time, also after frames of other streams were written.
+ *
+ * \param name : Name of the stream, e.g. "color" or "depth".
+ * \param type : Type of the frames of the stream.
+ * \param compressed : If true, the frames are compressed without loss. This is mainly useful for the depth images
+ * and the point clouds. A compressed stream cannot be read without copy.
+ *
+ * \return The id of the stream, to give to write().
+ *
+ * \exception vpException::ioError If no file is opened.
+ * \exception vpException::functionNotImplementedError If the compression is requested but ViSP was built without
+ * miniz.
+ */
+unsigned int vpRecordingWriter::addStream(const std::string &name, vpStreamType type, bool compressed)
+{
+  if (!isOpen()) {
+    throw(vpException(vpException::ioError, "The recording is not opened"));
+  }
+#if !defined(VISP_RECORDING_HAVE_COMPRESSION)
+  if (compressed) {
+    throw(vpException(vpException::functionNotImplementedError,
+                      "Cannot compress the stream %s, ViSP is built without miniz", name.c_str()));
+  }
+#endif
+  vpStream stream;
+  stream.type = type;
+  stream.compressed = compressed;
+  stream.nbFrames = 0;
+  m_streams.push_back(stream);
+
+  const unsigned int id = static_cast<unsigned int>(m_streams.size() - 1);
+  writeChunk(vpRecordingFormat::chunkStream, id, compressed ? vpRecordingFormat::flagCompressed : 0,
+             static_cast<uint32_t>(type), 0, 0., reinterpret_cast<const unsigned char *>(name.c_str()), name.size(),
+             name.size());
+  return id;
+}
+
+/*!
+ * Write the index of the frames and close the file. Nothing is done if no file is opened.
+ */
+void vpRecordingWriter::close()
+{
+  if (!isOpen()) {
+    return;
+  }
+
+  const uint64_t indexOffset = m_offset;
+  m_buffer.resize(m_offsets.size() * 8);
+  for (size_t i = 0; i < m_offsets.size(); ++i) {
+    vpRecordingFormat::writeUInt64(&m_buffer[i * 8], m_offsets[i]);
+  }
+  writeChunk(vpRecordingFormat::chunkIndex, 0, 0, 0, 0, 0., m_buffer.empty() ? nullptr : &m_buffer[0],
+             m_buffer.size(), m_buffer.size());
+  writeChunk(vpRecordingFormat::chunkEnd, 0, 0, 0, 0, 0., nullptr, 0, indexOffset);
+
+  m_file.close();
+  m_streams.clear();
+  m_offsets.clear();
+  m_buffer.clear();
+  m_compressed.clear();
+  m_offset = 0;
+}
+
+/*!
+ * Return the number of frames written in a stream.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ */
+unsigned int vpRecordingWriter::getNbFrames(unsigned int stream) const
+{
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  return m_streams[stream].nbFrames;
+}
+
+/*!
+ * Create a new recording. A recording previously opened is closed.
+ *
+ * \param filename : Name of the file, usually with the `.vprec` extension. An existing file is replaced.
+ *
+ * \exception vpException::ioError If the file cannot be created.
+ */
+void vpRecordingWriter::open(const std::string &filename)
+{
+  close();
+
+  const std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty() && !vpIoTools::checkDirectory(parent)) {
+    vpIoTools::makeDirectory(parent);
+  }
+  m_file.open(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+  if (!m_file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the recording %s", filename.c_str()));
+  }
+  m_filename = filename;
+
+  unsigned char header[vpRecordingFormat::headerSize] = { 0 };
+  memcpy(header, vpRecordingFormat::fileMagic, sizeof(vpRecordingFormat::fileMagic));
+  vpRecordingFormat::writeUInt32(header + 8, vpRecordingFormat::version);
+  m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  m_offset = sizeof(header);
+}
+
+/*!
+ * Append a grayscale image to a stream of type STREAM_GRAY.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image, e.g. in seconds. The timestamps of the frames of a stream should
+ * increase, to search the frames by timestamp with vpRecordingReader::getFrameIndex().
+ */
+void vpRecordingWriter::write(unsigned int stream, const vpImage<unsigned char> &I, double timestamp)
+{
+  checkStream(stream, STREAM_GRAY);
+  writeFrame(stream, I.getWidth(), I.getHeight(), timestamp, reinterpret_cast<const unsigned char *>(I.bitmap),
+             I.getSize(), 1);
+}
+
+/*!
+ * Append a color image to a stream of type STREAM_RGBA.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image.
+ */
+void vpRecordingWriter::write(unsigned int stream, const vpImage<vpRGBa> &I, double timestamp)
+{
+  checkStream(stream, STREAM_RGBA);
+  // The channels are bytes, grouped by channel when compressed
+  writeFrame(stream, I.getWidth(), I.getHeight(), timestamp, reinterpret_cast<const unsigned char *>(I.bitmap),
+             I.getSize() * sizeof(vpRGBa), sizeof(vpRGBa));
+}
+
+/*!
+ * Append a 16-bit image to a stream of type STREAM_DEPTH.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image.
+ */
+void vpRecordingWriter::write(unsigned int stream, const vpImage<uint16_t> &I, double timestamp)
+{
+  checkStream(stream, STREAM_DEPTH);
+  writeFrame(stream, I.getWidth(), I.getHeight(), timestamp, reinterpret_cast<const unsigned char *>(I.bitmap),
+             I.getSize() * sizeof(uint16_t), sizeof(uint16_t));
+}
+
+/*!
+ * Append a float image to a stream of type STREAM_FLOAT.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image.
+ */
+void vpRecordingWriter::write(unsigned int stream, const vpImage<float> &I, double timestamp)
+{
+  checkStream(stream, STREAM_FLOAT);
+  writeFrame(stream, I.getWidth(), I.getHeight(), timestamp, reinterpret_cast<const unsigned char *>(I.bitmap),
+             I.getSize() * sizeof(float), sizeof(float));
+}
+
+/*!
+ * Append a point cloud to a stream of type STREAM_POINT_CLOUD. The coordinates are stored in single precision.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param pointcloud : Points with at least 3 coordinates X, Y, Z. Other coordinates are not stored.
+ * \param timestamp : Timestamp of the point cloud.
+ */
+void vpRecordingWriter::write(unsigned int stream, const std::vector<vpColVector> &pointcloud, double timestamp)
+{
+  checkStream(stream, STREAM_POINT_CLOUD);
+  std::vector<float> points(pointcloud.size() * 3);
+  for (size_t i = 0; i < pointcloud.size(); ++i) {
+    if (pointcloud[i].size() < 3) {
+      throw(vpException(vpException::dimensionError, "The point %u of the point cloud has less than 3 coordinates",
+                        static_cast<unsigned int>(i)));
+    }
+    for (unsigned int j = 0; j < 3; ++j) {
+      points[(i * 3) + j] = static_cast<float>(pointcloud[i][j]);
+    }
+  }
+  writeFrame(stream, static_cast<unsigned int>(pointcloud.size()), 1, timestamp,
+             reinterpret_cast<const unsigned char *>(points.data()), points.size() * sizeof(float), sizeof(float));
+}
+
+/*!
+ * Append a pose to a stream of type STREAM_POSE.
+ *
+ * \param stream : Id of the stream returned by addStream().
+ * \param M : Pose to write.
+ * \param timestamp : Timestamp of the pose.
+ */
+void vpRecordingWriter::write(unsigned int stream, const vpHomogeneousMatrix &M, double timestamp)
+{
+  checkStream(stream, STREAM_POSE);
+  writeFrame(stream, 4, 4, timestamp, reinterpret_cast<const unsigned char *>(M.data), 16 * sizeof(double),
+             sizeof(double));
+}
+
+void vpRecordingWriter::checkStream(unsigned int stream, vpStreamType type) const
+{
+  if (!isOpen()) {
+    throw(vpException(vpException::ioError, "The recording is not opened"));
+  }
+  if (stream >= m_streams.size()) {
+    throw(vpException(vpException::badValue, "Unknown stream %u", stream));
+  }
+  if (m_streams[stream].type != type) {
+    throw(vpException(vpException::badValue, "The frame does not match the type of the stream %u", stream));
+  }
+}
+
+void vpRecordingWriter::writeChunk(uint32_t kind, uint32_t stream, uint32_t flags, uint32_t width, uint32_t height,
+                                   double timestamp, const unsigned char *payload, uint64_t payloadSize,
+                                   uint64_t rawSize)
+{
+  if ((kind != vpRecordingFormat::chunkIndex) && (kind != vpRecordingFormat::chunkEnd)) {
+    m_offsets.push_back(m_offset);
+  }
+
+  unsigned char header[vpRecordingFormat::headerSize] = { 0 };
+  memcpy(header, vpRecordingFormat::chunkMagic, sizeof(vpRecordingFormat::chunkMagic));
+  vpRecordingFormat::writeUInt32(header + 4, kind);
+  vpRecordingFormat::writeUInt32(header + 8, stream);
+  vpRecordingFormat::writeUInt32(header + 12, flags);
+  vpRecordingFormat::writeUInt64(header + 16, payloadSize);
+  vpRecordingFormat::writeUInt64(header + 24, rawSize);
+  vpRecordingFormat::writeDouble(header + 32, timestamp);
+  vpRecordingFormat::writeUInt32(header + 40, width);
+  vpRecordingFormat::writeUInt32(header + 44, height);
+  m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+  if (payloadSize > 0) {
+    m_file.write(reinterpret_cast<const char *>(payload), static_cast<std::streamsize>(payloadSize));
+  }
+  const size_t paddedSize = vpRecordingFormat::alignSize(static_cast<size_t>(payloadSize));
+  const char padding[vpRecordingFormat::alignment] = { 0 };
+  m_file.write(padding, static_cast<std::streamsize>(paddedSize - payloadSize));
+  if (!m_file.good()) {
+    throw(vpException(vpException::ioError, "Cannot write in the recording %s", m_filename.c_str()));
+  }
+  m_offset += sizeof(header) + paddedSize;
+}
+
+/*
+ * Write a frame, stored in little-endian order and, for a compressed stream, with the bytes of its elements grouped
+ * by significance before being deflated, which gives smaller files for images where neighbor pixels are close.
+ */
+void vpRecordingWriter::writeFrame(unsigned int stream, unsigned int width, unsigned int height, double timestamp,
+                                   const unsigned char *data, size_t size, size_t elemSize)
+{
+  const unsigned char *payload = data;
+  size_t payloadSize = size;
+  uint32_t flags = 0;
+#if defined(VISP_BIG_ENDIAN)
+  if ((elemSize > 1) && (m_streams[stream].type != STREAM_RGBA)) {
+    m_buffer.assign(data, data + size);
+    vpRecordingFormat::swapBytes(m_buffer.data(), size, elemSize);
+    payload = m_buffer.data();
+  }
+#endif
+
+#if defined(VISP_RECORDING_HAVE_COMPRESSION)
+  if (m_streams[stream].compressed && (size > 0)) {
+    std::vector<unsigned char> shuffled(size);
+    const size_t nbElements = size / elemSize;
+    for (size_t i = 0; i < nbElements; ++i) {
+      for (size_t j = 0; j < elemSize; ++j) {
+        shuffled[(j * nbElements) + i] = payload[(i * elemSize) + j];
+      }
+    }
+    buminiz::mz_ulong compressedSize = buminiz::mz_compressBound(static_cast<buminiz::mz_ulong>(size));
+    m_compressed.resize(compressedSize);
+    if (buminiz::mz_compress2(m_compressed.data(), &compressedSize, shuffled.data(),
+                              static_cast<buminiz::mz_ulong>(size), buminiz::MZ_BEST_SPEED) != buminiz::MZ_OK) {
+      throw(vpException(vpException::ioError, "Cannot compress a frame of the stream %u", stream));
+    }
+    payload = m_compressed.data();
+    payloadSize = compressedSize;
+    flags = vpRecordingFormat::flagCompressed;
+  }
+#else
+  (void)elemSize;
+#endif
+
+  writeChunk(vpRecordingFormat::chunkFrame, stream, flags, width, height, timestamp, payload, payloadSize, size);
+  ++m_streams[stream].nbFrames;
+}
+
+END_VISP_NAMESPACE
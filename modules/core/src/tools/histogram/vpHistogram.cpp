@@ -356,7 +356,7 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
   else {
 #if defined(VISP_HAVE_THREADS)
     // Multi-threads
-    std::vector<std::thread *> threadpool;
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
     std::vector<vpHistogram_Param_t *> histogramParams;
 
     unsigned int image_size = I.getSize();
@@ -379,15 +379,12 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
 
       histogramParams.push_back(histogram_param);
 
-      // Start the threads
-      std::thread *histogram_thread = new std::thread(&computeHistogramThread, histogram_param);
-      threadpool.push_back(histogram_thread);
+      // Start the tasks
+      group.run(std::bind(&computeHistogramThread, histogram_param));
     }
 
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
+    // Wait until the tasks end up
+    group.wait();
 
     m_total = 0;
     for (unsigned int cpt1 = 0; cpt1 < m_size; ++cpt1) {
@@ -402,10 +399,6 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
     }
 
     // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); ++cpt) {
-      delete threadpool[cpt];
-    }
-
     for (size_t cpt = 0; cpt < histogramParams.size(); ++cpt) {
       delete histogramParams[cpt];
     }
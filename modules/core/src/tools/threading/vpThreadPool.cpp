@@ -0,0 +1,493 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide work-stealing thread pool.
+ */
+
+#include <visp3/core/vpThreadPool.h>
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+
+#if defined(VISP_HAVE_THREADS)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#include <pthread.h>
+#include <sched.h>
+#define VP_THREAD_POOL_HAVE_AFFINITY
+#endif
+#endif
+
+BEGIN_VISP_NAMESPACE
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#if defined(VISP_HAVE_THREADS)
+namespace
+{
+// Pool and queue index of the calling thread when it is a worker, so that the tasks it submits go in its own queue
+thread_local const void *g_currentPool = nullptr;
+thread_local size_t g_currentQueue = 0;
+}
+
+class vpThreadPool::Impl
+{
+public:
+  struct vpQueue
+  {
+    std::mutex m_mutex;
+    std::deque<vpThreadPool::vpTask> m_tasks;
+  };
+
+  Impl() : m_queues(), m_workers(), m_cpus(), m_pending(0), m_stop(false), m_nbThreads(1) { }
+
+  ~Impl() { stop(); }
+
+  void start(unsigned int nbThreads)
+  {
+    m_nbThreads = nbThreads;
+    m_stop = false;
+    // One queue per worker, the last one being shared by the threads that are not workers
+    m_queues.resize(nbThreads);
+    for (size_t i = 0; i < m_queues.size(); ++i) {
+      m_queues[i] = new vpQueue();
+    }
+    for (unsigned int i = 0; i + 1 < nbThreads; ++i) {
+      m_workers.push_back(new std::thread(&Impl::workerLoop, this, static_cast<size_t>(i)));
+    }
+    applyAffinity();
+  }
+
+  void stop()
+  {
+    // Tasks that are still pending are executed before the workers are stopped
+    while (runPendingTask()) { }
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      m_workers[i]->join();
+      delete m_workers[i];
+    }
+    m_workers.clear();
+    for (size_t i = 0; i < m_queues.size(); ++i) {
+      delete m_queues[i];
+    }
+    m_queues.clear();
+  }
+
+  void applyAffinity()
+  {
+#if defined(VP_THREAD_POOL_HAVE_AFFINITY)
+    if (m_cpus.empty()) {
+      return;
+    }
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(m_cpus[i % m_cpus.size()], &cpuset);
+      pthread_setaffinity_np(m_workers[i]->native_handle(), sizeof(cpu_set_t), &cpuset);
+    }
+#endif
+  }
+
+  void submit(const vpThreadPool::vpTask &task)
+  {
+    size_t index = (g_currentPool == this) ? g_currentQueue : (m_queues.size() - 1);
+    {
+      std::lock_guard<std::mutex> lock(m_queues[index]->m_mutex);
+      m_queues[index]->m_tasks.push_back(task);
+    }
+    {
+      // Incremented under the lock so that a worker cannot miss the wake up between its check and its wait
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      ++m_pending;
+    }
+    m_cv.notify_one();
+  }
+
+  bool popTask(vpThreadPool::vpTask &task)
+  {
+    const size_t nbQueues = m_queues.size();
+    const bool isWorker = (g_currentPool == this);
+    const size_t first = isWorker ? g_currentQueue : (nbQueues - 1);
+    if (m_pending.load() == 0) {
+      return false;
+    }
+    for (size_t k = 0; k < nbQueues; ++k) {
+      vpQueue &queue = *m_queues[(first + k) % nbQueues];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (queue.m_tasks.empty()) {
+        continue;
+      }
+      // Newest task of the own queue for cache locality, oldest task of the other queues since it is the largest one
+      if ((k == 0) && isWorker) {
+        task = queue.m_tasks.back();
+        queue.m_tasks.pop_back();
+      }
+      else {
+        task = queue.m_tasks.front();
+        queue.m_tasks.pop_front();
+      }
+      --m_pending;
+      return true;
+    }
+    return false;
+  }
+
+  bool runPendingTask()
+  {
+    vpThreadPool::vpTask task;
+    if (!popTask(task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  void workerLoop(size_t index)
+  {
+    g_currentPool = this;
+    g_currentQueue = index;
+    for (;;) {
+      if (runPendingTask()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_sleepMutex);
+      m_cv.wait(lock, [this]() { return m_stop || (m_pending.load() > 0); });
+      if (m_stop && (m_pending.load() == 0)) {
+        return;
+      }
+    }
+  }
+
+  std::vector<vpQueue *> m_queues;
+  std::vector<std::thread *> m_workers;
+  std::vector<unsigned int> m_cpus;
+  std::mutex m_sleepMutex;
+  std::condition_variable m_cv;
+  std::atomic<size_t> m_pending; //!< Number of tasks in the queues
+  bool m_stop;
+  unsigned int m_nbThreads;
+};
+
+class vpThreadPool::vpTaskGroup::Impl
+{
+public:
+  Impl() : m_count(0), m_error() { }
+
+  void done()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_count;
+    if (m_count == 0) {
+      // Notified under the lock, the group may be destroyed as soon as the lock is released
+      m_cv.notify_all();
+    }
+  }
+
+  void setError(const std::exception_ptr &error)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error) {
+      m_error = error;
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  unsigned int m_count;
+  std::exception_ptr m_error;
+};
+#else
+class vpThreadPool::Impl
+{
+public:
+  Impl() : m_tasks(), m_cpus(), m_nbThreads(1) { }
+
+  bool runPendingTask()
+  {
+    if (m_tasks.empty()) {
+      return false;
+    }
+    vpThreadPool::vpTask task = m_tasks.front();
+    m_tasks.pop_front();
+    task();
+    return true;
+  }
+
+  std::deque<vpThreadPool::vpTask> m_tasks;
+  std::vector<unsigned int> m_cpus;
+  unsigned int m_nbThreads;
+};
+
+class vpThreadPool::vpTaskGroup::Impl
+{
+public:
+  Impl() : m_count(0), m_error() { }
+
+  void done() { --m_count; }
+
+  void setError(const std::exception_ptr &error)
+  {
+    if (!m_error) {
+      m_error = error;
+    }
+  }
+
+  unsigned int m_count;
+  std::exception_ptr m_error;
+};
+#endif
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Create a task group whose tasks are executed by \e pool.
+ */
+vpThreadPool::vpTaskGroup::vpTaskGroup(vpThreadPool &pool) : m_pool(pool), m_impl(new Impl()) { }
+
+/*!
+ * Wait for the pending tasks of the group. The exception thrown by a task, if any, is ignored.
+ */
+vpThreadPool::vpTaskGroup::~vpTaskGroup()
+{
+  try {
+    wait();
+  }
+  catch (...) {
+  }
+  delete m_impl;
+}
+
+/*!
+ * Submit a task to the pool. The task may be executed by any thread of the pool, or by the thread calling wait().
+ */
+void vpThreadPool::vpTaskGroup::run(const vpTask &task)
+{
+#if defined(VISP_HAVE_THREADS)
+  {
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    ++m_impl->m_count;
+  }
+#else
+  ++m_impl->m_count;
+#endif
+  Impl *group = m_impl;
+  m_pool.submit([task, group]() {
+    try {
+      task();
+    }
+    catch (...) {
+      group->setError(std::current_exception());
+    }
+    group->done();
+  });
+}
+
+/*!
+ * Wait for the end of all the tasks of the group. While waiting, the calling thread executes the pending tasks of the
+ * pool.
+ *
+ * The first exception thrown by a task of the group is rethrown, once all the tasks are done.
+ */
+void vpThreadPool::vpTaskGroup::wait()
+{
+#if defined(VISP_HAVE_THREADS)
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_impl->m_mutex);
+      if (m_impl->m_count == 0) {
+        break;
+      }
+    }
+    if (!m_pool.runPendingTask()) {
+      // The remaining tasks are being executed by other threads
+      std::unique_lock<std::mutex> lock(m_impl->m_mutex);
+      m_impl->m_cv.wait_for(lock, std::chrono::microseconds(100), [this]() { return m_impl->m_count == 0; });
+    }
+  }
+#else
+  while ((m_impl->m_count > 0) && m_pool.runPendingTask()) { }
+#endif
+
+  if (m_impl->m_error) {
+    std::exception_ptr error = m_impl->m_error;
+    m_impl->m_error = std::exception_ptr();
+    std::rethrow_exception(error);
+  }
+}
+
+/*!
+ * Create a thread pool.
+ *
+ * \param[in] nbThreads : Number of threads, including the thread that waits for the tasks. When 0, the number of
+ * hardware threads is used.
+ */
+vpThreadPool::vpThreadPool(unsigned int nbThreads) : m_impl(new Impl())
+{
+#if defined(VISP_HAVE_THREADS)
+  m_impl->start(nbThreads == 0 ? getHardwareConcurrency() : nbThreads);
+#else
+  (void)nbThreads;
+#endif
+}
+
+/*!
+ * Execute the pending tasks and stop the worker threads.
+ */
+vpThreadPool::~vpThreadPool() { delete m_impl; }
+
+/*!
+ * Get the pool shared by the whole process, with as many threads as hardware threads.
+ *
+ * As vpImagePool, the pool is intentionally never destroyed, so that it can still be used by objects with static
+ * storage duration destroyed at program exit.
+ */
+vpThreadPool &vpThreadPool::getInstance()
+{
+  static vpThreadPool *instance = new vpThreadPool();
+  return *instance;
+}
+
+/*!
+ * Get the CPUs the worker threads are pinned to, set with setCpuAffinity().
+ */
+std::vector<unsigned int> vpThreadPool::getCpuAffinity() const { return m_impl->m_cpus; }
+
+/*!
+ * Number of hardware threads, 1 when it cannot be determined or when ViSP is built without thread support.
+ */
+unsigned int vpThreadPool::getHardwareConcurrency()
+{
+#if defined(VISP_HAVE_THREADS)
+  unsigned int nbThreads = std::thread::hardware_concurrency();
+  return nbThreads == 0 ? 1 : nbThreads;
+#else
+  return 1;
+#endif
+}
+
+/*!
+ * Number of threads of the pool, including the thread that waits for the tasks.
+ */
+unsigned int vpThreadPool::getNbThreads() const { return m_impl->m_nbThreads; }
+
+/*!
+ * Execute \e func on sub-ranges of [\e begin, \e end[ in parallel, and wait for their end.
+ *
+ * The range is split in chunks of \e grainSize indices, the first chunk being executed by the calling thread. The
+ * first exception thrown by \e func is rethrown once all the chunks are done.
+ *
+ * \param[in] begin : First index of the range.
+ * \param[in] end : Index past the last index of the range.
+ * \param[in] func : Function called with the bounds [begin, end[ of each chunk.
+ * \param[in] grainSize : Minimal number of indices of a chunk. When 0, the range is split in 4 chunks per thread to
+ * balance the load.
+ */
+void vpThreadPool::parallelFor(unsigned int begin, unsigned int end, const vpRangeTask &func, unsigned int grainSize)
+{
+  if (end <= begin) {
+    return;
+  }
+  const unsigned int size = end - begin;
+  const unsigned int nbThreads = getNbThreads();
+  if (grainSize == 0) {
+    grainSize = std::max<unsigned int>(1, size / (4 * nbThreads));
+  }
+  if ((nbThreads == 1) || (size <= grainSize)) {
+    func(begin, end);
+    return;
+  }
+
+  vpTaskGroup group(*this);
+  for (unsigned int chunkBegin = begin + grainSize; chunkBegin < end; chunkBegin += std::min<unsigned int>(grainSize, end - chunkBegin)) {
+    const unsigned int chunkEnd = chunkBegin + std::min<unsigned int>(grainSize, end - chunkBegin);
+    group.run([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); });
+  }
+  func(begin, begin + grainSize);
+  group.wait();
+}
+
+/*!
+ * Pin the worker threads to the given CPUs, the worker \e i being pinned to the CPU \e cpus[i % cpus.size()]. The
+ * thread waiting for the tasks is not pinned.
+ *
+ * The affinity is only applied on Linux with the GNU C library, and is stored without effect on the other platforms.
+ * An empty list keeps the current affinity of the workers.
+ *
+ * \param[in] cpus : Indexes of the CPUs.
+ */
+void vpThreadPool::setCpuAffinity(const std::vector<unsigned int> &cpus)
+{
+  m_impl->m_cpus = cpus;
+#if defined(VISP_HAVE_THREADS)
+  m_impl->applyAffinity();
+#endif
+}
+
+/*!
+ * Change the number of threads of the pool. The pending tasks are executed before the workers are stopped, and this
+ * function must not be called while tasks are running.
+ *
+ * \param[in] nbThreads : Number of threads, including the thread that waits for the tasks. When 0, the number of
+ * hardware threads is used.
+ */
+void vpThreadPool::setNbThreads(unsigned int nbThreads)
+{
+#if defined(VISP_HAVE_THREADS)
+  if (nbThreads == 0) {
+    nbThreads = getHardwareConcurrency();
+  }
+  if (nbThreads != m_impl->m_nbThreads) {
+    m_impl->stop();
+    m_impl->start(nbThreads);
+  }
+#else
+  (void)nbThreads;
+#endif
+}
+
+bool vpThreadPool::runPendingTask() { return m_impl->runPendingTask(); }
+
+#if defined(VISP_HAVE_THREADS)
+void vpThreadPool::submit(const vpTask &task) { m_impl->submit(task); }
+#else
+void vpThreadPool::submit(const vpTask &task) { m_impl->m_tasks.push_back(task); }
+#endif
+
+END_VISP_NAMESPACE
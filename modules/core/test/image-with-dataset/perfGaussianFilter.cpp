@@ -120,6 +120,21 @@ TEST_CASE("vpImageFilter::gaussianBlur", "[benchmark]")
     };
   }
 
+  SECTION("unsigned char to float")
+  {
+    vpImage<unsigned char> I;
+    vpImageIo::read(I, imagePath);
+
+    vpImage<float> I_blur;
+    const unsigned int kernelSize = 7;
+    const float sigma = 5.0f;
+    BENCHMARK("Benchmark vpImageFilter::gaussianBlur uchar to float")
+    {
+      vpImageFilter::gaussianBlur(I, I_blur, kernelSize, sigma);
+      return I_blur;
+    };
+  }
+
   SECTION("vpRGBa")
   {
     vpImage<vpRGBa> I, I_blur;
@@ -0,0 +1,120 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tile-parallel Canny edge detection.
+ */
+
+/*!
+  \example catchCannyEdgeDetection.cpp
+
+  \brief Check that the Canny edge detection gives the same result whatever the number of threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpCannyEdgeDetection.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Discs and rings of various contrasts over a textured background, so that weak edges cross the tiles
+void createImage(vpImage<unsigned char> &I)
+{
+  I.resize(211, 317);
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      double value = 60. + (0.2 * j) + (((i * 13 + j * 7) % 17) * 1.5);
+      for (int k = 0; k < 6; ++k) {
+        const double ci = 30. + (k * 37) % 160, cj = 40. + (k * 71) % 250, radius = 12. + 9. * k;
+        const double d = std::sqrt((i - ci) * (i - ci) + (j - cj) * (j - cj));
+        if ((d < radius) && ((k % 2 == 0) || (d > radius - 6.))) {
+          value += 12. + 8. * k;
+        }
+      }
+      I[i][j] = static_cast<unsigned char>(std::min(255., value));
+    }
+  }
+}
+
+void detect(const vpImage<unsigned char> &I, int nbThread, vpImage<unsigned char> &edgeMap,
+            std::vector<vpImagePoint> &edgePoints)
+{
+  vpCannyEdgeDetection detector(5, 1.f, 3, -1.f, -1.f, 0.6f, 0.8f, vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING, true,
+                                nbThread);
+  edgeMap = detector.detect(I);
+  edgePoints = detector.getEdgePointsList();
+}
+}
+
+TEST_CASE("Canny edge detection", "[canny]")
+{
+  vpImage<unsigned char> I;
+  createImage(I);
+
+  vpImage<unsigned char> edgeMap_ref;
+  std::vector<vpImagePoint> edgePoints_ref;
+  detect(I, 1, edgeMap_ref, edgePoints_ref);
+
+  unsigned int nbEdgePoints = 0;
+  for (unsigned int i = 0; i < edgeMap_ref.getSize(); ++i) {
+    nbEdgePoints += (edgeMap_ref.bitmap[i] == 255) ? 1 : 0;
+  }
+  CHECK(nbEdgePoints > 500);
+  CHECK(edgePoints_ref.size() == nbEdgePoints);
+
+#ifdef VISP_HAVE_OPENMP
+  const int nbThreads[] = { 2, 3, 4, 7 };
+  for (size_t k = 0; k < sizeof(nbThreads) / sizeof(nbThreads[0]); ++k) {
+    INFO("Number of threads: " << nbThreads[k]);
+    vpImage<unsigned char> edgeMap;
+    std::vector<vpImagePoint> edgePoints;
+    detect(I, nbThreads[k], edgeMap, edgePoints);
+    CHECK((edgeMap == edgeMap_ref));
+    CHECK((edgePoints == edgePoints_ref));
+  }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
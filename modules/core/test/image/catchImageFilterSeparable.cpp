@@ -0,0 +1,192 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the vectorized separable filters.
+ */
+
+/*!
+  \example catchImageFilterSeparable.cpp
+
+  \brief Compare the vectorized separable filters of vpImageFilter with a naive implementation.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpMath.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+template <typename Type> void fill(vpImage<Type> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = static_cast<Type>((i * 31 + j * 17 + ((i * j) % 13)) % 256);
+    }
+  }
+}
+
+unsigned int mirror(int k, unsigned int n)
+{
+  if (k < 0) {
+    return static_cast<unsigned int>(-k);
+  }
+  if (k >= static_cast<int>(n)) {
+    return (2 * n) - static_cast<unsigned int>(k) - 1;
+  }
+  return static_cast<unsigned int>(k);
+}
+
+// Reference implementation, with the borders mirrored as vpImageFilter does
+template <typename ImageType, typename FilterType>
+void naiveFilter(const vpImage<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter, unsigned int size,
+                 bool horizontal)
+{
+  const int stop = static_cast<int>((size - 1) / 2);
+  GI.resize(I.getHeight(), I.getWidth());
+  for (int i = 0; i < static_cast<int>(I.getHeight()); ++i) {
+    for (int j = 0; j < static_cast<int>(I.getWidth()); ++j) {
+      FilterType res = filter[0] * static_cast<FilterType>(I[i][j]);
+      for (int k = 1; k <= stop; ++k) {
+        if (horizontal) {
+          res += filter[k] * static_cast<FilterType>(I[i][mirror(j + k, I.getWidth())] + I[i][mirror(j - k, I.getWidth())]);
+        }
+        else {
+          res += filter[k] * static_cast<FilterType>(I[mirror(i + k, I.getHeight())][j] + I[mirror(i - k, I.getHeight())][j]);
+        }
+      }
+      GI[i][j] = res;
+    }
+  }
+}
+
+template <typename FilterType>
+bool isEqual(const vpImage<FilterType> &I1, const vpImage<FilterType> &I2, const vpImage<bool> *p_mask = nullptr)
+{
+  if ((I1.getHeight() != I2.getHeight()) || (I1.getWidth() != I2.getWidth())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    FilterType ref = ((p_mask == nullptr) || p_mask->bitmap[i]) ? I2.bitmap[i] : 0;
+    if (!vpMath::equal(I1.bitmap[i], ref, std::numeric_limits<FilterType>::epsilon() * 256)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ImageType, typename FilterType> void checkFilters(unsigned int height, unsigned int width)
+{
+  vpImage<ImageType> I(height, width);
+  fill(I);
+  for (unsigned int size = 1; size <= 9; size += 2) {
+    // The default standard deviation of a kernel of size 1 is 0
+    FilterType kernel[5] = { 1 };
+    if (size > 1) {
+      vpImageFilter::getGaussianKernel(kernel, size, static_cast<FilterType>(0.), true);
+    }
+
+    vpImage<FilterType> dIx, dIx_ref, dIy, dIy_ref, GI, GI_ref;
+    vpImageFilter::filterX(I, dIx, kernel, size);
+    naiveFilter(I, dIx_ref, kernel, size, true);
+    CHECK(isEqual(dIx, dIx_ref));
+
+    vpImageFilter::filterY(I, dIy, kernel, size);
+    naiveFilter(I, dIy_ref, kernel, size, false);
+    CHECK(isEqual(dIy, dIy_ref));
+
+    vpImageFilter::filter(I, GI, kernel, size);
+    naiveFilter(dIx_ref, GI_ref, kernel, size, false);
+    CHECK(isEqual(GI, GI_ref));
+
+    vpImage<bool> mask(height, width, true);
+    for (unsigned int i = 0; i < height; ++i) {
+      mask[i][(i * 7) % width] = false;
+    }
+    vpImage<FilterType> dIx_mask_ref = dIx_ref;
+    for (unsigned int i = 0; i < mask.getSize(); ++i) {
+      if (!mask.bitmap[i]) {
+        dIx_mask_ref.bitmap[i] = 0;
+      }
+    }
+    vpImage<FilterType> GI_mask, GI_mask_ref;
+    vpImageFilter::filter(I, GI_mask, kernel, size, &mask);
+    naiveFilter(dIx_mask_ref, GI_mask_ref, kernel, size, false);
+    CHECK(isEqual(GI_mask, GI_mask_ref, &mask));
+  }
+}
+}
+
+TEST_CASE("Separable filters", "[image_filter]")
+{
+  // Odd sizes to exercise the scalar remainder of the SIMD loops
+  const unsigned int height = 67, width = 83;
+
+  SECTION("unsigned char to float") { checkFilters<unsigned char, float>(height, width); }
+  SECTION("unsigned char to double") { checkFilters<unsigned char, double>(height, width); }
+  SECTION("float to float") { checkFilters<float, float>(height, width); }
+  SECTION("double to double") { checkFilters<double, double>(height, width); }
+  SECTION("Image as small as the kernel") { checkFilters<unsigned char, float>(9, 9); }
+}
+
+TEST_CASE("Gaussian blur", "[image_filter]")
+{
+  vpImage<unsigned char> I(240, 321);
+  fill(I);
+
+  // The image view goes through the generic implementation
+  vpImage<float> I_blur, I_blur_ref;
+  vpImageFilter::gaussianBlur(I, I_blur, 7);
+  vpImageFilter::gaussianBlur(vpImageView<unsigned char>(I), I_blur_ref, 7);
+  CHECK(isEqual(I_blur, I_blur_ref));
+
+  vpImage<double> I_blur_d, I_blur_d_ref;
+  vpImageFilter::gaussianBlur(I, I_blur_d, 5, 1.5);
+  vpImageFilter::gaussianBlur(vpImageView<unsigned char>(I), I_blur_d_ref, 5, 1.5);
+  CHECK(isEqual(I_blur_d, I_blur_d_ref));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -419,6 +419,104 @@ TEST_CASE("Gray image morphology", "[image_morphology]")
   }
 }
 
+namespace
+{
+// Min or max on the rectangle centered on each pixel, restricted to the image
+template <typename T> void rectangularRef(const vpImage<T> &I, vpImage<T> &I_ref, int width, int height, bool erosion)
+{
+  I_ref.resize(I.getHeight(), I.getWidth());
+  for (int r = 0; r < static_cast<int>(I.getHeight()); ++r) {
+    for (int c = 0; c < static_cast<int>(I.getWidth()); ++c) {
+      T value = I[r][c];
+      for (int i = std::max(0, r - height / 2); i <= std::min(static_cast<int>(I.getHeight()) - 1, r + height / 2); ++i) {
+        for (int j = std::max(0, c - width / 2); j <= std::min(static_cast<int>(I.getWidth()) - 1, c + width / 2); ++j) {
+          value = erosion ? std::min(value, I[i][j]) : std::max(value, I[i][j]);
+        }
+      }
+      I_ref[r][c] = value;
+    }
+  }
+}
+
+template <typename T> void checkRectangular(const vpImage<T> &I)
+{
+  const int sizes[][2] = { { 1, 1 }, { 3, 3 }, { 5, 1 }, { 1, 7 }, { 15, 15 }, { 31, 17 }, { 101, 45 } };
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    const int width = sizes[s][0], height = sizes[s][1];
+    INFO("Structuring element: " << width << " x " << height);
+    vpImage<T> I_erosion = I, I_erosion_ref;
+    vpImageMorphology::erosion(I_erosion, width, height);
+    rectangularRef(I, I_erosion_ref, width, height, true);
+    CHECK((I_erosion_ref == I_erosion));
+
+    vpImage<T> I_dilatation = I, I_dilatation_ref;
+    vpImageMorphology::dilatation(I_dilatation, width, height);
+    rectangularRef(I, I_dilatation_ref, width, height, false);
+    CHECK((I_dilatation_ref == I_dilatation));
+  }
+}
+}
+
+TEST_CASE("Rectangular structuring element", "[image_morphology]")
+{
+  vpImage<unsigned char> I(59, 83);
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = static_cast<unsigned char>((i * 7919 + (i / 13) * 31) % 251);
+  }
+
+  SECTION("unsigned char") { checkRectangular(I); }
+
+  SECTION("float")
+  {
+    vpImage<float> I_float(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I_float.bitmap[i] = I.bitmap[i] * 0.5f - 30.f;
+    }
+    checkRectangular(I_float);
+  }
+
+  SECTION("bool")
+  {
+    vpImage<bool> I_bool(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I_bool.bitmap[i] = (I.bitmap[i] > 200);
+    }
+    checkRectangular(I_bool);
+  }
+
+  SECTION("Opening, closing and gradient")
+  {
+    const int size = 9;
+    vpImage<unsigned char> I_erosion = I, I_dilatation = I;
+    vpImageMorphology::erosion(I_erosion, size);
+    vpImageMorphology::dilatation(I_dilatation, size);
+
+    vpImage<unsigned char> I_opening = I, I_opening_ref = I_erosion;
+    vpImageMorphology::opening(I_opening, size);
+    vpImageMorphology::dilatation(I_opening_ref, size);
+    CHECK((I_opening_ref == I_opening));
+
+    vpImage<unsigned char> I_closing = I, I_closing_ref = I_dilatation;
+    vpImageMorphology::closing(I_closing, size);
+    vpImageMorphology::erosion(I_closing_ref, size);
+    CHECK((I_closing_ref == I_closing));
+
+    vpImage<unsigned char> I_gradient = I, I_gradient_ref(I.getHeight(), I.getWidth());
+    vpImageMorphology::gradient(I_gradient, size);
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I_gradient_ref.bitmap[i] = static_cast<unsigned char>(I_dilatation.bitmap[i] - I_erosion.bitmap[i]);
+    }
+    CHECK((I_gradient_ref == I_gradient));
+  }
+
+  SECTION("Wrong size")
+  {
+    vpImage<unsigned char> I_morpho = I;
+    CHECK_THROWS_AS(vpImageMorphology::erosion(I_morpho, 4), vpException);
+    CHECK_THROWS_AS(vpImageMorphology::dilatation(I_morpho, 3, 0), vpException);
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
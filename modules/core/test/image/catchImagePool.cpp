@@ -0,0 +1,165 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the image buffer pool.
+ */
+
+/*!
+  \example catchImagePool.cpp
+
+  \brief Test the allocation of vpImage bitmaps from vpImagePool.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePool.h>
+
+
+namespace
+{
+bool isAligned(const void *ptr, unsigned int alignment)
+{
+  return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+}
+
+TEST_CASE("Bucket size", "[image_pool]")
+{
+  CHECK(vpImagePool::getBucketSize(0) == 64);
+  CHECK(vpImagePool::getBucketSize(1) == 64);
+  CHECK(vpImagePool::getBucketSize(64) == 64);
+  CHECK(vpImagePool::getBucketSize(65) == 128);
+  CHECK(vpImagePool::getBucketSize(4096) == 4096);
+  CHECK(vpImagePool::getBucketSize(4097) == 8192);
+  CHECK(vpImagePool::getBucketSize(640 * 480) == 640 * 480);
+}
+
+TEST_CASE("Image allocation from the pool", "[image_pool]")
+{
+  vpImagePool &pool = vpImagePool::getInstance();
+  pool.clear();
+  pool.setEnabled(true);
+  pool.resetStatistics();
+
+  {
+    vpImage<unsigned char> I(120, 160, 7);
+    CHECK(isAligned(I.bitmap, 64));
+    CHECK(I[119][159] == 7);
+    vpImagePool::vpStatistics stats = pool.getStatistics();
+    CHECK(stats.misses == 2); // bitmap and row pointers
+    CHECK(stats.hits == 0);
+    CHECK(stats.usedBytes > 0);
+  }
+  vpImagePool::vpStatistics stats = pool.getStatistics();
+  CHECK(stats.usedBytes == 0);
+  CHECK(stats.cachedBytes > 0);
+
+  {
+    // Same size: both buffers are reused
+    vpImage<unsigned char> I(120, 160);
+    stats = pool.getStatistics();
+    CHECK(stats.misses == 2);
+    CHECK(stats.hits == 2);
+  }
+
+  SECTION("Steady state of a filtering loop")
+  {
+    vpImage<unsigned char> I(240, 320, 10);
+    {
+      vpImage<float> I_blur;
+      vpImageFilter::gaussianBlur(I, I_blur, 7);
+    }
+    vpImagePool::vpStatistics first = pool.getStatistics();
+    for (int iter = 0; iter < 5; ++iter) {
+      // The output image is allocated at each iteration
+      vpImage<float> I_blur;
+      vpImageFilter::gaussianBlur(I, I_blur, 7);
+    }
+    vpImagePool::vpStatistics last = pool.getStatistics();
+    CHECK(last.misses == first.misses);
+    CHECK(last.hits > first.hits);
+    CHECK(last.peakBytes == first.peakBytes);
+  }
+
+  SECTION("Move and swap keep track of the pooled buffers")
+  {
+    vpImage<float> I1(50, 60, 1.f);
+    vpImage<float> I2(std::move(I1));
+    vpImage<float> I3;
+    swap(I2, I3);
+    I1 = std::move(I3);
+    CHECK(I1[49][59] == 1.f);
+  }
+
+  SECTION("Disable the pool")
+  {
+    vpImage<unsigned char> *I = new vpImage<unsigned char>(30, 30);
+    pool.setEnabled(false);
+    vpImage<unsigned char> I_heap(30, 30);
+    size_t used = pool.getStatistics().usedBytes;
+    CHECK(used > 0);
+    delete I;
+    CHECK(pool.getStatistics().usedBytes < used);
+
+    I_heap.setMemoryAlignment(32);
+    CHECK(isAligned(I_heap.bitmap, 32));
+  }
+
+  SECTION("Limit the cached bytes")
+  {
+    pool.setMaxCachedBytes(0);
+    CHECK(pool.getStatistics().cachedBytes == 0);
+    {
+      vpImage<unsigned char> I(10, 10);
+    }
+    CHECK(pool.getStatistics().cachedBytes == 0);
+    pool.setMaxCachedBytes(static_cast<size_t>(512) * 1024 * 1024);
+  }
+
+  pool.setEnabled(false);
+  CHECK(pool.getStatistics().usedBytes == 0);
+  pool.clear();
+  CHECK(pool.getStatistics().cachedBytes == 0);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
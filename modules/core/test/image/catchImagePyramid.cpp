@@ -0,0 +1,168 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the image pyramid.
+ */
+
+/*!
+  \example catchImagePyramid.cpp
+
+  \brief Test the image pyramid and its integer Gaussian decimation.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImagePyramid.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void fill(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = static_cast<unsigned char>((i * 31 + j * 17 + ((i * j) % 13) + ((i * i + 7 * j) % 101)) % 256);
+    }
+  }
+}
+
+int reflect101(int k, int n)
+{
+  if (n == 1) {
+    return 0;
+  }
+  while ((k < 0) || (k >= n)) {
+    k = (k < 0) ? -k : (2 * (n - 1) - k);
+  }
+  return k;
+}
+
+// Direct evaluation of the 5x5 binomial kernel, as documented for cv::pyrDown()
+void naivePyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  const int kernel[5] = { 1, 4, 6, 4, 1 };
+  const int h = static_cast<int>(I.getHeight()), w = static_cast<int>(I.getWidth());
+  GI.resize((I.getHeight() + 1) / 2, (I.getWidth() + 1) / 2);
+  for (int y = 0; y < static_cast<int>(GI.getHeight()); ++y) {
+    for (int x = 0; x < static_cast<int>(GI.getWidth()); ++x) {
+      int sum = 0;
+      for (int ky = 0; ky < 5; ++ky) {
+        for (int kx = 0; kx < 5; ++kx) {
+          sum += kernel[ky] * kernel[kx] * I[reflect101(2 * y + ky - 2, h)][reflect101(2 * x + kx - 2, w)];
+        }
+      }
+      GI[y][x] = static_cast<unsigned char>((sum + 128) >> 8);
+    }
+  }
+}
+}
+
+TEST_CASE("Integer Gaussian decimation", "[image_pyramid]")
+{
+  const unsigned int sizes[][2] = { { 1, 1 }, { 2, 3 }, { 5, 4 }, { 17, 33 }, { 64, 64 }, { 121, 237 } };
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vpImage<unsigned char> I(sizes[s][0], sizes[s][1]);
+    fill(I);
+    vpImage<unsigned char> GI, GI_ref;
+    vpImagePyramid::pyrDown(I, GI);
+    naivePyrDown(I, GI_ref);
+    INFO("Image size: " << I.getHeight() << " x " << I.getWidth());
+    CHECK(GI == GI_ref);
+  }
+}
+
+TEST_CASE("Gaussian pyramid", "[image_pyramid]")
+{
+  vpImage<unsigned char> I(241, 321);
+  fill(I);
+
+  vpImagePyramid pyramid(4);
+  CHECK_FALSE(pyramid.isBuilt());
+  CHECK_THROWS_AS(pyramid.getLevel(1), vpException);
+  pyramid.build(I);
+  CHECK(pyramid.isBuilt());
+  CHECK(&pyramid[0] == &I);
+
+  vpImage<unsigned char> I_ref = I;
+  for (unsigned int level = 1; level < pyramid.getNbLevels(); ++level) {
+    vpImage<unsigned char> I_down;
+    naivePyrDown(I_ref, I_down);
+    CHECK(pyramid[level] == I_down);
+    I_ref = I_down;
+  }
+  CHECK(pyramid[3].getHeight() == 31);
+  CHECK(pyramid[3].getWidth() == 41);
+  CHECK_THROWS_AS(pyramid.getLevel(4), vpException);
+
+  // The buffers are reused when the size of the image does not change
+  const unsigned char *bitmap = pyramid[2].bitmap;
+  vpImage<unsigned char> I2(241, 321, 10);
+  pyramid.build(I2);
+  CHECK(pyramid[2].bitmap == bitmap);
+  CHECK(pyramid[2][10][10] == 10);
+}
+
+TEST_CASE("Subsampling pyramid", "[image_pyramid]")
+{
+  vpImage<unsigned char> I(100, 150);
+  fill(I);
+
+  vpImagePyramid pyramid(3, vpImagePyramid::PYRAMID_SUBSAMPLING);
+  pyramid.build(I);
+  const vpImage<unsigned char> &I2 = pyramid[2];
+  CHECK(I2.getHeight() == 25);
+  CHECK(I2.getWidth() == 37);
+  for (unsigned int i = 0; i < I2.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I2.getWidth(); ++j) {
+      CHECK(I2[i][j] == I[4 * i][4 * j]);
+    }
+  }
+
+  pyramid.setType(vpImagePyramid::PYRAMID_GAUSSIAN);
+  CHECK_FALSE(pyramid.isBuilt());
+  CHECK_THROWS_AS(pyramid.setNbLevels(0), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,203 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test aligned image allocation and image views.
+ */
+
+/*!
+  \example catchImageView.cpp
+
+  \brief Test aligned image allocation and zero-copy image views.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <type_traits>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void fill(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = static_cast<unsigned char>((i * 31 + j * 17 + ((i * j) % 13)) % 256);
+    }
+  }
+}
+
+bool isAligned(const void *ptr, unsigned int alignment)
+{
+  return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+}
+
+TEST_CASE("Aligned image allocation", "[image_view]")
+{
+  vpImage<unsigned char> I(37, 53);
+  fill(I);
+  vpImage<unsigned char> I_ref = I;
+
+  I.setMemoryAlignment(64);
+  CHECK(I.getMemoryAlignment() == 64);
+  CHECK(isAligned(I.bitmap, 64));
+  CHECK(I == I_ref);
+
+  I.resize(480, 641);
+  CHECK(isAligned(I.bitmap, 64));
+
+  vpImage<unsigned char> I_copy(I);
+  CHECK(I_copy.getMemoryAlignment() == 64);
+  CHECK(isAligned(I_copy.bitmap, 64));
+
+  vpImage<vpRGBa> I_color(10, 10, vpRGBa(1, 2, 3, 4));
+  I_color.setMemoryAlignment(32);
+  CHECK(isAligned(I_color.bitmap, 32));
+  CHECK(I_color[9][9] == vpRGBa(1, 2, 3, 4));
+
+  I_color.setMemoryAlignment(0);
+  CHECK(I_color.getMemoryAlignment() == 0);
+  CHECK(I_color[5][5] == vpRGBa(1, 2, 3, 4));
+
+  CHECK_THROWS_AS(I.setMemoryAlignment(48), vpException);
+}
+
+TEST_CASE("Image view on a ROI", "[image_view]")
+{
+  vpImage<unsigned char> I(60, 80);
+  fill(I);
+  vpRect roi(10, 7, 41, 33);
+
+  vpImageView<unsigned char> view;
+  vpImageTools::crop(I, roi, view);
+  CHECK(view.getWidth() == 41);
+  CHECK(view.getHeight() == 33);
+  CHECK(view.getStride() == I.getWidth());
+  CHECK_FALSE(view.isContiguous());
+  CHECK(view.data() == &I[7][10]);
+
+  vpImage<unsigned char> I_crop;
+  vpImageTools::crop(I, roi, I_crop);
+  vpImage<unsigned char> I_view;
+  view.copyTo(I_view);
+  CHECK(I_view == I_crop);
+
+  SECTION("Clipping")
+  {
+    vpImageView<unsigned char> clipped(I, vpRect(70, 50, 40, 40));
+    CHECK(clipped.getWidth() == 10);
+    CHECK(clipped.getHeight() == 10);
+    CHECK(clipped(9, 9) == I[59][79]);
+
+    vpImageView<unsigned char> sub = view.subView(vpRect(5, 3, 10, 10));
+    CHECK(sub[0] == &I[10][15]);
+    CHECK(vpImageView<unsigned char>(I, vpRect(100, 100, 5, 5)).isEmpty());
+  }
+
+  SECTION("Read-only view on a const image")
+  {
+    const vpImage<unsigned char> &I_const = I;
+    vpImageView<const unsigned char> view_const;
+    vpImageTools::crop(I_const, roi, view_const);
+    CHECK(view_const.data() == view.data());
+    CHECK(view_const(3, 4) == I[10][14]);
+
+    vpImageView<const unsigned char> converted = view;
+    CHECK(converted.data() == view.data());
+    CHECK(converted.getStride() == view.getStride());
+
+    vpImage<float> I_blur_ref, I_blur;
+    vpImageFilter::gaussianBlur(I_crop, I_blur_ref, 7);
+    vpImageFilter::gaussianBlur(view_const, I_blur, 7);
+    CHECK(I_blur == I_blur_ref);
+
+    // A const image must not give write access to its pixels, and an image never converts implicitly to a view
+    CHECK_FALSE(std::is_constructible<vpImageView<unsigned char>, const vpImage<unsigned char> &>::value);
+    CHECK_FALSE(std::is_constructible<vpImageView<unsigned char>, const vpImage<unsigned char> &, const vpRect &>::value);
+    CHECK_FALSE(std::is_constructible<vpImageView<unsigned char>, vpImageView<const unsigned char> >::value);
+    CHECK_FALSE(std::is_convertible<const vpImage<unsigned char> &, vpImageView<const unsigned char> >::value);
+    CHECK_FALSE(std::is_convertible<vpImage<unsigned char> &, vpImageView<unsigned char> >::value);
+    CHECK(std::is_constructible<vpImageView<const unsigned char>, const vpImage<unsigned char> &>::value);
+  }
+
+  SECTION("Gaussian blur")
+  {
+    vpImage<float> I_blur_ref, I_blur;
+    vpImageFilter::gaussianBlur(I_crop, I_blur_ref, 7);
+    vpImageFilter::gaussianBlur(view, I_blur, 7);
+    CHECK(I_blur == I_blur_ref);
+  }
+
+  SECTION("Separable filter with mask")
+  {
+    vpImage<bool> mask(I_crop.getHeight(), I_crop.getWidth(), true);
+    for (unsigned int i = 0; i < mask.getHeight(); i += 3) {
+      mask[i][i % mask.getWidth()] = false;
+    }
+    double kernel[3];
+    vpImageFilter::getGaussianKernel(kernel, 5, 1., true);
+    vpImage<double> I_filt_ref, I_filt;
+    vpImageFilter::filter(I_crop, I_filt_ref, kernel, 5, &mask);
+    vpImageFilter::filter(view, I_filt, kernel, 5, &mask);
+    CHECK(I_filt == I_filt_ref);
+  }
+
+  SECTION("Full image view")
+  {
+    vpImageView<unsigned char> full(I);
+    CHECK(full.isContiguous());
+    vpImage<double> dIx_ref, dIx;
+    double kernel[2] = { 0.5, 0.25 };
+    vpImageFilter::filterX<unsigned char, double, double>(I, dIx_ref, kernel, 3);
+    vpImageFilter::filterX(full, dIx, kernel, 3);
+    CHECK(dIx == dIx_ref);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,216 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark fixed size matrix multiplication.
+ */
+
+/*!
+  \example perfMatrixFixed.cpp
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+
+bool runBenchmark = false;
+
+double getRandomValues(double min, double max) { return (max - min) * (static_cast<double>(rand()) / static_cast<double>(RAND_MAX)) + min; }
+
+vpMatrix generateRandomMatrix(unsigned int rows, unsigned int cols, double min = -1, double max = 1)
+{
+  vpMatrix M(rows, cols);
+
+  for (unsigned int i = 0; i < M.getRows(); i++) {
+    for (unsigned int j = 0; j < M.getCols(); j++) {
+      M[i][j] = getRandomValues(min, max);
+    }
+  }
+
+  return M;
+}
+
+// Same loops as vpMatrix::mult2Matrices() without Blas
+vpMatrix dgemm_regular(const vpMatrix &A, const vpMatrix &B)
+{
+  vpMatrix C(A.getRows(), B.getCols());
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    for (unsigned int j = 0; j < B.getCols(); j++) {
+      double s = 0;
+      for (unsigned int k = 0; k < B.getRows(); k++) {
+        s += A[i][k] * B[k][j];
+      }
+      C[i][j] = s;
+    }
+  }
+  return C;
+}
+
+bool equalMatrix(const vpArray2D<double> &A, const vpArray2D<double> &B)
+{
+  if ((A.getRows() != B.getRows()) || (A.getCols() != B.getCols())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (A.data[i] != B.data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <unsigned int R, unsigned int K, unsigned int C> void checkProduct()
+{
+  vpMatrix A = generateRandomMatrix(R, K);
+  vpMatrix B = generateRandomMatrix(K, C);
+  vpMatrix AB_true = dgemm_regular(A, B);
+
+  vpMatrixFixed<R, K> A_fixed(A);
+  vpMatrixFixed<K, C> B_fixed(B);
+  vpMatrix AB;
+  (A_fixed * B_fixed).copyTo(AB);
+  CHECK(equalMatrix(AB, AB_true));
+}
+
+template <unsigned int N> void benchmarkProduct()
+{
+  vpMatrix A = generateRandomMatrix(N, N);
+  vpMatrix B = generateRandomMatrix(N, N);
+  vpMatrixFixed<N, N> A_fixed(A), B_fixed(B);
+
+  std::ostringstream oss;
+  oss << "(" << N << "x" << N << ")x(" << N << "x" << N << ") - vpMatrix";
+  BENCHMARK(oss.str().c_str())
+  {
+    return A * B;
+  };
+
+  oss.str("");
+  oss << "(" << N << "x" << N << ")x(" << N << "x" << N << ") - vpMatrixFixed";
+  BENCHMARK(oss.str().c_str())
+  {
+    return A_fixed * B_fixed;
+  };
+}
+} // namespace
+
+TEST_CASE("Fixed size matrix multiplication", "[matrix_fixed]")
+{
+  checkProduct<3, 3, 3>();
+  checkProduct<4, 4, 4>();
+  checkProduct<6, 6, 6>();
+  checkProduct<6, 6, 1>();
+  checkProduct<2, 5, 3>();
+
+  // vpMatrix uses the fixed size kernels for these sizes, even when Lapack is available
+  const unsigned int sizes[] = { 3, 4, 6 };
+  for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    vpMatrix A = generateRandomMatrix(sizes[i], sizes[i]);
+    vpMatrix B = generateRandomMatrix(sizes[i], sizes[i]);
+    CHECK(equalMatrix(A * B, dgemm_regular(A, B)));
+  }
+}
+
+TEST_CASE("Fixed size matrix conversions", "[matrix_fixed]")
+{
+  vpHomogeneousMatrix cMo(0.1, -0.2, 0.5, 0.3, -0.1, 0.2);
+  vpHomogeneousMatrix oMw(-0.4, 0.1, 1.5, -0.2, 0.4, 0.1);
+  vpMatrixFixed<4, 4> cMo_fixed(cMo), oMw_fixed(oMw);
+  vpHomogeneousMatrix cMw;
+  (cMo_fixed * oMw_fixed).copyTo(cMw);
+  CHECK(equalMatrix(cMw, dgemm_regular(static_cast<vpMatrix>(cMo), static_cast<vpMatrix>(oMw))));
+
+  vpVelocityTwistMatrix cVo(cMo), oVw(oMw);
+  vpMatrixFixed<6, 6> cVo_fixed(cVo);
+  CHECK(equalMatrix(cVo * oVw, dgemm_regular(static_cast<vpMatrix>(cVo), static_cast<vpMatrix>(oVw))));
+
+  vpMatrix cVo_t;
+  cVo_fixed.t().copyTo(cVo_t);
+  CHECK(equalMatrix(cVo_t, cVo.t()));
+
+  vpMatrixFixed<6, 6> I = vpMatrixFixed<6, 6>::eye();
+  vpMatrix cVo_I;
+  (cVo_fixed * I).copyTo(cVo_I);
+  CHECK(equalMatrix(cVo_I, cVo));
+
+  vpMatrix I_sum, I_true;
+  ((I + I) - I).copyTo(I_sum);
+  I_true.eye(6);
+  CHECK(equalMatrix(I_sum, I_true));
+
+  CHECK_THROWS_AS((vpMatrixFixed<3, 3>(cMo)), vpException);
+}
+
+TEST_CASE("Benchmark fixed size matrix multiplication", "[benchmark]")
+{
+  if (runBenchmark) {
+    SECTION("3x3") { benchmarkProduct<3>(); }
+    SECTION("4x4") { benchmarkProduct<4>(); }
+    SECTION("6x6") { benchmarkProduct<6>(); }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // Set random seed explicitly to avoid confusion
+  // See: https://en.cppreference.com/w/cpp/numeric/random/srand
+  // If rand() is used before any calls to srand(), rand() behaves as if it was seeded with srand(1).
+  srand(1);
+
+  Catch::Session session;
+
+  auto cli = session.cli()
+    | Catch::Clara::Opt(runBenchmark)["--benchmark"]("run benchmark comparing vpMatrix with vpMatrixFixed");
+
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -732,6 +732,103 @@ TEST_CASE("Benchmark AAt", "[benchmark]")
   }
 }
 
+TEST_CASE("Benchmark AtB and AtWA", "[benchmark]")
+{
+  if (runBenchmark || runBenchmarkAll) {
+    std::vector<std::pair<int, int> > sizes = { {6, 6}, {200, 6}, {1000, 6}, {2000, 6}, {207, 119} };
+
+    for (auto sz : sizes) {
+      vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+      vpMatrix B = generateRandomMatrix(sz.first, sz.second);
+      vpColVector b = generateRandomVector(sz.first);
+      vpColVector w = generateRandomVector(sz.first, 0, 1);
+
+      std::ostringstream oss;
+      oss << "(" << A.getRows() << "x" << A.getCols() << ")^T x (" << B.getRows() << "x" << B.getCols()
+        << ") - A.t() * B";
+      vpMatrix AtB, AtB_true;
+      BENCHMARK(oss.str().c_str())
+      {
+        AtB_true = A.t() * B;
+        return AtB_true;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ")^T x (" << B.getRows() << "x" << B.getCols()
+        << ") - A.AtB(B)";
+      BENCHMARK(oss.str().c_str())
+      {
+        A.AtB(B, AtB);
+        return AtB;
+      };
+      REQUIRE(equalMatrix(AtB, AtB_true));
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ")^T x (" << b.getRows() << ") - A.t() * b";
+      vpColVector Atb, Atb_true;
+      BENCHMARK(oss.str().c_str())
+      {
+        Atb_true = A.t() * b;
+        return Atb_true;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ")^T x (" << b.getRows() << ") - A.AtB(b)";
+      BENCHMARK(oss.str().c_str())
+      {
+        A.AtB(b, Atb);
+        return Atb;
+      };
+      REQUIRE(equalMatrix(static_cast<vpMatrix>(Atb), static_cast<vpMatrix>(Atb_true)));
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - A.t() * diag(w) * A";
+      vpMatrix AtWA, AtWA_true;
+      BENCHMARK(oss.str().c_str())
+      {
+        vpMatrix W;
+        W.diag(w);
+        AtWA_true = A.t() * W * A;
+        return AtWA_true;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - A.AtWA(w)";
+      BENCHMARK(oss.str().c_str())
+      {
+        A.AtWA(w, AtWA);
+        return AtWA;
+      };
+      REQUIRE(equalMatrix(AtWA, AtWA_true));
+    }
+  }
+
+  {
+    const unsigned int rows = 47, cols = 13;
+    vpMatrix A = generateRandomMatrix(rows, cols);
+    vpMatrix B = generateRandomMatrix(rows, cols + 2);
+    vpColVector b = generateRandomVector(rows);
+    vpColVector w = generateRandomVector(rows, 0, 1);
+    vpMatrix W;
+    W.diag(w);
+
+    // Check both the Lapack and the fallback implementations
+    const unsigned int lapackMinSize = vpMatrix::getLapackMatrixMinSize();
+    const unsigned int minSizes[] = { lapackMinSize, 1000 };
+    for (unsigned int i = 0; i < 2; ++i) {
+      vpMatrix::setLapackMatrixMinSize(minSizes[i]);
+
+      REQUIRE(equalMatrix(A.AtB(B), dgemm_regular(A.t(), B)));
+      REQUIRE(equalMatrix(static_cast<vpMatrix>(A.AtB(b)), static_cast<vpMatrix>(dgemv_regular(A.t(), b))));
+      REQUIRE(equalMatrix(A.AtWA(w), dgemm_regular(A.t(), dgemm_regular(W, A))));
+      REQUIRE(equalMatrix(A.AtA(), AtA_regular(A)));
+    }
+    vpMatrix::setLapackMatrixMinSize(lapackMinSize);
+
+    REQUIRE_THROWS_AS(A.AtB(b.extract(0, rows - 1)), vpException);
+  }
+}
+
 TEST_CASE("Benchmark matrix-velocity twist multiplication", "[benchmark]")
 {
   if (runBenchmark || runBenchmarkAll) {
@@ -0,0 +1,278 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the recordings of synchronized streams.
+ */
+/*!
+  \example catchRecording.cpp
+
+  \brief Test writing and reading recordings of images, point clouds and poses with vpRecordingWriter and
+  vpRecordingReader.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRecordingReader.h>
+#include <visp3/core/vpRecordingWriter.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int nbFrames = 5;
+
+vpImage<vpRGBa> createColor(unsigned int i)
+{
+  vpImage<vpRGBa> I(6, 9);
+  for (unsigned int k = 0; k < I.getSize(); ++k) {
+    I.bitmap[k] = vpRGBa(static_cast<unsigned char>(k + i), static_cast<unsigned char>(2 * k),
+                         static_cast<unsigned char>(i), static_cast<unsigned char>(255 - k));
+  }
+  return I;
+}
+
+vpImage<uint16_t> createDepth(unsigned int i)
+{
+  vpImage<uint16_t> I(12, 18);
+  for (unsigned int k = 0; k < I.getSize(); ++k) {
+    I.bitmap[k] = static_cast<uint16_t>(1000 + (10 * i) + (k % 7));
+  }
+  return I;
+}
+
+vpImage<float> createFloat(unsigned int i)
+{
+  vpImage<float> I(3, 4);
+  for (unsigned int k = 0; k < I.getSize(); ++k) {
+    I.bitmap[k] = 0.25f * static_cast<float>(k) - static_cast<float>(i);
+  }
+  return I;
+}
+
+std::vector<vpColVector> createPointCloud(unsigned int i)
+{
+  std::vector<vpColVector> pointcloud(10 + i, vpColVector(3));
+  for (size_t k = 0; k < pointcloud.size(); ++k) {
+    pointcloud[k][0] = 0.5 * static_cast<double>(k);
+    pointcloud[k][1] = -static_cast<double>(i);
+    pointcloud[k][2] = 1.25;
+  }
+  return pointcloud;
+}
+
+// Write the streams, the depth and pose streams being shifted in time
+void writeRecording(vpRecordingWriter &writer, bool compressed)
+{
+  const unsigned int color = writer.addStream("color", vpRecordingWriter::STREAM_RGBA);
+  const unsigned int depth = writer.addStream("depth", vpRecordingWriter::STREAM_DEPTH, compressed);
+  const unsigned int pointcloud = writer.addStream("pointcloud", vpRecordingWriter::STREAM_POINT_CLOUD, compressed);
+  for (unsigned int i = 0; i < nbFrames; ++i) {
+    writer.write(color, createColor(i), 0.1 * i);
+    writer.write(depth, createDepth(i), (0.1 * i) + 0.01);
+    writer.write(pointcloud, createPointCloud(i), 0.1 * i);
+    if (i == 1) {
+      writer.addStream("gray", vpRecordingWriter::STREAM_GRAY);
+      writer.addStream("float", vpRecordingWriter::STREAM_FLOAT, compressed);
+      writer.addStream("pose", vpRecordingWriter::STREAM_POSE);
+    }
+    if (i >= 2) {
+      vpImage<unsigned char> I(2, 3, static_cast<unsigned char>(i));
+      writer.write(3, I, 0.1 * i);
+      writer.write(4, createFloat(i), 0.1 * i);
+      writer.write(5, vpHomogeneousMatrix(0.1 * i, 0.2, 0.3, 0., 0.1, 0.2 * i), (0.1 * i) - 0.02);
+    }
+  }
+}
+
+void checkRecording(const vpRecordingReader &reader, bool compressed)
+{
+  REQUIRE(reader.getNbStreams() == 6);
+  const int color = reader.findStream("color");
+  const int depth = reader.findStream(vpRecordingWriter::STREAM_DEPTH);
+  const int pointcloud = reader.findStream("pointcloud");
+  REQUIRE(color == 0);
+  REQUIRE(depth == 1);
+  REQUIRE(pointcloud == 2);
+  CHECK(reader.findStream("unknown") == -1);
+  CHECK(reader.getStreamName(5) == "pose");
+  CHECK(reader.getStreamType(4) == vpRecordingWriter::STREAM_FLOAT);
+  CHECK(reader.isStreamCompressed(depth) == compressed);
+  CHECK(reader.getNbFrames(color) == nbFrames);
+  CHECK(reader.getNbFrames(3) == nbFrames - 2);
+
+  for (unsigned int i = 0; i < nbFrames; ++i) {
+    vpImageView<const vpRGBa> I_color_view;
+    CHECK(reader.getView(color, i, I_color_view));
+    // The pixels are mapped read-only
+    CHECK(std::is_const<std::remove_pointer<decltype(I_color_view.data())>::type>::value);
+    vpImage<vpRGBa> I_color;
+    I_color_view.copyTo(I_color);
+    CHECK(I_color == createColor(i));
+
+    // Synchronized depth image
+    const unsigned int j = reader.getFrameIndex(depth, reader.getTimestamp(color, i));
+    CHECK(j == i);
+    vpImageView<const uint16_t> I_depth_view;
+    CHECK(reader.getView(depth, j, I_depth_view) == !compressed);
+    CHECK(I_depth_view.isEmpty() == compressed);
+    vpImage<uint16_t> I_depth;
+    if (!compressed) {
+      I_depth_view.copyTo(I_depth);
+      CHECK(I_depth == createDepth(i));
+    }
+    reader.read(depth, j, I_depth);
+    CHECK(I_depth == createDepth(i));
+
+    std::vector<vpColVector> points;
+    reader.read(pointcloud, i, points);
+    const std::vector<vpColVector> expected = createPointCloud(i);
+    REQUIRE(points.size() == expected.size());
+    for (size_t k = 0; k < points.size(); ++k) {
+      CHECK((points[k] - expected[k]).frobeniusNorm() < 1e-6);
+    }
+  }
+
+  for (unsigned int i = 0; i < nbFrames - 2; ++i) {
+    vpImage<unsigned char> I_gray;
+    reader.read(3, i, I_gray);
+    CHECK(I_gray == vpImage<unsigned char>(2, 3, static_cast<unsigned char>(i + 2)));
+    vpImage<vpRGBa> I_color;
+    reader.read(3, i, I_color);
+    const unsigned char value = static_cast<unsigned char>(i + 2);
+    CHECK(I_color[1][2] == vpRGBa(value, value, value, vpRGBa::alpha_default));
+
+    vpImage<float> I_float;
+    reader.read(4, i, I_float);
+    CHECK(I_float == createFloat(i + 2));
+
+    vpHomogeneousMatrix M;
+    reader.read(5, i, M);
+    CHECK(M == vpHomogeneousMatrix(0.1 * (i + 2), 0.2, 0.3, 0., 0.1, 0.2 * (i + 2)));
+  }
+
+  // Closest timestamps
+  CHECK(reader.getFrameIndex(color, -1.) == 0);
+  CHECK(reader.getFrameIndex(color, 0.14) == 1);
+  CHECK(reader.getFrameIndex(color, 0.16) == 2);
+  CHECK(reader.getFrameIndex(color, 10.) == nbFrames - 1);
+
+  // Type mismatch
+  vpImage<float> I_float;
+  CHECK_THROWS(reader.read(depth, 0, I_float));
+  CHECK_THROWS(reader.getTimestamp(color, nbFrames));
+}
+} // namespace
+
+TEST_CASE("Recording of synchronized streams", "[recording]")
+{
+  const std::string tmp = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+  const std::string filename = tmp + "/recording.vprec";
+
+#if defined(VISP_HAVE_MINIZ) && defined(VISP_HAVE_WORKING_REGEX)
+  const bool compressed = GENERATE(false, true);
+#else
+  const bool compressed = false;
+#endif
+
+  SECTION("Closed recording")
+  {
+    {
+      vpRecordingWriter writer(filename);
+      writeRecording(writer, compressed);
+    }
+    vpRecordingReader reader(filename);
+    checkRecording(reader, compressed);
+  }
+
+  SECTION("Recording that was not closed")
+  {
+    {
+      vpRecordingWriter writer(filename);
+      writeRecording(writer, compressed);
+      writer.write(3, vpImage<unsigned char>(2, 3, 0), 1.);
+    }
+    std::ifstream ifs(filename.c_str(), std::ifstream::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+    REQUIRE(content.size() > 64);
+
+    // Remove the index and cut the header of the last frame of 128 bytes, as after a crash while writing it
+    uint64_t indexOffset = 0;
+    for (unsigned int i = 0; i < 8; ++i) {
+      indexOffset |= static_cast<uint64_t>(static_cast<unsigned char>(content[(content.size() - 64) + 24 + i]))
+        << (8 * i);
+    }
+    REQUIRE(indexOffset < content.size());
+    std::ofstream ofs(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    ofs.write(&content[0], static_cast<std::streamsize>(indexOffset - 96));
+    ofs.close();
+
+    vpRecordingReader reader(filename);
+    checkRecording(reader, compressed);
+  }
+
+  SECTION("Invalid file")
+  {
+    std::ofstream ofs(filename.c_str());
+    ofs << "not a recording";
+    ofs.close();
+    CHECK_THROWS_AS(vpRecordingReader(filename), vpException);
+  }
+
+  vpIoTools::remove(tmp);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the work-stealing thread pool.
+ */
+
+/*!
+  \example catchThreadPool.cpp
+
+  \brief Test vpThreadPool parallel loops and task groups.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpThreadPool.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+TEST_CASE("Parallel for", "[thread_pool]")
+{
+  const unsigned int nbThreads[] = { 1, 2, 4 };
+  for (unsigned int n : nbThreads) {
+    vpThreadPool pool(n);
+#if defined(VISP_HAVE_THREADS)
+    CHECK(pool.getNbThreads() == n);
+#else
+    CHECK(pool.getNbThreads() == 1);
+#endif
+
+    for (unsigned int grainSize = 0; grainSize <= 1000; grainSize += 333) {
+      // Each index must be visited exactly once
+      std::vector<int> visits(10007, 0);
+      pool.parallelFor(3, static_cast<unsigned int>(visits.size()), [&visits](unsigned int begin, unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i) {
+          ++visits[i];
+        }
+      }, grainSize);
+      CHECK(std::accumulate(visits.begin(), visits.begin() + 3, 0) == 0);
+      CHECK(std::accumulate(visits.begin() + 3, visits.end(), 0) == static_cast<int>(visits.size()) - 3);
+      CHECK(*std::max_element(visits.begin(), visits.end()) == 1);
+    }
+
+    // Empty range
+    bool called = false;
+    pool.parallelFor(5, 5, [&called](unsigned int, unsigned int) { called = true; });
+    CHECK_FALSE(called);
+  }
+}
+
+TEST_CASE("Nested parallel for", "[thread_pool]")
+{
+  vpThreadPool pool(3);
+  std::atomic<unsigned int> count(0);
+  pool.parallelFor(0, 64, [&pool, &count](unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i) {
+      pool.parallelFor(0, 100, [&count](unsigned int b, unsigned int e) { count += e - b; }, 7);
+    }
+  }, 1);
+  CHECK(count == 6400);
+}
+
+TEST_CASE("Task group", "[thread_pool]")
+{
+  vpThreadPool pool(4);
+
+  SECTION("Results")
+  {
+    std::vector<double> results(100, 0.);
+    vpThreadPool::vpTaskGroup group(pool);
+    for (size_t i = 0; i < results.size(); ++i) {
+      group.run([&results, i]() { results[i] = 2. * static_cast<double>(i); });
+    }
+    group.wait();
+    for (size_t i = 0; i < results.size(); ++i) {
+      CHECK(results[i] == 2. * static_cast<double>(i));
+    }
+  }
+
+  SECTION("Exception")
+  {
+    std::atomic<int> nbDone(0);
+    vpThreadPool::vpTaskGroup group(pool);
+    group.run([]() { throw vpException(vpException::badValue, "Task error"); });
+    for (int i = 0; i < 10; ++i) {
+      group.run([&nbDone]() { ++nbDone; });
+    }
+    CHECK_THROWS_AS(group.wait(), vpException);
+    // The other tasks are done before the exception is rethrown
+    CHECK(nbDone == 10);
+    // The group can be reused
+    group.run([&nbDone]() { ++nbDone; });
+    CHECK_NOTHROW(group.wait());
+    CHECK(nbDone == 11);
+  }
+
+  SECTION("Exception in parallel for")
+  {
+    CHECK_THROWS_AS(pool.parallelFor(0, 1000, [](unsigned int begin, unsigned int) {
+      if (begin > 500) {
+        throw std::runtime_error("Loop error");
+      }
+    }, 10), std::runtime_error);
+  }
+}
+
+TEST_CASE("Configuration", "[thread_pool]")
+{
+  vpThreadPool pool(2);
+  pool.setNbThreads(3);
+#if defined(VISP_HAVE_THREADS)
+  CHECK(pool.getNbThreads() == 3);
+#endif
+  pool.setNbThreads(0);
+  CHECK(pool.getNbThreads() == vpThreadPool::getHardwareConcurrency());
+
+  std::vector<unsigned int> cpus(1, 0);
+  pool.setCpuAffinity(cpus);
+  CHECK(pool.getCpuAffinity() == cpus);
+
+  std::atomic<unsigned int> count(0);
+  pool.parallelFor(0, 1000, [&count](unsigned int begin, unsigned int end) { count += end - begin; });
+  CHECK(count == 1000);
+
+  CHECK(&vpThreadPool::getInstance() == &vpThreadPool::getInstance());
+  CHECK(vpThreadPool::getInstance().getNbThreads() >= 1);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -86,6 +86,11 @@ BEGIN_VISP_NAMESPACE
  *    detect(const vpImage<unsigned char> &, double, const vpCameraParameters &, std::vector<vpHomogeneousMatrix> &, std::vector<vpHomogeneousMatrix> *, std::vector<double> *, std::vector<double> *)
  * 2. If tag sizes differ, use rather getPose()
  *
+ * On video streams, setAprilTagTracking() enables a tracking mode where the tags are searched only in regions of
+ * interest around their location predicted from the previous images, which is much faster than processing the whole
+ * image when the tags are small with respect to the image. The whole image is still processed periodically to
+ * detect the tags that enter the field of view.
+ *
  * \note With ViSP, the size of the tag corresponds to the black part of the tag. Note also that to be detected,
  * the black part of the tag must be surrounded by a white border as wide as the black border as in the next image:
  * \image html img-apriltag-size.jpg
@@ -378,6 +383,8 @@ public:
 
   bool isZAlignedWithCameraAxis() const;
 
+  void resetAprilTagTracking();
+
   void setAprilTagDebugOption(bool flag);
   void setAprilTagDecisionMarginThreshold(float decisionMarginThreshold);
   void setAprilTagDecodeSharpening(double decodeSharpening);
@@ -388,6 +395,7 @@ public:
   void setAprilTagQuadDecimate(float quadDecimate);
   void setAprilTagQuadSigma(float quadSigma);
   void setAprilTagRefineEdges(bool refineEdges);
+  void setAprilTagTracking(bool tracking, unsigned int fullDetectionPeriod = 10, double roiMargin = 0.5);
 
 
   /*! Allow to enable the display of overlay tag information in the windows
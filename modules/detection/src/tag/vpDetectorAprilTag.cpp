@@ -33,6 +33,9 @@
 #include <visp3/core/vpConfig.h>
 
 #ifdef VISP_HAVE_APRILTAG
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
 
 #ifdef __cplusplus
@@ -85,7 +88,9 @@ public:
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_poseEstimationMethod(method), m_tagsId(), m_tagFamily(tagFamily), m_tagsDecisionMargin(),
     m_tagsHammingDistance(), m_td(nullptr), m_tf(nullptr),
-    m_detections(nullptr), m_decisionMarginThreshold(-1), m_hammingDistanceThreshold(2), m_zAlignedWithCameraFrame(false)
+    m_detections(nullptr), m_decisionMarginThreshold(-1), m_hammingDistanceThreshold(2), m_zAlignedWithCameraFrame(false),
+    m_tracking(false), m_trackingFullDetectionPeriod(10), m_trackingRoiMargin(0.5), m_nbFramesSinceFullDetection(0),
+    m_trackedWidth(0), m_trackedHeight(0), m_trackedTags()
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -209,7 +214,10 @@ public:
     : m_poseEstimationMethod(o.m_poseEstimationMethod), m_tagsId(o.m_tagsId), m_tagFamily(o.m_tagFamily),
     m_tagsDecisionMargin(o.m_tagsDecisionMargin), m_tagsHammingDistance(o.m_tagsHammingDistance), m_td(nullptr),
     m_tf(nullptr), m_detections(nullptr), m_decisionMarginThreshold(o.m_decisionMarginThreshold),
-    m_hammingDistanceThreshold(o.m_hammingDistanceThreshold), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame)
+    m_hammingDistanceThreshold(o.m_hammingDistanceThreshold), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame),
+    m_tracking(o.m_tracking), m_trackingFullDetectionPeriod(o.m_trackingFullDetectionPeriod),
+    m_trackingRoiMargin(o.m_trackingRoiMargin), m_nbFramesSinceFullDetection(o.m_nbFramesSinceFullDetection),
+    m_trackedWidth(o.m_trackedWidth), m_trackedHeight(o.m_trackedHeight), m_trackedTags(o.m_trackedTags)
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -498,7 +506,7 @@ public:
       m_detections = nullptr;
     }
 
-    m_detections = apriltag_detector_detect(m_td, &im);
+    m_detections = m_tracking ? trackTags(I, im) : apriltag_detector_detect(m_td, &im);
     int nb_detections = zarray_size(m_detections);
     bool detected = nb_detections > 0;
 
@@ -508,6 +516,7 @@ public:
     m_tagsId.reserve(static_cast<size_t>(nb_detections));
     m_tagsDecisionMargin.reserve(static_cast<size_t>(nb_detections));
     m_tagsHammingDistance.reserve(static_cast<size_t>(nb_detections));
+    std::vector<vpTrackedTag> trackedTags;
 
     int zarray_size_m_detections = zarray_size(m_detections);
     for (int i = 0; i < zarray_size_m_detections; ++i) {
@@ -535,6 +544,9 @@ public:
       m_tagsId.push_back(det->id);
       m_tagsDecisionMargin.push_back(det->decision_margin);
       m_tagsHammingDistance.push_back(det->hamming);
+      if (m_tracking) {
+        trackedTags.push_back(toTrackedTag(det));
+      }
 
       if (displayTag) {
         vpColor Ox = (color == vpColor::none) ? vpColor::red : color;
@@ -573,6 +585,12 @@ public:
       }
     }
 
+    if (m_tracking) {
+      updateTrackedTags(trackedTags);
+      m_trackedWidth = I.getWidth();
+      m_trackedHeight = I.getHeight();
+    }
+
     return detected;
   }
 
@@ -1093,6 +1111,167 @@ public:
     return m_zAlignedWithCameraFrame;
   }
 
+  void getTracking(bool &tracking, unsigned int &fullDetectionPeriod, double &roiMargin) const
+  {
+    tracking = m_tracking;
+    fullDetectionPeriod = m_trackingFullDetectionPeriod;
+    roiMargin = m_trackingRoiMargin;
+  }
+
+  void resetTracking()
+  {
+    m_nbFramesSinceFullDetection = 0;
+    m_trackedTags.clear();
+  }
+
+  void setTracking(bool tracking, unsigned int fullDetectionPeriod, double roiMargin)
+  {
+    m_tracking = tracking;
+    m_trackingFullDetectionPeriod = fullDetectionPeriod;
+    m_trackingRoiMargin = roiMargin;
+    resetTracking();
+  }
+
+  //! Bounding box of a tag detected in the previous image, and displacement of its center since the image before
+  struct vpTrackedTag
+  {
+    int id;
+    double uMin, uMax, vMin, vMax;
+    double du, dv;
+  };
+
+  //! Region of interest [left, right[ x [top, bottom[ in pixels
+  struct vpTagRoi
+  {
+    int left, top, right, bottom;
+  };
+
+  static vpTrackedTag toTrackedTag(const apriltag_detection_t *det)
+  {
+    vpTrackedTag tag;
+    tag.id = det->id;
+    tag.uMin = tag.uMax = det->p[0][0];
+    tag.vMin = tag.vMax = det->p[0][1];
+    for (int j = 1; j < 4; ++j) {
+      tag.uMin = std::min<double>(tag.uMin, det->p[j][0]);
+      tag.uMax = std::max<double>(tag.uMax, det->p[j][0]);
+      tag.vMin = std::min<double>(tag.vMin, det->p[j][1]);
+      tag.vMax = std::max<double>(tag.vMax, det->p[j][1]);
+    }
+    tag.du = 0.;
+    tag.dv = 0.;
+    return tag;
+  }
+
+  /*
+   * Keep the tags detected in the current image, with the displacement of their center from the closest tag with
+   * the same id in the previous image.
+   */
+  void updateTrackedTags(std::vector<vpTrackedTag> &tags)
+  {
+    for (size_t i = 0; i < tags.size(); ++i) {
+      const double u = 0.5 * (tags[i].uMin + tags[i].uMax), v = 0.5 * (tags[i].vMin + tags[i].vMax);
+      double bestDist = std::numeric_limits<double>::max();
+      for (size_t j = 0; j < m_trackedTags.size(); ++j) {
+        if (m_trackedTags[j].id != tags[i].id) {
+          continue;
+        }
+        const double du = u - (0.5 * (m_trackedTags[j].uMin + m_trackedTags[j].uMax));
+        const double dv = v - (0.5 * (m_trackedTags[j].vMin + m_trackedTags[j].vMax));
+        if (((du * du) + (dv * dv)) < bestDist) {
+          bestDist = (du * du) + (dv * dv);
+          tags[i].du = du;
+          tags[i].dv = dv;
+        }
+      }
+    }
+    m_trackedTags.swap(tags);
+  }
+
+  /*
+   * Detect the tags in regions of interest around the locations of the tags of the previous image, predicted with a
+   * constant velocity model. The regions are views of the input image, that is not copied. The whole image is
+   * processed every m_trackingFullDetectionPeriod images, or when no tag is found in the regions of interest.
+   */
+  zarray_t *trackTags(const vpImage<unsigned char> &I, image_u8_t &im)
+  {
+    const bool fullDetection = m_trackedTags.empty() || (I.getWidth() != m_trackedWidth) ||
+      (I.getHeight() != m_trackedHeight) ||
+      ((m_trackingFullDetectionPeriod > 0) && ((m_nbFramesSinceFullDetection + 1) >= m_trackingFullDetectionPeriod));
+
+    if (!fullDetection) {
+      // Regions of interest, merged when they overlap
+      std::vector<vpTagRoi> rois;
+      const int width = static_cast<int>(I.getWidth()), height = static_cast<int>(I.getHeight());
+      for (size_t i = 0; i < m_trackedTags.size(); ++i) {
+        const vpTrackedTag &tag = m_trackedTags[i];
+        const double margin = m_trackingRoiMargin * std::max<double>(tag.uMax - tag.uMin, tag.vMax - tag.vMin);
+        const int left = std::max<int>(0, static_cast<int>(std::floor((tag.uMin + tag.du) - margin)));
+        const int top = std::max<int>(0, static_cast<int>(std::floor((tag.vMin + tag.dv) - margin)));
+        const int right = std::min<int>(width, static_cast<int>(std::ceil((tag.uMax + tag.du) + margin)) + 1);
+        const int bottom = std::min<int>(height, static_cast<int>(std::ceil((tag.vMax + tag.dv) + margin)) + 1);
+        if ((left < right) && (top < bottom)) {
+          vpTagRoi roi = { left, top, right, bottom };
+          rois.push_back(roi);
+        }
+      }
+      bool merged = true;
+      while (merged) {
+        merged = false;
+        for (size_t i = 0; (i < rois.size()) && !merged; ++i) {
+          for (size_t j = i + 1; (j < rois.size()) && !merged; ++j) {
+            if ((rois[i].left < rois[j].right) && (rois[j].left < rois[i].right) && (rois[i].top < rois[j].bottom) &&
+                (rois[j].top < rois[i].bottom)) {
+              rois[i].left = std::min<int>(rois[i].left, rois[j].left);
+              rois[i].top = std::min<int>(rois[i].top, rois[j].top);
+              rois[i].right = std::max<int>(rois[i].right, rois[j].right);
+              rois[i].bottom = std::max<int>(rois[i].bottom, rois[j].bottom);
+              rois.erase(rois.begin() + static_cast<std::ptrdiff_t>(j));
+              merged = true;
+            }
+          }
+        }
+      }
+
+      zarray_t *detections = zarray_create(sizeof(apriltag_detection_t *));
+      for (size_t i = 0; i < rois.size(); ++i) {
+        const int left = rois[i].left, top = rois[i].top;
+        image_u8_t roi = {/*.width =*/static_cast<int32_t>(rois[i].right - left),
+          /*.height =*/static_cast<int32_t>(rois[i].bottom - top),
+          /*.stride =*/static_cast<int32_t>(I.getWidth()),
+          /*.buf =*/I.bitmap + (static_cast<size_t>(top) * I.getWidth()) + static_cast<size_t>(left) };
+        zarray_t *roiDetections = apriltag_detector_detect(m_td, &roi);
+        int nbRoiDetections = zarray_size(roiDetections);
+        for (int j = 0; j < nbRoiDetections; ++j) {
+          apriltag_detection_t *det;
+          zarray_get(roiDetections, j, &det);
+          // Express the corners, the center and the homography in the full image
+          for (int k = 0; k < 4; ++k) {
+            det->p[k][0] += left;
+            det->p[k][1] += top;
+          }
+          det->c[0] += left;
+          det->c[1] += top;
+          for (int k = 0; k < 3; ++k) {
+            MATD_EL(det->H, 0, k) += left * MATD_EL(det->H, 2, k);
+            MATD_EL(det->H, 1, k) += top * MATD_EL(det->H, 2, k);
+          }
+          zarray_add(detections, &det);
+        }
+        zarray_destroy(roiDetections);
+      }
+
+      if (zarray_size(detections) > 0) {
+        ++m_nbFramesSinceFullDetection;
+        return detections;
+      }
+      apriltag_detections_destroy(detections);
+    }
+
+    m_nbFramesSinceFullDetection = 0;
+    return apriltag_detector_detect(m_td, &im);
+  }
+
 protected:
   std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType> m_mapOfCorrespondingPoseMethods;
   vpPoseEstimationMethod m_poseEstimationMethod;
@@ -1106,6 +1285,13 @@ protected:
   float m_decisionMarginThreshold;
   int m_hammingDistanceThreshold;
   bool m_zAlignedWithCameraFrame;
+  bool m_tracking;
+  unsigned int m_trackingFullDetectionPeriod;
+  double m_trackingRoiMargin;
+  unsigned int m_nbFramesSinceFullDetection;
+  unsigned int m_trackedWidth;
+  unsigned int m_trackedHeight;
+  std::vector<vpTrackedTag> m_trackedTags;
 };
 
 namespace
@@ -1528,6 +1714,10 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   bool refineEdges = true;
   m_impl->getRefineEdges(refineEdges);
   bool zAxis = m_impl->getZAlignedWithCameraAxis();
+  bool tracking = false;
+  unsigned int fullDetectionPeriod = 10;
+  double roiMargin = 0.5;
+  m_impl->getTracking(tracking, fullDetectionPeriod, roiMargin);
 
   delete m_impl;
   m_impl = new Impl(tagFamily, m_poseEstimationMethod);
@@ -1537,6 +1727,7 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   m_impl->setQuadSigma(quadSigma);
   m_impl->setRefineEdges(refineEdges);
   m_impl->setZAlignedWithCameraAxis(zAxis);
+  m_impl->setTracking(tracking, fullDetectionPeriod, roiMargin);
 }
 
 /*!
@@ -1616,6 +1807,32 @@ void vpDetectorAprilTag::setAprilTagRefineDecode(bool refineDecode)
 */
 void vpDetectorAprilTag::setAprilTagRefineEdges(bool refineEdges) { m_impl->setRefineEdges(refineEdges); }
 
+/*!
+  Enable or disable the tracking mode, dedicated to video streams.
+
+  In tracking mode, detect() looks for the tags only in regions of interest around the tags detected in the previous
+  image, shifted by their last displacement. The regions of interest are views of the input image, that is not
+  copied, and the regions that overlap are merged. When the tags are small with respect to the image, the detection
+  is much faster than on the whole image.
+
+  The whole image is processed at the first image, when the size of the image changes, when no tag is found in the
+  regions of interest, and every \e fullDetectionPeriod images to detect the tags that enter the field of view.
+
+  \param[in] tracking : If true, enable the tracking mode. Otherwise the whole image is processed at each image.
+  \param[in] fullDetectionPeriod : Number of images between two detections over the whole image. When set to 0, the
+  whole image is processed only when no tag is found in the regions of interest.
+  \param[in] roiMargin : Margin around the bounding box of a tag, as a ratio of the size of this bounding box.
+
+  \sa resetAprilTagTracking()
+*/
+void vpDetectorAprilTag::setAprilTagTracking(bool tracking, unsigned int fullDetectionPeriod, double roiMargin)
+{
+  if (roiMargin < 0.) {
+    throw vpException(vpException::badValue, "The margin of the regions of interest must be positive");
+  }
+  m_impl->setTracking(tracking, fullDetectionPeriod, roiMargin);
+}
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 /*!
   \deprecated Deprecated parameter from AprilTag 2 version.
@@ -1645,6 +1862,14 @@ bool vpDetectorAprilTag::isZAlignedWithCameraAxis() const
 {
   return m_impl->isZAlignedWithCameraAxis();
 }
+
+/*!
+  Forget the tags tracked in the previous images, so that the next call to detect() processes the whole image,
+  e.g. after a discontinuity in the video stream.
+
+  \sa setAprilTagTracking()
+*/
+void vpDetectorAprilTag::resetAprilTagTracking() { m_impl->resetTracking(); }
 END_VISP_NAMESPACE
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work around to avoid warning: libvisp_core.a(vpDetectorAprilTag.cpp.o) has
@@ -0,0 +1,192 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test AprilTag detection in tracking mode.
+ */
+/*!
+  \example catchAprilTagTracking.cpp
+
+  \brief Test AprilTag detection in tracking mode on a synthetic sequence of moving tags.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_APRILTAG)
+
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int tagScale = 6;
+
+// Draw the tags with the given ids, with their top left corner at the given locations
+void createImage(vpDetectorAprilTag &detector, const std::vector<int> &ids, const std::vector<vpImagePoint> &locations,
+                 vpImage<unsigned char> &I)
+{
+  I.resize(480, 640, 160);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    vpImage<unsigned char> tag, tagBig;
+    detector.getTagImage(tag, ids[i]);
+    tagBig.resize(tag.getHeight() * tagScale, tag.getWidth() * tagScale);
+    vpImageTools::resize(tag, tagBig, vpImageTools::INTERPOLATION_NEAREST);
+    const int top = static_cast<int>(locations[i].get_i()), left = static_cast<int>(locations[i].get_j());
+    for (unsigned int r = 0; r < tagBig.getHeight(); ++r) {
+      for (unsigned int c = 0; c < tagBig.getWidth(); ++c) {
+        I[top + r][left + c] = tagBig[r][c];
+      }
+    }
+  }
+}
+
+// Ids and corners of the detected tags, sorted by id
+std::vector<std::pair<int, std::vector<vpImagePoint> > > getSortedTags(const vpDetectorAprilTag &detector)
+{
+  std::vector<std::pair<int, std::vector<vpImagePoint> > > tags;
+  const std::vector<int> ids = detector.getTagsId();
+  const std::vector<std::vector<vpImagePoint> > corners = detector.getTagsCorners();
+  for (size_t i = 0; i < ids.size(); ++i) {
+    tags.push_back(std::make_pair(ids[i], corners[i]));
+  }
+  std::sort(tags.begin(), tags.end(),
+            [](const std::pair<int, std::vector<vpImagePoint> > &a, const std::pair<int, std::vector<vpImagePoint> > &b) {
+              return a.first < b.first;
+            });
+  return tags;
+}
+} // namespace
+
+TEST_CASE("AprilTag detection in tracking mode", "[apriltag_tracking]")
+{
+  vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11);
+  vpDetectorAprilTag tracker(vpDetectorAprilTag::TAG_36h11);
+  tracker.setAprilTagTracking(true, 5);
+
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const double tagSize = 0.05;
+  const std::vector<int> ids = { 0, 1, 2 };
+  vpImage<unsigned char> I;
+
+  SECTION("Same detections as on the whole image")
+  {
+    for (int frame = 0; frame < 20; ++frame) {
+      const std::vector<vpImagePoint> locations = { vpImagePoint(40 + (2 * frame), 30 + (3 * frame)),
+                                                    vpImagePoint(300 - (2 * frame), 100 + (4 * frame)),
+                                                    vpImagePoint(200, 500 - (3 * frame)) };
+      createImage(detector, ids, locations, I);
+
+      std::vector<vpHomogeneousMatrix> cMo_vec, cMo_vec_tracking;
+      REQUIRE(detector.detect(I, tagSize, cam, cMo_vec));
+      REQUIRE(tracker.detect(I, tagSize, cam, cMo_vec_tracking));
+
+      const std::vector<std::pair<int, std::vector<vpImagePoint> > > tags = getSortedTags(detector);
+      const std::vector<std::pair<int, std::vector<vpImagePoint> > > trackedTags = getSortedTags(tracker);
+      REQUIRE(tags.size() == ids.size());
+      REQUIRE(trackedTags.size() == tags.size());
+      for (size_t i = 0; i < tags.size(); ++i) {
+        CHECK(trackedTags[i].first == tags[i].first);
+        for (size_t j = 0; j < 4; ++j) {
+          CHECK(vpImagePoint::distance(trackedTags[i].second[j], tags[i].second[j]) < 0.5);
+        }
+      }
+
+      // The poses are computed from the homographies of the detections
+      const std::vector<int> detectorIds = detector.getTagsId(), trackerIds = tracker.getTagsId();
+      for (size_t i = 0; i < detectorIds.size(); ++i) {
+        const size_t k = static_cast<size_t>(std::find(trackerIds.begin(), trackerIds.end(), detectorIds[i]) -
+                                             trackerIds.begin());
+        REQUIRE(k < trackerIds.size());
+        CHECK((cMo_vec[i].getTranslationVector() - cMo_vec_tracking[k].getTranslationVector()).frobeniusNorm() <
+              1e-3);
+      }
+    }
+  }
+
+  SECTION("Tag entering the field of view")
+  {
+    std::vector<int> someIds = { 0, 1 };
+    std::vector<vpImagePoint> locations = { vpImagePoint(40, 30), vpImagePoint(300, 100) };
+    createImage(detector, someIds, locations, I);
+    CHECK(tracker.detect(I));
+    CHECK(tracker.getNbObjects() == 2);
+
+    // The new tag is found at the next detection over the whole image
+    locations.push_back(vpImagePoint(200, 500));
+    createImage(detector, ids, locations, I);
+    unsigned int nbFrames = 0;
+    while ((tracker.getNbObjects() < 3) && (nbFrames < 10)) {
+      tracker.detect(I);
+      ++nbFrames;
+    }
+    CHECK(tracker.getNbObjects() == 3);
+    CHECK(nbFrames <= 5);
+
+    // Lost tags
+    createImage(detector, std::vector<int>(1, 2), std::vector<vpImagePoint>(1, vpImagePoint(100, 400)), I);
+    CHECK(tracker.detect(I));
+    CHECK(tracker.getTagsId() == std::vector<int>(1, 2));
+
+    tracker.resetAprilTagTracking();
+    CHECK(tracker.detect(I));
+  }
+
+  SECTION("Tracking settings are kept when changing the family")
+  {
+    tracker.setAprilTagFamily(vpDetectorAprilTag::TAG_36h11);
+    createImage(detector, ids, { vpImagePoint(40, 30), vpImagePoint(300, 100), vpImagePoint(200, 500) }, I);
+    CHECK(tracker.detect(I));
+    CHECK(tracker.getNbObjects() == 3);
+    CHECK_THROWS(tracker.setAprilTagTracking(true, 5, -1.));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -239,6 +239,11 @@ VISP_EXPORT void adjust(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_A
  * over amplification of noise. This method is a transcription of the CLAHE
  * ImageJ plugin code by Stephan Saalfeld.
  *
+ * The transfer functions of the boxes of the fast version, and the bands of
+ * rows of the image, are processed in parallel by the threads of
+ * vpThreadPool::getInstance(). The result does not depend on the number of
+ * threads.
+ *
  * \param I1 : The first grayscale image.
  * \param I2 : The second grayscale image after application of the CLAHE
  * method.
@@ -271,6 +276,11 @@ VISP_EXPORT void clahe(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I
  * over amplification of noise. This method is a transcription of the CLAHE
  * ImageJ plugin code by Stephan Saalfeld.
  *
+ * The transfer functions of the boxes of the fast version, and the bands of
+ * rows of the image, are processed in parallel by the threads of
+ * vpThreadPool::getInstance(). The result does not depend on the number of
+ * threads.
+ *
  * \param I1 : The first color image.
  * \param I2 : The second color image after application of the CLAHE method.
  * \param blockRadius : The size (2*blockRadius+1) of the local region around a
@@ -575,17 +585,66 @@ VISP_EXPORT void unsharpMask(VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_AD
  */
 VISP_EXPORT void unsharpMask(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I, VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &Ires, float sigma, double weight = 0.6);
 
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Statistics of a connected component, computed by connectedComponents() while labeling the image.
+ * The coordinates are in pixels, \f$ u \f$ being the column and \f$ v \f$ the row.
+ */
+typedef struct vpConnectedComponentStats
+{
+  unsigned int area;   //!< Number of pixels of the component, that is the moment \f$ m_{00} \f$.
+  unsigned int left;   //!< Column of the leftmost pixel.
+  unsigned int top;    //!< Row of the topmost pixel.
+  unsigned int right;  //!< Column of the rightmost pixel.
+  unsigned int bottom; //!< Row of the bottommost pixel.
+  double u;            //!< Column of the centroid, \f$ m_{10} / m_{00} \f$.
+  double v;            //!< Row of the centroid, \f$ m_{01} / m_{00} \f$.
+  double m10;          //!< Moment \f$ m_{10} = \sum u \f$.
+  double m01;          //!< Moment \f$ m_{01} = \sum v \f$.
+  double m20;          //!< Moment \f$ m_{20} = \sum u^2 \f$.
+  double m11;          //!< Moment \f$ m_{11} = \sum u v \f$.
+  double m02;          //!< Moment \f$ m_{02} = \sum v^2 \f$.
+  double mu20;         //!< Centered moment \f$ \mu_{20} = \sum (u - \bar{u})^2 \f$.
+  double mu11;         //!< Centered moment \f$ \mu_{11} = \sum (u - \bar{u})(v - \bar{v}) \f$.
+  double mu02;         //!< Centered moment \f$ \mu_{02} = \sum (v - \bar{v})^2 \f$.
+} vpConnectedComponentStats;
+
 /*!
  * \ingroup group_imgproc_connected_components
  *
  * Perform connected components detection.
  *
+ * A component is a connected set of pixels that have the same non-zero value. The components are labeled from 1, in
+ * the order of their first pixel in a row by row scan of the image.
+ *
+ * The image is labeled in horizontal strips by the threads of vpThreadPool::getInstance(), whose labels are merged
+ * along the strip borders. The result does not depend on the number of threads.
+ *
+ * \param I : Input image (0 means background).
+ * \param labels : Label image that contain for each position the component label.
+ * \param nbComponents : Number of connected components.
+ * \param connexity : Type of connexity.
+ */
+VISP_EXPORT void connectedComponents(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I, VISP_NAMESPACE_ADDRESSING vpImage<int> &labels, int &nbComponents,
+                                     const VISP_NAMESPACE_ADDRESSING vpImageMorphology::vpConnexityType &connexity = VISP_NAMESPACE_ADDRESSING vpImageMorphology::CONNEXITY_4);
+
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Perform connected components detection, and compute the area, the bounding box, the centroid and the moments of the
+ * components in the same pass.
+ *
+ * The labels are the same as with connectedComponents(const vpImage<unsigned char> &, vpImage<int> &, int &, const vpImageMorphology::vpConnexityType &).
+ *
  * \param I : Input image (0 means background).
  * \param labels : Label image that contain for each position the component label.
  * \param nbComponents : Number of connected components.
+ * \param stats : Statistics of the components, `stats[k]` being the statistics of the component of label `k + 1`.
  * \param connexity : Type of connexity.
  */
 VISP_EXPORT void connectedComponents(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I, VISP_NAMESPACE_ADDRESSING vpImage<int> &labels, int &nbComponents,
+                                     std::vector<vpConnectedComponentStats> &stats,
                                      const VISP_NAMESPACE_ADDRESSING vpImageMorphology::vpConnexityType &connexity = VISP_NAMESPACE_ADDRESSING vpImageMorphology::CONNEXITY_4);
 
 /*!
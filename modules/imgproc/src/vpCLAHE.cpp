@@ -77,16 +77,17 @@
 */
 
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace VISP_NAMESPACE_NAME
 {
 int fastRound(float value);
 void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist, int limit);
-void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCenter, const vpImage<unsigned char> &I,
-                     std::vector<int> &hist);
+void createHistogram(int blockRadius, const std::vector<int> &binOf, int blockXCenter, int blockYCenter,
+                     const vpImage<unsigned char> &I, std::vector<int> &hist);
 std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs);
-float transferValue(int v, std::vector<int> &clippedHist);
+float transferValue(int v, const std::vector<int> &clippedHist);
 float transferValue(int v, const std::vector<int> &hist, std::vector<int> &clippedHist, int limit);
 bool checkClaheInputs(const int &blockRadius, const int &bins, const unsigned int &width, const unsigned int &height);
 void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope, bool fast);
@@ -126,8 +127,8 @@ void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist,
   } while (clippedEntries != clippedEntriesBefore);
 }
 
-void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCenter, const vpImage<unsigned char> &I,
-                     std::vector<int> &hist)
+void createHistogram(int blockRadius, const std::vector<int> &binOf, int blockXCenter, int blockYCenter,
+                     const vpImage<unsigned char> &I, std::vector<int> &hist)
 {
   std::fill(hist.begin(), hist.end(), 0);
 
@@ -137,8 +138,9 @@ void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCent
   int yMax = std::min<int>(static_cast<int>(I.getHeight()), blockYCenter + blockRadius + 1);
 
   for (int y = yMin; y < yMax; ++y) {
+    const unsigned char *row = I[y];
     for (int x = xMin; x < xMax; ++x) {
-      ++hist[fastRound((I[y][x] / 255.0f) * bins)];
+      ++hist[binOf[row[x]]];
     }
   }
 }
@@ -177,7 +179,7 @@ std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::
   return transfer;
 }
 
-float transferValue(int v, std::vector<int> &clippedHist)
+float transferValue(int v, const std::vector<int> &clippedHist)
 {
   int clippedHistLength = static_cast<int>(clippedHist.size());
   int hMin = clippedHistLength - 1;
@@ -208,6 +210,17 @@ float transferValue(int v, std::vector<int> &clippedHist)
 
 float transferValue(int v, const std::vector<int> &hist, std::vector<int> &clippedHist, int limit)
 {
+  // When no bin is above the limit, clipping leaves the histogram unchanged and the copy is avoided
+  const int *data = hist.data();
+  const int histLength = static_cast<int>(hist.size());
+  int i = 0;
+  while ((i < histLength) && (data[i] <= limit)) {
+    ++i;
+  }
+  if (i == histLength) {
+    return transferValue(v, hist);
+  }
+
   clipHistogram(hist, clippedHist, limit);
 
   return transferValue(v, clippedHist);
@@ -241,6 +254,14 @@ void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blo
   if (!checkClaheInputs(blockRadius, bins, I1.getWidth(), I1.getHeight())) { return; }
 
   I2.resize(I1.getHeight(), I1.getWidth());
+
+  // Histogram bin of each intensity
+  std::vector<int> binOf(256);
+  for (int i = 0; i < 256; ++i) {
+    binOf[i] = fastRound((static_cast<unsigned char>(i) / 255.0f) * bins);
+  }
+
+  vpThreadPool &pool = vpThreadPool::getInstance();
   if (fast) {
     const int val_2 = 2;
     int blockSize = (val_2 * blockRadius) + 1;
@@ -299,134 +320,139 @@ void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blo
       rs[nr + 1] = I1.getHeight() - blockRadius - 1;
     }
 
-    std::vector<int> hist(static_cast<size_t>(bins + 1)), cdfs(static_cast<size_t>(bins + 1));
-    std::vector<float> tl, tr, br, bl;
-    int rs_size = static_cast<int>(rs.size());
-    for (int r = 0; r <= rs_size; ++r) {
-      int r0 = std::max<int>(0, r - 1);
-      int r1 = std::min<int>(static_cast<int>(rs.size()) - 1, r);
-      int dr = rs[r1] - rs[r0];
-      createHistogram(blockRadius, bins, cs[0], rs[r0], I1, hist);
-      tr = createTransfer(hist, limit, cdfs);
-      if (r0 == r1) {
-        br = tr;
+    // Transfer function of each tile, computed once and in parallel
+    const int nbRows = static_cast<int>(rs.size()), nbCols = static_cast<int>(cs.size());
+    const size_t transferSize = static_cast<size_t>(bins + 1);
+    std::vector<float> transfers(static_cast<size_t>(nbRows * nbCols) * transferSize);
+    pool.parallelFor(0, static_cast<unsigned int>(nbRows * nbCols), [&](unsigned int begin, unsigned int end) {
+      std::vector<int> hist(transferSize), cdfs(transferSize);
+      for (unsigned int k = begin; k < end; ++k) {
+        createHistogram(blockRadius, binOf, cs[k % nbCols], rs[k / nbCols], I1, hist);
+        const std::vector<float> transfer = createTransfer(hist, limit, cdfs);
+        std::copy(transfer.begin(), transfer.end(), transfers.begin() + static_cast<std::ptrdiff_t>(k * transferSize));
       }
-      else {
-        createHistogram(blockRadius, bins, cs[0], rs[r1], I1, hist);
-        br = createTransfer(hist, limit, cdfs);
+    }, 1);
+
+    // Tiles around each column, and weight of the left ones
+    const int width = static_cast<int>(I1.getWidth());
+    std::vector<int> col0(static_cast<size_t>(width)), col1(static_cast<size_t>(width));
+    std::vector<float> wxs(static_cast<size_t>(width));
+    for (int c = 0, x = 0; c <= nbCols; ++c) {
+      int c0 = std::max<int>(0, c - 1);
+      int c1 = std::min<int>(nbCols - 1, c);
+      int dc = cs[c1] - cs[c0];
+      int xMax = (c < nbCols ? cs[c1] : width);
+      for (; x < xMax; ++x) {
+        col0[x] = c0;
+        col1[x] = c1;
+        wxs[x] = static_cast<float>(cs[c1] - x) / dc;
       }
+    }
 
-      int yMin = (r == 0 ? 0 : rs[r0]);
-      int yMax = (r < static_cast<int>(rs.size()) ? rs[r1] : I1.getHeight());
-      int cs_size = static_cast<int>(cs.size());
-      for (int c = 0; c <= cs_size; ++c) {
-        int c0 = std::max<int>(0, c - 1);
-        int c1 = std::min<int>(static_cast<int>(cs.size()) - 1, c);
-        int dc = cs[c1] - cs[c0];
-        tl = tr;
-        bl = br;
-        if (c0 != c1) {
-          createHistogram(blockRadius, bins, cs[c1], rs[r0], I1, hist);
-          tr = createTransfer(hist, limit, cdfs);
-          if (r0 == r1) {
-            br = tr;
-          }
-          else {
-            createHistogram(blockRadius, bins, cs[c1], rs[r1], I1, hist);
-            br = createTransfer(hist, limit, cdfs);
-          }
+    // Bilinear interpolation of the transfer functions of the four tiles around each pixel
+    pool.parallelFor(0, I1.getHeight(), [&](unsigned int begin, unsigned int end) {
+      int r = 0;
+      for (int y = static_cast<int>(begin); y < static_cast<int>(end); ++y) {
+        while ((r < nbRows) && (y >= rs[r])) {
+          ++r;
         }
-
-        int xMin = (c == 0 ? 0 : cs[c0]);
-        int xMax = (c < static_cast<int>(cs.size()) ? cs[c1] : I1.getWidth());
-        for (int y = yMin; y < yMax; ++y) {
-          float wy = static_cast<float>(rs[r1] - y) / dr;
-          for (int x = xMin; x < xMax; ++x) {
-            float wx = static_cast<float>(cs[c1] - x) / dc;
-            int v = fastRound((I1[y][x] / 255.0f) * bins);
-            float t00 = tl[v];
-            float t01 = tr[v];
-            float t10 = bl[v];
-            float t11 = br[v];
-            float t0 = (c0 == c1) ? t00 : ((wx * t00) + ((1.0f - wx) * t01));
-            float t1 = (c0 == c1) ? t10 : ((wx * t10) + ((1.0f - wx) * t11));
-            float t = (r0 == r1) ? t0 : ((wy * t0) + ((1.0f - wy) * t1));
-            const int maxPixelIntensity = 255;
-            I2[y][x] = std::max<unsigned char>(0, std::min<unsigned char>(maxPixelIntensity, fastRound(t * 255.0f)));
-          }
+        int r0 = std::max<int>(0, r - 1);
+        int r1 = std::min<int>(nbRows - 1, r);
+        int dr = rs[r1] - rs[r0];
+        float wy = static_cast<float>(rs[r1] - y) / dr;
+        const float *top = &transfers[static_cast<size_t>(r0 * nbCols) * transferSize];
+        const float *bottom = &transfers[static_cast<size_t>(r1 * nbCols) * transferSize];
+        const unsigned char *src = I1[y];
+        unsigned char *dst = I2[y];
+        for (int x = 0; x < width; ++x) {
+          int c0 = col0[x], c1 = col1[x];
+          float wx = wxs[x];
+          int v = binOf[src[x]];
+          float t00 = top[(c0 * transferSize) + v];
+          float t01 = top[(c1 * transferSize) + v];
+          float t10 = bottom[(c0 * transferSize) + v];
+          float t11 = bottom[(c1 * transferSize) + v];
+          float t0 = (c0 == c1) ? t00 : ((wx * t00) + ((1.0f - wx) * t01));
+          float t1 = (c0 == c1) ? t10 : ((wx * t10) + ((1.0f - wx) * t11));
+          float t = (r0 == r1) ? t0 : ((wy * t0) + ((1.0f - wy) * t1));
+          const int maxPixelIntensity = 255;
+          dst[x] = std::max<unsigned char>(0, std::min<unsigned char>(maxPixelIntensity, fastRound(t * 255.0f)));
         }
       }
-    }
+    });
   }
   else {
-    std::vector<int> hist(bins + 1), prev_hist(bins + 1), clippedHist(bins + 1);
-    bool first = true;
-    int xMin0 = 0;
-    int xMax0 = std::min<int>(static_cast<int>(I1.getWidth()), blockRadius);
-    int i1_height = static_cast<int>(I1.getHeight());
-    for (int y = 0; y < i1_height; ++y) {
-      int yMin = std::max<int>(0, y - static_cast<int>(blockRadius));
-      int yMax = std::min<int>(static_cast<int>(I1.getHeight()), y + blockRadius + 1);
-      int h = yMax - yMin;
-
-      if (first) {
-        first = false;
-        // Compute histogram for the block at (0,0)
-        for (int yi = yMin; yi < yMax; ++yi) {
-          for (int xi = xMin0; xi < xMax0; ++xi) {
-            ++hist[fastRound((I1[yi][xi] / 255.0f) * bins)];
+    // Bands of rows processed in parallel, each one with its own sliding histogram
+    pool.parallelFor(0, I1.getHeight(), [&](unsigned int begin, unsigned int end) {
+      std::vector<int> hist(bins + 1), prev_hist(bins + 1), clippedHist(bins + 1);
+      bool first = true;
+      int xMin0 = 0;
+      int xMax0 = std::min<int>(static_cast<int>(I1.getWidth()), blockRadius);
+      for (int y = static_cast<int>(begin); y < static_cast<int>(end); ++y) {
+        int yMin = std::max<int>(0, y - static_cast<int>(blockRadius));
+        int yMax = std::min<int>(static_cast<int>(I1.getHeight()), y + blockRadius + 1);
+        int h = yMax - yMin;
+
+        if (first) {
+          first = false;
+          // Compute histogram for the block at (0,y)
+          std::fill(hist.begin(), hist.end(), 0);
+          for (int yi = yMin; yi < yMax; ++yi) {
+            for (int xi = xMin0; xi < xMax0; ++xi) {
+              ++hist[binOf[I1[yi][xi]]];
+            }
           }
         }
-      }
-      else {
-        hist = prev_hist;
-
-        if (yMin > 0) {
-          int yMin1 = yMin - 1;
-          // Sliding histogram, remove top
-          for (int xi = xMin0; xi < xMax0; ++xi) {
-            --hist[fastRound((I1[yMin1][xi] / 255.0f) * bins)];
+        else {
+          hist = prev_hist;
+
+          if (yMin > 0) {
+            int yMin1 = yMin - 1;
+            // Sliding histogram, remove top
+            for (int xi = xMin0; xi < xMax0; ++xi) {
+              --hist[binOf[I1[yMin1][xi]]];
+            }
           }
-        }
 
-        if ((y + blockRadius) < static_cast<int>(I1.getHeight())) {
-          int yMax1 = yMax - 1;
-          // Sliding histogram, add bottom
-          for (int xi = xMin0; xi < xMax0; ++xi) {
-            ++hist[fastRound((I1[yMax1][xi] / 255.0f) * bins)];
+          if ((y + blockRadius) < static_cast<int>(I1.getHeight())) {
+            int yMax1 = yMax - 1;
+            // Sliding histogram, add bottom
+            for (int xi = xMin0; xi < xMax0; ++xi) {
+              ++hist[binOf[I1[yMax1][xi]]];
+            }
           }
         }
-      }
-      prev_hist = hist;
-
-      int i1_width = static_cast<int>(I1.getWidth());
-      for (int x = 0; x < i1_width; ++x) {
-        int xMin = std::max<int>(0, x - static_cast<int>(blockRadius));
-        int xMax = x + blockRadius + 1;
-
-        if (xMin > 0) {
-          int xMin1 = xMin - 1;
-          // Sliding histogram, remove left
-          for (int yi = yMin; yi < yMax; ++yi) {
-            --hist[fastRound((I1[yi][xMin1] / 255.0f) * bins)];
+        prev_hist = hist;
+
+        int i1_width = static_cast<int>(I1.getWidth());
+        for (int x = 0; x < i1_width; ++x) {
+          int xMin = std::max<int>(0, x - static_cast<int>(blockRadius));
+          int xMax = x + blockRadius + 1;
+
+          if (xMin > 0) {
+            int xMin1 = xMin - 1;
+            // Sliding histogram, remove left
+            for (int yi = yMin; yi < yMax; ++yi) {
+              --hist[binOf[I1[yi][xMin1]]];
+            }
           }
-        }
 
-        if (xMax <= static_cast<int>(I1.getWidth())) {
-          int xMax1 = xMax - 1;
-          // Sliding histogram, add right
-          for (int yi = yMin; yi < yMax; ++yi) {
-            ++hist[fastRound((I1[yi][xMax1] / 255.0f) * bins)];
+          if (xMax <= static_cast<int>(I1.getWidth())) {
+            int xMax1 = xMax - 1;
+            // Sliding histogram, add right
+            for (int yi = yMin; yi < yMax; ++yi) {
+              ++hist[binOf[I1[yi][xMax1]]];
+            }
           }
-        }
 
-        int v = fastRound((I1[y][x] / 255.0f) * bins);
-        int w = std::min<int>(static_cast<int>(I1.getWidth()), xMax) - xMin;
-        int n = h * w;
-        int limit = static_cast<int>(((slope * n) / bins) + 0.5f);
-        I2[y][x] = fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
+          int v = binOf[I1[y][x]];
+          int w = std::min<int>(static_cast<int>(I1.getWidth()), xMax) - xMin;
+          int n = h * w;
+          int limit = static_cast<int>(((slope * n) / bins) + 0.5f);
+          I2[y][x] = fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
+        }
       }
-    }
+    });
   }
 }
 
@@ -440,11 +466,13 @@ void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int
 
   vpImageConvert::split(I1, &pR, &pG, &pB, &pa);
 
-  // Apply CLAHE independently on RGB channels
+  // Apply CLAHE independently on RGB channels, concurrently
   vpImage<unsigned char> resR, resG, resB;
-  clahe(pR, resR, blockRadius, bins, slope, fast);
-  clahe(pG, resG, blockRadius, bins, slope, fast);
-  clahe(pB, resB, blockRadius, bins, slope, fast);
+  vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
+  group.run([&]() { clahe(pR, resR, blockRadius, bins, slope, fast); });
+  group.run([&]() { clahe(pG, resG, blockRadius, bins, slope, fast); });
+  group.run([&]() { clahe(pB, resB, blockRadius, bins, slope, fast); });
+  group.wait();
 
   const unsigned int sizeRGBa = 4;
   I2.resize(I1.getHeight(), I1.getWidth());
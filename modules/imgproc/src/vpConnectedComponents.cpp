@@ -33,137 +33,343 @@
 
 /*!
   \file vpConnectedComponents.cpp
-  \brief Basic connected components.
+  \brief Connected components labeling with a two-pass union-find algorithm.
 */
 
-#include <queue>
+#include <algorithm>
+#include <stdint.h>
+
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace VISP_NAMESPACE_NAME
 {
+namespace
+{
+// Minimal number of rows of a strip labeled by a thread
+const unsigned int minStripHeight = 64;
 
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity);
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity);
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity);
-
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+/*
+ * Sums over the pixels of a provisional label. The sums are integers, so that the statistics of a component do not
+ * depend on the order in which its provisional labels are merged.
+ */
+struct vpComponentSums
 {
-  unsigned char currValue = I[i][j];
+  unsigned int area;
+  unsigned int left, top, right, bottom;
+  uint64_t su, sv, suu, suv, svv;
 
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
-    }
+  void init(unsigned int i, unsigned int j)
+  {
+    area = 0;
+    left = right = j;
+    top = bottom = i;
+    su = sv = suu = suv = svv = 0;
+  }
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
-    }
+  void add(unsigned int i, unsigned int j)
+  {
+    ++area;
+    left = std::min<unsigned int>(left, j);
+    right = std::max<unsigned int>(right, j);
+    bottom = i;
+    su += j;
+    sv += i;
+    suu += static_cast<uint64_t>(j) * j;
+    suv += static_cast<uint64_t>(i) * j;
+    svv += static_cast<uint64_t>(i) * i;
+  }
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
-    }
+  void merge(const vpComponentSums &other)
+  {
+    area += other.area;
+    left = std::min<unsigned int>(left, other.left);
+    top = std::min<unsigned int>(top, other.top);
+    right = std::max<unsigned int>(right, other.right);
+    bottom = std::max<unsigned int>(bottom, other.bottom);
+    su += other.su;
+    sv += other.sv;
+    suu += other.suu;
+    suv += other.suv;
+    svv += other.svv;
+  }
+};
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
-    }
+/*
+ * Rows [begin, end[ of the image, labeled independently from the other strips. The provisional labels of the strip
+ * start from 1, the label 0 being the background.
+ */
+struct vpLabelStrip
+{
+  unsigned int begin, end;
+  std::vector<int> parent;
+  std::vector<vpComponentSums> sums;
+};
+
+int findRoot(std::vector<int> &parent, int label)
+{
+  int root = label;
+  while (parent[root] != root) {
+    root = parent[root];
   }
-  else {
-    for (int cpt1 = -1; cpt1 <= 1; ++cpt1) {
-      for (int cpt2 = -1; cpt2 <= 1; ++cpt2) {
-        // Everything except the current position
-        if ((cpt1 != 0) || (cpt2 != 0)) {
-          if (I[static_cast<int>(i) + cpt1][static_cast<int>(j) + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint(static_cast<int>(i) + cpt1, static_cast<int>(j) + cpt2));
-          }
-        }
-      }
-    }
+  // Path compression
+  while (parent[label] != root) {
+    const int next = parent[label];
+    parent[label] = root;
+    label = next;
   }
+  return root;
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+// The root of a set is its smallest label, that is the first one created in a row by row scan
+int unite(std::vector<int> &parent, int a, int b)
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = static_cast<unsigned int>(imPt.get_i());
-    unsigned int j = static_cast<unsigned int>(imPt.get_j());
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
-    }
+  const int ra = findRoot(parent, a), rb = findRoot(parent, b);
+  if (ra < rb) {
+    parent[rb] = ra;
+    return ra;
   }
+  parent[ra] = rb;
+  return rb;
 }
 
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity)
+int newLabel(vpLabelStrip &strip, bool computeStats, unsigned int i, unsigned int j)
 {
-  if (I.getSize() == 0) {
-    return;
+  const int label = static_cast<int>(strip.parent.size());
+  strip.parent.push_back(label);
+  if (computeStats) {
+    vpComponentSums sums;
+    sums.init(i, j);
+    strip.sums.push_back(sums);
   }
+  return label;
+}
 
-  labels.resize(I.getHeight(), I.getWidth());
+/*
+ * First pass over a strip: each pixel takes the label of an already visited neighbor with the same value, the
+ * labels of the neighbors being merged when they differ. With the 8-connexity, the neighbors are tested in the
+ * order of the decision tree of Wu et al., so that at most one union is needed per pixel: when the top neighbor
+ * matches, the other visited neighbors that match are already in its set.
+ */
+void labelStrip(const vpImage<unsigned char> &I, vpImage<int> &labels, vpLabelStrip &strip, bool connexity8,
+                bool computeStats)
+{
+  const unsigned int width = I.getWidth();
+  strip.parent.assign(1, 0);
+  strip.sums.assign(computeStats ? 1 : 0, vpComponentSums());
 
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  unsigned int i_copy_height = I_copy.getHeight();
-  for (unsigned int i = 0; i < i_copy_height; ++i) {
-    if ((i == 0) || (i == (I_copy.getHeight() - 1))) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
-    }
-    else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
+  for (unsigned int i = strip.begin; i < strip.end; ++i) {
+    const unsigned char *row = I[i];
+    const unsigned char *prevRow = (i > strip.begin) ? I[i - 1] : nullptr;
+    int *labelRow = labels[i];
+    const int *prevLabelRow = (i > strip.begin) ? labels[i - 1] : nullptr;
+
+    for (unsigned int j = 0; j < width; ++j) {
+      const unsigned char value = row[j];
+      if (value == 0) {
+        labelRow[j] = 0;
+        continue;
+      }
+      const bool left = (j > 0) && (row[j - 1] == value);
+      const bool top = (prevRow != nullptr) && (prevRow[j] == value);
+      int label;
+      if (connexity8) {
+        const bool topLeft = (prevRow != nullptr) && (j > 0) && (prevRow[j - 1] == value);
+        const bool topRight = (prevRow != nullptr) && ((j + 1) < width) && (prevRow[j + 1] == value);
+        if (top) {
+          label = prevLabelRow[j];
+        }
+        else if (topRight) {
+          label = prevLabelRow[j + 1];
+          if (topLeft) {
+            label = unite(strip.parent, label, prevLabelRow[j - 1]);
+          }
+          else if (left) {
+            label = unite(strip.parent, label, labelRow[j - 1]);
+          }
+        }
+        else if (topLeft) {
+          label = prevLabelRow[j - 1];
+        }
+        else if (left) {
+          label = labelRow[j - 1];
+        }
+        else {
+          label = newLabel(strip, computeStats, i, j);
+        }
+      }
+      else {
+        if (top) {
+          label = prevLabelRow[j];
+          if (left && (labelRow[j - 1] != label)) {
+            label = unite(strip.parent, label, labelRow[j - 1]);
+          }
+        }
+        else if (left) {
+          label = labelRow[j - 1];
+        }
+        else {
+          label = newLabel(strip, computeStats, i, j);
+        }
+      }
+      labelRow[j] = label;
+      if (computeStats) {
+        strip.sums[label].add(i, j);
+      }
     }
   }
+}
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
-
-  int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
+void labelComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                     std::vector<vpConnectedComponentStats> *stats,
+                     const vpImageMorphology::vpConnexityType &connexity)
+{
+  nbComponents = 0;
+  if (stats != nullptr) {
+    stats->clear();
+  }
+  if (I.getSize() == 0) {
+    return;
+  }
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  labels.resize(height, width);
+  const bool connexity8 = (connexity == vpImageMorphology::CONNEXITY_8);
+  const bool computeStats = (stats != nullptr);
 
-  unsigned int i_height = I.getHeight();
-  for (unsigned int cpt1 = 0; cpt1 < i_height; ++cpt1) {
-    unsigned int i = cpt1 + 1;
+  // First pass, in parallel over horizontal strips
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  const unsigned int nbStrips = std::max<unsigned int>(1, std::min<unsigned int>(pool.getNbThreads(),
+                                                                                 height / minStripHeight));
+  std::vector<vpLabelStrip> strips(nbStrips);
+  for (unsigned int s = 0; s < nbStrips; ++s) {
+    strips[s].begin = static_cast<unsigned int>((static_cast<uint64_t>(height) * s) / nbStrips);
+    strips[s].end = static_cast<unsigned int>((static_cast<uint64_t>(height) * (s + 1)) / nbStrips);
+  }
+  if (nbStrips == 1) {
+    labelStrip(I, labels, strips[0], connexity8, computeStats);
+  }
+  else {
+    pool.parallelFor(0, nbStrips, [&](unsigned int begin, unsigned int end) {
+      for (unsigned int s = begin; s < end; ++s) {
+        labelStrip(I, labels, strips[s], connexity8, computeStats);
+      }
+    }, 1);
+  }
 
-    unsigned int i_width = I.getWidth();
-    for (unsigned int cpt2 = 0; cpt2 < i_width; ++cpt2) {
-      unsigned int j = cpt2 + 1;
+  // Provisional labels of all the strips, the labels of a strip being shifted by the labels of the previous ones
+  std::vector<int> offsets(nbStrips);
+  size_t nbLabels = 1;
+  for (unsigned int s = 0; s < nbStrips; ++s) {
+    offsets[s] = static_cast<int>(nbLabels - 1);
+    nbLabels += strips[s].parent.size() - 1;
+  }
+  std::vector<int> parent(nbLabels);
+  parent[0] = 0;
+  for (unsigned int s = 0; s < nbStrips; ++s) {
+    for (size_t k = 1; k < strips[s].parent.size(); ++k) {
+      parent[offsets[s] + k] = strips[s].parent[k] + offsets[s];
+    }
+  }
 
-      if (I_copy[i][j] && (labels_copy[i][j] == 0)) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+  // Merge step, along the first row of each strip
+  for (unsigned int s = 1; s < nbStrips; ++s) {
+    const unsigned int i = strips[s].begin;
+    const unsigned char *row = I[i], *prevRow = I[i - 1];
+    const int *labelRow = labels[i], *prevLabelRow = labels[i - 1];
+    for (unsigned int j = 0; j < width; ++j) {
+      const unsigned char value = row[j];
+      if (value == 0) {
+        continue;
+      }
+      const int label = labelRow[j] + offsets[s];
+      const unsigned int jBegin = ((j > 0) && connexity8) ? (j - 1) : j;
+      const unsigned int jEnd = (((j + 1) < width) && connexity8) ? (j + 1) : j;
+      for (unsigned int k = jBegin; k <= jEnd; ++k) {
+        if (prevRow[k] == value) {
+          unite(parent, label, prevLabelRow[k] + offsets[s - 1]);
+        }
+      }
+    }
+  }
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+  // Final labels, in the order of the roots that are the first labels of their component in a row by row scan
+  std::vector<int> finalLabels(nbLabels, 0);
+  for (size_t k = 1; k < nbLabels; ++k) {
+    const int root = findRoot(parent, static_cast<int>(k));
+    if (root == static_cast<int>(k)) {
+      finalLabels[k] = ++nbComponents;
+    }
+    else {
+      finalLabels[k] = finalLabels[root];
+    }
+  }
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+  // Second pass
+  pool.parallelFor(0, nbStrips, [&](unsigned int begin, unsigned int end) {
+    for (unsigned int s = begin; s < end; ++s) {
+      const int *table = &finalLabels[offsets[s]];
+      for (unsigned int i = strips[s].begin; i < strips[s].end; ++i) {
+        int *labelRow = labels[i];
+        for (unsigned int j = 0; j < width; ++j) {
+          if (labelRow[j] != 0) {
+            labelRow[j] = table[labelRow[j]];
+          }
+        }
+      }
+    }
+  }, 1);
 
-        // Increment label
-        ++current_label;
+  if (computeStats) {
+    std::vector<vpComponentSums> sums(static_cast<size_t>(nbComponents));
+    std::vector<bool> initialized(static_cast<size_t>(nbComponents), false);
+    for (unsigned int s = 0; s < nbStrips; ++s) {
+      for (size_t k = 1; k < strips[s].sums.size(); ++k) {
+        const size_t c = static_cast<size_t>(finalLabels[offsets[s] + k] - 1);
+        if (initialized[c]) {
+          sums[c].merge(strips[s].sums[k]);
+        }
+        else {
+          sums[c] = strips[s].sums[k];
+          initialized[c] = true;
+        }
       }
     }
+
+    stats->resize(sums.size());
+    for (size_t c = 0; c < sums.size(); ++c) {
+      const vpComponentSums &sum = sums[c];
+      vpConnectedComponentStats &stat = (*stats)[c];
+      stat.area = sum.area;
+      stat.left = sum.left;
+      stat.top = sum.top;
+      stat.right = sum.right;
+      stat.bottom = sum.bottom;
+      stat.m10 = static_cast<double>(sum.su);
+      stat.m01 = static_cast<double>(sum.sv);
+      stat.m20 = static_cast<double>(sum.suu);
+      stat.m11 = static_cast<double>(sum.suv);
+      stat.m02 = static_cast<double>(sum.svv);
+      stat.u = stat.m10 / sum.area;
+      stat.v = stat.m01 / sum.area;
+      stat.mu20 = stat.m20 - (stat.u * stat.m10);
+      stat.mu11 = stat.m11 - (stat.u * stat.m01);
+      stat.mu02 = stat.m02 - (stat.v * stat.m01);
+    }
   }
-  unsigned int labels_height = labels.getHeight();
-  for (unsigned int i = 0; i < labels_height; ++i) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
-  }
+}
+} // namespace
 
-  nbComponents = current_label - 1;
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, nullptr, connexity);
+}
+
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         std::vector<vpConnectedComponentStats> &stats,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, &stats, connexity);
 }
 
 } // namespace
@@ -0,0 +1,212 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test CLAHE.
+ */
+/*!
+  \example catchCLAHE.cpp
+
+  \brief Test the Contrast Limited Adaptive Histogram Equalization against a direct computation, with several
+  threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+int toBin(unsigned char value, int bins) { return static_cast<int>(((value / 255.0f) * bins) + 0.5f); }
+
+// Clipping of the ImageJ plugin, the excess being redistributed until it does not change
+void clip(std::vector<int> &hist, int limit)
+{
+  const int length = static_cast<int>(hist.size());
+  int excess = 0, previousExcess;
+  do {
+    previousExcess = excess;
+    excess = 0;
+    for (int i = 0; i < length; ++i) {
+      if (hist[i] > limit) {
+        excess += hist[i] - limit;
+        hist[i] = limit;
+      }
+    }
+    for (int i = 0; i < length; ++i) {
+      hist[i] += excess / length;
+    }
+    if ((excess % length) != 0) {
+      const int step = (length - 1) / (excess % length);
+      for (int i = step / 2; i < length; i += step) {
+        ++hist[i];
+      }
+    }
+  } while (excess != previousExcess);
+}
+
+// Per-pixel CLAHE at a pixel, with the histogram of the block around the pixel computed from scratch
+unsigned char claheReference(const vpImage<unsigned char> &I, int y, int x, int blockRadius, int bins, float slope)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  std::vector<int> hist(static_cast<size_t>(bins + 1), 0);
+  const int yMin = std::max<int>(0, y - blockRadius), yMax = std::min<int>(height, y + blockRadius + 1);
+  const int xMin = std::max<int>(0, x - blockRadius), xMax = std::min<int>(width, x + blockRadius + 1);
+  for (int yi = yMin; yi < yMax; ++yi) {
+    for (int xi = xMin; xi < xMax; ++xi) {
+      ++hist[toBin(I[yi][xi], bins)];
+    }
+  }
+  clip(hist, static_cast<int>(((slope * ((yMax - yMin) * (xMax - xMin))) / bins) + 0.5f));
+
+  int hMin = bins;
+  for (int i = 0; i < bins; ++i) {
+    if (hist[i] != 0) {
+      hMin = i;
+      break;
+    }
+  }
+  const int v = toBin(I[y][x], bins);
+  int cdf = 0, cdfMax = 0;
+  for (int i = hMin; i <= bins; ++i) {
+    cdfMax += hist[i];
+    if (i <= v) {
+      cdf += hist[i];
+    }
+  }
+  const float t = (cdf - hist[hMin]) / static_cast<float>(cdfMax - hist[hMin]);
+  return static_cast<unsigned char>(static_cast<int>((t * 255.0f) + 0.5f));
+}
+
+// Smooth gradient with noise and a darker square, so that the blocks have different histograms
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width)
+{
+  vpUniRand rng(7);
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      int value = static_cast<int>((60 * j) / width) + static_cast<int>((40 * i) / height) + rng.uniform(0, 30);
+      if ((i > height / 4) && (i < height / 2) && (j > width / 3) && (j < (2 * width) / 3)) {
+        value /= 3;
+      }
+      I[i][j] = static_cast<unsigned char>(value);
+    }
+  }
+  return I;
+}
+} // namespace
+
+TEST_CASE("CLAHE", "[clahe]")
+{
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  const unsigned int nbThreads = pool.getNbThreads();
+
+  SECTION("Per-pixel version")
+  {
+    const vpImage<unsigned char> I = createImage(61, 83);
+    const int blockRadius = GENERATE(3, 10);
+    const int bins = GENERATE(64, 256);
+    vpImage<unsigned char> I_ref(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getHeight(); ++i) {
+      for (unsigned int j = 0; j < I.getWidth(); ++j) {
+        I_ref[i][j] = claheReference(I, static_cast<int>(i), static_cast<int>(j), blockRadius, bins, 3.0f);
+      }
+    }
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+      pool.setNbThreads(threads);
+      vpImage<unsigned char> I_res;
+      VISP_NAMESPACE_NAME::clahe(I, I_res, blockRadius, bins, 3.0f, false);
+      CHECK(I_res == I_ref);
+    }
+  }
+
+  SECTION("Fast version does not depend on the number of threads")
+  {
+    const vpImage<unsigned char> I = createImage(480, 640);
+    const int blockRadius = GENERATE(8, 31, 150);
+    pool.setNbThreads(1);
+    vpImage<unsigned char> I_res1;
+    VISP_NAMESPACE_NAME::clahe(I, I_res1, blockRadius, 256, 3.0f, true);
+    pool.setNbThreads(4);
+    vpImage<unsigned char> I_res4;
+    VISP_NAMESPACE_NAME::clahe(I, I_res4, blockRadius, 256, 3.0f, true);
+    CHECK(I_res1 == I_res4);
+
+    // At the center of the top left box, the intensity transfer function is the one of the box
+    const int center = blockRadius + 1;
+    CHECK(I_res4[center][center] == claheReference(I, center, center, blockRadius, 256, 3.0f));
+  }
+
+  SECTION("Color image")
+  {
+    vpImage<vpRGBa> I(120, 160);
+    const vpImage<unsigned char> I_gray = createImage(120, 160);
+    for (unsigned int k = 0; k < I.getSize(); ++k) {
+      I.bitmap[k] = vpRGBa(I_gray.bitmap[k], static_cast<unsigned char>(255 - I_gray.bitmap[k]),
+                           static_cast<unsigned char>(I_gray.bitmap[k] / 2), 128);
+    }
+    vpImage<vpRGBa> I_res;
+    VISP_NAMESPACE_NAME::clahe(I, I_res, 20, 256, 3.0f, true);
+    vpImage<unsigned char> I_red;
+    VISP_NAMESPACE_NAME::clahe(I_gray, I_red, 20, 256, 3.0f, true);
+    for (unsigned int k = 0; k < I.getSize(); ++k) {
+      CHECK(I_res.bitmap[k].R == I_red.bitmap[k]);
+      CHECK(I_res.bitmap[k].A == 128);
+    }
+  }
+
+  pool.setNbThreads(nbThreads);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test connected components labeling.
+ */
+/*!
+  \example catchConnectedComponents.cpp
+
+  \brief Test connected components labeling and statistics against a flood fill, with several strips of threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+
+#include <queue>
+
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Label the components with a flood fill started from each unlabeled pixel in a row by row scan
+int floodFillLabels(const vpImage<unsigned char> &I, vpImage<int> &labels, bool connexity8)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  labels.resize(I.getHeight(), I.getWidth(), 0);
+  int nbComponents = 0;
+  for (int i = 0; i < height; ++i) {
+    for (int j = 0; j < width; ++j) {
+      if ((I[i][j] == 0) || (labels[i][j] != 0)) {
+        continue;
+      }
+      ++nbComponents;
+      std::queue<std::pair<int, int> > queue;
+      queue.push(std::make_pair(i, j));
+      labels[i][j] = nbComponents;
+      while (!queue.empty()) {
+        const std::pair<int, int> p = queue.front();
+        queue.pop();
+        for (int di = -1; di <= 1; ++di) {
+          for (int dj = -1; dj <= 1; ++dj) {
+            const int ni = p.first + di, nj = p.second + dj;
+            if (((di == 0) && (dj == 0)) || ((!connexity8) && (di != 0) && (dj != 0)) || (ni < 0) || (nj < 0) ||
+                (ni >= height) || (nj >= width)) {
+              continue;
+            }
+            if ((I[ni][nj] == I[i][j]) && (labels[ni][nj] == 0)) {
+              labels[ni][nj] = nbComponents;
+              queue.push(std::make_pair(ni, nj));
+            }
+          }
+        }
+      }
+    }
+  }
+  return nbComponents;
+}
+
+// Blobs of a few values, with thin diagonal structures that are only connected with the 8-connexity
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width, long seed)
+{
+  vpUniRand rng(seed);
+  vpImage<unsigned char> I(height, width, 0);
+  for (unsigned int k = 0; k < (height * width) / 40; ++k) {
+    const unsigned int i = static_cast<unsigned int>(rng.uniform(0, static_cast<int>(height)));
+    const unsigned int j = static_cast<unsigned int>(rng.uniform(0, static_cast<int>(width)));
+    const unsigned char value = static_cast<unsigned char>(rng.uniform(1, 4));
+    const unsigned int size = static_cast<unsigned int>(rng.uniform(1, 6));
+    const bool diagonal = rng.uniform(0, 4) == 0;
+    for (unsigned int di = 0; di < size; ++di) {
+      for (unsigned int dj = 0; dj < size; ++dj) {
+        if ((i + di < height) && (j + dj < width) && ((!diagonal) || (di == dj))) {
+          I[i + di][j + dj] = value;
+        }
+      }
+    }
+  }
+  return I;
+}
+} // namespace
+
+TEST_CASE("Connected components labeling", "[connected_components]")
+{
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  const unsigned int nbThreads = pool.getNbThreads();
+  const unsigned int threads = GENERATE(1, 3, 4);
+  pool.setNbThreads(threads);
+
+  const bool connexity8 = GENERATE(false, true);
+  const vpImageMorphology::vpConnexityType connexity =
+    connexity8 ? vpImageMorphology::CONNEXITY_8 : vpImageMorphology::CONNEXITY_4;
+
+  SECTION("Same labels as a flood fill")
+  {
+    const unsigned int sizes[][2] = { { 1, 1 }, { 1, 57 }, { 57, 1 }, { 40, 30 }, { 301, 211 }, { 517, 64 } };
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      const vpImage<unsigned char> I = createImage(sizes[s][0], sizes[s][1], static_cast<long>(s) + 1);
+      vpImage<int> labels, labels_ref;
+      int nbComponents = -1;
+      const int nbComponents_ref = floodFillLabels(I, labels_ref, connexity8);
+      VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, connexity);
+      CHECK(nbComponents == nbComponents_ref);
+      CHECK(labels == labels_ref);
+    }
+  }
+
+  SECTION("Statistics of the components")
+  {
+    const vpImage<unsigned char> I = createImage(400, 150, 42);
+    vpImage<int> labels;
+    int nbComponents = 0;
+    std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats;
+    VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats, connexity);
+    REQUIRE(stats.size() == static_cast<size_t>(nbComponents));
+
+    std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> expected(stats.size());
+    for (size_t c = 0; c < expected.size(); ++c) {
+      expected[c].area = 0;
+      expected[c].left = expected[c].top = std::numeric_limits<unsigned int>::max();
+      expected[c].right = expected[c].bottom = 0;
+      expected[c].m10 = expected[c].m01 = expected[c].m20 = expected[c].m11 = expected[c].m02 = 0.;
+    }
+    for (unsigned int i = 0; i < I.getHeight(); ++i) {
+      for (unsigned int j = 0; j < I.getWidth(); ++j) {
+        if (labels[i][j] > 0) {
+          VISP_NAMESPACE_NAME::vpConnectedComponentStats &e = expected[static_cast<size_t>(labels[i][j] - 1)];
+          ++e.area;
+          e.left = std::min<unsigned int>(e.left, j);
+          e.top = std::min<unsigned int>(e.top, i);
+          e.right = std::max<unsigned int>(e.right, j);
+          e.bottom = std::max<unsigned int>(e.bottom, i);
+          e.m10 += j;
+          e.m01 += i;
+          e.m20 += static_cast<double>(j * j);
+          e.m11 += static_cast<double>(i * j);
+          e.m02 += static_cast<double>(i * i);
+        }
+      }
+    }
+    for (size_t c = 0; c < stats.size(); ++c) {
+      CHECK(stats[c].area == expected[c].area);
+      CHECK(stats[c].left == expected[c].left);
+      CHECK(stats[c].top == expected[c].top);
+      CHECK(stats[c].right == expected[c].right);
+      CHECK(stats[c].bottom == expected[c].bottom);
+      CHECK(stats[c].m10 == expected[c].m10);
+      CHECK(stats[c].m11 == expected[c].m11);
+      CHECK(stats[c].m02 == expected[c].m02);
+      CHECK(stats[c].u == Catch::Approx(expected[c].m10 / expected[c].area));
+      CHECK(stats[c].v == Catch::Approx(expected[c].m01 / expected[c].area));
+      const double mu20 = expected[c].m20 - ((expected[c].m10 * expected[c].m10) / expected[c].area);
+      CHECK(stats[c].mu20 == Catch::Approx(mu20).margin(1e-9));
+      CHECK(stats[c].mu20 >= -1e-9);
+    }
+  }
+
+  SECTION("Empty image")
+  {
+    vpImage<unsigned char> I;
+    vpImage<int> labels;
+    int nbComponents = -1;
+    std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats(2);
+    VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats, connexity);
+    CHECK(nbComponents == 0);
+    CHECK(stats.empty());
+  }
+
+  pool.setNbThreads(nbThreads);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -46,6 +46,8 @@
 
 BEGIN_VISP_NAMESPACE
 
+class vpRecordingReader;
+
 /*!
  * \class vpDiskGrabber
  *
@@ -104,6 +106,14 @@ BEGIN_VISP_NAMESPACE
  *   }
  * }
  * \endcode
+ *
+ * When the images are read in sequence, setPrefetching() enables a read-ahead mode where the next images are read
+ * and decoded by background threads, while the previous ones are processed. The images are still returned in the
+ * order of the sequence.
+ *
+ * When the generic name is a recording written with vpRecordingWriter (extension `.vprec`), the image number is the
+ * index of the frame in the first stream of grayscale or color images of the recording, or in the first stream of
+ * float images for vpImage<float>. The frames are read from the memory mapped file, without decoding step.
 */
 class VISP_EXPORT vpDiskGrabber : public vpFrameGrabber
 {
@@ -122,6 +132,12 @@ private:
   std::string m_generic_name;
   std::string m_image_name;
 
+  unsigned int m_prefetch_size;    //!< number of images read ahead, 0 to disable prefetching
+  unsigned int m_prefetch_threads; //!< number of threads that read the images ahead
+  class vpPrefetcher;
+  vpPrefetcher *m_prefetcher;      //!< threads and decoded images, created at the first acquisition
+  vpRecordingReader *m_recording;  //!< recording opened at the first acquisition of a frame of a .vprec file
+
 public:
   /*!
    * Default constructor.
@@ -139,10 +155,9 @@ public:
   VP_EXPLICIT vpDiskGrabber(const std::string &genericName);
 
   /*!
-   * Destructor.
-   * In fact nothing to destroy...
+   * Destructor. Stop the threads that read the images ahead.
    */
-  virtual ~vpDiskGrabber() VP_OVERRIDE { }
+  virtual ~vpDiskGrabber() VP_OVERRIDE;
 
   /*!
    * Copy operator.
@@ -278,10 +293,17 @@ public:
    */
   void setNumberOfZero(unsigned int noz) { m_number_of_zero = noz; }
 
+  void setPrefetching(unsigned int nbImages, unsigned int nbThreads = 2);
+
   /*!
    * Set the step between two images.
    */
   void setStep(long step) { m_image_step = step; }
+
+private:
+  std::string buildImageName(long number) const;
+  template <typename Type> bool prefetch(vpImage<Type> &I, long image_number);
+  template <typename Type> bool readRecording(vpImage<Type> &I, long image_number);
 };
 
 END_VISP_NAMESPACE
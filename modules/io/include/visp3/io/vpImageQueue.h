@@ -39,10 +39,11 @@
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
 
 #include <condition_variable>
+#include <iostream>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpIoTools.h>
@@ -60,6 +61,12 @@ BEGIN_VISP_NAMESPACE
 
   This call is to use with vpImageStorageWorker.
 
+  The images are stored in a ring of preallocated slots. The image buffers are recycled between the producer and the
+  consumers, so that no memory is allocated once the queue reached its steady state, and the images are copied
+  outside of the lock. When the queue is full, setQueuePolicy() selects if the oldest image is dropped (default),
+  the new image is dropped, or the producer waits for a consumer to free a slot. Dropped images are counted, see
+  getNbDroppedImages().
+
 */
 template <class Type> class vpImageQueue
 {
@@ -67,6 +74,14 @@ public:
   struct vpCancelled_t
   { };
 
+  //! Behavior of push() when the queue is full
+  typedef enum
+  {
+    DROP_OLDEST, //!< The oldest image of the queue is dropped to store the new one
+    DROP_NEWEST, //!< The new image is dropped
+    BLOCK        //!< Wait until a consumer pops an image
+  } vpQueuePolicy;
+
   /*!
    * Queue (FIFO) constructor. By default the max queue size is set to 1024*8.
    *
@@ -75,7 +90,8 @@ public:
    * \param[in] record_mode : 0 to record a sequence of images, 1 to record single images.
    */
   vpImageQueue(const std::string &seqname, int record_mode)
-    : m_cancelled(false), m_cond(), m_queue_image(), m_queue_data(), m_maxQueueSize(1024 * 8), m_mutex(),
+    : m_cancelled(false), m_cond(), m_cond_not_full(), m_slots(1024 * 8), m_free_images(), m_head(0), m_size(0),
+    m_policy(DROP_OLDEST), m_nb_pushed(0), m_nb_popped(0), m_nb_dropped(0), m_max_size(0), m_mutex(),
     m_seqname(seqname), m_recording_mode(record_mode), m_start_recording(false), m_directory_to_create(false),
     m_recording_trigger(false)
   {
@@ -98,6 +114,52 @@ public:
     std::cout << "Wait to finish saving images..." << std::endl;
     m_cancelled = true;
     m_cond.notify_all();
+    m_cond_not_full.notify_all();
+  }
+
+  /*!
+   * Return the highest number of images that were waiting in the queue.
+   */
+  size_t getMaxQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_size;
+  }
+
+  /*!
+   * Return the number of images dropped because the queue was full.
+   */
+  unsigned int getNbDroppedImages() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nb_dropped;
+  }
+
+  /*!
+   * Return the number of images pushed in the queue, including the dropped ones.
+   */
+  unsigned int getNbPushedImages() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nb_pushed;
+  }
+
+  /*!
+   * Return the number of images waiting in the queue.
+   */
+  size_t getQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+  }
+
+  /*!
+   * Return the behavior of push() when the queue is full.
+   */
+  vpQueuePolicy getQueuePolicy() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_policy;
   }
 
   /*!
@@ -116,66 +178,107 @@ public:
   std::string getSeqName() const { return m_seqname; }
 
   /*!
-   * Pop the image to save from the queue (FIFO).
+   * Pop the image to save from the queue (FIFO). Several threads may pop images concurrently.
    *
-   * \param[out] I : Image to record.
-   * \param[out] data : Data to record.
+   * \param[out] I : Image to record. Its previous buffer is recycled by the queue.
+   * \param[out] data : Data to record, empty if no data was pushed with the image.
    *
    */
   void pop(vpImage<Type> &I, std::string &data)
+  {
+    unsigned int index;
+    pop(I, data, index);
+  }
+
+  /*!
+   * Pop the image to save from the queue (FIFO). Several threads may pop images concurrently.
+   *
+   * \param[out] I : Image to record. Its previous buffer is recycled by the queue.
+   * \param[out] data : Data to record, empty if no data was pushed with the image.
+   * \param[out] index : Index of the image among the popped images, starting from 1. It gives the order of the images
+   * when they are saved by several threads.
+   */
+  void pop(vpImage<Type> &I, std::string &data, unsigned int &index)
   {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    while (m_queue_image.empty()) {
+    while (m_size == 0) {
       if (m_cancelled) {
         throw vpCancelled_t();
       }
 
       m_cond.wait(lock);
 
-      if (m_cancelled) {
+      if (m_cancelled && (m_size == 0)) {
         throw vpCancelled_t();
       }
     }
 
-    I = m_queue_image.front();
+    vpSlot &slot = m_slots[m_head];
+    swap(I, slot.image);
+    data.swap(slot.data);
+    slot.data.clear();
+    recycle(slot.image);
+    m_head = (m_head + 1) % m_slots.size();
+    --m_size;
+    index = ++m_nb_popped;
 
-    m_queue_image.pop();
-
-    if (!m_queue_data.empty()) {
-      data = m_queue_data.front();
-      m_queue_data.pop();
-    }
+    m_cond_not_full.notify_one();
   }
 
   /*!
-   * Push data to save in the queue (FIFO).
+   * Push data to save in the queue (FIFO). When the queue is full, the image is handled according to the policy set
+   * with setQueuePolicy().
    *
    * \param[in] I : Image to record.
    * \param[in] data : Data to record.
+   * \return false when the new image was dropped.
    */
-  void push(const vpImage<Type> &I, std::string *data)
+  bool push(const vpImage<Type> &I, std::string *data)
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    m_queue_image.push(I);
-
-    if (data != nullptr) {
-      m_queue_data.push(*data);
+    // Copy the image in a recycled buffer, without holding the lock
+    vpImage<Type> image;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_free_images.empty()) {
+        swap(image, m_free_images.back());
+        m_free_images.pop_back();
+      }
     }
+    image = I;
 
-    // Pop extra data in the queue
-    while (m_queue_image.size() > m_maxQueueSize) {
-      m_queue_image.pop();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_nb_pushed;
+    if (m_size == m_slots.size()) {
+      if (m_policy == BLOCK) {
+        while ((m_size == m_slots.size()) && !m_cancelled) {
+          m_cond_not_full.wait(lock);
+        }
+      }
+      else if (m_policy == DROP_OLDEST) {
+        dropOldest();
+        notifyDrop();
+      }
+      if (m_size == m_slots.size()) {
+        notifyDrop();
+        recycle(image);
+        return false;
+      }
     }
 
+    vpSlot &slot = m_slots[(m_head + m_size) % m_slots.size()];
+    swap(slot.image, image);
+    recycle(image);
     if (data != nullptr) {
-      while (m_queue_data.size() > m_maxQueueSize) {
-        m_queue_data.pop();
-      }
+      slot.data = *data;
+    }
+    ++m_size;
+    if (m_size > m_max_size) {
+      m_max_size = m_size;
     }
 
     m_cond.notify_one();
+    return true;
   }
 
   /*!
@@ -265,18 +368,94 @@ public:
   }
 
   /*!
-   * Set queue size.
+   * Set queue size. When the queue contains more images, the oldest ones are dropped.
    * \param[in] max_queue_size : Queue size.
    */
-  void setMaxQueueSize(const size_t max_queue_size) { m_maxQueueSize = max_queue_size; }
+  void setMaxQueueSize(const size_t max_queue_size)
+  {
+    if (max_queue_size == 0) {
+      throw(vpException(vpException::badValue, "The size of the image queue should be positive"));
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_size > max_queue_size) {
+      dropOldest();
+      notifyDrop();
+    }
+    std::vector<vpSlot> slots(max_queue_size);
+    for (size_t i = 0; i < m_size; ++i) {
+      vpSlot &slot = m_slots[(m_head + i) % m_slots.size()];
+      swap(slots[i].image, slot.image);
+      slots[i].data.swap(slot.data);
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+    m_cond_not_full.notify_all();
+  }
+
+  /*!
+   * Set the behavior of push() when the queue is full. By default the oldest image is dropped.
+   * \param[in] policy : Queue policy.
+   */
+  void setQueuePolicy(vpQueuePolicy policy)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_policy = policy;
+    m_cond_not_full.notify_all();
+  }
 
 private:
+  //! Image waiting in the queue, and its additional data
+  struct vpSlot
+  {
+    vpImage<Type> image;
+    std::string data;
+  };
+
+  //! Drop the oldest image of the queue. The mutex must be locked.
+  void dropOldest()
+  {
+    if (m_size > 0) {
+      vpSlot &slot = m_slots[m_head];
+      recycle(slot.image);
+      slot.data.clear();
+      m_head = (m_head + 1) % m_slots.size();
+      --m_size;
+    }
+  }
+
+  //! Count a dropped image, and warn the first time. The mutex must be locked.
+  void notifyDrop()
+  {
+    if (m_nb_dropped == 0) {
+      std::cerr << "Warning: the image queue is full, images are dropped" << std::endl;
+    }
+    ++m_nb_dropped;
+  }
+
+  //! Keep the buffer of an image to copy the next pushed images. The mutex must be locked.
+  void recycle(vpImage<Type> &I)
+  {
+    // A few buffers are enough, one for each producer copying an image
+    const size_t max_free_images = 8;
+    if ((I.bitmap != nullptr) && (m_free_images.size() < max_free_images)) {
+      m_free_images.push_back(vpImage<Type>());
+      swap(m_free_images.back(), I);
+    }
+  }
+
   bool m_cancelled;
   std::condition_variable m_cond;
-  std::queue<vpImage<Type> > m_queue_image;
-  std::queue<std::string> m_queue_data;
-  size_t m_maxQueueSize;
-  std::mutex m_mutex;
+  std::condition_variable m_cond_not_full;
+  std::vector<vpSlot> m_slots;
+  std::vector<vpImage<Type> > m_free_images;
+  size_t m_head;
+  size_t m_size;
+  vpQueuePolicy m_policy;
+  unsigned int m_nb_pushed;
+  unsigned int m_nb_popped;
+  unsigned int m_nb_dropped;
+  size_t m_max_size;
+  mutable std::mutex m_mutex;
   std::string m_seqname;
   std::string m_directory;
   int m_recording_mode;
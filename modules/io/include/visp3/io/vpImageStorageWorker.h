@@ -38,7 +38,15 @@
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
 
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/io/vpImageIo.h>
 #include <visp3/io/vpImageQueue.h>
 
@@ -50,6 +58,10 @@ BEGIN_VISP_NAMESPACE
 
   Save data contained in an vpImageQueue.
 
+  The images can be encoded and written by several threads, which is useful when the encoding, for example in PNG, is
+  slower than the acquisition. The images keep their index in the sequence, and the additional data are written in
+  the order of the images.
+
 */
 template <class Type> class vpImageStorageWorker
 {
@@ -57,81 +69,153 @@ public:
   /*!
    * Constructor.
    * \param[in] queue : A reference to a queue.
+   * \param[in] nb_threads : Number of threads that save the images, including the one calling run().
    */
-  vpImageStorageWorker(vpImageQueue<Type> &queue)
-    : m_queue(queue), m_dataname(""), m_cpt(1), m_ofs_data(), m_data_file_created(false)
+  vpImageStorageWorker(vpImageQueue<Type> &queue, unsigned int nb_threads = 1)
+    : m_queue(queue), m_dataname(""), m_cpt(1), m_ofs_data(), m_data_file_created(false),
+    m_nb_threads(nb_threads > 0 ? nb_threads : 1), m_mutex(), m_pending_data(), m_nb_saved(0),
+    m_total_encoding_time(0.), m_max_encoding_time(0.)
   {
     m_seqname = queue.getSeqName();
     m_record_mode = queue.getRecordingMode();
   }
 
   /*!
-   * Thread main loop that save the images and additional data.
+   * Return the highest time in ms spent to encode and write an image.
+   */
+  double getMaxEncodingTime() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_encoding_time;
+  }
+
+  /*!
+   * Return the mean time in ms spent to encode and write an image.
+   */
+  double getMeanEncodingTime() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_nb_saved > 0) ? (m_total_encoding_time / m_nb_saved) : 0.;
+  }
+
+  /*!
+   * Return the number of saved images.
+   */
+  unsigned int getNbSavedImages() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nb_saved;
+  }
+
+  /*!
+   * Thread main loop that save the images and additional data. The additional threads set in the constructor are
+   * started here, and joined when the queue is cancelled.
    */
   void run()
+  {
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < m_nb_threads; ++i) {
+      threads.push_back(std::thread(&vpImageStorageWorker::save, this));
+    }
+    save();
+    for (size_t i = 0; i < threads.size(); ++i) {
+      threads[i].join();
+    }
+
+    if (std::is_same<Type, vpRGBa>::value) {
+      std::cout << "Receive cancel during color image saving." << std::endl;
+    }
+    else {
+      std::cout << "Receive cancel during gray image saving." << std::endl;
+    }
+    if (m_data_file_created) {
+      std::cout << "Close data file: " << m_dataname << std::endl;
+      m_ofs_data.close();
+    }
+  }
+
+private:
+  //! Save the images popped from the queue, until the queue is cancelled
+  void save()
   {
     try {
       vpImage<Type> I;
       std::string data;
+      unsigned int index;
 
       for (;;) {
-        m_queue.pop(I, data);
+        m_queue.pop(I, data, index);
 
         // Save image
-        std::string filename = vpIoTools::formatString(m_seqname, m_cpt);
+        std::string filename = vpIoTools::formatString(m_seqname, index);
 
         if (m_record_mode > 0) { // Single image
+          std::lock_guard<std::mutex> lock(m_mutex);
           std::cout << "Save image: " << filename << std::endl;
         }
-        else if (m_cpt == 1) {
+        else if (index == 1) {
+          std::lock_guard<std::mutex> lock(m_mutex);
           std::cout << "Started sequence saving: " << m_seqname << std::endl;
         }
+        double t = vpTime::measureTimeMs();
         vpImageIo::write(I, filename);
+        t = vpTime::measureTimeMs() - t;
 
-        if (!data.empty()) {
-          if (!m_data_file_created) {
-            std::string parent = vpIoTools::getParent(m_seqname);
-            if (!parent.empty()) {
-              m_dataname = vpIoTools::getParent(m_seqname) + "/";
-            }
-            m_dataname += vpIoTools::getNameWE(m_seqname);
-            m_dataname += ".txt";
+        saved(index, filename, data, t);
+      }
+    }
+    catch (const typename vpImageQueue<Type>::vpCancelled_t &) {
+    }
+  }
 
-            std::cout << "Create data file: " << m_dataname << std::endl;
-            m_ofs_data.open(m_dataname);
+  //! Update the statistics and write the additional data of the images saved in sequence
+  void saved(unsigned int index, const std::string &filename, const std::string &data, double encoding_time)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_nb_saved;
+    m_total_encoding_time += encoding_time;
+    if (encoding_time > m_max_encoding_time) {
+      m_max_encoding_time = encoding_time;
+    }
 
-            m_data_file_created = true;
+    m_pending_data[index] = std::make_pair(filename, data);
+    typename std::map<unsigned int, std::pair<std::string, std::string> >::iterator it;
+    while ((it = m_pending_data.find(m_cpt)) != m_pending_data.end()) {
+      if (!it->second.second.empty()) {
+        if (!m_data_file_created) {
+          std::string parent = vpIoTools::getParent(m_seqname);
+          if (!parent.empty()) {
+            m_dataname = vpIoTools::getParent(m_seqname) + "/";
           }
-          m_ofs_data << vpIoTools::getName(filename) << " " << data << std::endl;
-        }
+          m_dataname += vpIoTools::getNameWE(m_seqname);
+          m_dataname += ".txt";
 
-        m_cpt++;
-      }
-    }
-    catch (const vpImageQueue<vpRGBa>::vpCancelled_t &) {
-      std::cout << "Receive cancel during color image saving." << std::endl;
-      if (m_data_file_created) {
-        std::cout << "Close data file: " << m_dataname << std::endl;
-        m_ofs_data.close();
-      }
-    }
-    catch (const vpImageQueue<unsigned char>::vpCancelled_t &) {
-      std::cout << "Receive cancel during gray image saving." << std::endl;
-      if (m_data_file_created) {
-        std::cout << "Close data file: " << m_dataname << std::endl;
-        m_ofs_data.close();
+          std::cout << "Create data file: " << m_dataname << std::endl;
+          m_ofs_data.open(m_dataname);
+
+          m_data_file_created = true;
+        }
+        m_ofs_data << vpIoTools::getName(it->second.first) << " " << it->second.second << std::endl;
       }
+      m_pending_data.erase(it);
+      m_cpt++;
     }
   }
 
-private:
   vpImageQueue<Type> &m_queue;
   std::string m_seqname;
   std::string m_dataname;
   int m_record_mode;
-  unsigned int m_cpt;
+  unsigned int m_cpt; //!< index of the next image whose data has to be written
   std::ofstream m_ofs_data;
   bool m_data_file_created;
+  unsigned int m_nb_threads;
+  mutable std::mutex m_mutex;
+  //! Name and data of the images saved before the previous ones in the sequence
+  std::map<unsigned int, std::pair<std::string, std::string> > m_pending_data;
+  unsigned int m_nb_saved;
+  double m_total_encoding_time;
+  double m_max_encoding_time;
 };
 END_VISP_NAMESPACE
 #endif
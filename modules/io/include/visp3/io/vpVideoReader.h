@@ -62,7 +62,8 @@ BEGIN_VISP_NAMESPACE
  * other frame grabber class.
  *
  * This class has its own implementation to read a sequence of PGM and PPM
- * images.
+ * images, and the frames of the first image stream of a recording written
+ * with vpRecordingWriter (`.vprec` file), the index of the first frame being 0.
  *
  * This class may benefit from optional 3rd parties:
  * - libpng: If installed this optional 3rd party is used to read a sequence of
@@ -214,6 +215,8 @@ private:
     FORMAT_WMV,
     FORMAT_FLV,
     FORMAT_MKV,
+    // Recording written with vpRecordingWriter
+    FORMAT_VPREC,
     FORMAT_UNKNOWN
   } vpVideoFormatType;
 
@@ -238,6 +241,9 @@ private:
   //! The frame step
   long m_frameStep;
   double m_frameRate;
+  //! Number of images of a sequence read ahead, and number of threads that read them
+  unsigned int m_prefetchImages;
+  unsigned int m_prefetchThreads;
 
 public:
   vpVideoReader();
@@ -384,11 +390,14 @@ public:
    */
   inline void setFrameStep(const long frame_step) { m_frameStep = frame_step; }
 
+  void setPrefetching(unsigned int nbImages, unsigned int nbThreads = 2);
+
 private:
   vpVideoFormatType getFormat(const std::string &filename) const;
   static std::string getExtension(const std::string &filename);
   void findFirstFrameIndex();
   void findLastFrameIndex();
+  unsigned int getRecordingNbFrames() const;
   bool isImageExtensionSupported() const;
   bool isVideoExtensionSupported() const;
   bool checkImageNameFormat(const std::string &format) const;
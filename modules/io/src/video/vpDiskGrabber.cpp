@@ -31,23 +31,257 @@
  * Disk framegrabber.
  */
 
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRecordingReader.h>
 #include <visp3/io/vpDiskGrabber.h>
 
+#if defined(VISP_HAVE_THREADS)
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
+namespace
+{
+std::string buildName(bool use_generic_name, const std::string &generic_name, const std::string &directory,
+                      const std::string &base_name, unsigned int number_of_zero, const std::string &extension,
+                      long number)
+{
+  if (use_generic_name) {
+    return vpIoTools::formatString(generic_name, static_cast<unsigned int>(number));
+  }
+  std::stringstream ss;
+  ss << directory << "/" << base_name << std::setfill('0') << std::setw(number_of_zero) << number << "." << extension;
+  return ss.str();
+}
+
+#if defined(VISP_HAVE_THREADS)
+//! Copy of the settings of the grabber that give the name of an image from its number, used by the workers
+struct vpImageNaming
+{
+  bool use_generic_name;
+  std::string generic_name;
+  std::string directory;
+  std::string base_name;
+  unsigned int number_of_zero;
+  std::string extension;
+
+  std::string build(long number) const
+  {
+    return buildName(use_generic_name, generic_name, directory, base_name, number_of_zero, extension, number);
+  }
+};
+#endif
+}
+
+#if defined(VISP_HAVE_THREADS)
+/*!
+ * Ring of decoded images, filled by worker threads that read the images of the sequence ahead of the consumer.
+ *
+ * The k-th image of the current run is the image number first + k * step, stored in the slot k % size once decoded.
+ * A worker only starts the k-th image when the image k - size was consumed, so that the memory used is bounded.
+ * When the consumer asks for an image that is not the next one of the run (seek, new step, other image type), a new
+ * run starts and the images of the previous run that are being decoded are discarded.
+ */
+class vpDiskGrabber::vpPrefetcher
+{
+public:
+  vpPrefetcher(unsigned int nbImages, unsigned int nbThreads)
+    : m_slots(nbImages), m_generation(0), m_running(false), m_stop(false), m_first(0), m_step(1), m_color(false),
+    m_naming(), m_nextToDecode(0), m_nextToConsume(0), m_threads()
+  {
+    for (unsigned int i = 0; i < nbThreads; ++i) {
+      m_threads.push_back(std::thread(&vpPrefetcher::run, this));
+    }
+  }
+
+  ~vpPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_condWork.notify_all();
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+      m_threads[i].join();
+    }
+  }
+
+  /*!
+   * Get the image `number` of the sequence, and let the workers read the next ones with the given step. An exception
+   * raised while reading the image is thrown here.
+   *
+   * \param I : Decoded image.
+   * \param number : Number of the image.
+   * \param step : Step between two images.
+   * \param name : Name of the image, used to detect a change of the naming of the images.
+   * \param naming : Settings that give the name of an image from its number.
+   */
+  template <typename Type>
+  void read(vpImage<Type> &I, long number, long step, const std::string &name, const vpImageNaming &naming)
+  {
+    const bool color = std::is_same<Type, vpRGBa>::value;
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if ((!m_running) || (step != m_step) || (color != m_color) ||
+          (number != (m_first + (static_cast<long>(m_nextToConsume) * m_step)))) {
+        restart(number, step, color, naming);
+      }
+      bool done = false;
+      while (!done) {
+        const unsigned long k = m_nextToConsume;
+        vpSlot &slot = m_slots[k % m_slots.size()];
+        m_condReady.wait(lock, [&slot, k] { return slot.ready && (slot.index == k); });
+        if (slot.name != name) {
+          // The naming of the images changed since the run started
+          restart(number, step, color, naming);
+        }
+        else {
+          swap(I, getImage(slot, I));
+          error = slot.error;
+          slot.error = nullptr;
+          slot.ready = false;
+          ++m_nextToConsume;
+          done = true;
+        }
+      }
+    }
+    m_condWork.notify_all();
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  //! Image decoded by a worker
+  struct vpSlot
+  {
+    vpSlot() : index(0), name(), gray(), color(), error(), ready(false) { }
+
+    unsigned long index; //!< index of the image in the run
+    std::string name;
+    vpImage<unsigned char> gray;
+    vpImage<vpRGBa> color;
+    std::exception_ptr error; //!< exception raised while reading the image
+    bool ready;
+  };
+
+  static vpImage<unsigned char> &getImage(vpSlot &slot, const vpImage<unsigned char> &) { return slot.gray; }
+  static vpImage<vpRGBa> &getImage(vpSlot &slot, const vpImage<vpRGBa> &) { return slot.color; }
+
+  //! Start a new run. The mutex must be locked.
+  void restart(long number, long step, bool color, const vpImageNaming &naming)
+  {
+    ++m_generation;
+    m_running = true;
+    m_first = number;
+    m_step = step;
+    m_color = color;
+    m_naming = naming;
+    m_nextToDecode = 0;
+    m_nextToConsume = 0;
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+      m_slots[i].ready = false;
+      m_slots[i].error = nullptr;
+    }
+    m_condWork.notify_all();
+  }
+
+  //! Loop of a worker thread
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_condWork.wait(lock,
+                      [this] { return m_stop || (m_running && (m_nextToDecode < (m_nextToConsume + m_slots.size()))); });
+      if (m_stop) {
+        return;
+      }
+      const unsigned long k = m_nextToDecode++;
+      const unsigned long generation = m_generation;
+      const long number = m_first + (static_cast<long>(k) * m_step);
+      const bool color = m_color;
+      // Building the name is cheap, it is done under the lock to avoid copying the naming settings
+      vpSlot decoded;
+      decoded.name = m_naming.build(number);
+      lock.unlock();
+
+      // The image is decoded without holding the lock
+      try {
+        if (color) {
+          vpImageIo::read(decoded.color, decoded.name);
+        }
+        else {
+          vpImageIo::read(decoded.gray, decoded.name);
+        }
+      }
+      catch (...) {
+        decoded.error = std::current_exception();
+      }
+
+      lock.lock();
+      if (generation == m_generation) {
+        vpSlot &slot = m_slots[k % m_slots.size()];
+        slot.index = k;
+        slot.name.swap(decoded.name);
+        swap(slot.gray, decoded.gray);
+        swap(slot.color, decoded.color);
+        slot.error = decoded.error;
+        slot.ready = true;
+        m_condReady.notify_all();
+      }
+    }
+  }
+
+  std::vector<vpSlot> m_slots;
+  unsigned long m_generation; //!< incremented at each new run, to discard the images of the previous ones
+  bool m_running;
+  bool m_stop;
+  long m_first;
+  long m_step;
+  bool m_color;
+  vpImageNaming m_naming;
+  unsigned long m_nextToDecode;  //!< index in the run of the next image to read by a worker
+  unsigned long m_nextToConsume; //!< index in the run of the next image returned to the consumer
+  std::mutex m_mutex;
+  std::condition_variable m_condWork;
+  std::condition_variable m_condReady;
+  std::vector<std::thread> m_threads;
+};
+#endif
+
 vpDiskGrabber::vpDiskGrabber()
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-  m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty")
+  m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty"), m_prefetch_size(0),
+  m_prefetch_threads(0), m_prefetcher(nullptr), m_recording(nullptr)
 {
   init = false;
 }
 
-vpDiskGrabber::vpDiskGrabber(const vpDiskGrabber &grabber) : vpFrameGrabber(grabber)
+vpDiskGrabber::vpDiskGrabber(const vpDiskGrabber &grabber)
+  : vpFrameGrabber(grabber), m_prefetch_size(0), m_prefetch_threads(0), m_prefetcher(nullptr), m_recording(nullptr)
 {
   *this = grabber;
 }
 
+vpDiskGrabber::~vpDiskGrabber()
+{
+#if defined(VISP_HAVE_THREADS)
+  delete m_prefetcher;
+#endif
+  delete m_recording;
+}
+
 vpDiskGrabber &vpDiskGrabber::operator=(const vpDiskGrabber &grabber)
 {
   m_image_number = grabber.m_image_number;
@@ -59,13 +293,21 @@ vpDiskGrabber &vpDiskGrabber::operator=(const vpDiskGrabber &grabber)
   m_extension = grabber.m_extension;
   m_use_generic_name = grabber.m_use_generic_name;
   m_generic_name = grabber.m_generic_name;
+  if (this != &grabber) {
+    // The threads are not shared, they are created again at the next acquisition
+    setPrefetching(grabber.m_prefetch_size, grabber.m_prefetch_threads);
+    // The recording is mapped again at the next acquisition
+    delete m_recording;
+    m_recording = nullptr;
+  }
 
   return *this;
 }
 
 vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-  m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name)
+  m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name), m_prefetch_size(0),
+  m_prefetch_threads(0), m_prefetcher(nullptr), m_recording(nullptr)
 {
   init = false;
 }
@@ -73,11 +315,79 @@ vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
 vpDiskGrabber::vpDiskGrabber(const std::string &dir, const std::string &basename, long number, int step,
                              unsigned int noz, const std::string &ext)
   : m_image_number(number), m_image_number_next(number), m_image_step(step), m_number_of_zero(noz), m_directory(dir),
-  m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"), m_image_name()
+  m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"), m_image_name(),
+  m_prefetch_size(0), m_prefetch_threads(0), m_prefetcher(nullptr), m_recording(nullptr)
 {
   init = false;
 }
 
+/*!
+ * Get the image `image_number` from the images read ahead when the prefetching is enabled.
+ *
+ * \return false when the prefetching is disabled, and the image has to be read by the caller.
+ */
+template <typename Type> bool vpDiskGrabber::prefetch(vpImage<Type> &I, long image_number)
+{
+#if defined(VISP_HAVE_THREADS)
+  if (m_prefetch_size == 0) {
+    return false;
+  }
+  if (m_prefetcher == nullptr) {
+    m_prefetcher = new vpPrefetcher(m_prefetch_size, m_prefetch_threads);
+  }
+  // The workers use a copy of the naming settings, that can be modified while they run
+  vpImageNaming naming;
+  naming.use_generic_name = m_use_generic_name;
+  naming.generic_name = m_generic_name;
+  naming.directory = m_directory;
+  naming.base_name = m_base_name;
+  naming.number_of_zero = m_number_of_zero;
+  naming.extension = m_extension;
+  m_prefetcher->read(I, image_number, m_image_step, m_image_name, naming);
+  return true;
+#else
+  (void)I;
+  (void)image_number;
+  return false;
+#endif
+}
+
+/*!
+ * Read the frame `image_number` of the first image stream of the recording when the image name is a recording
+ * written with vpRecordingWriter.
+ *
+ * \return false when the image name is not a recording, and the image has to be read by the caller.
+ */
+template <typename Type> bool vpDiskGrabber::readRecording(vpImage<Type> &I, long image_number)
+{
+  if (vpIoTools::toLowerCase(vpIoTools::getFileExtension(m_image_name)) != ".vprec") {
+    return false;
+  }
+  if ((m_recording == nullptr) || (m_recording->getFilename() != m_image_name)) {
+    delete m_recording;
+    m_recording = nullptr;
+    m_recording = new vpRecordingReader(m_image_name);
+  }
+
+  int stream = -1;
+  if (std::is_same<Type, float>::value) {
+    stream = m_recording->findStream(vpRecordingWriter::STREAM_FLOAT);
+  }
+  else {
+    const int gray = m_recording->findStream(vpRecordingWriter::STREAM_GRAY);
+    const int color = m_recording->findStream(vpRecordingWriter::STREAM_RGBA);
+    stream = ((gray < 0) || ((color >= 0) && (color < gray))) ? color : gray;
+  }
+  if (stream < 0) {
+    throw(vpException(vpException::ioError, "No image stream in the recording %s", m_image_name.c_str()));
+  }
+  if ((image_number < 0) || (image_number >= static_cast<long>(m_recording->getNbFrames(stream)))) {
+    throw(vpException(vpException::ioError, "No frame %ld in the recording %s", image_number, m_image_name.c_str()));
+  }
+  m_recording->read(static_cast<unsigned int>(stream), static_cast<unsigned int>(image_number), I);
+  return true;
+}
+
 void vpDiskGrabber::open(vpImage<unsigned char> &I)
 {
   long first_number = getImageNumber();
@@ -127,19 +437,11 @@ void vpDiskGrabber::open(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = buildImageName(m_image_number);
   m_image_number_next += m_image_step;
-  vpImageIo::read(I, m_image_name);
+  if ((!readRecording(I, m_image_number)) && (!prefetch(I, m_image_number))) {
+    vpImageIo::read(I, m_image_name);
+  }
 
   width = I.getWidth();
   height = I.getHeight();
@@ -148,20 +450,12 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = buildImageName(m_image_number);
   m_image_number_next += m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  if ((!readRecording(I, m_image_number)) && (!prefetch(I, m_image_number))) {
+    vpImageIo::read(I, m_image_name);
+  }
 
   width = I.getWidth();
   height = I.getHeight();
@@ -170,16 +464,7 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 void vpDiskGrabber::acquire(vpImage<float> &I)
 {
   m_image_number = m_image_number_next;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
+  m_image_name = buildImageName(m_image_number);
 
   m_image_number_next += m_image_step;
 
@@ -194,7 +479,7 @@ void vpDiskGrabber::acquire(vpImage<float> &I)
     throw(vpException(vpException::ioError, "Miniz is not installed, npy files cannot be read"));
 #endif
   }
-  else {
+  else if (!readRecording(I, m_image_number)) {
     vpImageIo::read(I, m_image_name);
   }
 
@@ -205,20 +490,12 @@ void vpDiskGrabber::acquire(vpImage<float> &I)
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long image_number)
 {
   m_image_number = image_number;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = buildImageName(m_image_number);
   m_image_number_next = m_image_number + m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  if ((!readRecording(I, m_image_number)) && (!prefetch(I, m_image_number))) {
+    vpImageIo::read(I, m_image_name);
+  }
 
   width = I.getWidth();
   height = I.getHeight();
@@ -227,20 +504,12 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long image_number)
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long image_number)
 {
   m_image_number = image_number;
-
-  if (m_use_generic_name) {
-    m_image_name = vpIoTools::formatString(m_generic_name, static_cast<unsigned int>(m_image_number));
-  }
-  else {
-    std::stringstream ss;
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-      << m_extension;
-    m_image_name = ss.str();
-  }
-
+  m_image_name = buildImageName(m_image_number);
   m_image_number_next = m_image_number + m_image_step;
 
-  vpImageIo::read(I, m_image_name);
+  if ((!readRecording(I, m_image_number)) && (!prefetch(I, m_image_number))) {
+    vpImageIo::read(I, m_image_name);
+  }
 
   width = I.getWidth();
   height = I.getHeight();
@@ -262,7 +531,9 @@ void vpDiskGrabber::acquire(vpImage<float> &I, long image_number)
 
   m_image_number_next += m_image_step;
 
-  vpImageIo::readPFM(I, m_image_name);
+  if (!readRecording(I, image_number)) {
+    vpImageIo::readPFM(I, m_image_name);
+  }
 
   width = I.getWidth();
   height = I.getHeight();
@@ -280,4 +551,38 @@ void vpDiskGrabber::setGenericName(const std::string &generic_name)
   m_use_generic_name = true;
 }
 
+/*!
+ * Enable the reading of the images ahead. While the current image is processed, `nbThreads` background threads read
+ * and decode the next `nbImages` images of the sequence, so that acquire() does not wait for the disk and the image
+ * decoder when the processing is slower than the reading.
+ *
+ * The images are returned in the same order and with the same content as without prefetching. Reading the images
+ * out of the sequence, with acquire(vpImage<unsigned char> &, long) on a non consecutive number, setImageNumber() or
+ * setStep(), discards the images read ahead and restarts the prefetching from the requested image. Images of type
+ * vpImage<float> are always read synchronously.
+ *
+ * \param nbImages : Maximum number of images read ahead. 0 disables the prefetching, which is the default.
+ * \param nbThreads : Number of threads used to read the images.
+ *
+ * \note Without thread support the images are always read synchronously.
+ */
+void vpDiskGrabber::setPrefetching(unsigned int nbImages, unsigned int nbThreads)
+{
+  if ((nbImages > 0) && (nbThreads == 0)) {
+    throw(vpException(vpException::badValue, "At least one thread is needed to read the images ahead"));
+  }
+#if defined(VISP_HAVE_THREADS)
+  delete m_prefetcher;
+  m_prefetcher = nullptr;
+#endif
+  m_prefetch_size = nbImages;
+  m_prefetch_threads = nbThreads;
+}
+
+std::string vpDiskGrabber::buildImageName(long number) const
+{
+  return buildName(m_use_generic_name, m_generic_name, m_directory, m_base_name, m_number_of_zero, m_extension,
+                   number);
+}
+
 END_VISP_NAMESPACE
@@ -37,6 +37,7 @@
  */
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRecordingReader.h>
 #include <visp3/io/vpVideoReader.h>
 
 #include <cctype>
@@ -57,7 +58,7 @@ BEGIN_VISP_NAMESPACE
 #endif
   m_formatType(FORMAT_UNKNOWN), m_videoName(), m_frameName(), m_initFileName(false), m_isOpen(false), m_frameCount(0),
   m_firstFrame(0), m_lastFrame(0), m_firstFrameIndexIsSet(false), m_lastFrameIndexIsSet(false), m_frameStep(1),
-  m_frameRate(0.)
+  m_frameRate(0.), m_prefetchImages(0), m_prefetchThreads(0)
 { }
 
 /*!
@@ -103,6 +104,8 @@ vpVideoReader &vpVideoReader::operator=(const vpVideoReader &reader)
   m_lastFrameIndexIsSet = reader.m_lastFrameIndexIsSet;
   m_frameStep = reader.m_frameStep;
   m_frameRate = reader.m_frameRate;
+  m_prefetchImages = reader.m_prefetchImages;
+  m_prefetchThreads = reader.m_prefetchThreads;
   return *this;
 }
 
@@ -146,6 +149,28 @@ void vpVideoReader::setFileName(const std::string &filename)
   m_initFileName = true;
 }
 
+/*!
+  Enable the reading of the images of a sequence ahead, while the current image is processed.
+  See vpDiskGrabber::setPrefetching() for details. The frames are returned in the same order and with the same
+  content as without prefetching.
+
+  \param nbImages : Maximum number of images read ahead. 0 disables the prefetching, which is the default.
+  \param nbThreads : Number of threads used to read the images.
+
+  \note Video files read with OpenCV are not affected by this setting.
+*/
+void vpVideoReader::setPrefetching(unsigned int nbImages, unsigned int nbThreads)
+{
+  if ((nbImages > 0) && (nbThreads == 0)) {
+    throw(vpException(vpException::badValue, "At least one thread is needed to read the images ahead"));
+  }
+  m_prefetchImages = nbImages;
+  m_prefetchThreads = nbThreads;
+  if (m_imSequence != nullptr) {
+    m_imSequence->setPrefetching(m_prefetchImages, m_prefetchThreads);
+  }
+}
+
 /*!
   Open video stream and get first and last frame indexes.
 */
@@ -160,6 +185,17 @@ void vpVideoReader::getProperties()
   }
 
   if (isImageExtensionSupported()) {
+    m_imSequence = new vpDiskGrabber;
+    m_imSequence->setGenericName(m_videoName.c_str());
+    m_imSequence->setStep(m_frameStep);
+    m_imSequence->setPrefetching(m_prefetchImages, m_prefetchThreads);
+    if (m_firstFrameIndexIsSet) {
+      m_imSequence->setImageNumber(m_firstFrame);
+    }
+    m_frameRate = -1.;
+  }
+  else if (m_formatType == FORMAT_VPREC) {
+    // The frames of the recording are read by the disk grabber, the image number being the index of the frame
     m_imSequence = new vpDiskGrabber;
     m_imSequence->setGenericName(m_videoName.c_str());
     m_imSequence->setStep(m_frameStep);
@@ -727,6 +763,10 @@ vpVideoReader::vpVideoFormatType vpVideoReader::getFormat(const std::string &fil
     return FORMAT_MTS;
   else if (ext.compare(".mts") == 0)
     return FORMAT_MTS;
+  else if (ext.compare(".VPREC") == 0)
+    return FORMAT_VPREC;
+  else if (ext.compare(".vprec") == 0)
+    return FORMAT_VPREC;
   else
     return FORMAT_UNKNOWN;
 }
@@ -749,7 +789,12 @@ void vpVideoReader::findLastFrameIndex()
     throw(vpException(vpException::notInitialized, "File not yet opened. Use the open() method before"));
   }
 
-  if (m_imSequence != nullptr) {
+  if (m_formatType == FORMAT_VPREC) {
+    if (!m_lastFrameIndexIsSet) {
+      m_lastFrame = static_cast<long>(getRecordingNbFrames()) - 1;
+    }
+  }
+  else if (m_imSequence != nullptr) {
     if (!m_lastFrameIndexIsSet) {
       std::string imageNameFormat = vpIoTools::getName(m_videoName);
       std::string dirName = vpIoTools::getParent(m_videoName);
@@ -803,7 +848,13 @@ void vpVideoReader::findLastFrameIndex()
 */
 void vpVideoReader::findFirstFrameIndex()
 {
-  if (m_imSequence != nullptr) {
+  if (m_formatType == FORMAT_VPREC) {
+    if (!m_firstFrameIndexIsSet) {
+      m_firstFrame = 0;
+      m_imSequence->setImageNumber(m_firstFrame);
+    }
+  }
+  else if (m_imSequence != nullptr) {
     if (!m_firstFrameIndexIsSet) {
       std::string imageNameFormat = vpIoTools::getName(m_videoName);
       std::string dirName = vpIoTools::getParent(m_videoName);
@@ -834,6 +885,21 @@ void vpVideoReader::findFirstFrameIndex()
 #endif
 }
 
+/*!
+  Return the number of frames of the first image stream of a recording written with vpRecordingWriter.
+*/
+unsigned int vpVideoReader::getRecordingNbFrames() const
+{
+  vpRecordingReader recording(m_videoName);
+  const int gray = recording.findStream(vpRecordingWriter::STREAM_GRAY);
+  const int color = recording.findStream(vpRecordingWriter::STREAM_RGBA);
+  const int stream = ((gray < 0) || ((color >= 0) && (color < gray))) ? color : gray;
+  if (stream < 0) {
+    throw(vpException(vpException::ioError, "No image stream in the recording %s", m_videoName.c_str()));
+  }
+  return recording.getNbFrames(static_cast<unsigned int>(stream));
+}
+
 /*!
   Return true if the image file extension is supported, false otherwise.
 */
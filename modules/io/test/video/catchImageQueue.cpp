@@ -0,0 +1,203 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test image queue and storage worker used to record sequences of images.
+ */
+/*!
+  \example catchImageQueue.cpp
+
+  \brief Test the policies of vpImageQueue and the recording of a sequence with several vpImageStorageWorker threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+
+#include <catch_amalgamated.hpp>
+
+#include <fstream>
+#include <thread>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpImageQueue.h>
+#include <visp3/io/vpImageStorageWorker.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+VP_ATTRIBUTE_NO_DESTROY static std::string tmp;
+
+namespace
+{
+// Push images filled with the values first, first + 1, ... and return the number of images queued
+unsigned int pushImages(vpImageQueue<unsigned char> &queue, unsigned int first, unsigned int nb_images)
+{
+  unsigned int nb_queued = 0;
+  for (unsigned int i = first; i < first + nb_images; ++i) {
+    vpImage<unsigned char> I(4, 6, static_cast<unsigned char>(i));
+    std::string data = std::to_string(i);
+    if (queue.push(I, &data)) {
+      ++nb_queued;
+    }
+  }
+  return nb_queued;
+}
+
+// Pop an image and check its value and index
+void checkPop(vpImageQueue<unsigned char> &queue, unsigned int value, unsigned int index)
+{
+  vpImage<unsigned char> I;
+  std::string data;
+  unsigned int popped_index;
+  queue.pop(I, data, popped_index);
+  CHECK(I.getSize() == 24);
+  CHECK(I[3][5] == value);
+  CHECK(data == std::to_string(value));
+  CHECK(popped_index == index);
+}
+} // namespace
+
+TEST_CASE("Image queue policies", "[image_queue]")
+{
+  vpImageQueue<unsigned char> queue("", 0);
+  queue.setMaxQueueSize(3);
+
+  SECTION("Drop the oldest images")
+  {
+    CHECK(pushImages(queue, 0, 5) == 5);
+    CHECK(queue.getNbPushedImages() == 5);
+    CHECK(queue.getNbDroppedImages() == 2);
+    CHECK(queue.getQueueDepth() == 3);
+    for (unsigned int i = 2; i < 5; ++i) {
+      checkPop(queue, i, i - 1);
+    }
+    CHECK(queue.getQueueDepth() == 0);
+    CHECK(queue.getMaxQueueDepth() == 3);
+  }
+
+  SECTION("Drop the newest images")
+  {
+    queue.setQueuePolicy(vpImageQueue<unsigned char>::DROP_NEWEST);
+    CHECK(pushImages(queue, 0, 5) == 3);
+    CHECK(queue.getNbDroppedImages() == 2);
+    for (unsigned int i = 0; i < 3; ++i) {
+      checkPop(queue, i, i + 1);
+    }
+  }
+
+  SECTION("Block the producer")
+  {
+    queue.setQueuePolicy(vpImageQueue<unsigned char>::BLOCK);
+    const unsigned int nb_images = 50;
+    std::thread producer([&queue, nb_images]() { pushImages(queue, 0, nb_images); });
+    for (unsigned int i = 0; i < nb_images; ++i) {
+      checkPop(queue, i, i + 1);
+    }
+    producer.join();
+    CHECK(queue.getNbDroppedImages() == 0);
+    CHECK(queue.getMaxQueueDepth() <= 3);
+  }
+
+  SECTION("Reduce the size of the queue")
+  {
+    CHECK(pushImages(queue, 0, 3) == 3);
+    queue.setMaxQueueSize(1);
+    CHECK(queue.getNbDroppedImages() == 2);
+    checkPop(queue, 2, 1);
+    CHECK_THROWS(queue.setMaxQueueSize(0));
+  }
+
+  SECTION("Cancel")
+  {
+    CHECK(pushImages(queue, 0, 1) == 1);
+    queue.cancel();
+    // The images in the queue are still available
+    checkPop(queue, 0, 1);
+    vpImage<unsigned char> I;
+    std::string data;
+    CHECK_THROWS_AS(queue.pop(I, data), vpImageQueue<unsigned char>::vpCancelled_t);
+  }
+}
+
+TEST_CASE("Record a sequence with several threads", "[image_queue]")
+{
+  const std::string seqname = tmp + "/image-%04d.pgm";
+  const unsigned int nb_images = 40;
+  vpImageQueue<unsigned char> queue(seqname, 0);
+  queue.setMaxQueueSize(4);
+  queue.setQueuePolicy(vpImageQueue<unsigned char>::BLOCK);
+  vpImageStorageWorker<unsigned char> worker(queue, 3);
+  std::thread worker_thread(&vpImageStorageWorker<unsigned char>::run, &worker);
+
+  CHECK(pushImages(queue, 0, nb_images) == nb_images);
+  queue.cancel();
+  worker_thread.join();
+
+  CHECK(queue.getNbDroppedImages() == 0);
+  CHECK(worker.getNbSavedImages() == nb_images);
+  CHECK(worker.getMaxEncodingTime() >= worker.getMeanEncodingTime());
+  for (unsigned int i = 0; i < nb_images; ++i) {
+    vpImage<unsigned char> I;
+    vpImageIo::read(I, vpIoTools::formatString(seqname, i + 1));
+    CHECK(I[0][0] == i);
+  }
+
+  // The data are written in the order of the images
+  std::ifstream ifs(tmp + "/image-%04d.txt");
+  for (unsigned int i = 0; i < nb_images; ++i) {
+    std::string name, data;
+    ifs >> name >> data;
+    CHECK(name == vpIoTools::getName(vpIoTools::formatString(seqname, i + 1)));
+    CHECK(data == std::to_string(i));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  tmp = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+
+  int numFailed = session.run();
+
+  vpIoTools::remove(tmp);
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
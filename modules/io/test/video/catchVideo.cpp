@@ -43,6 +43,9 @@
 #include <catch_amalgamated.hpp>
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRecordingWriter.h>
+#include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpImageIo.h>
 #include <visp3/io/vpVideoReader.h>
 #include <visp3/io/vpVideoWriter.h>
 
@@ -57,6 +60,8 @@ static long last_frame = first_frame + static_cast<long>(frame_step) * (nframes
 VP_ATTRIBUTE_NO_DESTROY static std::string tmp;
 VP_ATTRIBUTE_NO_DESTROY static std::string videoname_grey;
 VP_ATTRIBUTE_NO_DESTROY static std::string videoname_color;
+VP_ATTRIBUTE_NO_DESTROY static std::string videoname_prefetch;
+VP_ATTRIBUTE_NO_DESTROY static std::string videoname_recording;
 
 template <class Type>
 bool test_createSequence(vpImage<Type> &I, const std::string &videoname, unsigned int first_frame, int frame_step,
@@ -164,6 +169,137 @@ TEST_CASE("Test reading a sequence of color images", "[color]")
   }
 }
 
+template <class Type>
+bool test_readSequencePrefetching(vpImage<Type> &I, const std::string &videoname, int step)
+{
+  vpVideoReader reader, reader_prefetch;
+  reader.setFileName(videoname);
+  reader.setFrameStep(step);
+  reader_prefetch.setFileName(videoname);
+  reader_prefetch.setFrameStep(step);
+  reader_prefetch.setPrefetching(3, 2);
+
+  vpImage<Type> I_prefetch;
+  reader.open(I);
+  reader_prefetch.open(I_prefetch);
+  while (!reader.end()) {
+    if (reader_prefetch.end()) {
+      return false;
+    }
+    reader.acquire(I);
+    reader_prefetch.acquire(I_prefetch);
+    if ((reader.getFrameIndex() != reader_prefetch.getFrameIndex()) || (I != I_prefetch)) {
+      std::cout << "Wrong frame " << reader_prefetch.getFrameIndex() << " read with prefetching" << std::endl;
+      return false;
+    }
+  }
+
+  // Seek in the sequence, and read the next frames
+  reader.getFrame(I, reader.getFirstFrameIndex() + 1);
+  reader_prefetch.getFrame(I_prefetch, reader_prefetch.getFirstFrameIndex() + 1);
+  for (int i = 0; i < 3; ++i) {
+    reader.acquire(I);
+    reader_prefetch.acquire(I_prefetch);
+    if ((reader.getFrameIndex() != reader_prefetch.getFrameIndex()) || (I != I_prefetch)) {
+      std::cout << "Wrong frame " << reader_prefetch.getFrameIndex() << " read with prefetching after a seek"
+        << std::endl;
+      return false;
+    }
+  }
+  return reader_prefetch.end() == reader.end();
+}
+
+TEST_CASE("Test reading a sequence of images with prefetching", "[prefetch]")
+{
+  const unsigned int nb_images = 10;
+  for (unsigned int i = 0; i < nb_images; ++i) {
+    vpImage<vpRGBa> I(3, 5, vpRGBa(static_cast<unsigned char>(10 * i), static_cast<unsigned char>(255 - (10 * i)),
+                                   static_cast<unsigned char>(5 * i)));
+    vpImageIo::write(I, vpIoTools::formatString(videoname_prefetch, i));
+  }
+
+  SECTION("Read sequence of uchar images")
+  {
+    vpImage<unsigned char> I;
+    CHECK(test_readSequencePrefetching(I, videoname_prefetch, 1));
+    CHECK(test_readSequencePrefetching(I, videoname_prefetch, 2));
+  }
+
+  SECTION("Read sequence of color images")
+  {
+    vpImage<vpRGBa> I;
+    CHECK(test_readSequencePrefetching(I, videoname_prefetch, 1));
+    CHECK(test_readSequencePrefetching(I, videoname_prefetch, 2));
+  }
+
+  SECTION("Read sequence with vpDiskGrabber")
+  {
+    vpDiskGrabber grabber(videoname_prefetch);
+    grabber.setPrefetching(4, 3);
+    vpImage<vpRGBa> I;
+    vpImage<unsigned char> I_grey;
+    for (unsigned int i = 0; i < nb_images; ++i) {
+      grabber.acquire(I);
+      CHECK(grabber.getImageName() == vpIoTools::formatString(videoname_prefetch, i));
+      CHECK(I[0][0] == vpRGBa(static_cast<unsigned char>(10 * i), static_cast<unsigned char>(255 - (10 * i)),
+                              static_cast<unsigned char>(5 * i)));
+    }
+    // Errors are reported for the image that cannot be read
+    CHECK_THROWS(grabber.acquire(I));
+    CHECK(grabber.getImageNumber() == static_cast<long>(nb_images));
+
+    // Change of image type and step
+    grabber.setImageNumber(1);
+    grabber.setStep(3);
+    for (unsigned int i = 1; i < nb_images; i += 3) {
+      grabber.acquire(I_grey);
+      vpImage<unsigned char> I_sync;
+      vpImageIo::read(I_sync, vpIoTools::formatString(videoname_prefetch, i));
+      CHECK(I_grey == I_sync);
+    }
+    grabber.acquire(I, 5);
+    CHECK(grabber.getImageNumber() == 5);
+    CHECK(I[0][0].R == 50);
+
+    CHECK_THROWS(grabber.setPrefetching(2, 0));
+  }
+}
+
+TEST_CASE("Test reading the images of a recording", "[recording]")
+{
+  const unsigned int nb_images = 6;
+  {
+    vpRecordingWriter writer(videoname_recording);
+    const unsigned int depth = writer.addStream("depth", vpRecordingWriter::STREAM_DEPTH);
+    const unsigned int color = writer.addStream("color", vpRecordingWriter::STREAM_RGBA);
+    for (unsigned int i = 0; i < nb_images; ++i) {
+      writer.write(depth, vpImage<uint16_t>(2, 2, static_cast<uint16_t>(i)), 0.1 * i);
+      writer.write(color, vpImage<vpRGBa>(3, 5, vpRGBa(static_cast<unsigned char>(10 * i))), 0.1 * i);
+    }
+  }
+
+  vpImage<vpRGBa> I;
+  vpVideoReader reader;
+  reader.setFileName(videoname_recording);
+  reader.setFrameStep(2);
+  reader.open(I);
+  CHECK(reader.getFirstFrameIndex() == 0);
+  CHECK(reader.getLastFrameIndex() == static_cast<long>(nb_images - 1));
+  long cpt = 0;
+  while (!reader.end()) {
+    reader.acquire(I);
+    CHECK(reader.getFrameIndex() == 2 * cpt);
+    CHECK(I[2][4] == vpRGBa(static_cast<unsigned char>(20 * cpt)));
+    ++cpt;
+  }
+  CHECK(cpt == static_cast<long>(nb_images / 2));
+
+  vpImage<unsigned char> I_grey;
+  CHECK(reader.getFrame(I_grey, 5));
+  CHECK(I_grey[0][0] == 50);
+  CHECK_FALSE(reader.getFrame(I_grey, static_cast<long>(nb_images)));
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -191,6 +327,8 @@ int main(int argc, char *argv[])
 
   videoname_grey = tmp + std::string("/I%d.pgm");
   videoname_color = tmp + std::string("/I%d.ppm");
+  videoname_prefetch = tmp + std::string("/J%04d.ppm");
+  videoname_recording = tmp + std::string("/recording.vprec");
 
   int numFailed = session.run();
 
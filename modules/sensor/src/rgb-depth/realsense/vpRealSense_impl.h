@@ -39,6 +39,7 @@
 #include <librealsense/rs.hpp>
 #include <thread>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpThreadPool.h>
 
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
 #include <pcl/pcl_config.h>
@@ -352,16 +353,9 @@ void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::map<rs::st
       ? 3
       : 4;
 
-    int nb_threads = static_cast<int>(std::thread::hardware_concurrency());
-    int step = depth_height / nb_threads;
-
-    std::vector<std::thread> workers;
-    for (int index = 0; index < nb_threads; ++index) {
-      int start_index = index * step;
-      int end_index = index == nb_threads - 1 ? depth_height : (index + 1) * step;
-
-      workers.push_back(std::thread([&, start_index, end_index]() {
-        for (int i = start_index; i < end_index; ++i) {
+    {
+      vpThreadPool::getInstance().parallelFor(0, static_cast<unsigned int>(depth_height), [&](unsigned int start_index, unsigned int end_index) {
+        for (int i = static_cast<int>(start_index); i < static_cast<int>(end_index); ++i) {
           for (int j = 0; j < depth_width; ++j) {
             float scaled_depth = depth[i * depth_width + j] * depth_scale;
 
@@ -434,10 +428,8 @@ void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::map<rs::st
             }
           }
         }
-                                    }));
+      });
     }
-
-    std::for_each(workers.begin(), workers.end(), [](std::thread &t) { t.join(); });
   }
   else {
     pointcloud->clear();
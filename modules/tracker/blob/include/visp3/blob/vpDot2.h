@@ -102,6 +102,10 @@ BEGIN_VISP_NAMESPACE
  *   is used when there was a problem performing basic tracking of the dot, but
  *   can also be used to find a certain type of dots in the full image.
  *
+ * - trackDots() tracks a set of dots, e.g. the dots of a calibration grid,
+ *   in a single call. The dots are tracked in parallel and a lost dot does not
+ *   stop the tracking of the other ones.
+ *
  * The following sample code available in
  * tutorial-blob-tracker-live.cpp shows how to grab images from a
  * firewire camera, track a blob and display the tracking results.
@@ -188,7 +192,18 @@ public:
    * \param edges_list : The list of all the images points on the dot
    * border. This list is update after a call to track().
    */
-  void getEdges(std::list<vpImagePoint> &edges_list) const { edges_list = m_ip_edges_list; }
+  void getEdges(std::list<vpImagePoint> &edges_list) const
+  {
+    edges_list.assign(m_ip_edges.begin(), m_ip_edges.end());
+  }
+
+  /*!
+   * Return the image points on the dot border without the conversion to a list.
+   *
+   * \param edges : The images points on the dot border, in the order of the
+   * Freeman chain. They are updated after a call to track().
+   */
+  void getEdges(std::vector<vpImagePoint> &edges) const { edges = m_ip_edges; }
 
   /*!
    * Return the list of all the image points on the dot
@@ -197,7 +212,7 @@ public:
    * \return The list of all the images points on the dot
    * border. This list is update after a call to track().
    */
-  std::list<vpImagePoint> getEdges() const { return m_ip_edges_list; }
+  std::list<vpImagePoint> getEdges() const { return std::list<vpImagePoint>(m_ip_edges.begin(), m_ip_edges.end()); }
 
   /*!
    * Get the percentage of sampled points that are considered non conform
@@ -236,7 +251,7 @@ public:
   /*!
    * \return a vpPolygon made from the edges of the dot.
    */
-  vpPolygon getPolygon() const { return (vpPolygon(m_ip_edges_list)); }
+  vpPolygon getPolygon() const { return (vpPolygon(m_ip_edges)); }
   double getSizePrecision() const;
   double getWidth() const;
 
@@ -374,6 +389,9 @@ public:
   void track(const vpImage<unsigned char> &I, bool canMakeTheWindowGrow = true);
   void track(const vpImage<unsigned char> &I, vpImagePoint &cog, bool canMakeTheWindowGrow = true);
 
+  static unsigned int trackDots(std::vector<vpDot2> &dots, const vpImage<unsigned char> &I,
+                                std::vector<bool> &tracked, bool canMakeTheWindowGrow = true);
+
   static void trackAndDisplay(vpDot2 dot[], const unsigned int &n, vpImage<unsigned char> &I,
                               std::vector<vpImagePoint> &cogs, vpImagePoint *cogStar = nullptr);
 
@@ -548,8 +566,8 @@ private:
   vpRect m_area;
 
   // other
-  std::list<unsigned int> m_direction_list;
-  std::list<vpImagePoint> m_ip_edges_list;
+  std::vector<unsigned int> m_directions; // Freeman chain
+  std::vector<vpImagePoint> m_ip_edges;   // Dot border, one point per element of the Freeman chain
 
   // flag
   bool m_compute_moment; // true moment are computed
@@ -41,6 +41,7 @@
 // exception handling
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/core/vpTrackingException.h>
 
 #include <cmath> // std::fabs
@@ -111,7 +112,7 @@ vpDot2::vpDot2()
   : m00(0.), m10(0.), m01(0.), m11(0.), m20(0.), m02(0.), mu11(0.), mu20(0.), mu02(0.), m_cog(), m_width(0), m_height(0),
   m_surface(0), m_mean_gray_level(0), m_grayLevelPrecision(0.8), m_gamma(1.5),
   m_sizePrecision(0.65), m_ellipsoidShapePrecision(0.65), m_maxSizeSearchDistPrecision(0.65),
-  m_allowedBadPointsPercentage(0.), m_area(), m_direction_list(), m_ip_edges_list(), m_compute_moment(false), m_graphics(false),
+  m_allowedBadPointsPercentage(0.), m_area(), m_directions(), m_ip_edges(), m_compute_moment(false), m_graphics(false),
   m_thickness(1), m_bbox_u_min(0), m_bbox_u_max(0), m_bbox_v_min(0), m_bbox_v_max(0), m_firstBorder_u(0), m_firstBorder_v()
 {
   const unsigned int val_max = 255;
@@ -132,7 +133,7 @@ vpDot2::vpDot2(const vpImagePoint &ip)
   : m00(0.), m10(0.), m01(0.), m11(0.), m20(0.), m02(0.), mu11(0.), mu20(0.), mu02(0.), m_cog(ip), m_width(0), m_height(0),
   m_surface(0), m_mean_gray_level(0), m_grayLevelPrecision(0.8), m_gamma(1.5),
   m_sizePrecision(0.65), m_ellipsoidShapePrecision(0.65), m_maxSizeSearchDistPrecision(0.65),
-  m_allowedBadPointsPercentage(0.), m_area(), m_direction_list(), m_ip_edges_list(), m_compute_moment(false), m_graphics(false),
+  m_allowedBadPointsPercentage(0.), m_area(), m_directions(), m_ip_edges(), m_compute_moment(false), m_graphics(false),
   m_thickness(1), m_bbox_u_min(0), m_bbox_u_max(0), m_bbox_v_min(0), m_bbox_v_max(0), m_firstBorder_u(0), m_firstBorder_v()
 {
   const unsigned int val_max = 255;
@@ -148,7 +149,7 @@ vpDot2::vpDot2(const vpDot2 &twinDot)
   : vpTracker(twinDot), m00(0.), m10(0.), m01(0.), m11(0.), m20(0.), m02(0.), mu11(0.), mu20(0.), mu02(0.), m_cog(),
   m_width(0), m_height(0), m_surface(0), m_mean_gray_level(0),
   m_grayLevelPrecision(0.8), m_gamma(1.5), m_sizePrecision(0.65), m_ellipsoidShapePrecision(0.65),
-  m_maxSizeSearchDistPrecision(0.65), m_allowedBadPointsPercentage(0.), m_area(), m_direction_list(), m_ip_edges_list(),
+  m_maxSizeSearchDistPrecision(0.65), m_allowedBadPointsPercentage(0.), m_area(), m_directions(), m_ip_edges(),
   m_compute_moment(false), m_graphics(false), m_thickness(1), m_bbox_u_min(0), m_bbox_u_max(0), m_bbox_v_min(0), m_bbox_v_max(0),
   m_firstBorder_u(0), m_firstBorder_v()
 {
@@ -181,8 +182,8 @@ vpDot2 &vpDot2::operator=(const vpDot2 &twinDot)
   m_allowedBadPointsPercentage = twinDot.m_allowedBadPointsPercentage;
   m_area = twinDot.m_area;
 
-  m_direction_list = twinDot.m_direction_list;
-  m_ip_edges_list = twinDot.m_ip_edges_list;
+  m_directions = twinDot.m_directions;
+  m_ip_edges = twinDot.m_ip_edges;
 
   m_compute_moment = twinDot.m_compute_moment;
   m_graphics = twinDot.m_graphics;
@@ -227,10 +228,10 @@ void vpDot2::display(const vpImage<unsigned char> &I, vpColor color, unsigned in
   const unsigned int val_3 = 3;
   const unsigned int val_8 = 8;
   vpDisplay::displayCross(I, m_cog, (val_3 * t) + val_8, color, t);
-  std::list<vpImagePoint>::const_iterator it;
+  std::vector<vpImagePoint>::const_iterator it;
 
-  std::list<vpImagePoint>::const_iterator ip_edges_list_end = m_ip_edges_list.end();
-  for (it = m_ip_edges_list.begin(); it != ip_edges_list_end; ++it) {
+  std::vector<vpImagePoint>::const_iterator ip_edges_end = m_ip_edges.end();
+  for (it = m_ip_edges.begin(); it != ip_edges_end; ++it) {
     vpDisplay::displayPoint(I, *it, color);
   }
 }
@@ -1281,8 +1282,8 @@ vpDot2 *vpDot2::getInstance() { return new vpDot2(); }
 */
 bool vpDot2::computeParameters(const vpImage<unsigned char> &I, const double &v_u, const double &v_v)
 {
-  m_direction_list.clear();
-  m_ip_edges_list.clear();
+  m_directions.clear();
+  m_ip_edges.clear();
 
   double est_u = v_u; // estimated
   double est_v = v_v;
@@ -1334,12 +1335,12 @@ bool vpDot2::computeParameters(const vpImage<unsigned char> &I, const double &v_
   }
 
   // store the new direction and dot border coordinates.
-  m_direction_list.push_back(dir);
+  m_directions.push_back(dir);
   vpImagePoint ip;
   ip.set_u(m_firstBorder_u);
   ip.set_v(m_firstBorder_v);
 
-  m_ip_edges_list.push_back(ip);
+  m_ip_edges.push_back(ip);
 
   int border_u = static_cast<int>(m_firstBorder_u);
   int border_v = static_cast<int>(m_firstBorder_v);
@@ -1391,11 +1392,11 @@ bool vpDot2::computeParameters(const vpImage<unsigned char> &I, const double &v_
 
     // store the new direction and dot border coordinates.
 
-    m_direction_list.push_back(dir);
+    m_directions.push_back(dir);
 
     ip.set_u(border_u);
     ip.set_v(border_v);
-    m_ip_edges_list.push_back(ip);
+    m_ip_edges.push_back(ip);
 
     // update the extreme point of the dot.
     if (border_v < m_bbox_v_min) {
@@ -1795,6 +1796,72 @@ vpMatrix vpDot2::defineDots(vpDot2 dot[], const unsigned int &n, const std::stri
   return Cogs;
 }
 
+/*!
+  Track a set of dots in an image, for example the dots of a calibration grid.
+
+  Each dot is tracked as with track(). The dots being independent, they are
+  tracked in parallel using the threads of vpThreadPool::getInstance(). When
+  one of the dots has the graphics enabled (see setGraphics()), the dots are
+  tracked sequentially since the display is not thread safe.
+
+  Contrary to track(), a lost dot does not throw an exception: it is reported
+  in \e tracked and the other dots are still tracked. A lost dot keeps the
+  state left by track() when it failed, and has to be initialized again before
+  being tracked.
+
+  \param dots : Dots to track.
+
+  \param I : Image.
+
+  \param tracked : Resized to the number of dots. Element \e i is true if
+  dot \e i was tracked, false if it was lost.
+
+  \param canMakeTheWindowGrow : If true, the size of the area where a lost
+  dot is searched is increased, see track().
+
+  \return The number of dots that were tracked.
+
+  \sa track()
+*/
+unsigned int vpDot2::trackDots(std::vector<vpDot2> &dots, const vpImage<unsigned char> &I, std::vector<bool> &tracked,
+                               bool canMakeTheWindowGrow)
+{
+  const unsigned int nbDots = static_cast<unsigned int>(dots.size());
+  // std::vector<bool> packs its elements and cannot be written concurrently
+  std::vector<unsigned char> status(nbDots, 0);
+
+  vpThreadPool::vpRangeTask trackRange = [&](unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i) {
+      try {
+        dots[i].track(I, canMakeTheWindowGrow);
+        status[i] = 1;
+      }
+      catch (const vpTrackingException &) {
+        status[i] = 0;
+      }
+    }
+  };
+
+  bool graphics = false;
+  for (unsigned int i = 0; (i < nbDots) && (!graphics); ++i) {
+    graphics = dots[i].m_graphics;
+  }
+  if (graphics) {
+    trackRange(0, nbDots);
+  }
+  else {
+    vpThreadPool::getInstance().parallelFor(0, nbDots, trackRange);
+  }
+
+  unsigned int nbTracked = 0;
+  tracked.resize(nbDots);
+  for (unsigned int i = 0; i < nbDots; ++i) {
+    tracked[i] = (status[i] != 0);
+    nbTracked += status[i];
+  }
+  return nbTracked;
+}
+
 /*!
   Tracks a number of dots in an image and displays their trajectories
 
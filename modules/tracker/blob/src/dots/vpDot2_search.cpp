@@ -67,8 +67,8 @@ BEGIN_VISP_NAMESPACE
     while ((itbad != data.m_badDotsVector.end()) && (good_germ == true)) {
       if ((static_cast<double>(data.m_u) >= (*itbad).m_bbox_u_min) && (static_cast<double>(data.m_u) <= (*itbad).m_bbox_u_max) &&
           (static_cast<double>(data.m_v) >= (*itbad).m_bbox_v_min) && (static_cast<double>(data.m_v) <= (*itbad).m_bbox_v_max)) {
-        std::list<vpImagePoint>::const_iterator it_edges = m_ip_edges_list.begin();
-        while ((it_edges != m_ip_edges_list.end()) && (good_germ == true)) {
+        std::vector<vpImagePoint>::const_iterator it_edges = m_ip_edges.begin();
+        while ((it_edges != m_ip_edges.end()) && (good_germ == true)) {
           // Test if the germ belong to a previously detected dot:
           // - from the germ go right to the border and compare this
           //   position to the list of pixels of previously detected dots
@@ -0,0 +1,170 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tracking of a set of dots with vpDot2::trackDots().
+ */
+
+/*!
+ * \example catchDot2Batch.cpp
+ *
+ * Test vpDot2::trackDots() on a synthetic grid of dots against the tracking of
+ * each dot with vpDot2::track().
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/blob/vpDot2.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpThreadPool.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int gridSize = 8;
+const double gridStep = 60.;
+const double gridOrigin = 60.;
+const double dotRadius = 5.;
+
+// Draw the grid of white dots shifted by (du, dv), without the dot number missingDot if any
+void drawGrid(vpImage<unsigned char> &I, double du, double dv, int missingDot = -1)
+{
+  I.resize(540, 540, 0);
+  for (unsigned int k = 0; k < gridSize * gridSize; ++k) {
+    if (static_cast<int>(k) == missingDot) {
+      continue;
+    }
+    const double uc = gridOrigin + ((k % gridSize) * gridStep) + du;
+    const double vc = gridOrigin + ((k / gridSize) * gridStep) + dv;
+    for (unsigned int v = 0; v < I.getHeight(); ++v) {
+      for (unsigned int u = 0; u < I.getWidth(); ++u) {
+        if ((((u - uc) * (u - uc)) + ((v - vc) * (v - vc))) <= (dotRadius * dotRadius)) {
+          I[v][u] = 255;
+        }
+      }
+    }
+  }
+}
+
+std::vector<vpDot2> initGrid(const vpImage<unsigned char> &I)
+{
+  std::vector<vpDot2> dots(gridSize * gridSize);
+  for (unsigned int k = 0; k < dots.size(); ++k) {
+    vpImagePoint ip(gridOrigin + ((k / gridSize) * gridStep), gridOrigin + ((k % gridSize) * gridStep));
+    dots[k].initTracking(I, ip, 200, 255);
+  }
+  return dots;
+}
+} // namespace
+
+TEST_CASE("Batch tracking matches the tracking of each dot", "[vpDot2]")
+{
+  vpImage<unsigned char> I;
+  drawGrid(I, 0., 0.);
+  std::vector<vpDot2> dots = initGrid(I);
+  std::vector<vpDot2> refDots = dots;
+
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  const unsigned int nbThreads = pool.getNbThreads();
+  pool.setNbThreads(4);
+
+  const double shifts[3][2] = { { 2., 1. }, { 3.5, -1.5 }, { 1., 2.5 } };
+  for (unsigned int s = 0; s < 3; ++s) {
+    drawGrid(I, shifts[s][0], shifts[s][1]);
+
+    std::vector<bool> tracked;
+    CHECK(vpDot2::trackDots(dots, I, tracked) == dots.size());
+    REQUIRE(tracked.size() == dots.size());
+
+    for (unsigned int k = 0; k < dots.size(); ++k) {
+      refDots[k].track(I);
+      CHECK(tracked[k]);
+      CHECK(dots[k].getCog() == refDots[k].getCog());
+      CHECK(dots[k].getArea() == refDots[k].getArea());
+
+      const double uc = gridOrigin + ((k % gridSize) * gridStep) + shifts[s][0];
+      const double vc = gridOrigin + ((k / gridSize) * gridStep) + shifts[s][1];
+      CHECK(dots[k].getCog().get_u() == Catch::Approx(uc).margin(0.5));
+      CHECK(dots[k].getCog().get_v() == Catch::Approx(vc).margin(0.5));
+
+      std::vector<vpImagePoint> edges;
+      dots[k].getEdges(edges);
+      std::list<vpImagePoint> edges_list = refDots[k].getEdges();
+      REQUIRE(edges.size() == edges_list.size());
+      CHECK(std::equal(edges.begin(), edges.end(), edges_list.begin()));
+    }
+  }
+
+  pool.setNbThreads(nbThreads);
+}
+
+TEST_CASE("A lost dot does not stop the batch tracking", "[vpDot2]")
+{
+  vpImage<unsigned char> I;
+  drawGrid(I, 0., 0.);
+  std::vector<vpDot2> dots = initGrid(I);
+
+  const int missingDot = 19;
+  drawGrid(I, 1., 1., missingDot);
+
+  std::vector<bool> tracked;
+  CHECK(vpDot2::trackDots(dots, I, tracked) == (dots.size() - 1));
+  REQUIRE(tracked.size() == dots.size());
+  for (unsigned int k = 0; k < dots.size(); ++k) {
+    CHECK(tracked[k] == (static_cast<int>(k) != missingDot));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -40,6 +40,7 @@
 #define vpMbEdgeTracker_HH
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceCircle.h>
@@ -289,6 +290,12 @@ protected:
   //! computed in the init() and in the track() methods.
   std::vector<const vpImage<unsigned char> *> Ipyramid;
 
+  //! Pyramid owned by the tracker, whose levels are reused from one image to the next one.
+  vpImagePyramid m_pyramid;
+
+  //! Pyramid given by setImagePyramid(), used instead of m_pyramid when built from the tracked image.
+  const vpImagePyramid *m_sharedPyramid;
+
   //! Current scale level used. This attribute must not be modified outside of
   //! the downScale() and upScale() methods, as it used to specify to some
   //! methods which set of distanceLine use.
@@ -320,6 +327,20 @@ protected:
   vpRobust m_robust_edge;
   //! Display features
   std::vector<std::vector<double> > m_featuresToBeDisplayedEdge;
+  //! If true, the moving-edge sites of the tracked lines are compiled in contiguous arrays, see setFlatFeatureStorage()
+  bool m_flatFeatureStorage;
+  //! Tracked lines of the flat storage
+  std::vector<vpMbtDistanceLine *> m_flatLines;
+  //! For each line of the flat storage: rho, cos(theta), sin(theta) and the interaction matrices of rho and theta,
+  //! all set to 0 in the degenerate case
+  std::vector<double> m_flatLineParameters;
+  //! For each moving-edge site of the flat storage, index in m_flatLines of its line
+  std::vector<unsigned int> m_flatSiteLine;
+  //! For each moving-edge site of the flat storage, normalized coordinates along x
+  std::vector<double> m_flatSiteX;
+  //! For each moving-edge site of the flat storage, normalized coordinates along y
+  std::vector<double> m_flatSiteY;
+
 public:
   vpMbEdgeTracker();
   virtual ~vpMbEdgeTracker() VP_OVERRIDE;
@@ -376,6 +397,14 @@ public:
 
   virtual inline vpColVector getError() const VP_OVERRIDE { return m_error_edge; }
 
+  /*!
+   * \return true if the moving-edge sites of the lines are compiled in contiguous arrays for the virtual visual
+   * servoing.
+   *
+   * \sa setFlatFeatureStorage()
+   */
+  inline bool getFlatFeatureStorage() const { return m_flatFeatureStorage; }
+
   virtual inline vpColVector getRobustWeights() const VP_OVERRIDE { return m_w_edge; }
 
   virtual void loadConfigFile(const std::string &configFile, bool verbose = true) VP_OVERRIDE;
@@ -415,6 +444,23 @@ public:
 
   virtual void setFarClippingDistance(const double &dist) VP_OVERRIDE;
 
+  /*!
+   * Enable or disable the flat storage of the features. When enabled, the positions of the moving-edge sites of
+   * the tracked lines and the index of their line are compiled in contiguous arrays once per image, before the
+   * virtual visual servoing. At each iteration, the projection of each line is then computed once and the rows of
+   * the interaction matrix and of the residual are built from those arrays in a single pass, split between the
+   * threads of vpThreadPool::getInstance(), instead of walking through the lists of moving-edge sites of each line.
+   * The estimated pose is the same in both modes.
+   *
+   * \note When enabled, vpMbtDistanceLine::L and vpMbtDistanceLine::error are not updated by the iterations of
+   * the virtual visual servoing.
+   *
+   * \param flat : True to enable the flat storage, false to use the lists of the lines (default).
+   *
+   * \sa getFlatFeatureStorage()
+   */
+  void setFlatFeatureStorage(bool flat) { m_flatFeatureStorage = flat; }
+
   virtual void setNearClippingDistance(const double &dist) VP_OVERRIDE;
 
   /*!
@@ -466,6 +512,8 @@ public:
    */
   void setGoodMovingEdgesRatioThreshold(double threshold) { percentageGdPt = threshold; }
 
+  void setImagePyramid(const vpImagePyramid *pyramid);
+
   void setMovingEdge(const vpMe &me);
 
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo) VP_OVERRIDE;
@@ -500,6 +548,7 @@ protected:
   virtual void computeVVSInteractionMatrixAndResidu(const vpImage<unsigned char> &I);
   virtual void computeVVSWeights();
   using vpMbTracker::computeVVSWeights;
+  void computeVVSFlatLines();
 
   void displayFeaturesOnImage(const vpImage<unsigned char> &I);
   void displayFeaturesOnImage(const vpImage<vpRGBa> &I);
@@ -512,6 +561,7 @@ protected:
                             const std::string &name = "") VP_OVERRIDE;
   virtual void initFaceFromCorners(vpMbtPolygon &polygon) VP_OVERRIDE;
   virtual void initFaceFromLines(vpMbtPolygon &polygon) VP_OVERRIDE;
+  void initFlatFeatureStorage();
   unsigned int initMbtTracking(unsigned int &nberrors_lines, unsigned int &nberrors_cylinders,
                                unsigned int &nberrors_circles);
   void initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo, const bool &useInitRange = true);
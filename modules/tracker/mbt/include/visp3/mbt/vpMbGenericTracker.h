@@ -46,6 +46,8 @@
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/core/vpJsonParsing.h>
 
+#include <functional>
+
 BEGIN_VISP_NAMESPACE
 /*!
  * \class vpMbGenericTracker
@@ -340,6 +342,13 @@ public:
   virtual unsigned int getNbPolygon() const VP_OVERRIDE;
   virtual void getNbPolygon(std::map<std::string, unsigned int> &mapOfNbPolygons) const;
 
+  /*!
+   * Return true if the cameras and the feature types of each camera are processed in parallel.
+   *
+   * \sa setParallelTracking()
+   */
+  virtual inline bool getParallelTracking() const { return m_parallelTracking; }
+
   virtual vpMbtPolygon *getPolygon(unsigned int index) VP_OVERRIDE;
   virtual vpMbtPolygon *getPolygon(const std::string &cameraName, unsigned int index);
 
@@ -505,6 +514,8 @@ public:
 
   virtual void setFeatureFactors(const std::map<vpTrackerType, double> &mapOfFeatureFactors);
 
+  virtual void setFlatFeatureStorage(bool flat);
+
   virtual void setGoodMovingEdgesRatioThreshold(double threshold);
 
 #ifdef VISP_HAVE_OGRE
@@ -544,6 +555,8 @@ public:
 
   virtual void setOptimizationMethod(const vpMbtOptimizationMethod &opt) VP_OVERRIDE;
 
+  virtual void setParallelTracking(bool parallel);
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo) VP_OVERRIDE;
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo) VP_OVERRIDE;
 
@@ -642,9 +655,14 @@ protected:
 #endif
 
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_SEGMENTATION) && defined(VISP_HAVE_PCL_FILTERS) && defined(VISP_HAVE_PCL_COMMON)
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
 #endif
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+    std::map<std::string, unsigned int> &mapOfPointCloudHeights);
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
@@ -655,6 +673,9 @@ protected:
     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
 private:
+  class TrackerWrapper;
+  void runOnTrackers(const std::function<void(const std::string &, TrackerWrapper *)> &func, bool parallel);
+
   class TrackerWrapper : public vpMbEdgeTracker,
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
     public vpMbKltTracker,
@@ -679,6 +700,8 @@ private:
     vpColVector m_w;
     //! Weighted error
     vpColVector m_weightedError;
+    //! If true, the feature types are extracted in parallel in preTracking()
+    bool m_parallelFeatures;
 
     TrackerWrapper();
     explicit TrackerWrapper(int trackerType);
@@ -843,6 +866,8 @@ protected:
   unsigned int m_nb_feat_depthNormal;
   //! Number of depth dense features
   unsigned int m_nb_feat_depthDense;
+  //! If true, the cameras and the feature types of each camera are processed in parallel
+  bool m_parallelTracking;
 };
 
 #ifdef VISP_HAVE_NLOHMANN_JSON
@@ -145,6 +145,7 @@ public:
 
   bool closeToImageBorder(const vpImage<unsigned char> &I, const unsigned int threshold);
   void computeInteractionMatrixError(const vpHomogeneousMatrix &cMo);
+  bool computeProjectedLine(const vpHomogeneousMatrix &cMo, double &rho, double &theta, vpMatrix &H);
 
   void display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
                const vpColor &col, unsigned int thickness = 1, bool displayFullModel = false);
@@ -217,7 +217,7 @@ void vpMbDepthDenseTracker::computeVVS()
         L_true = m_L_depthDense;
         if (!isoJoIdentity) {
           cVo.buildFrom(m_cMo);
-          LVJ_true = (m_L_depthDense * cVo * oJo);
+          LVJ_true = (m_L_depthDense * (cVo * oJo));
         }
       }
 
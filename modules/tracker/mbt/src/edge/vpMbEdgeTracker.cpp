@@ -45,6 +45,7 @@
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPolygon3D.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
@@ -64,10 +65,12 @@ BEGIN_VISP_NAMESPACE
 */
 vpMbEdgeTracker::vpMbEdgeTracker()
   : me(), lines(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
-  percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
+  percentageGdPt(0.4), scales(1), Ipyramid(0),
+    m_pyramid(1, vpImagePyramid::PYRAMID_SUBSAMPLING), m_sharedPyramid(nullptr), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
   m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
   m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-  m_robust_edge(), m_featuresToBeDisplayedEdge()
+  m_robust_edge(), m_featuresToBeDisplayedEdge(), m_flatFeatureStorage(false), m_flatLines(), m_flatLineParameters(),
+  m_flatSiteLine(), m_flatSiteX(), m_flatSiteY()
 {
   scales[0] = true;
 
@@ -232,7 +235,7 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &I_, unsigned int
         L_true = m_L_edge;
         if (!isoJoIdentity) {
           cVo.buildFrom(m_cMo);
-          LVJ_true = (m_L_edge * cVo * oJo);
+          LVJ_true = (m_L_edge * (cVo * oJo));
         }
       }
 
@@ -714,7 +717,7 @@ void vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(unsigned int iter, bool
   }
   else {
     cVo.buildFrom(m_cMo);
-    vpMatrix LVJ = (m_L_edge * cVo * oJo);
+    vpMatrix LVJ = (m_L_edge * (cVo * oJo));
     vpMatrix LVJTLVJ = (LVJ).AtA();
     vpColVector LVJTR;
     computeJTR(LVJ, m_weightedError_edge, LVJTR);
@@ -763,6 +766,10 @@ void vpMbEdgeTracker::computeVVSInit()
   m_errorLines.resize(nberrors_lines, false);
   m_errorCylinders.resize(nberrors_cylinders, false);
   m_errorCircles.resize(nberrors_circles, false);
+
+  if (m_flatFeatureStorage) {
+    initFlatFeatureStorage();
+  }
 }
 
 void vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu()
@@ -783,20 +790,26 @@ void vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(const vpImage<unsigne
   unsigned int ncylinders = 0;
   unsigned int ncircles = 0;
 
-  for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
-       ++it) {
-    if ((*it)->isTracked()) {
-      l = *it;
-      l->computeInteractionMatrixError(m_cMo);
-      for (unsigned int i = 0; i < l->nbFeatureTotal; i++) {
-        for (unsigned int j = 0; j < 6; j++) {
-          m_L_edge[n + i][j] = l->L[i][j];
-          m_error_edge[n + i] = l->error[i];
-          m_errorLines[nlines + i] = m_error_edge[n + i];
+  if (m_flatFeatureStorage) {
+    computeVVSFlatLines();
+    n = static_cast<unsigned int>(m_flatSiteX.size());
+  }
+  else {
+    for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
+         ++it) {
+      if ((*it)->isTracked()) {
+        l = *it;
+        l->computeInteractionMatrixError(m_cMo);
+        for (unsigned int i = 0; i < l->nbFeatureTotal; i++) {
+          for (unsigned int j = 0; j < 6; j++) {
+            m_L_edge[n + i][j] = l->L[i][j];
+            m_error_edge[n + i] = l->error[i];
+            m_errorLines[nlines + i] = m_error_edge[n + i];
+          }
         }
+        n += l->nbFeatureTotal;
+        nlines += l->nbFeatureTotal;
       }
-      n += l->nbFeatureTotal;
-      nlines += l->nbFeatureTotal;
     }
   }
 
@@ -837,6 +850,104 @@ void vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(const vpImage<unsigne
   }
 }
 
+/*!
+  Compile the moving-edge sites of the tracked lines in the contiguous arrays of the flat storage: the normalized
+  coordinates of each site and the index of its line, in the same order than the rows of the interaction matrix.
+
+  \sa setFlatFeatureStorage(), computeVVSFlatLines()
+*/
+void vpMbEdgeTracker::initFlatFeatureStorage()
+{
+  m_flatLines.clear();
+  m_flatSiteLine.clear();
+  m_flatSiteX.clear();
+  m_flatSiteY.clear();
+
+  for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
+       ++it) {
+    vpMbtDistanceLine *l = *it;
+    if (l->isTracked() && l->isVisible()) {
+      vpCameraParameters cam;
+      l->getCameraParameters(cam);
+      double mx = 1.0 / cam.get_px();
+      double my = 1.0 / cam.get_py();
+      double xc = cam.get_u0();
+      double yc = cam.get_v0();
+
+      unsigned int lineIndex = static_cast<unsigned int>(m_flatLines.size());
+      m_flatLines.push_back(l);
+      for (size_t i = 0; i < l->meline.size(); i++) {
+        const std::list<vpMeSite> &sites = l->meline[i]->getMeList();
+        for (std::list<vpMeSite>::const_iterator itSite = sites.begin(); itSite != sites.end(); ++itSite) {
+          m_flatSiteLine.push_back(lineIndex);
+          m_flatSiteX.push_back((static_cast<double>(itSite->get_j()) - xc) * mx);
+          m_flatSiteY.push_back((static_cast<double>(itSite->get_i()) - yc) * my);
+        }
+      }
+    }
+  }
+  m_flatLineParameters.resize(15 * m_flatLines.size());
+}
+
+/*!
+  Compute the rows of the interaction matrix and of the residual corresponding to the moving-edge sites of the
+  lines from the flat storage. The projection of each line is computed first, then the rows of all the sites are
+  computed in a single pass over the contiguous arrays.
+
+  \sa setFlatFeatureStorage(), initFlatFeatureStorage()
+*/
+void vpMbEdgeTracker::computeVVSFlatLines()
+{
+  const size_t nbLines = m_flatLines.size();
+  vpMatrix H;
+  for (size_t i = 0; i < nbLines; ++i) {
+    double *params = &m_flatLineParameters[15 * i];
+    double rho, theta;
+    if (m_flatLines[i]->computeProjectedLine(m_cMo, rho, theta, H)) {
+      params[0] = rho;
+      params[1] = cos(theta);
+      params[2] = sin(theta);
+      for (unsigned int k = 0; k < 6; ++k) {
+        params[3 + k] = H[0][k];
+        params[9 + k] = H[1][k];
+      }
+    }
+    else {
+      // Degenerate case: the image of the straight line is a point, the rows are set to zero
+      for (unsigned int k = 0; k < 15; ++k) {
+        params[k] = 0.;
+      }
+    }
+  }
+
+  vpThreadPool::getInstance().parallelFor(0, static_cast<unsigned int>(m_flatSiteX.size()),
+                                          [this](unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i) {
+      const double *params = &m_flatLineParameters[15 * m_flatSiteLine[i]];
+      const double rho = params[0], co = params[1], si = params[2];
+      const double *Lrho = params + 3;
+      const double *Ltheta = params + 9;
+      const double x = m_flatSiteX[i];
+      const double y = m_flatSiteY[i];
+      double *L = m_L_edge[i];
+      if ((std::fabs(co) > 0.) || (std::fabs(si) > 0.)) {
+        const double alpha_ = x * si - y * co;
+        for (unsigned int k = 0; k < 6; ++k) {
+          L[k] = (Lrho[k] + alpha_ * Ltheta[k]);
+        }
+        m_error_edge[i] = rho - (x * co + y * si);
+      }
+      else {
+        for (unsigned int k = 0; k < 6; ++k) {
+          L[k] = 0.;
+        }
+        m_error_edge[i] = 0.;
+      }
+      m_errorLines[i] = m_error_edge[i];
+    }
+  });
+}
+
 void vpMbEdgeTracker::computeVVSWeights()
 {
   unsigned int nberrors_lines = m_errorLines.getRows(), nberrors_cylinders = m_errorCylinders.getRows(),
@@ -2743,14 +2854,12 @@ void vpMbEdgeTracker::setClipping(const unsigned int &flags)
 /*!
   Compute the pyramid of image associated to the image in parameter. The
   scales computed are the ones corresponding to the scales  attribute of the
-  class. If OpenCV is detected, the functions used to computed a smoothed
-  pyramid come from OpenCV, otherwise a simple subsampling (no smoothing, no
-  interpolation) is realized.
+  class. The levels come from the pyramid given to setImagePyramid() when it
+  was built from \e I_, otherwise they are computed by a simple subsampling (no
+  smoothing, no interpolation) in a pyramid owned by the tracker.
 
-  \warning The pyramid contains pointers to vpImage. To properly deallocate
-  the pyramid. All the element but the first (which is a pointer to the input
-  image) must be freed. A proper cleaning is implemented in the cleanPyramid()
-  method.
+  \warning The pyramid contains pointers to images owned by a vpImagePyramid
+  that are valid until the next call to this method. They must not be freed.
 
   \param I_ : The input image.
   \param _pyramid : The pyramid of image to build from the input image.
@@ -2758,50 +2867,73 @@ void vpMbEdgeTracker::setClipping(const unsigned int &flags)
 void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &I_,
                                   std::vector<const vpImage<unsigned char> *> &_pyramid)
 {
-  _pyramid.resize(scales.size());
-
-  if (scales[0]) {
-    _pyramid[0] = &I_;
-  }
-  else {
-    _pyramid[0] = nullptr;
-  }
+  const unsigned int nbLevels = static_cast<unsigned int>(scales.size());
+  _pyramid.resize(nbLevels);
 
-  for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
+  // Only the levels up to the coarsest used scale are needed
+  unsigned int nbUsedLevels = 1;
+  for (unsigned int i = 0; i < nbLevels; i += 1) {
     if (scales[i]) {
-      unsigned int cScale = static_cast<unsigned int>(pow(2., static_cast<int>(i)));
-      vpImage<unsigned char> *I = new vpImage<unsigned char>(I_.getHeight() / cScale, I_.getWidth() / cScale);
-      for (unsigned int k = 0, ii = 0; k < I->getHeight(); k += 1, ii += cScale) {
-        for (unsigned int l = 0, jj = 0; l < I->getWidth(); l += 1, jj += cScale) {
-          (*I)[k][l] = I_[ii][jj];
-        }
-      }
-      _pyramid[i] = I;
+      nbUsedLevels = i + 1;
     }
-    else {
-      _pyramid[i] = nullptr;
+  }
+
+  const vpImagePyramid *pyramid = m_sharedPyramid;
+  // A shared pyramid whose type was changed after setImagePyramid() is ignored, its levels would be smoothed
+  if ((pyramid == nullptr) || (pyramid->getType() != vpImagePyramid::PYRAMID_SUBSAMPLING) ||
+      (pyramid->getBaseImage() != &I_) || (pyramid->getNbLevels() < nbUsedLevels)) {
+    // Levels are only reallocated when the used scales or the size of the image change
+    if (m_pyramid.getNbLevels() != nbUsedLevels) {
+      m_pyramid.setNbLevels(nbUsedLevels);
     }
+    m_pyramid.build(I_);
+    pyramid = &m_pyramid;
+  }
+
+  for (unsigned int i = 0; i < nbLevels; i += 1) {
+    _pyramid[i] = scales[i] ? &pyramid->getLevel(i) : nullptr;
   }
 }
 
 /*!
-  Clean the pyramid of image allocated with the initPyramid() method. The
-  vector has a size equal to zero at the end of the method.
+  Set a pyramid built outside of the tracker from the images that are given to
+  track(), so that an image is decimated only once when it is shared between
+  several consumers. The pyramid is used when its base image is the image given
+  to track() and when it has at least as many levels as the coarsest scale
+  used (see setScales()). Otherwise, the tracker builds its own pyramid by
+  subsampling the image.
+
+  The pyramid has to be of type vpImagePyramid::PYRAMID_SUBSAMPLING, which is
+  the decimation used by the tracker for its scales. With the smoothed levels
+  of a vpImagePyramid::PYRAMID_GAUSSIAN pyramid, the default type of
+  vpImagePyramid, the moving edges would not give the same results. If the
+  type of the pyramid is changed after this call, the pyramid is ignored.
+
+  \param pyramid : Pointer to the pyramid, that must remain valid while
+  tracking. Use nullptr to come back to the pyramid built by the tracker.
+
+  \exception vpException::badValue : If the pyramid is not of type
+  vpImagePyramid::PYRAMID_SUBSAMPLING.
+*/
+void vpMbEdgeTracker::setImagePyramid(const vpImagePyramid *pyramid)
+{
+  if ((pyramid != nullptr) && (pyramid->getType() != vpImagePyramid::PYRAMID_SUBSAMPLING)) {
+    throw(vpException(vpException::badValue,
+                      "The image pyramid given to the edge tracker must be of type PYRAMID_SUBSAMPLING"));
+  }
+  m_sharedPyramid = pyramid;
+}
+
+/*!
+  Clean the pyramid of image set with the initPyramid() method. The images are
+  owned by the pyramid and kept for the next image. The vector has a size equal
+  to zero at the end of the method.
 
   \param _pyramid : The pyramid of image to clean.
 */
 void vpMbEdgeTracker::cleanPyramid(std::vector<const vpImage<unsigned char> *> &_pyramid)
 {
-  if (_pyramid.size() > 0) {
-    _pyramid[0] = nullptr;
-    for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
-      if (_pyramid[i] != nullptr) {
-        delete _pyramid[i];
-        _pyramid[i] = nullptr;
-      }
-    }
-    _pyramid.resize(0);
-  }
+  _pyramid.resize(0);
 }
 
 /*!
@@ -844,6 +844,36 @@ void vpMbtDistanceLine::initInteractionMatrixError()
   }
 }
 
+/*!
+  Compute the projection of the line in the image and the interaction matrix of the corresponding
+  \f$(\rho,\theta)\f$ feature.
+
+  \param cMo : The pose of the camera.
+  \param rho : Parameter \f$\rho\f$ of the projected line.
+  \param theta : Parameter \f$\theta\f$ of the projected line.
+  \param H : Interaction matrix of the \f$(\rho,\theta)\f$ feature.
+
+  \return false in the degenerate case where the image of the line is a point.
+*/
+bool vpMbtDistanceLine::computeProjectedLine(const vpHomogeneousMatrix &cMo, double &rho, double &theta, vpMatrix &H)
+{
+  try {
+    // feature projection
+    line->changeFrame(cMo);
+    line->projection();
+
+    vpFeatureBuilder::create(featureline, *line);
+
+    rho = featureline.getRho();
+    theta = featureline.getTheta();
+    H = featureline.interaction();
+  }
+  catch (...) {
+    return false;
+  }
+  return true;
+}
+
 /*!
   Compute the interaction matrix and the error vector corresponding to the
   line.
@@ -851,16 +881,9 @@ void vpMbtDistanceLine::initInteractionMatrixError()
 void vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
 {
   if (isvisible) {
-    try {
-      // feature projection
-      line->changeFrame(cMo);
-      line->projection();
-
-      vpFeatureBuilder::create(featureline, *line);
-
-      double rho = featureline.getRho();
-      double theta = featureline.getTheta();
-
+    double rho, theta;
+    vpMatrix H;
+    if (computeProjectedLine(cMo, rho, theta, H)) {
       double co = cos(theta);
       double si = sin(theta);
 
@@ -870,7 +893,6 @@ void vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix
       double yc = cam.get_v0();
 
       double alpha_;
-      vpMatrix H = featureline.interaction();
 
       double x, y;
       unsigned int j = 0;
@@ -897,7 +919,7 @@ void vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix
         }
       }
     }
-    catch (...) {
+    else {
    // Handle potential exception: due to a degenerate case: the image of the straight line is a point!
    // Set the corresponding interaction matrix part to zero
       unsigned int j = 0;
@@ -838,7 +838,7 @@ void vpMbEdgeKltTracker::computeVVS(const vpImage<unsigned char> &I, const unsig
         if (!isoJoIdentity) {
           vpVelocityTwistMatrix cVo;
           cVo.buildFrom(m_cMo);
-          LVJ_true = (L * cVo * oJo);
+          LVJ_true = (L * (cVo * oJo));
         }
       }
 
@@ -825,7 +825,7 @@ void vpMbKltTracker::computeVVS()
         if (!isoJoIdentity) {
           vpVelocityTwistMatrix cVo;
           cVo.buildFrom(m_cMo);
-          LVJ_true = (m_L_klt * cVo * oJo);
+          LVJ_true = (m_L_klt * (cVo * oJo));
         }
       }
 
@@ -37,6 +37,7 @@
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
 #ifdef VISP_HAVE_NLOHMANN_JSON
@@ -45,10 +46,37 @@ using json = nlohmann::json; //! json namespace shortcut
 #endif
 
 BEGIN_VISP_NAMESPACE
+namespace
+{
+// Value associated to a camera, or the default value when the camera is not in the map. Unlike operator[], the map is
+// not modified so that it can be read by several threads.
+template <typename Type> Type getCameraValue(const std::map<std::string, Type> &map, const std::string &name)
+{
+  typename std::map<std::string, Type>::const_iterator it = map.find(name);
+  return (it == map.end()) ? Type() : it->second;
+}
+
+void runTasks(const std::vector<std::function<void()> > &tasks, bool parallel)
+{
+  if (parallel && (tasks.size() > 1)) {
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      group.run(tasks[i]);
+    }
+    group.wait();
+  }
+  else {
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i]();
+    }
+  }
+}
+}
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_parallelTracking(false)
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -69,7 +97,7 @@ vpMbGenericTracker::vpMbGenericTracker()
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_parallelTracking(false)
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -108,7 +136,7 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_parallelTracking(false)
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -149,7 +177,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_parallelTracking(false)
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -541,14 +569,14 @@ void vpMbGenericTracker::computeVVSInit()
 
 void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
-  unsigned int nbFeatures = 0;
+  runOnTrackers([&mapOfImages](const std::string &name, TrackerWrapper *tracker) {
+    tracker->computeVVSInit(getCameraValue(mapOfImages, name));
+  }, m_parallelTracking);
 
+  unsigned int nbFeatures = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
-
-    nbFeatures += tracker->m_error.getRows();
+    nbFeatures += it->second->m_error.getRows();
   }
 
   m_L.resize(nbFeatures, 6, false, false);
@@ -570,20 +598,22 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
   std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
-
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
+  runOnTrackers([this, &mapOfImages](const std::string &name, TrackerWrapper *tracker) {
+    const vpHomogeneousMatrix cMcRef = getCameraValue(m_mapOfCameraTransformationMatrix, name);
+    tracker->m_cMo = cMcRef * m_cMo;
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-    vpHomogeneousMatrix c_curr_tTc_curr0 =
-      m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
+    vpHomogeneousMatrix c_curr_tTc_curr0 = cMcRef * m_cMo * tracker->c0Mo.inverse();
     tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+    tracker->computeVVSInteractionMatrixAndResidu(getCameraValue(mapOfImages, name));
+  }, m_parallelTracking);
+
+  // Stack the features in the order of the cameras, whatever the order in which they have been computed
+  unsigned int start_index = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
 
     m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
     m_error.insert(start_index, tracker->m_error);
@@ -594,12 +624,12 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
 
 void vpMbGenericTracker::computeVVSWeights()
 {
-  unsigned int start_index = 0;
+  runOnTrackers([](const std::string &, TrackerWrapper *tracker) { tracker->computeVVSWeights(); }, m_parallelTracking);
 
+  unsigned int start_index = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
 
     m_w.insert(start_index, tracker->m_w);
     start_index += tracker->m_w.getRows();
@@ -2982,6 +3012,7 @@ void vpMbGenericTracker::loadConfigFileJSON(const std::string &settingsFile, boo
       }
       TrackerWrapper *tw = new TrackerWrapper(); //vpMBTracker is responsible for deleting trackers
       *tw = trackerJson;
+      tw->m_parallelFeatures = m_parallelTracking;
       m_mapOfTrackers[cameraName] = tw;
     }
     const auto unusedCamIt = std::remove(unusedCameraNames.begin(), unusedCameraNames.end(), cameraName); // Mark this camera name as used
@@ -3266,28 +3297,88 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
 }
 
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_SEGMENTATION) && defined(VISP_HAVE_PCL_FILTERS) && defined(VISP_HAVE_PCL_COMMON)
-void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  // The visibility test with Ogre relies on a rendering context that cannot be shared between threads
+  bool parallel = m_parallelTracking;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    parallel = parallel && (!it->second->useOgre);
   }
-}
+
+  runOnTrackers([&](const std::string &name, TrackerWrapper *tracker) {
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+    tracker->postTracking(getCameraValue(mapOfImages, name), getCameraValue(mapOfPointClouds, name));
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
 #endif
 
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+  }, parallel);
+}
+
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
-  std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
+  std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
+{
+  runOnTrackers([&mapOfImages, &mapOfPointClouds](const std::string &name, TrackerWrapper *tracker) {
+    tracker->preTracking(getCameraValue(mapOfImages, name), getCameraValue(mapOfPointClouds, name));
+  }, m_parallelTracking);
+}
+#endif
+
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
   std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  // The visibility test with Ogre relies on a rendering context that cannot be shared between threads
+  bool parallel = m_parallelTracking;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-      mapOfPointCloudHeights[it->first]);
+    parallel = parallel && (!it->second->useOgre);
   }
+
+  runOnTrackers([&](const std::string &name, TrackerWrapper *tracker) {
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+    tracker->postTracking(getCameraValue(mapOfImages, name), getCameraValue(mapOfPointCloudWidths, name),
+      getCameraValue(mapOfPointCloudHeights, name));
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
+#endif
+
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+  }, parallel);
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
+  std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+  std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  runOnTrackers([&](const std::string &name, TrackerWrapper *tracker) {
+    tracker->preTracking(getCameraValue(mapOfImages, name), getCameraValue(mapOfPointClouds, name),
+      getCameraValue(mapOfPointCloudWidths, name), getCameraValue(mapOfPointCloudHeights, name));
+  }, m_parallelTracking);
 }
 
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
@@ -3295,12 +3386,27 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
   std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  runOnTrackers([&](const std::string &name, TrackerWrapper *tracker) {
+    tracker->preTracking(getCameraValue(mapOfImages, name), getCameraValue(mapOfPointClouds, name),
+      getCameraValue(mapOfPointCloudWidths, name), getCameraValue(mapOfPointCloudHeights, name));
+  }, m_parallelTracking);
+}
+
+/*!
+  Call \e func for each camera, in parallel when \e parallel is true. The function must not modify the members of
+  vpMbGenericTracker, only those of the given tracker.
+*/
+void vpMbGenericTracker::runOnTrackers(const std::function<void(const std::string &, TrackerWrapper *)> &func,
+  bool parallel)
+{
+  std::vector<std::function<void()> > tasks;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
+    const std::string &name = it->first;
     TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-      mapOfPointCloudHeights[it->first]);
+    tasks.push_back([&func, &name, tracker]() { func(name, tracker); });
   }
+  runTasks(tasks, parallel);
 }
 
 /*!
@@ -4321,6 +4427,24 @@ void vpMbGenericTracker::setFeatureFactors(const std::map<vpTrackerType, double>
   }
 }
 
+/*!
+  Enable or disable the flat storage of the moving-edge features of the lines, see
+  vpMbEdgeTracker::setFlatFeatureStorage(). The estimated pose is the same in both modes.
+
+  \param flat : True to compile the moving-edge sites of the lines in contiguous arrays before the virtual visual
+  servoing, false to use the lists of the lines (default).
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setFlatFeatureStorage(bool flat)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setFlatFeatureStorage(flat);
+  }
+}
+
 /*!
    Set the threshold value between 0 and 1 over good moving edges ratio. It
   allows to decide if the tracker has enough valid moving edges to compute a
@@ -4800,6 +4924,26 @@ void vpMbGenericTracker::setOptimizationMethod(const vpMbtOptimizationMethod &op
   }
 }
 
+/*!
+  Enable or disable the parallel processing of track(). When enabled, the cameras are processed in parallel by the
+  tasks of vpThreadPool::getInstance(), and for each camera the moving-edges tracking, the KLT tracking and the point
+  cloud segmentation of the depth features are done in parallel. The features are then stacked in the order of the
+  cameras and of the feature types, so that the estimated pose does not depend on this option.
+
+  The visibility test of the faces is done sequentially when the Ogre visibility test is enabled.
+
+  \param parallel : If true, process the cameras and the feature types in parallel. By default false.
+*/
+void vpMbGenericTracker::setParallelTracking(bool parallel)
+{
+  m_parallelTracking = parallel;
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    it->second->m_parallelFeatures = parallel;
+  }
+}
+
 /*!
   Set the pose to be used in entry (as guess) of the next call to the track()
   function. This pose will be just used once.
@@ -5499,28 +5643,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5585,28 +5708,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5666,28 +5768,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5756,28 +5837,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5826,28 +5886,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5916,35 +5955,14 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
 
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
-  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError(), m_parallelFeatures(false)
 {
   m_lambda = 1.0;
   m_maxIter = 30;
@@ -5957,7 +5975,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
 }
 
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper(int trackerType)
-  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError(), m_parallelFeatures(false)
 {
   if ((m_trackerType & (EDGE_TRACKER |
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
@@ -6043,7 +6061,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
         if (!isoJoIdentity) {
           vpVelocityTwistMatrix cVo;
           cVo.buildFrom(m_cMo);
-          LVJ_true = (m_L * cVo * oJo);
+          LVJ_true = (m_L * (cVo * oJo));
         }
       }
 
@@ -6887,47 +6905,59 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
 void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
                                                      const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
+  std::vector<std::function<void()> > tasks;
+
   if (m_trackerType & EDGE_TRACKER) {
-    try {
-      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
-    }
-    catch (...) {
-      std::cerr << "Error in moving edge tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+      }
+      catch (...) {
+        std::cerr << "Error in moving edge tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
   if (m_trackerType & KLT_TRACKER) {
-    try {
-      vpMbKltTracker::preTracking(*ptr_I);
-    }
-    catch (const vpException &e) {
-      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbKltTracker::preTracking(*ptr_I);
+      }
+      catch (const vpException &e) {
+        std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+        throw;
+      }
+    });
   }
 #endif
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
-    try {
-      vpMbDepthNormalTracker::segmentPointCloud(point_cloud);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth normal tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthNormalTracker::segmentPointCloud(point_cloud);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth normal tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    try {
-      vpMbDepthDenseTracker::segmentPointCloud(point_cloud);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth dense tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthDenseTracker::segmentPointCloud(point_cloud);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth dense tracking" << std::endl;
+        throw;
+      }
+    });
   }
+
+  runTasks(tasks, m_parallelFeatures);
 }
 #endif
 
@@ -6982,47 +7012,59 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   const unsigned int pointcloud_width,
   const unsigned int pointcloud_height)
 {
+  std::vector<std::function<void()> > tasks;
+
   if (m_trackerType & EDGE_TRACKER) {
-    try {
-      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
-    }
-    catch (...) {
-      std::cerr << "Error in moving edge tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+      }
+      catch (...) {
+        std::cerr << "Error in moving edge tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
   if (m_trackerType & KLT_TRACKER) {
-    try {
-      vpMbKltTracker::preTracking(*ptr_I);
-    }
-    catch (const vpException &e) {
-      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbKltTracker::preTracking(*ptr_I);
+      }
+      catch (const vpException &e) {
+        std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+        throw;
+      }
+    });
   }
 #endif
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
-    try {
-      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    try {
-      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth dense tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth dense tracking" << std::endl;
+        throw;
+      }
+    });
   }
+
+  runTasks(tasks, m_parallelFeatures);
 }
 
 void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
@@ -7030,47 +7072,59 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   const unsigned int pointcloud_width,
   const unsigned int pointcloud_height)
 {
+  std::vector<std::function<void()> > tasks;
+
   if (m_trackerType & EDGE_TRACKER) {
-    try {
-      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
-    }
-    catch (...) {
-      std::cerr << "Error in moving edge tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+      }
+      catch (...) {
+        std::cerr << "Error in moving edge tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
   if (m_trackerType & KLT_TRACKER) {
-    try {
-      vpMbKltTracker::preTracking(*ptr_I);
-    }
-    catch (const vpException &e) {
-      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbKltTracker::preTracking(*ptr_I);
+      }
+      catch (const vpException &e) {
+        std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+        throw;
+      }
+    });
   }
 #endif
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
-    try {
-      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth tracking" << std::endl;
+        throw;
+      }
+    });
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    try {
-      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
-    }
-    catch (...) {
-      std::cerr << "Error in Depth dense tracking" << std::endl;
-      throw;
-    }
+    tasks.push_back([&]() {
+      try {
+        vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      }
+      catch (...) {
+        std::cerr << "Error in Depth dense tracking" << std::endl;
+        throw;
+      }
+    });
   }
+
+  runTasks(tasks, m_parallelFeatures);
 }
 
 void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char> *const I,
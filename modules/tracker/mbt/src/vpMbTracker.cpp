@@ -3203,15 +3203,7 @@ void vpMbTracker::computeJTR(const vpMatrix &interaction, const vpColVector &err
 #if defined(VISP_HAVE_SIMDLIB)
   SimdComputeJtR(interaction.data, interaction.getRows(), error.data, JTR.data);
 #else
-  const unsigned int N = interaction.getRows();
-
-  for (unsigned int i = 0; i < 6; i += 1) {
-    double ssum = 0;
-    for (unsigned int j = 0; j < N; j += 1) {
-      ssum += interaction[j][i] * error[j];
-    }
-    JTR[i] = ssum;
-  }
+  interaction.AtB(error, JTR);
 #endif
 }
 
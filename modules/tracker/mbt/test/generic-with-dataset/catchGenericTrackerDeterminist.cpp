@@ -281,6 +281,61 @@ TEST_CASE("Check Stereo MBT determinism parallel", "[MBT_determinism]")
   checkPoses(cMo1, cMo2);
 }
 
+TEST_CASE("Check Stereo MBT parallel tracking", "[MBT_determinism]")
+{
+  // Reference tracker, cameras processed one after the other
+  vpMbGenericTracker tracker1(2);
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+
+  // Same tracker with the cameras and feature families processed concurrently
+  vpMbGenericTracker tracker2(2);
+  configureTracker(tracker2, cam);
+  tracker2.setParallelTracking(true);
+  CHECK(tracker2.getParallelTracking());
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1, cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I, I);
+    tracker1.getPose(cMo1);
+    tracker2.track(I, I);
+    tracker2.getPose(cMo2);
+  }
+  std::cout << "Sequential stereo tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Parallel stereo tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Stacking order does not depend on the scheduling, poses must be identical
+  checkPoses(cMo1, cMo2);
+}
+
+TEST_CASE("Check MBT flat feature storage", "[MBT_determinism]")
+{
+  // Reference tracker, line features iterated through the lists
+  vpMbGenericTracker tracker1;
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+
+  // Same tracker with the line features stored in contiguous arrays
+  vpMbGenericTracker tracker2;
+  configureTracker(tracker2, cam);
+  tracker2.setFlatFeatureStorage(true);
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1, cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I);
+    tracker1.getPose(cMo1);
+    tracker2.track(I);
+    tracker2.getPose(cMo2);
+  }
+  std::cout << "List storage tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Flat storage tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Same features stacked in the same order, poses must be identical
+  checkPoses(cMo1, cMo2);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
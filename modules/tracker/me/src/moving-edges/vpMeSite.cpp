@@ -36,10 +36,11 @@
   \brief Moving edges
 */
 
+#include <algorithm> // std::stable_sort
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
 #include <stdlib.h>
-#include <map>
+#include <vector>
 
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
@@ -49,22 +50,103 @@ BEGIN_VISP_NAMESPACE
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-struct vpMeSiteHypothesis
-{
-  vpMeSiteHypothesis(vpMeSite *site, double l, double c) : site(site), likelihood(l), contrast(c)
-  { }
-
-  vpMeSite *site;
-  double likelihood;
-  double contrast;
-};
-
 static bool outsideImage(int i, int j, int half, int rows, int cols)
 {
   int half_1 = half + 1;
   int half_3 = half + 3;
   return ((0 < (half_1 - i)) || (((i - rows) + half_3) > 0) || (0 < (half_1 - j)) || (((j - cols) + half_3) > 0));
 }
+
+namespace
+{
+/*!
+ * Query pixels sought along the normal of a site, stored as a structure of arrays. The convolutions of all the
+ * queries are computed at once: the loop over the queries is the inner one, so that it is vectorized by the compiler
+ * while each query keeps the same summation order as vpMeSite::convolution().
+ */
+struct vpMeQueryBatch
+{
+  std::vector<double> ifloat;      //!< Subpixel coordinates along i of the queries
+  std::vector<double> jfloat;      //!< Subpixel coordinates along j of the queries
+  std::vector<double> convolution; //!< Convolution of the queries, 0 for the queries outside the image
+  std::vector<bool> outside;       //!< True for the queries too close to the image border
+  std::vector<unsigned int> index;  //!< Index of the queries inside the image
+  std::vector<unsigned int> offset; //!< Bitmap offset of the top left pixel of the mask of the queries inside the image
+  std::vector<double> sum;         //!< Convolution accumulators of the queries inside the image
+
+  void compute(const vpImage<unsigned char> &I, const vpMe &me, double ifloat0, double jfloat0, double alpha,
+               int sign, unsigned int mask_index)
+  {
+    const int range = static_cast<int>(me.getRange());
+    const unsigned int numQueries = static_cast<unsigned int>((2 * range) + 1);
+    const int height = static_cast<int>(I.getHeight());
+    const int width = static_cast<int>(I.getWidth());
+    const unsigned int msize = me.getMaskSize();
+    const int half = static_cast<int>((msize - 1) >> 1);
+    const double salpha = sin(alpha);
+    const double calpha = cos(alpha);
+
+    ifloat.resize(numQueries);
+    jfloat.resize(numQueries);
+    convolution.assign(numQueries, 0.0);
+    outside.assign(numQueries, false);
+    index.clear();
+    offset.clear();
+
+    unsigned int n = 0;
+    for (int k = -range; k <= range; ++k, ++n) {
+      const double ii = ifloat0 + (k * salpha);
+      const double jj = jfloat0 + (k * calpha);
+      ifloat[n] = ii;
+      jfloat[n] = jj;
+      const int i = static_cast<int>(ii);
+      const int j = static_cast<int>(jj);
+      if (outsideImage(i, j, half + me.getStrip(), height, width)) {
+        outside[n] = true;
+      }
+      else {
+        index.push_back(n);
+        offset.push_back((static_cast<unsigned int>(i - half) * static_cast<unsigned int>(width)) +
+                         static_cast<unsigned int>(j - half));
+      }
+    }
+
+    const size_t nbInside = index.size();
+    sum.assign(nbInside, 0.0);
+    const double *mask = me.getMask()[mask_index].data;
+    const unsigned char *bitmap = I.bitmap;
+    const unsigned int *offset_ptr = offset.data();
+    double *sum_ptr = sum.data();
+    for (unsigned int a = 0; a < msize; ++a) {
+      for (unsigned int b = 0; b < msize; ++b) {
+        const double coef = sign * mask[(a * msize) + b];
+        const unsigned char *bitmap_ab = bitmap + ((a * static_cast<unsigned int>(width)) + b);
+        for (size_t q = 0; q < nbInside; ++q) {
+          sum_ptr[q] += coef * bitmap_ab[offset_ptr[q]];
+        }
+      }
+    }
+    for (size_t q = 0; q < nbInside; ++q) {
+      convolution[index[q]] = sum[q];
+    }
+  }
+
+  //! Integer coordinate along i of the query \e n, set to 0 as vpMeSite::convolution() does when it is outside
+  int get_i(unsigned int n) const { return outside[n] ? 0 : static_cast<int>(ifloat[n]); }
+
+  //! Integer coordinate along j of the query \e n, set to 0 as vpMeSite::convolution() does when it is outside
+  int get_j(unsigned int n) const { return outside[n] ? 0 : static_cast<int>(jfloat[n]); }
+
+  //! Display the queries.
+  void display(const vpImage<unsigned char> &I) const
+  {
+    const size_t numQueries = ifloat.size();
+    for (size_t n = 0; n < numQueries; ++n) {
+      vpDisplay::displayCross(I, vpImagePoint(ifloat[n], jfloat[n]), 1, vpColor::yellow);
+    }
+  }
+};
+} // namespace
 #endif
 
 void vpMeSite::init()
@@ -340,24 +422,31 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
   const unsigned int normalSides = 2;
   const unsigned int numQueries = range * normalSides + 1;
   unsigned int mask_index = computeMaskIndex(m_alpha, *me);
-  vpMeSite *list_query_pixels = getQueryList(I, static_cast<int>(range));
 
   double contrast_max = 1 + me->getMu2();
   double contrast_min = 1 - me->getMu1();
 
   double threshold = computeFinalThreshold(*me);
 
-  if (test_contrast) { // likelihood test
-    double diff = 1e6;
+  if (test_contrast) {
     // Change of mask sign to have a continuity at 0 and 180.
     // Threshold at 120 to be more than the 90 initial value
     if (vpMath::abs(static_cast<int>(mask_index - m_index_prev)) > 120) {
       m_mask_sign = -m_mask_sign;
     }
+  }
+
+  // Convolution results of all the queries along the normal
+  thread_local vpMeQueryBatch queries;
+  queries.compute(I, *me, m_ifloat, m_jfloat, m_alpha, m_mask_sign, mask_index);
+  if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RANGE)) {
+    queries.display(I);
+  }
+
+  if (test_contrast) { // likelihood test
+    double diff = 1e6;
     for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      list_query_pixels[n].m_mask_sign = m_mask_sign;
-      double convolution_ = list_query_pixels[n].convolution(I, *me, mask_index);
+      const double convolution_ = queries.convolution[n];
       // no fabs since m_convlt > 0 and we look for a similar one
       const double likelihood = convolution_ + m_convlt;
 
@@ -374,8 +463,7 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
   }
   else { // test on contrast only
     for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      double convolution_ = list_query_pixels[n].convolution(I, me);
+      const double convolution_ = queries.convolution[n];
       const double likelihood = fabs(2 * convolution_);
       if ((likelihood > max) && (likelihood > threshold)) {
         max_convolution = convolution_;
@@ -391,28 +479,27 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     }
   }
 
-  vpImagePoint ip;
-
   if (max_rank >= 0) {
+    // The site is replaced by the query of max likelihood
+    const unsigned int rank = static_cast<unsigned int>(max_rank);
+    m_ifloat = queries.ifloat[rank];
+    m_jfloat = queries.jfloat[rank];
+    m_i = queries.get_i(rank);
+    m_j = queries.get_j(rank);
+    m_index_prev = mask_index;
+    m_convlt = max_convolution;
+    m_normGradient = vpMath::sqr(max_convolution);
+    m_weight = 1;
+    m_state = NO_SUPPRESSION;
+
     if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[max_rank].m_i);
-      ip.set_j(list_query_pixels[max_rank].m_j);
-      vpDisplay::displayPoint(I, ip, vpColor::red);
+      vpDisplay::displayPoint(I, vpImagePoint(m_i, m_j), vpColor::red);
     }
-
-    list_query_pixels[max_rank].m_mask_sign = m_mask_sign;
-    list_query_pixels[max_rank].m_index_prev = mask_index;
-    list_query_pixels[max_rank].m_convlt = max_convolution;
-    list_query_pixels[max_rank].m_normGradient = vpMath::sqr(max_convolution);
-
-    *this = list_query_pixels[max_rank]; // The vpMeSite2 is replaced by the vpMeSite2 of max likelihood
   }
   else // none of the query sites is better than the threshold
   {
     if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[0].m_i);
-      ip.set_j(list_query_pixels[0].m_j);
-      vpDisplay::displayPoint(I, ip, vpColor::green);
+      vpDisplay::displayPoint(I, vpImagePoint(queries.get_i(0), queries.get_j(0)), vpColor::green);
     }
     m_normGradient = 0;
     if (std::fabs(contrast) > std::numeric_limits<double>::epsilon()) {
@@ -421,9 +508,7 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     else {
       m_state = THRESHOLD; // threshold suppression
     }
-
   }
-  delete[] list_query_pixels;
 }
 
 void vpMeSite::trackMultipleHypotheses(const vpImage<unsigned char> &I, const vpMe &me, const bool &test_contrast,
@@ -440,85 +525,84 @@ void vpMeSite::trackMultipleHypotheses(const vpImage<unsigned char> &I, const vp
     throw vpException(vpException::badValue, "Error in vpMeSite::track(): the number of retained hypotheses cannot be greater to the number of queried sites.");
   }
 
-  vpMeSite *list_query_pixels = getQueryList(I, static_cast<int>(range));
-
-  // Insert into a map, where the key is the sorting criterion (negative likelihood or contrast diff)
-  // and the key is the ME site + its computed likelihood and contrast.
-  // After computation: iterating on the map is guaranteed to be done with the keys being sorted according to the criterion.
-  // Multimap allows to have multiple values (sites) with the same key (likelihood/contrast diff)
-  // Only the candidates that are above the threshold are kept
-  std::multimap<double, vpMeSiteHypothesis> candidates;
-
   const double contrast_max = 1 + me.getMu2();
   const double contrast_min = 1 - me.getMu1();
 
   const double threshold = computeFinalThreshold(me);
 
-  // First step: compute likelihoods and contrasts for all queries
   if (test_contrast) {
     // Change of mask sign to have a continuity at 0 and 180.
     // Threshold at 120 to be more than the 90 initial value
     if (vpMath::abs(static_cast<int>(mask_index - m_index_prev)) > 120) {
       m_mask_sign = -m_mask_sign;
     }
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      list_query_pixels[n].m_mask_sign = m_mask_sign;
-      vpMeSite &query = list_query_pixels[n];
-      // Convolution results
-      const double convolution_ = query.convolution(I, me, mask_index);
-      // no fabs since m_convlt > 0 and we look for a similar one
-      const double likelihood = convolution_ + m_convlt;
+  }
 
-      query.m_convlt = convolution_;
-      const double contrast = convolution_ / m_convlt;
-      candidates.insert(std::pair<double, vpMeSiteHypothesis>(fabs(1.0 - contrast), vpMeSiteHypothesis(&query, likelihood, contrast)));
-    }
+  // First step: compute likelihoods and contrasts for all queries
+  thread_local vpMeQueryBatch queries;
+  queries.compute(I, me, m_ifloat, m_jfloat, m_alpha, m_mask_sign, mask_index);
+  if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RANGE)) {
+    queries.display(I);
   }
-  else { // test on likelihood only
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // convolution results
-      vpMeSite &query = list_query_pixels[n];
-      const double convolution_ = query.convolution(I, &me);
-      const double likelihood = fabs(2 * convolution_);
-      query.m_convlt = convolution_;
-      candidates.insert(std::pair<double, vpMeSiteHypothesis>(-likelihood, vpMeSiteHypothesis(&query, likelihood, 0.0)));
+
+  // Sorting criterion (contrast difference or negative likelihood) of each query. The stable sort keeps the queries
+  // with the same criterion in the order of the normal
+  std::vector<double> likelihoods(numQueries), contrasts(numQueries, 0.0), criteria(numQueries);
+  for (unsigned int n = 0; n < numQueries; ++n) {
+    const double convolution_ = queries.convolution[n];
+    if (test_contrast) {
+      // no fabs since m_convlt > 0 and we look for a similar one
+      likelihoods[n] = convolution_ + m_convlt;
+      contrasts[n] = convolution_ / m_convlt;
+      criteria[n] = fabs(1.0 - contrasts[n]);
+    }
+    else { // test on likelihood only
+      likelihoods[n] = fabs(2 * convolution_);
+      criteria[n] = -likelihoods[n];
     }
   }
-  // Take first numCandidates hypotheses: map is sorted according to the likelihood/contrast difference so we can just
-  // iterate from the start
-  outputHypotheses.resize(numCandidates);
+  std::vector<unsigned int> order(numQueries);
+  for (unsigned int n = 0; n < numQueries; ++n) {
+    order[n] = n;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&criteria](unsigned int a, unsigned int b) { return criteria[a] < criteria[b]; });
 
-  std::multimap<double, vpMeSiteHypothesis>::iterator it = candidates.begin();
-  if (test_contrast) {
-    for (unsigned int i = 0; i < numCandidates; ++i, ++it) {
-      outputHypotheses[i] = *(it->second.site);
-      outputHypotheses[i].m_normGradient = vpMath::sqr(outputHypotheses[i].m_convlt);
-      const double likelihood = it->second.likelihood;
-      const double contrast = it->second.contrast;
+  // Take first numCandidates hypotheses
+  outputHypotheses.resize(numCandidates);
+  for (unsigned int i = 0; i < numCandidates; ++i) {
+    const unsigned int n = order[i];
+    vpMeSite &hypothesis = outputHypotheses[i];
+    hypothesis = vpMeSite();
+    hypothesis.init(queries.ifloat[n], queries.jfloat[n], m_alpha, queries.convolution[n], m_mask_sign,
+                    m_contrastThreshold);
+    hypothesis.m_i = queries.get_i(n);
+    hypothesis.m_j = queries.get_j(n);
+    hypothesis.setDisplay(m_selectDisplay);
+
+    const double likelihood = likelihoods[n];
+    if (test_contrast) {
+      hypothesis.m_normGradient = vpMath::sqr(hypothesis.m_convlt);
+      const double contrast = contrasts[n];
 
       if (likelihood > threshold) {
         if (contrast <= contrast_min || contrast >= contrast_max) {
-          outputHypotheses[i].m_state = CONTRAST;
+          hypothesis.m_state = CONTRAST;
         }
         else {
-          outputHypotheses[i].m_state = NO_SUPPRESSION;
+          hypothesis.m_state = NO_SUPPRESSION;
         }
       }
       else {
-        outputHypotheses[i].m_state = THRESHOLD;
+        hypothesis.m_state = THRESHOLD;
       }
     }
-  }
-  else {
-    for (unsigned int i = 0; i < numCandidates; ++i, ++it) {
-      outputHypotheses[i] = *(it->second.site);
-      const double likelihood = it->second.likelihood;
+    else {
       if (likelihood > threshold) {
-        outputHypotheses[i].m_state = NO_SUPPRESSION;
+        hypothesis.m_state = NO_SUPPRESSION;
       }
       else {
-        outputHypotheses[i].m_state = THRESHOLD;
+        hypothesis.m_state = THRESHOLD;
       }
     }
   }
@@ -538,8 +622,6 @@ void vpMeSite::trackMultipleHypotheses(const vpImage<unsigned char> &I, const vp
     }
     m_normGradient = 0;
   }
-
-  delete[] list_query_pixels;
 }
 
 int vpMeSite::operator!=(const vpMeSite &m) { return ((m.m_i != m_i) || (m.m_j != m_j)); }
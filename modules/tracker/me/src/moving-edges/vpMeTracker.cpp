@@ -192,7 +192,7 @@ void vpMeTracker::initTracking(const vpImage<unsigned char> &I)
   // Loop through list of sites to track
   std::list<vpMeSite>::iterator end = m_meList.end();
   for (std::list<vpMeSite>::iterator it = m_meList.begin(); it != end; ++it) {
-    vpMeSite refp = *it; // current reference pixel
+    vpMeSite &refp = *it; // current reference pixel, tracked in place
 
     // If element hasn't been suppressed
     if (refp.getState() == vpMeSite::NO_SUPPRESSION) {
@@ -203,8 +203,6 @@ void vpMeTracker::initTracking(const vpImage<unsigned char> &I)
         ++m_nGoodElement;
       }
     }
-
-    *it = refp;
   }
 
   m_me->setRange(range_tmp);
@@ -226,7 +224,7 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
   std::list<vpMeSite>::iterator it = m_meList.begin();
   std::list<vpMeSite>::iterator end = m_meList.end();
   while (it != end) {
-    vpMeSite s = *it; // current reference pixel
+    vpMeSite &s = *it; // current reference pixel, tracked in place
 
     // If element hasn't been suppressed
     if (s.getState() == vpMeSite::NO_SUPPRESSION) {
@@ -244,7 +242,6 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
       }
     }
 
-    *it = s;
     ++it;
   }
 }
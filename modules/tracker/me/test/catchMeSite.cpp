@@ -0,0 +1,274 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test moving-edges site tracking.
+ */
+
+/*!
+  \file catchMeSite.cpp
+
+  Test that the moving-edges search along the normal of a site, that computes the convolutions of all the queries
+  at once, gives the same result than a scan of the queries with vpMeSite::convolution().
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <random>
+#include <visp3/core/vpMath.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+
+#include <catch_amalgamated.hpp>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Smooth diagonal edge with noise, shifted by \e shift pixels
+void createImage(vpImage<unsigned char> &I, double shift, std::mt19937 &gen)
+{
+  std::uniform_int_distribution<int> noise(-8, 8);
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      double d = ((0.8 * j) + (0.6 * i)) - (150. + shift);
+      double v = 60. + (140. / (1. + std::exp(-d / 1.5))) + noise(gen);
+      I[i][j] = static_cast<unsigned char>(vpMath::saturate<unsigned char>(v));
+    }
+  }
+}
+
+/*
+ * Scan of the queries of a site with vpMeSite::convolution(), as vpMeSite::track() used to do one query after
+ * the other. The state of the site is kept here since the sign and the convolution of a site are not accessible.
+ */
+struct vpMeSiteReference
+{
+  double ifloat, jfloat, alpha, convlt, threshold;
+  int i, j, sign;
+  unsigned int index_prev;
+  vpMeSite::vpMeSiteState state;
+
+  vpMeSiteReference(double ip, double jp, double alphap, double contrastThreshold)
+    : ifloat(ip), jfloat(jp), alpha(alphap), convlt(0.), threshold(contrastThreshold), i(static_cast<int>(ip)),
+    j(static_cast<int>(jp)), sign(1), index_prev(90), state(vpMeSite::NO_SUPPRESSION)
+  { }
+
+  vpMeSite query(int k) const
+  {
+    vpMeSite q;
+    q.init(ifloat + (k * sin(alpha)), jfloat + (k * cos(alpha)), alpha, convlt, sign, threshold);
+    return q;
+  }
+
+  void track(const vpImage<unsigned char> &I, const vpMe &me, bool test_contrast)
+  {
+    const int range = static_cast<int>(me.getRange());
+    vpMeSite site;
+    site.init(ifloat, jfloat, alpha, convlt, sign, threshold);
+    const unsigned int mask_index = site.computeMaskIndex(alpha, me);
+    const double finalThreshold = site.computeFinalThreshold(me);
+    if (test_contrast && (vpMath::abs(static_cast<int>(mask_index - index_prev)) > 120)) {
+      sign = -sign;
+    }
+    int max_k = range + 1;
+    double max_convolution = 0, max = 0, contrast = 0, diff = 1e6;
+    vpMeSite best;
+    for (int k = -range; k <= range; ++k) {
+      vpMeSite q = query(k);
+      const double c = q.convolution(I, me, mask_index);
+      if (test_contrast) {
+        const double likelihood = c + convlt;
+        if (likelihood > finalThreshold) {
+          contrast = c / convlt;
+          if ((contrast > (1 - me.getMu1())) && (contrast < (1 + me.getMu2())) && (fabs(1 - contrast) < diff)) {
+            diff = fabs(1 - contrast);
+            max_convolution = c;
+            max_k = k;
+            best = q;
+          }
+        }
+      }
+      else {
+        const double likelihood = fabs(2 * c);
+        if ((likelihood > max) && (likelihood > finalThreshold)) {
+          max_convolution = c;
+          max = likelihood;
+          max_k = k;
+          best = q;
+        }
+      }
+    }
+    if (!test_contrast && (max_convolution < 0)) {
+      max_convolution = -max_convolution;
+      sign = -sign;
+    }
+    if (max_k <= range) {
+      ifloat = best.get_ifloat();
+      jfloat = best.get_jfloat();
+      i = best.get_i();
+      j = best.get_j();
+      convlt = max_convolution;
+      index_prev = mask_index;
+      state = vpMeSite::NO_SUPPRESSION;
+    }
+    else {
+      state = (std::fabs(contrast) > std::numeric_limits<double>::epsilon()) ? vpMeSite::CONTRAST : vpMeSite::THRESHOLD;
+    }
+  }
+};
+
+void checkSite(const vpMeSite &site, const vpMeSiteReference &ref)
+{
+  CHECK(site.get_i() == ref.i);
+  CHECK(site.get_j() == ref.j);
+  CHECK(site.get_ifloat() == ref.ifloat);
+  CHECK(site.get_jfloat() == ref.jfloat);
+  CHECK(site.getState() == ref.state);
+  if (ref.state == vpMeSite::NO_SUPPRESSION) {
+    CHECK(site.getIndex() == ref.index_prev);
+  }
+}
+} // namespace
+
+TEST_CASE("Moving-edges site tracking", "[me]")
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist_i(0., 239.), dist_j(0., 319.), dist_alpha(-M_PI, M_PI);
+  vpImage<unsigned char> I(240, 320);
+
+  vpMe me;
+  me.setRange(10);
+  me.setLikelihoodThresholdType(vpMe::NORMALIZED_THRESHOLD);
+  me.setThreshold(10);
+
+  for (unsigned int maskSize : { 5, 7 }) {
+    me.setMaskSize(maskSize);
+    createImage(I, 0., gen);
+
+    // Sites near the edge with their normal roughly along the edge gradient, and random sites, some of them
+    // close to the image border
+    std::vector<vpMeSite> sites;
+    std::vector<vpMeSiteReference> refs;
+    for (unsigned int n = 0; n < 200; ++n) {
+      double ip, jp, alpha;
+      if (n < 100) {
+        ip = 20. + n * 2.;
+        jp = (150. - (0.6 * ip)) / 0.8 + dist_alpha(gen);
+        alpha = std::atan2(0.6, 0.8) + (0.1 * dist_alpha(gen));
+      }
+      else {
+        ip = dist_i(gen);
+        jp = dist_j(gen);
+        alpha = dist_alpha(gen);
+      }
+      vpMeSite site;
+      site.init(ip, jp, alpha, 0., 1, me.getThreshold());
+      sites.push_back(site);
+      refs.push_back(vpMeSiteReference(ip, jp, alpha, me.getThreshold()));
+    }
+
+    SECTION("Initialization then tracking on contrast, mask size " + std::to_string(maskSize))
+    {
+      for (size_t n = 0; n < sites.size(); ++n) {
+        sites[n].track(I, &me, false);
+        refs[n].track(I, me, false);
+        checkSite(sites[n], refs[n]);
+      }
+      for (unsigned int frame = 1; frame < 6; ++frame) {
+        createImage(I, frame * 1.5, gen);
+        for (size_t n = 0; n < sites.size(); ++n) {
+          if (sites[n].getState() == vpMeSite::NO_SUPPRESSION) {
+            sites[n].track(I, &me, true);
+            refs[n].track(I, me, true);
+            checkSite(sites[n], refs[n]);
+          }
+        }
+      }
+    }
+
+    SECTION("Multiple hypotheses, mask size " + std::to_string(maskSize))
+    {
+      const unsigned int numCandidates = 5;
+      std::vector<vpMeSite> hypotheses;
+      for (size_t n = 0; n < sites.size(); ++n) {
+        vpMeSite site = sites[n];
+        const vpMeSiteReference &ref = refs[n];
+        site.trackMultipleHypotheses(I, me, false, hypotheses, numCandidates);
+        REQUIRE(hypotheses.size() == numCandidates);
+
+        // Queries sorted by decreasing likelihood, keeping the order along the normal for equal likelihoods
+        const int range = static_cast<int>(me.getRange());
+        std::vector<vpMeSite> queries;
+        std::vector<double> likelihoods;
+        for (int k = -range; k <= range; ++k) {
+          vpMeSite q = ref.query(k);
+          likelihoods.push_back(fabs(2 * q.convolution(I, &me)));
+          queries.push_back(q);
+        }
+        std::vector<size_t> order(queries.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+          order[k] = k;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&likelihoods](size_t a, size_t b) { return likelihoods[a] > likelihoods[b]; });
+
+        for (unsigned int k = 0; k < numCandidates; ++k) {
+          const vpMeSite &q = queries[order[k]];
+          CHECK(hypotheses[k].get_i() == q.get_i());
+          CHECK(hypotheses[k].get_j() == q.get_j());
+          CHECK(hypotheses[k].get_ifloat() == q.get_ifloat());
+          CHECK(hypotheses[k].get_jfloat() == q.get_jfloat());
+          const bool aboveThreshold = likelihoods[order[k]] > q.computeFinalThreshold(me);
+          CHECK((hypotheses[k].getState() == vpMeSite::NO_SUPPRESSION) == aboveThreshold);
+        }
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
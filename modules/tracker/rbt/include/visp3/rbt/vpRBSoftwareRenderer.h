@@ -0,0 +1,141 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+/*!
+  \file vpRBSoftwareRenderer.h
+  \brief CPU rasterizer of the renders used by the render-based tracker
+*/
+#ifndef VP_RB_SOFTWARE_RENDERER_H
+#define VP_RB_SOFTWARE_RENDERER_H
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpRect.h>
+#include <visp3/core/vpTranslationVector.h>
+
+#include <visp3/rbt/vpRBFeatureTrackerInput.h>
+
+BEGIN_VISP_NAMESPACE
+
+/*!
+  \brief Multithreaded CPU rasterizer that produces the same renders as the Panda3D renderers of the render-based
+  tracker.
+
+  \ingroup group_rbt_rendering
+
+  It is an alternative to the vpObjectCentricRenderer of vpRBTracker when no GPU is available. For a given object
+  pose, render() fills the depth, the object frame normals, and, if required, the silhouette gradients and the
+  silhouette mask of a vpRBRenderData, as vpPanda3DGeometryRenderer and vpPanda3DDepthCannyFilter do.
+
+  Only the region of interest around the projection of the bounding box of the object is rasterized. This region is
+  split in tiles of getTileSize() x getTileSize() pixels, that are rasterized in parallel by the threads of
+  vpThreadPool::getInstance(), each triangle being only processed by the tiles that its bounding box overlaps. As
+  with Panda3D, the triangles seen from the back are culled and the depth of a pixel is the Z coordinate of the
+  closest surface in the camera frame, or 0 if the pixel does not see the object. The depth and the normals are
+  interpolated with perspective correction at the pixel coordinates (i, j).
+
+  The object is loaded from a Wavefront .obj file with loadObject(). The faces are triangulated and, when a face does
+  not come with vertex normals, its geometric normal is used.
+*/
+class VISP_EXPORT vpRBSoftwareRenderer
+{
+public:
+  vpRBSoftwareRenderer();
+
+  void loadObject(const std::string &file);
+  void setMesh(const std::vector<vpColVector> &vertices, const std::vector<std::vector<unsigned int> > &faces);
+
+  //! Number of triangles of the loaded object.
+  unsigned int getNbTriangles() const { return static_cast<unsigned int>(m_triangleVertices.size() / 3); }
+
+  void setCameraParameters(const vpCameraParameters &cam, unsigned int h, unsigned int w);
+  vpCameraParameters getCameraParameters() const { return m_cam; }
+  unsigned int getImageHeight() const { return m_imageHeight; }
+  unsigned int getImageWidth() const { return m_imageWidth; }
+
+  void setClippingDistance(double nearV, double farV);
+  double getNearClippingDistance() const { return m_clipNear; }
+  double getFarClippingDistance() const { return m_clipFar; }
+
+  /*!
+    Set the threshold on the absolute value of the laplacian of the depth above which a pixel is considered as
+    part of the silhouette of the object. It is the edgeThreshold of vpPanda3DDepthCannyFilter.
+  */
+  void setEdgeThreshold(float edgeThreshold) { m_edgeThreshold = edgeThreshold; }
+  float getEdgeThreshold() const { return m_edgeThreshold; }
+
+  void setTileSize(unsigned int tileSize);
+  unsigned int getTileSize() const { return m_tileSize; }
+
+  void get3DExtents(vpTranslationVector &minValues, vpTranslationVector &maxValues) const;
+  vpRect computeBoundingBox(const vpHomogeneousMatrix &cMo) const;
+  void computeClipping(const vpHomogeneousMatrix &cMo, float &nearV, float &farV) const;
+
+  void render(const vpHomogeneousMatrix &cMo, vpRBRenderData &renders, bool renderSilhouette);
+
+private:
+  void setTriangles(const std::vector<double> &vertices, const std::vector<double> &normals,
+                    const std::vector<unsigned int> &triangleVertices, const std::vector<unsigned int> &triangleNormals);
+  void computeSilhouette(vpRBRenderData &renders, unsigned int top, unsigned int left, unsigned int bottom,
+                         unsigned int right) const;
+
+  std::vector<double> m_vertices; //!< Vertices of the object, in the object frame (x, y, z)
+  std::vector<double> m_normals; //!< Normals of the object, in the object frame (x, y, z)
+  std::vector<unsigned int> m_triangleVertices; //!< Vertex indices of the three corners of each triangle
+  std::vector<unsigned int> m_triangleNormals; //!< Normal indices of the three corners of each triangle
+  double m_minExtents[3], m_maxExtents[3]; //!< 3D bounding box of the object
+
+  vpCameraParameters m_cam;
+  unsigned int m_imageHeight, m_imageWidth;
+  double m_clipNear, m_clipFar;
+  float m_edgeThreshold;
+  unsigned int m_tileSize;
+
+  //! Triangle in the image, after clipping by the near plane
+  struct vpRasterTriangle
+  {
+    double u[3], v[3]; //!< Pixel coordinates of the corners
+    double invZ[3]; //!< Inverse of the depth of the corners
+    double n[3][3]; //!< Normals of the corners, divided by their depth
+    int minI, maxI, minJ, maxJ; //!< Pixels covered by the bounding box of the triangle
+  };
+
+  std::vector<double> m_cVertices; //!< Vertices in the camera frame
+  std::vector<std::vector<vpRasterTriangle> > m_rasterTriangles; //!< Triangles to rasterize, per chunk of the mesh
+  std::vector<std::vector<std::pair<unsigned int, unsigned int> > > m_tileTriangles; //!< Triangles overlapping each tile
+};
+
+END_VISP_NAMESPACE
+
+#endif
@@ -43,11 +43,13 @@
 #include <visp3/rbt/vpRBSilhouettePointsExtractionSettings.h>
 #include <visp3/rbt/vpPanda3DDepthFilters.h>
 #include <visp3/rbt/vpObjectCentricRenderer.h>
+#include <visp3/rbt/vpRBSoftwareRenderer.h>
 #include <visp3/rbt/vpRBTrackingResult.h>
 #include <visp3/rbt/vpRBADDSMetric.h>
 #include <visp3/rbt/vpRBInitializationHelper.h>
 #include <visp3/core/vpDisplay.h>
 
+#include <functional>
 #include <ostream>
 #include <type_traits>
 
@@ -230,6 +232,48 @@ public:
     m_scaleInvariantOptim = invariant;
   }
 
+  /**
+   * \see setParallelTrackers
+  */
+  bool getParallelTrackers() const { return m_parallelTrackers; }
+  /**
+   * \brief Sets whether the feature trackers run concurrently.
+   *
+   * When enabled, each stage of the tracking (tracking initialization, feature extraction, feature tracking,
+   * optimization initialization and each optimization iteration) runs the feature trackers in parallel on the
+   * threads of vpThreadPool::getInstance(). All the trackers have finished a stage before the next one starts,
+   * and the LTL and LTR contributions are summed in the order of the trackers, so the result is the same as in the
+   * sequential mode. The time spent by each tracker in each stage is still reported by vpRBTrackingTimings.
+   *
+   * The feature trackers must not share mutable data between them, which is the case of the trackers of ViSP.
+   *
+   * \param parallel true to run the feature trackers concurrently, false to run them one after the other (default).
+  */
+  inline void setParallelTrackers(bool parallel)
+  {
+    m_parallelTrackers = parallel;
+  }
+
+  /**
+   * \see setSoftwareRendering
+  */
+  bool getSoftwareRendering() const { return m_softwareRendering; }
+  /**
+   * \brief Sets whether the renders are computed on the CPU by a vpRBSoftwareRenderer instead of Panda3D.
+   *
+   * The software renderer produces the depth, normals and silhouette maps used by the feature trackers without a
+   * GPU, which is useful on headless machines. Only triangulated geometry from a Wavefront .obj file is supported.
+   * The color render is not available in this mode.
+   *
+   * This setting is taken into account by startTracking().
+   *
+   * \param software true to use the CPU renderer, false to use Panda3D (default).
+  */
+  inline void setSoftwareRendering(bool software)
+  {
+    m_softwareRendering = software;
+  }
+
   /**
    * \see setDriftDetector
    *
@@ -450,6 +494,23 @@ protected:
    * \param cMo the pose of the object at which to perform rendering
   */
   void updateRender(vpRBFeatureTrackerInput &frame, const vpHomogeneousMatrix &cMo);
+  /**
+   * \brief Update the frame data with renders of the CPU renderer at a given pose
+   *
+   * \param frame the frame to update
+   * \param cMo the pose of the object at which to perform rendering
+  */
+  void updateSoftwareRender(vpRBFeatureTrackerInput &frame, const vpHomogeneousMatrix &cMo);
+
+  /**
+   * \brief Run a tracking stage on all the feature trackers, concurrently if setParallelTrackers() is enabled.
+   *
+   * \param stage Name of the stage, used in the message printed when a tracker raises an exception
+   * \param func Function to call on each tracker
+   * \param elapsed Time spent by each tracker in the stage, in ms
+  */
+  void runTrackersStage(const std::string &stage, const std::function<void(vpRBFeatureTracker &)> &func,
+                        std::vector<double> &elapsed);
 
   /**
    * \brief Display the object silhouette of the frame in I
@@ -464,7 +525,7 @@ protected:
   {
     if (shouldRenderSilhouette()) {
       const vpImage<unsigned char> &Isilhouette = frame.renders.isSilhouette;
-      const vpRect bb = m_renderer.getBoundingBox();
+      const vpRect &bb = frame.renders.boundingBox;
       for (unsigned int r = std::max(bb.getTop(), 0.); (r < bb.getBottom()) &&(r < I.getRows()); ++r) {
         for (unsigned int c = std::max(bb.getLeft(), 0.); (c < bb.getRight()) && (c < I.getCols()); ++c) {
           if (Isilhouette[r][c] != 0) {
@@ -516,6 +577,14 @@ protected:
   */
   bool shouldRenderSilhouette()
   {
+    if (m_softwareRendering) {
+      for (const std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
+        if (tracker->requiresSilhouetteCandidates()) {
+          return true;
+        }
+      }
+      return false;
+    }
     return m_renderer.getRenderer<vpPanda3DDepthCannyFilter>() != nullptr;
   }
   //! Whether this is the first iteration
@@ -546,6 +615,8 @@ protected:
   double m_muIterFactor;
   //! Whether to use diagonal scaling in Levenberg-Marquardt regularization
   bool m_scaleInvariantOptim;
+  //! Whether the feature trackers run concurrently in each tracking stage
+  bool m_parallelTrackers;
 
   //! Settings for silhouette extraction
   vpSilhouettePointsExtractionSettings m_depthSilhouetteSettings;
@@ -553,6 +624,10 @@ protected:
   vpPanda3DRenderParameters m_rendererSettings;
   //! 3D renderer
   vpObjectCentricRenderer m_renderer;
+  //! Whether the renders are computed on the CPU
+  bool m_softwareRendering;
+  //! CPU renderer, used instead of m_renderer when m_softwareRendering is true
+  vpRBSoftwareRenderer m_softwareRenderer;
 
   //! Color and render image dimensions
   unsigned m_imageHeight, m_imageWidth;
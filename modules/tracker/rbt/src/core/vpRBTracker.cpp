@@ -36,6 +36,7 @@
 
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpThreadPool.h>
 
 #include <visp3/ar/vpPanda3DRendererSet.h>
 #include <visp3/ar/vpPanda3DGeometryRenderer.h>
@@ -50,11 +51,12 @@
 BEGIN_VISP_NAMESPACE
 
 vpRBTracker::vpRBTracker() :
-  m_firstIteration(true), m_trackers(0), m_lambda(1.0), m_vvsIterations(10), m_muInit(0.0), m_muIterFactor(0.5), m_scaleInvariantOptim(false),
-  m_renderer(m_rendererSettings), m_imageHeight(480), m_imageWidth(640), m_convergenceMetric(1024, 41), m_convergedMetricThreshold(0.0), m_updateRenderThreshold(0.0), m_displaySilhouette(false)
+  m_firstIteration(true), m_trackers(0), m_lambda(1.0), m_vvsIterations(10), m_muInit(0.0), m_muIterFactor(0.5), m_scaleInvariantOptim(false), m_parallelTrackers(false),
+  m_renderer(m_rendererSettings), m_softwareRendering(false), m_imageHeight(480), m_imageWidth(640), m_convergenceMetric(1024, 41), m_convergedMetricThreshold(0.0), m_updateRenderThreshold(0.0), m_displaySilhouette(false)
 {
   m_rendererSettings.setClippingDistance(0.01, 1.0);
   m_renderer.setRenderParameters(m_rendererSettings);
+  m_softwareRenderer.setCameraParameters(m_cam, m_imageHeight, m_imageWidth);
 
   m_driftDetector = nullptr;
   m_mask = nullptr;
@@ -116,6 +118,7 @@ void vpRBTracker::setCameraParameters(const vpCameraParameters &cam, unsigned h,
   m_rendererSettings.setCameraIntrinsics(m_cam);
   m_rendererSettings.setImageResolution(m_imageHeight, m_imageWidth);
   m_renderer.setRenderParameters(m_rendererSettings);
+  m_softwareRenderer.setCameraParameters(m_cam, m_imageHeight, m_imageWidth);
 }
 
 void vpRBTracker::setSilhouetteExtractionParameters(const vpSilhouettePointsExtractionSettings &settings)
@@ -135,10 +138,15 @@ void vpRBTracker::setModelPath(const std::string &path)
 
 void vpRBTracker::setupRenderer(const std::string &file)
 {
-  m_renderer = vpObjectCentricRenderer(m_rendererSettings);
   if (!vpIoTools::checkFilename(file)) {
     throw vpException(vpException::badValue, "3D model file %s could not be found", file.c_str());
   }
+  if (m_softwareRendering) {
+    m_softwareRenderer.setCameraParameters(m_cam, m_imageHeight, m_imageWidth);
+    m_softwareRenderer.loadObject(file);
+    return;
+  }
+  m_renderer = vpObjectCentricRenderer(m_rendererSettings);
 
   const std::shared_ptr<vpPanda3DGeometryRenderer> geometryRenderer = std::make_shared<vpPanda3DGeometryRenderer>(
     vpPanda3DGeometryRenderer::vpRenderType::OBJECT_NORMALS);
@@ -196,7 +204,14 @@ vpRBTrackingResult vpRBTracker::track(const vpImage<unsigned char> &I, const vpI
 void vpRBTracker::startTracking()
 {
   setupRenderer(m_modelPath);
-  m_convergenceMetric.sampleObject(m_renderer);
+  if (m_softwareRendering) {
+    vpTranslationVector minAxes, maxAxes;
+    m_softwareRenderer.get3DExtents(minAxes, maxAxes);
+    m_convergenceMetric.sampleObject(minAxes, maxAxes);
+  }
+  else {
+    m_convergenceMetric.sampleObject(m_renderer);
+  }
 }
 
 vpRBTrackingResult vpRBTracker::track(const vpImage<unsigned char> &I, const vpImage<vpRGBa> &IRGB, const vpImage<float> &depth)
@@ -293,49 +308,33 @@ vpRBTrackingResult vpRBTracker::track(vpRBFeatureTrackerInput &input)
 
   }
 
-  int id = 0;
-  for (std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
-    timer.startTimer();
-    tracker->onTrackingIterStart(m_cMo);
-    timer.setTrackerIterStartTime(id, timer.endTimer());
-    id += 1;
+  std::vector<double> elapsed;
+  runTrackersStage("onTrackingIterStart", [this](vpRBFeatureTracker &tracker) {
+    tracker.onTrackingIterStart(m_cMo);
+  }, elapsed);
+  for (size_t id = 0; id < elapsed.size(); ++id) {
+    timer.setTrackerIterStartTime(static_cast<int>(id), elapsed[id]);
   }
-  id = 0;
-  for (std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
 
-    timer.startTimer();
-    try {
-      tracker->extractFeatures(input, m_previousFrame, m_cMo);
-    }
-    catch (vpException &e) {
-      std::cerr << "Tracker " << id << " raised an exception in extractFeatures" << std::endl;
-      throw e;
-    }
-    timer.setTrackerFeatureExtractionTime(id, timer.endTimer());
-    id += 1;
-  }
-  id = 0;
-  for (std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
-    timer.startTimer();
-    try {
-      tracker->trackFeatures(input, m_previousFrame, m_cMo);
-    }
-    catch (vpException &e) {
-      std::cerr << "Tracker " << id << " raised an exception in trackFeatures" << std::endl;
-      throw e;
-    }
-    timer.setTrackerFeatureTrackingTime(id, timer.endTimer());
-    id += 1;
+  runTrackersStage("extractFeatures", [this, &input](vpRBFeatureTracker &tracker) {
+    tracker.extractFeatures(input, m_previousFrame, m_cMo);
+  }, elapsed);
+  for (size_t id = 0; id < elapsed.size(); ++id) {
+    timer.setTrackerFeatureExtractionTime(static_cast<int>(id), elapsed[id]);
   }
 
-  id = 0;
-  for (std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
+  runTrackersStage("trackFeatures", [this, &input](vpRBFeatureTracker &tracker) {
+    tracker.trackFeatures(input, m_previousFrame, m_cMo);
+  }, elapsed);
+  for (size_t id = 0; id < elapsed.size(); ++id) {
+    timer.setTrackerFeatureTrackingTime(static_cast<int>(id), elapsed[id]);
+  }
 
-    timer.startTimer();
-    tracker->initVVS(input, m_previousFrame, m_cMo);
-    timer.setInitVVSTime(id, timer.endTimer());
-    //std::cout << "Tracker " << id << " has " << tracker->getNumFeatures() << " features" << std::endl;
-    id += 1;
+  runTrackersStage("initVVS", [this, &input](vpRBFeatureTracker &tracker) {
+    tracker.initVVS(input, m_previousFrame, m_cMo);
+  }, elapsed);
+  for (size_t id = 0; id < elapsed.size(); ++id) {
+    timer.setInitVVSTime(static_cast<int>(id), elapsed[id]);
   }
 
 
@@ -347,18 +346,12 @@ vpRBTrackingResult vpRBTracker::track(vpRBFeatureTrackerInput &input)
   unsigned int iter = 0;
   result.beforeIter(m_cMo);
   for (iter = 0; iter < m_vvsIterations; ++iter) {
-    id = 0;
-    for (std::shared_ptr<vpRBFeatureTracker> &tracker : m_trackers) {
-      timer.startTimer();
-      try {
-        tracker->computeVVSIter(input, m_cMo, iter);
-      }
-      catch (vpException &e) {
-        std::cerr << "Tracker " << id << " raised an exception in computeVVSIter" << std::endl;
-        throw e;
-      }
-      timer.addTrackerVVSTime(id, timer.endTimer());
-      id += 1;
+    runTrackersStage("computeVVSIter", [this, &input, iter](vpRBFeatureTracker &tracker) {
+      tracker.computeVVSIter(input, m_cMo, iter);
+    }, elapsed);
+    // Barrier: all the trackers are done, their contributions are summed in order
+    for (size_t id = 0; id < elapsed.size(); ++id) {
+      timer.addTrackerVVSTime(static_cast<int>(id), elapsed[id]);
     }
 
     vpMatrix LTL(6, 6, 0.0);
@@ -476,6 +469,37 @@ double vpRBTracker::score(const vpHomogeneousMatrix &cMo, const vpImage<unsigned
 }
 
 
+void vpRBTracker::runTrackersStage(const std::string &stage, const std::function<void(vpRBFeatureTracker &)> &func,
+                                   std::vector<double> &elapsed)
+{
+  elapsed.assign(m_trackers.size(), 0.0);
+  auto runTracker = [this, &stage, &func, &elapsed](size_t id) {
+    const double startTime = vpTime::measureTimeMs();
+    try {
+      func(*m_trackers[id]);
+    }
+    catch (vpException &) {
+      std::cerr << "Tracker " << id << " raised an exception in " << stage << std::endl;
+      throw;
+    }
+    elapsed[id] = vpTime::measureTimeMs() - startTime;
+  };
+
+#if defined(VISP_HAVE_THREADS)
+  if (m_parallelTrackers && (m_trackers.size() > 1)) {
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
+    for (size_t id = 0; id < m_trackers.size(); ++id) {
+      group.run([&runTracker, id]() { runTracker(id); });
+    }
+    group.wait();
+    return;
+  }
+#endif
+  for (size_t id = 0; id < m_trackers.size(); ++id) {
+    runTracker(id);
+  }
+}
+
 void vpRBTracker::updateRender(vpRBFeatureTrackerInput &frame)
 {
   updateRender(frame, m_cMo);
@@ -483,10 +507,15 @@ void vpRBTracker::updateRender(vpRBFeatureTrackerInput &frame)
 
 void vpRBTracker::updateRender(vpRBFeatureTrackerInput &frame, const vpHomogeneousMatrix &cMo)
 {
-  m_renderer.setCameraPose(cMo.inverse());
-
   frame.renders.cMo = cMo;
 
+  if (m_softwareRendering) {
+    updateSoftwareRender(frame, cMo);
+    return;
+  }
+
+  m_renderer.setCameraPose(cMo.inverse());
+
   // Update clipping distances
   frame.renders.normals.resize(m_imageHeight, m_imageWidth);
   frame.renders.silhouetteCanny.resize(m_imageHeight, m_imageWidth);
@@ -553,6 +582,28 @@ void vpRBTracker::updateRender(vpRBFeatureTrackerInput &frame, const vpHomogeneo
   }
 }
 
+void vpRBTracker::updateSoftwareRender(vpRBFeatureTrackerInput &frame, const vpHomogeneousMatrix &cMo)
+{
+  float clipNear, clipFar;
+  m_softwareRenderer.computeClipping(cMo, clipNear, clipFar);
+  frame.renders.zNear = std::max(0.001f, clipNear);
+  frame.renders.zFar = std::max(clipFar, frame.renders.zNear);
+  m_softwareRenderer.setClippingDistance(frame.renders.zNear, frame.renders.zFar);
+
+  bool renderSilhouette = shouldRenderSilhouette();
+  if (renderSilhouette) {
+    double thresholdValue = m_depthSilhouetteSettings.getThreshold();
+    if (m_depthSilhouetteSettings.thresholdIsRelative()) {
+      m_softwareRenderer.setEdgeThreshold(static_cast<float>((frame.renders.zFar - frame.renders.zNear) * thresholdValue));
+    }
+    else {
+      m_softwareRenderer.setEdgeThreshold(static_cast<float>(thresholdValue));
+    }
+  }
+
+  m_softwareRenderer.render(cMo, frame.renders, renderSilhouette);
+}
+
 std::vector<vpRBSilhouettePoint>
 vpRBTracker::extractSilhouettePoints(const vpImage<vpRGBf> &Inorm, const vpImage<float> &Idepth,
                                      const vpImage<vpRGBf> &silhouetteCanny, const vpImage<unsigned char> &Ivalid,
@@ -656,6 +707,8 @@ void vpRBTracker::loadConfiguration(const nlohmann::json &j)
   m_firstIteration = true;
 
   m_displaySilhouette = j.value("displaySilhouette", m_displaySilhouette);
+  m_parallelTrackers = j.value("parallelTrackers", m_parallelTrackers);
+  m_softwareRendering = j.value("softwareRendering", m_softwareRendering);
   m_updateRenderThreshold = j.value("updateRenderThreshold", m_updateRenderThreshold);
 
   if (j.contains("camera")) {
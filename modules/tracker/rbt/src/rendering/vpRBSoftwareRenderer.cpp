@@ -0,0 +1,581 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <visp3/rbt/vpRBSoftwareRenderer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpThreadPool.h>
+
+BEGIN_VISP_NAMESPACE
+
+namespace
+{
+// Number of triangles per chunk of the mesh in the parallel triangle setup
+const unsigned int chunkSize = 1024;
+
+// Convert a face corner index of a Wavefront .obj file, 1-based or negative if relative to the end, to a 0-based index
+unsigned int objIndex(int index, size_t count, const std::string &line)
+{
+  const int absIndex = (index < 0) ? (static_cast<int>(count) + index) : (index - 1);
+  if ((index == 0) || (absIndex < 0) || (absIndex >= static_cast<int>(count))) {
+    throw vpException(vpException::badValue, "Invalid index in face \"%s\"", line.c_str());
+  }
+  return static_cast<unsigned int>(absIndex);
+}
+
+// Append the unit normal of the triangle (a, b, c), seen counter-clockwise from the front
+void appendTriangleNormal(const double *a, const double *b, const double *c, std::vector<double> &normals)
+{
+  const double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+  const double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+  const double n[3] = { (e1[1] * e2[2]) - (e1[2] * e2[1]), (e1[2] * e2[0]) - (e1[0] * e2[2]),
+                        (e1[0] * e2[1]) - (e1[1] * e2[0]) };
+  const double norm = sqrt((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+  for (unsigned int k = 0; k < 3; ++k) {
+    normals.push_back((norm > 0.0) ? (n[k] / norm) : 0.0);
+  }
+}
+
+// Triangulate a face as a fan, using the normals of the corners if given or the normals of the triangles otherwise
+void appendFace(const std::vector<unsigned int> &faceVertices, const std::vector<unsigned int> &faceNormals,
+                const std::vector<double> &vertices, std::vector<double> &normals,
+                std::vector<unsigned int> &triangleVertices, std::vector<unsigned int> &triangleNormals)
+{
+  const bool hasNormals = (faceNormals.size() == faceVertices.size());
+  for (size_t k = 1; (k + 1) < faceVertices.size(); ++k) {
+    const size_t corners[3] = { 0, k, k + 1 };
+    if (!hasNormals) {
+      appendTriangleNormal(&vertices[3 * faceVertices[0]], &vertices[3 * faceVertices[k]],
+                           &vertices[3 * faceVertices[k + 1]], normals);
+    }
+    for (unsigned int l = 0; l < 3; ++l) {
+      triangleVertices.push_back(faceVertices[corners[l]]);
+      triangleNormals.push_back(hasNormals ? faceNormals[corners[l]] : static_cast<unsigned int>((normals.size() / 3) - 1));
+    }
+  }
+}
+
+// Corner of a triangle in the camera frame, with its normal in the object frame
+struct vpClipVertex
+{
+  double X[3];
+  double n[3];
+};
+
+vpClipVertex interpolate(const vpClipVertex &a, const vpClipVertex &b, double t)
+{
+  vpClipVertex r;
+  for (unsigned int k = 0; k < 3; ++k) {
+    r.X[k] = a.X[k] + (t * (b.X[k] - a.X[k]));
+    r.n[k] = a.n[k] + (t * (b.n[k] - a.n[k]));
+  }
+  return r;
+}
+}
+
+vpRBSoftwareRenderer::vpRBSoftwareRenderer()
+  : m_imageHeight(480), m_imageWidth(640), m_clipNear(0.001), m_clipFar(10.0), m_edgeThreshold(0.f), m_tileSize(32)
+{
+  for (unsigned int k = 0; k < 3; ++k) {
+    m_minExtents[k] = 0.0;
+    m_maxExtents[k] = 0.0;
+  }
+}
+
+/*!
+  Load the object to render from a Wavefront .obj file. Only the vertices, the vertex normals and the faces are read,
+  the coordinates being expressed in the object frame.
+
+  \param[in] file : Path to the .obj file.
+*/
+void vpRBSoftwareRenderer::loadObject(const std::string &file)
+{
+  std::ifstream f(file.c_str());
+  if (!f.good()) {
+    throw vpException(vpException::ioError, "Cannot open 3D model file %s", file.c_str());
+  }
+
+  std::vector<double> vertices, normals;
+  std::vector<unsigned int> triangleVertices, triangleNormals;
+  std::vector<std::pair<std::vector<unsigned int>, std::vector<unsigned int> > > faces;
+  std::string line;
+  while (std::getline(f, line)) {
+    std::istringstream ss(line);
+    std::string type;
+    ss >> type;
+    if ((type == "v") || (type == "vn")) {
+      double x, y, z;
+      if (!(ss >> x >> y >> z)) {
+        throw vpException(vpException::badValue, "Invalid line \"%s\" in %s", line.c_str(), file.c_str());
+      }
+      std::vector<double> &target = (type == "v") ? vertices : normals;
+      target.push_back(x);
+      target.push_back(y);
+      target.push_back(z);
+    }
+    else if (type == "f") {
+      std::vector<unsigned int> faceVertices, faceNormals;
+      std::string corner;
+      while (ss >> corner) {
+        // Corners are "v", "v/vt", "v//vn" or "v/vt/vn"
+        const size_t firstSlash = corner.find('/');
+        faceVertices.push_back(objIndex(atoi(corner.substr(0, firstSlash).c_str()), vertices.size() / 3, line));
+        const size_t secondSlash = (firstSlash == std::string::npos) ? std::string::npos : corner.find('/', firstSlash + 1);
+        if ((secondSlash != std::string::npos) && ((secondSlash + 1) < corner.size())) {
+          faceNormals.push_back(objIndex(atoi(corner.substr(secondSlash + 1).c_str()), normals.size() / 3, line));
+        }
+      }
+      if (faceVertices.size() < 3) {
+        throw vpException(vpException::badValue, "Face \"%s\" has less than 3 vertices", line.c_str());
+      }
+      faces.push_back(std::make_pair(faceVertices, faceNormals));
+    }
+  }
+
+  // Faces are triangulated once all the normals are read, since the normals computed for the faces are appended
+  // to the normals of the file
+  for (size_t n = 0; n < faces.size(); ++n) {
+    appendFace(faces[n].first, faces[n].second, vertices, normals, triangleVertices, triangleNormals);
+  }
+  if (triangleVertices.empty()) {
+    throw vpException(vpException::badValue, "3D model file %s does not contain any face", file.c_str());
+  }
+  setTriangles(vertices, normals, triangleVertices, triangleNormals);
+}
+
+/*!
+  Set the object to render from its vertices and its faces. The normal of each triangle of a face is its geometric
+  normal.
+
+  \param[in] vertices : 3D coordinates of the vertices, in the object frame.
+  \param[in] faces : Indices of the vertices of each face, in counter-clockwise order when the face is seen from
+  the front.
+*/
+void vpRBSoftwareRenderer::setMesh(const std::vector<vpColVector> &vertices,
+                                   const std::vector<std::vector<unsigned int> > &faces)
+{
+  std::vector<double> v;
+  v.reserve(3 * vertices.size());
+  for (size_t n = 0; n < vertices.size(); ++n) {
+    if (vertices[n].size() != 3) {
+      throw vpException(vpException::dimensionError, "Vertex %u should have 3 coordinates", static_cast<unsigned int>(n));
+    }
+    v.insert(v.end(), vertices[n].data, vertices[n].data + 3);
+  }
+  std::vector<double> normals;
+  std::vector<unsigned int> triangleVertices, triangleNormals;
+  for (size_t n = 0; n < faces.size(); ++n) {
+    if (faces[n].size() < 3) {
+      throw vpException(vpException::dimensionError, "Face %u has less than 3 vertices", static_cast<unsigned int>(n));
+    }
+    for (size_t k = 0; k < faces[n].size(); ++k) {
+      if (faces[n][k] >= vertices.size()) {
+        throw vpException(vpException::badValue, "Vertex index %u of face %u is out of range", faces[n][k],
+                          static_cast<unsigned int>(n));
+      }
+    }
+    appendFace(faces[n], std::vector<unsigned int>(), v, normals, triangleVertices, triangleNormals);
+  }
+  if (triangleVertices.empty()) {
+    throw vpException(vpException::badValue, "Mesh does not contain any face");
+  }
+  setTriangles(v, normals, triangleVertices, triangleNormals);
+}
+
+void vpRBSoftwareRenderer::setTriangles(const std::vector<double> &vertices, const std::vector<double> &normals,
+                                        const std::vector<unsigned int> &triangleVertices,
+                                        const std::vector<unsigned int> &triangleNormals)
+{
+  m_vertices = vertices;
+  m_normals = normals;
+  m_triangleVertices = triangleVertices;
+  m_triangleNormals = triangleNormals;
+  for (unsigned int k = 0; k < 3; ++k) {
+    m_minExtents[k] = std::numeric_limits<double>::max();
+    m_maxExtents[k] = -std::numeric_limits<double>::max();
+  }
+  for (size_t n = 0; n < m_triangleVertices.size(); ++n) {
+    const double *X = &m_vertices[3 * m_triangleVertices[n]];
+    for (unsigned int k = 0; k < 3; ++k) {
+      m_minExtents[k] = std::min(m_minExtents[k], X[k]);
+      m_maxExtents[k] = std::max(m_maxExtents[k], X[k]);
+    }
+  }
+}
+
+/*!
+  Set the intrinsics of the camera, that should not have distortion, and the resolution of the renders.
+*/
+void vpRBSoftwareRenderer::setCameraParameters(const vpCameraParameters &cam, unsigned int h, unsigned int w)
+{
+  if (cam.get_projModel() != vpCameraParameters::perspectiveProjWithoutDistortion) {
+    throw vpException(vpException::badValue, "Camera model cannot have distortion");
+  }
+  if ((h == 0) || (w == 0)) {
+    throw vpException(vpException::badValue, "Image dimensions must be greater than 0");
+  }
+  m_cam = cam;
+  m_imageHeight = h;
+  m_imageWidth = w;
+}
+
+/*!
+  Set the distances, along the optical axis, of the near and far clipping planes. The parts of the object that are
+  closer than the near plane or farther than the far plane are not rendered.
+*/
+void vpRBSoftwareRenderer::setClippingDistance(double nearV, double farV)
+{
+  if ((nearV <= 0.0) || (farV < nearV)) {
+    throw vpException(vpException::badValue, "Clipping distances should satisfy 0 < near <= far, got near = %f and far = %f",
+                      nearV, farV);
+  }
+  m_clipNear = nearV;
+  m_clipFar = farV;
+}
+
+/*!
+  Set the size in pixels of the square tiles that are rasterized in parallel.
+*/
+void vpRBSoftwareRenderer::setTileSize(unsigned int tileSize)
+{
+  if (tileSize == 0) {
+    throw vpException(vpException::badValue, "Tile size should be greater than 0");
+  }
+  m_tileSize = tileSize;
+}
+
+/*!
+  Get the minimum and maximum coordinates of the vertices of the object, in the object frame.
+*/
+void vpRBSoftwareRenderer::get3DExtents(vpTranslationVector &minValues, vpTranslationVector &maxValues) const
+{
+  for (unsigned int k = 0; k < 3; ++k) {
+    minValues[k] = m_minExtents[k];
+    maxValues[k] = m_maxExtents[k];
+  }
+}
+
+/*!
+  Compute the image region, clamped to the image, that contains the projection of the 3D bounding box of the object.
+*/
+vpRect vpRBSoftwareRenderer::computeBoundingBox(const vpHomogeneousMatrix &cMo) const
+{
+  double minu = m_imageWidth, maxu = 0.0, minv = m_imageHeight, maxv = 0.0;
+  for (unsigned int c = 0; c < 8; ++c) {
+    const vpColVector oX({ (c & 1) ? m_maxExtents[0] : m_minExtents[0], (c & 2) ? m_maxExtents[1] : m_minExtents[1],
+                           (c & 4) ? m_maxExtents[2] : m_minExtents[2], 1.0 });
+    const vpColVector cX = cMo * oX;
+    vpImagePoint ip;
+    vpMeterPixelConversion::convertPoint(m_cam, cX[0] / cX[2], cX[1] / cX[2], ip);
+    const double u = vpMath::clamp(ip.get_u(), 0.0, m_imageWidth - 1.0);
+    const double v = vpMath::clamp(ip.get_v(), 0.0, m_imageHeight - 1.0);
+    minu = std::min(minu, u);
+    maxu = std::max(maxu, u);
+    minv = std::min(minv, v);
+    maxv = std::max(maxv, v);
+  }
+  return vpRect(vpImagePoint(minv, minu), vpImagePoint(maxv, maxu));
+}
+
+/*!
+  Compute the minimum and maximum depths of the 3D bounding box of the object, that can be used as clipping
+  distances.
+*/
+void vpRBSoftwareRenderer::computeClipping(const vpHomogeneousMatrix &cMo, float &nearV, float &farV) const
+{
+  float minZ = std::numeric_limits<float>::max(), maxZ = 0.f;
+  for (unsigned int c = 0; c < 8; ++c) {
+    const vpColVector oX({ (c & 1) ? m_maxExtents[0] : m_minExtents[0], (c & 2) ? m_maxExtents[1] : m_minExtents[1],
+                           (c & 4) ? m_maxExtents[2] : m_minExtents[2], 1.0 });
+    const float Z = static_cast<float>((cMo * oX)[2]);
+    minZ = std::min(minZ, Z);
+    maxZ = std::max(maxZ, Z);
+  }
+  nearV = minZ;
+  farV = maxZ;
+}
+
+/*!
+  Render the object at a given pose.
+
+  \param[in] cMo : Pose of the object in the camera frame.
+  \param[out] renders : Renders, at the resolution given to setCameraParameters(). The depth, the normals in the
+  object frame and the bounding box are always updated. If \e renderSilhouette is true, the silhouette gradients and
+  orientation, and the silhouette mask are also updated.
+  \param[in] renderSilhouette : Whether to compute the silhouette of the object.
+*/
+void vpRBSoftwareRenderer::render(const vpHomogeneousMatrix &cMo, vpRBRenderData &renders, bool renderSilhouette)
+{
+  if (m_triangleVertices.empty()) {
+    throw vpException(vpException::notInitialized, "No object to render, call loadObject() first");
+  }
+  vpThreadPool &pool = vpThreadPool::getInstance();
+
+  const vpRect bb = computeBoundingBox(cMo);
+  renders.boundingBox = bb;
+  renders.depth.resize(m_imageHeight, m_imageWidth, 0.f);
+  renders.normals.resize(m_imageHeight, m_imageWidth, vpRGBf(0.f));
+
+  // Rendered region: same size as the sub render of vpObjectCentricRenderer
+  const int top = static_cast<int>(std::max(0.0, bb.getTop()));
+  const int left = static_cast<int>(std::max(0.0, bb.getLeft()));
+  const int bottom = std::min(static_cast<int>(m_imageHeight), top + static_cast<int>(bb.getHeight()));
+  const int right = std::min(static_cast<int>(m_imageWidth), left + static_cast<int>(bb.getWidth()));
+
+  // Vertices in the camera frame
+  const unsigned int nbVertices = static_cast<unsigned int>(m_vertices.size() / 3);
+  m_cVertices.resize(m_vertices.size());
+  pool.parallelFor(0, nbVertices, [this, &cMo](unsigned int begin, unsigned int end) {
+    for (unsigned int n = begin; n < end; ++n) {
+      const double *oX = &m_vertices[3 * n];
+      double *cX = &m_cVertices[3 * n];
+      for (unsigned int k = 0; k < 3; ++k) {
+        cX[k] = (cMo[k][0] * oX[0]) + (cMo[k][1] * oX[1]) + (cMo[k][2] * oX[2]) + cMo[k][3];
+      }
+    }
+  });
+
+  // Triangle setup: back face culling, clipping by the near plane and projection, by chunks of the mesh
+  const unsigned int nbTriangles = getNbTriangles();
+  const unsigned int nbChunks = (nbTriangles + chunkSize - 1) / chunkSize;
+  m_rasterTriangles.resize(nbChunks);
+  pool.parallelFor(0, nbChunks, [&](unsigned int beginChunk, unsigned int endChunk) {
+    for (unsigned int c = beginChunk; c < endChunk; ++c) {
+      std::vector<vpRasterTriangle> &triangles = m_rasterTriangles[c];
+      triangles.clear();
+      const unsigned int endTriangle = std::min(nbTriangles, (c + 1) * chunkSize);
+      for (unsigned int t = c * chunkSize; t < endTriangle; ++t) {
+        vpClipVertex corners[3];
+        for (unsigned int k = 0; k < 3; ++k) {
+          const double *cX = &m_cVertices[3 * m_triangleVertices[(3 * t) + k]];
+          const double *n = &m_normals[3 * m_triangleNormals[(3 * t) + k]];
+          for (unsigned int l = 0; l < 3; ++l) {
+            corners[k].X[l] = cX[l];
+            corners[k].n[l] = n[l];
+          }
+        }
+        // The triangle faces the camera if its normal points towards the optical center
+        const double *a = corners[0].X, *b = corners[1].X, *d = corners[2].X;
+        const double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        const double e2[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+        const double facing = (a[0] * ((e1[1] * e2[2]) - (e1[2] * e2[1]))) + (a[1] * ((e1[2] * e2[0]) - (e1[0] * e2[2]))) +
+          (a[2] * ((e1[0] * e2[1]) - (e1[1] * e2[0])));
+        if (facing >= 0.0) {
+          continue;
+        }
+
+        // Sutherland-Hodgman clipping by the plane Z = near, giving a polygon of at most 4 corners
+        vpClipVertex polygon[4];
+        unsigned int nbCorners = 0;
+        for (unsigned int k = 0; k < 3; ++k) {
+          const vpClipVertex &p = corners[k], &q = corners[(k + 1) % 3];
+          const bool pIn = (p.X[2] >= m_clipNear), qIn = (q.X[2] >= m_clipNear);
+          if (pIn) {
+            polygon[nbCorners++] = p;
+          }
+          if (pIn != qIn) {
+            polygon[nbCorners++] = interpolate(p, q, (m_clipNear - p.X[2]) / (q.X[2] - p.X[2]));
+          }
+        }
+
+        for (unsigned int k = 1; (k + 1) < nbCorners; ++k) {
+          const unsigned int fan[3] = { 0, k, k + 1 };
+          vpRasterTriangle tri;
+          double minU = std::numeric_limits<double>::max(), maxU = -minU, minV = minU, maxV = -minU;
+          for (unsigned int l = 0; l < 3; ++l) {
+            const vpClipVertex &p = polygon[fan[l]];
+            tri.invZ[l] = 1.0 / p.X[2];
+            tri.u[l] = m_cam.get_u0() + (m_cam.get_px() * p.X[0] * tri.invZ[l]);
+            tri.v[l] = m_cam.get_v0() + (m_cam.get_py() * p.X[1] * tri.invZ[l]);
+            for (unsigned int m = 0; m < 3; ++m) {
+              tri.n[l][m] = p.n[m] * tri.invZ[l];
+            }
+            minU = std::min(minU, tri.u[l]);
+            maxU = std::max(maxU, tri.u[l]);
+            minV = std::min(minV, tri.v[l]);
+            maxV = std::max(maxV, tri.v[l]);
+          }
+          // Pixels (i, j) whose coordinates are in the bounding box of the triangle and in the rendered region
+          tri.minI = std::max(top, static_cast<int>(std::ceil(std::max(minV, -1.0))));
+          tri.maxI = std::min(bottom - 1, static_cast<int>(std::floor(std::min(maxV, static_cast<double>(bottom)))));
+          tri.minJ = std::max(left, static_cast<int>(std::ceil(std::max(minU, -1.0))));
+          tri.maxJ = std::min(right - 1, static_cast<int>(std::floor(std::min(maxU, static_cast<double>(right)))));
+          if ((tri.minI <= tri.maxI) && (tri.minJ <= tri.maxJ)) {
+            triangles.push_back(tri);
+          }
+        }
+      }
+    }
+  }, 1);
+
+  // Binning of the triangles in the tiles they overlap, in the order of the mesh
+  const int tileSize = static_cast<int>(m_tileSize);
+  const int nbTilesI = std::max(0, (bottom - top + tileSize - 1) / tileSize);
+  const int nbTilesJ = std::max(0, (right - left + tileSize - 1) / tileSize);
+  m_tileTriangles.resize(static_cast<size_t>(nbTilesI * nbTilesJ));
+  for (size_t n = 0; n < m_tileTriangles.size(); ++n) {
+    m_tileTriangles[n].clear();
+  }
+  for (unsigned int c = 0; c < nbChunks; ++c) {
+    for (unsigned int t = 0; t < m_rasterTriangles[c].size(); ++t) {
+      const vpRasterTriangle &tri = m_rasterTriangles[c][t];
+      for (int ti = (tri.minI - top) / tileSize; ti <= ((tri.maxI - top) / tileSize); ++ti) {
+        for (int tj = (tri.minJ - left) / tileSize; tj <= ((tri.maxJ - left) / tileSize); ++tj) {
+          m_tileTriangles[(ti * nbTilesJ) + tj].push_back(std::make_pair(c, t));
+        }
+      }
+    }
+  }
+
+  // Rasterization of the tiles, each pixel keeping the closest surface. Since the triangles of a tile are processed
+  // in the order of the mesh, the result does not depend on the number of threads.
+  const float clipNear = static_cast<float>(m_clipNear), clipFar = static_cast<float>(m_clipFar);
+  pool.parallelFor(0, static_cast<unsigned int>(m_tileTriangles.size()), [&](unsigned int beginTile, unsigned int endTile) {
+    for (unsigned int tile = beginTile; tile < endTile; ++tile) {
+      const int tileTop = top + (static_cast<int>(tile) / nbTilesJ) * tileSize;
+      const int tileLeft = left + (static_cast<int>(tile) % nbTilesJ) * tileSize;
+      const int tileBottom = std::min(bottom, tileTop + tileSize);
+      const int tileRight = std::min(right, tileLeft + tileSize);
+      const std::vector<std::pair<unsigned int, unsigned int> > &tileTriangles = m_tileTriangles[tile];
+      for (size_t n = 0; n < tileTriangles.size(); ++n) {
+        const vpRasterTriangle &tri = m_rasterTriangles[tileTriangles[n].first][tileTriangles[n].second];
+        const double area = ((tri.u[1] - tri.u[0]) * (tri.v[2] - tri.v[0])) - ((tri.u[2] - tri.u[0]) * (tri.v[1] - tri.v[0]));
+        if (std::fabs(area) <= std::numeric_limits<double>::epsilon()) {
+          continue;
+        }
+        const double invArea = 1.0 / area;
+        // Edge functions, w_k(i, j) = a_k j + b_k i + c_k, normalized to be the barycentric coordinates
+        double ea[3], eb[3], ec[3];
+        for (unsigned int k = 0; k < 3; ++k) {
+          const unsigned int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+          ea[k] = (tri.v[k1] - tri.v[k2]) * invArea;
+          eb[k] = (tri.u[k2] - tri.u[k1]) * invArea;
+          ec[k] = ((tri.u[k1] * tri.v[k2]) - (tri.u[k2] * tri.v[k1])) * invArea;
+        }
+        const int iStart = std::max(tileTop, tri.minI), iEnd = std::min(tileBottom - 1, tri.maxI);
+        const int jStart = std::max(tileLeft, tri.minJ), jEnd = std::min(tileRight - 1, tri.maxJ);
+        for (int i = iStart; i <= iEnd; ++i) {
+          float *depthRow = renders.depth[i];
+          vpRGBf *normalsRow = renders.normals[i];
+          // The edge functions are evaluated at each pixel rather than accumulated along the row, so that the pixels
+          // on the edges of the triangles do not depend on the tiling
+          const double r0 = (eb[0] * i) + ec[0], r1 = (eb[1] * i) + ec[1], r2 = (eb[2] * i) + ec[2];
+          for (int j = jStart; j <= jEnd; ++j) {
+            const double w0 = (ea[0] * j) + r0, w1 = (ea[1] * j) + r1, w2 = (ea[2] * j) + r2;
+            if ((w0 < 0.0) || (w1 < 0.0) || (w2 < 0.0)) {
+              continue;
+            }
+            const double invZ = (w0 * tri.invZ[0]) + (w1 * tri.invZ[1]) + (w2 * tri.invZ[2]);
+            const float Z = static_cast<float>(1.0 / invZ);
+            if ((Z < clipNear) || (Z > clipFar) || ((depthRow[j] > 0.f) && (Z >= depthRow[j]))) {
+              continue;
+            }
+            double n[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+              n[k] = (w0 * tri.n[0][k]) + (w1 * tri.n[1][k]) + (w2 * tri.n[2][k]);
+            }
+            const double norm = sqrt((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+            const double invNorm = (norm > 0.0) ? (1.0 / norm) : 0.0;
+            depthRow[j] = Z;
+            normalsRow[j].R = static_cast<float>(n[0] * invNorm);
+            normalsRow[j].G = static_cast<float>(n[1] * invNorm);
+            normalsRow[j].B = static_cast<float>(n[2] * invNorm);
+          }
+        }
+      }
+    }
+  }, 1);
+
+  if (renderSilhouette) {
+    renders.silhouetteCanny.resize(m_imageHeight, m_imageWidth, vpRGBf(0.f));
+    renders.isSilhouette.resize(m_imageHeight, m_imageWidth, 0);
+    if ((top < bottom) && (left < right)) {
+      computeSilhouette(renders, static_cast<unsigned int>(top), static_cast<unsigned int>(left),
+                        static_cast<unsigned int>(bottom), static_cast<unsigned int>(right));
+    }
+  }
+}
+
+/*!
+  Detect the silhouette of the object in the rendered depth, as the fragment shader of vpPanda3DDepthCannyFilter
+  does: a pixel of the object belongs to the silhouette if the absolute value of the laplacian of the depth is above
+  the edge threshold. For these pixels, the red and green channels of the silhouette image are the horizontal and
+  vertical Sobel gradients of the depth, and the blue channel is the orientation of the gradient.
+*/
+void vpRBSoftwareRenderer::computeSilhouette(vpRBRenderData &renders, unsigned int top, unsigned int left,
+                                             unsigned int bottom, unsigned int right) const
+{
+  const vpImage<float> &depth = renders.depth;
+  const int h = static_cast<int>(m_imageHeight), w = static_cast<int>(m_imageWidth);
+  const float edgeThreshold = m_edgeThreshold;
+  vpThreadPool::getInstance().parallelFor(top, bottom, [&](unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i) {
+      vpRGBf *cannyRow = renders.silhouetteCanny[i];
+      unsigned char *silhouetteRow = renders.isSilhouette[i];
+      for (unsigned int j = left; j < right; ++j) {
+        if (depth[i][j] == 0.f) {
+          continue;
+        }
+        // 3x3 neighbourhood, the background and the pixels out of the image being far away
+        float d[3][3];
+        for (int di = -1; di <= 1; ++di) {
+          for (int dj = -1; dj <= 1; ++dj) {
+            const int ii = static_cast<int>(i) + di, jj = static_cast<int>(j) + dj;
+            const float pix = ((ii >= 0) && (ii < h) && (jj >= 0) && (jj < w)) ? depth[ii][jj] : 0.f;
+            d[di + 1][dj + 1] = (pix < 1e-5f) ? 1000.f : pix;
+          }
+        }
+        const float laplacian = d[0][1] + d[1][0] + d[1][2] + d[2][1] - (4.f * d[1][1]);
+        if (std::fabs(laplacian) <= edgeThreshold) {
+          continue;
+        }
+        // The vertical axis of the shader points upwards
+        const float sum_h = (d[0][2] + (2.f * d[1][2]) + d[2][2]) - (d[0][0] + (2.f * d[1][0]) + d[2][0]);
+        const float sum_v = (d[0][0] + (2.f * d[0][1]) + d[0][2]) - (d[2][0] + (2.f * d[2][1]) + d[2][2]);
+        cannyRow[j].R = sum_h;
+        cannyRow[j].G = sum_v;
+        if (sum_h != 0.f) {
+          cannyRow[j].B = std::atan2(sum_v, -sum_h);
+          silhouetteRow[j] = 1;
+        }
+      }
+    }
+  });
+}
+
+END_VISP_NAMESPACE
@@ -44,6 +44,7 @@
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/rbt/vpRBTracker.h>
+#include <visp3/rbt/vpRBSoftwareRenderer.h>
 
 #include <visp3/rbt/vpRBSilhouetteMeTracker.h>
 #include <visp3/rbt/vpRBSilhouetteCCDTracker.h>
@@ -492,6 +493,19 @@ SCENARIO("Instantiating a render-based tracker", "[rbt]")
     }
   }
 
+  WHEN("Setting concurrent feature trackers")
+  {
+    THEN("Trackers are run sequentially by default")
+    {
+      REQUIRE_FALSE(tracker.getParallelTrackers());
+    }
+    THEN("Enabling concurrent trackers is ok")
+    {
+      tracker.setParallelTrackers(true);
+      REQUIRE(tracker.getParallelTrackers());
+    }
+  }
+
   WHEN("Setting camera parameters and resolution")
   {
     unsigned int h = 480, w = 640;
@@ -590,7 +604,8 @@ SCENARIO("Instantiating a render-based tracker", "[rbt]")
       ],
       "verbose": {
         "enabled": true
-      }
+      },
+      "parallelTrackers": true
     })JSON";
     const auto verifyBase = [&tracker]() {
       REQUIRE((tracker.getImageHeight() == 240 && tracker.getImageWidth() == 320));
@@ -602,6 +617,7 @@ SCENARIO("Instantiating a render-based tracker", "[rbt]")
 
       REQUIRE((tracker.getOptimizationGain() == 1.0 && tracker.getMaxOptimizationIters() == 10));
       REQUIRE((tracker.getOptimizationInitialMu() == 0.5 && tracker.getOptimizationMuIterFactor() == 0.1));
+      REQUIRE(tracker.getParallelTrackers());
       };
     nlohmann::json j = nlohmann::json::parse(jsonLiteral);
     THEN("Loading configuration with trackers")
@@ -667,6 +683,64 @@ SCENARIO("Instantiating a render-based tracker", "[rbt]")
 #endif
 }
 
+SCENARIO("Rendering with the software renderer", "[rbt]")
+{
+  const unsigned int h = 480, w = 640;
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const std::string tempDir = vpIoTools::makeTempDirectory("visp_test_rbt_obj");
+  const std::string objFile = vpIoTools::createFilePath(tempDir, "cube.obj");
+  std::ofstream f(objFile);
+  f << objCube;
+  f.close();
+
+  vpRBSoftwareRenderer renderer;
+  renderer.loadObject(objFile);
+  REQUIRE(renderer.getNbTriangles() == 12);
+  renderer.setCameraParameters(cam, h, w);
+  REQUIRE_THROWS(renderer.setClippingDistance(0.5, 0.1));
+  REQUIRE_THROWS(renderer.setTileSize(0));
+
+  // Cube seen from the front, the face at z = -0.05 in the object frame is at 0.25 m from the camera
+  const vpHomogeneousMatrix cMo(0.0, 0.0, 0.3, 0.0, 0.0, 0.0);
+  float clipNear, clipFar;
+  renderer.computeClipping(cMo, clipNear, clipFar);
+  REQUIRE(clipNear <= 0.25f);
+  REQUIRE(clipFar >= 0.35f);
+  renderer.setClippingDistance(clipNear, clipFar);
+  renderer.setEdgeThreshold(0.01f);
+
+  vpRBRenderData renders;
+  renderer.render(cMo, renders, true);
+  REQUIRE(renders.depth.getHeight() == h);
+  REQUIRE(renders.depth.getWidth() == w);
+  REQUIRE(renders.boundingBox.getLeft() <= 200.0);
+  REQUIRE(renders.boundingBox.getRight() >= 440.0);
+
+  THEN("Depth and normals are those of the front face")
+  {
+    REQUIRE(renders.depth[240][320] == Catch::Approx(0.25f).margin(1e-6));
+    REQUIRE(renders.normals[240][320].B == Catch::Approx(-1.f).margin(1e-6));
+    REQUIRE(renders.depth[10][10] == 0.f);
+  }
+  THEN("The silhouette is found at the border of the cube and not inside")
+  {
+    unsigned int nbSilhouette = 0;
+    for (unsigned int j = 190; j < 210; ++j) {
+      nbSilhouette += renders.isSilhouette[240][j] != 0 ? 1 : 0;
+    }
+    REQUIRE(nbSilhouette > 0);
+    REQUIRE(renders.isSilhouette[240][320] == 0);
+  }
+  THEN("The renders do not depend on the tile size")
+  {
+    renderer.setTileSize(7);
+    vpRBRenderData rendersTiled;
+    renderer.render(cMo, rendersTiled, true);
+    REQUIRE(rendersTiled.depth == renders.depth);
+    REQUIRE(rendersTiled.isSilhouette == renders.isSilhouette);
+  }
+}
+
 SCENARIO("Running tracker on static synthetic sequences", "[rbt]")
 {
   if(opt_no_display)
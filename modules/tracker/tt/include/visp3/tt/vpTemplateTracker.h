@@ -44,7 +44,9 @@
 #ifndef vpTemplateTracker_hh
 #define vpTemplateTracker_hh
 
+#include <functional>
 #include <math.h>
+#include <vector>
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImageFilter.h>
@@ -59,6 +61,11 @@ BEGIN_VISP_NAMESPACE
 
   This class allows to instantiate a template tracker using image registration
   algorithms \cite Dame10c \cite Dame11c.
+
+  The template points are split in partitions of a fixed number of points that are warped and accumulated in
+  parallel by the threads of vpThreadPool, each thread using its own copy of the warping function, see
+  vpTemplateTrackerWarp::duplicate(). The partitions do not depend on the number of threads and their partial sums
+  are added in the order of the partitions, so that the results are the same whatever the number of threads.
 */
 class VISP_EXPORT vpTemplateTracker
 {
@@ -144,11 +151,36 @@ protected:
   vpImage<double> dIy;
   vpTemplateTrackerZone zoneRef_; // Reference zone
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  /*!
+    Sums accumulated over one partition of the template points. Their meaning depends on the tracker.
+  */
+  struct vpTemplatePartialSums
+  {
+    vpMatrix H;
+    vpColVector G;
+    vpColVector G2;
+    double sum[3];
+    unsigned int nbPoints;
+  };
+
+  /*!
+    Function processing the template points in [begin, end[ of a partition. The warp is a copy of the warping
+    function that is not used by another thread at the same time, whose coefficients are already computed.
+  */
+  typedef std::function<void(unsigned int partition, unsigned int begin, unsigned int end,
+                             vpTemplateTrackerWarp &warp)> vpTemplatePointsTask;
+
+  unsigned int m_nbPartitions;                       // Number of partitions of the template points
+  std::vector<vpTemplatePartialSums> m_partialSums; // Sums of each partition
+  std::vector<vpTemplateTrackerWarp *> m_warps;      // Copies of Warp used by the threads other than the first one
+#endif
+
 public:
   //! Default constructor.
   vpTemplateTracker()
-    : nbLvlPyr(0), l0Pyr(0), pyrInitialised(false), ptTemplate(nullptr), ptTemplatePyr(nullptr), ptTemplateInit(false),
-    templateSize(0), templateSizePyr(nullptr), ptTemplateSelect(nullptr), ptTemplateSelectPyr(nullptr),
+    : nbLvlPyr(0), l0Pyr(0), pyrInitialised(false), evolRMS(0), x_pos(), y_pos(), evolRMS_eps(1e-4),
+    ptTemplate(nullptr), ptTemplatePyr(nullptr), ptTemplateInit(false), templateSize(0), templateSizePyr(nullptr), ptTemplateSelect(nullptr), ptTemplateSelectPyr(nullptr),
     ptTemplateSelectInit(false), templateSelectSize(0), ptTemplateSupp(nullptr), ptTemplateSuppPyr(nullptr),
     ptTemplateCompo(nullptr), ptTemplateCompoPyr(nullptr), zoneTracked(nullptr), zoneTrackedPyr(nullptr), pyr_IDes(nullptr), H(),
     Hdesire(), HdesirePyr(nullptr), HLM(), HLMdesire(), HLMdesirePyr(nullptr), HLMdesireInverse(),
@@ -156,7 +188,7 @@ public:
     useBrent(false), nbIterBrent(0), taillef(0), fgG(nullptr), fgdG(nullptr), ratioPixelIn(0), mod_i(0), mod_j(0),
     nbParam(), lambdaDep(0), iterationMax(0), iterationGlobale(0), diverge(false), nbIteration(0),
     useCompositionnal(false), useInverse(false), Warp(nullptr), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(),
-    zoneRef_()
+    zoneRef_(), m_nbPartitions(1), m_partialSums(), m_warps()
   { }
   VP_EXPLICIT vpTemplateTracker(vpTemplateTrackerWarp *_warp);
   virtual ~vpTemplateTracker();
@@ -295,6 +327,11 @@ protected:
   virtual void initPyramidal(unsigned int nbLvl, unsigned int l0);
   void initTracking(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void initTrackingPyr(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  unsigned int initPartitions(const vpColVector &tp);
+  void parallelForPartitions(const vpTemplatePointsTask &task);
+  vpTemplatePartialSums &reducePartialSums();
+#endif
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   virtual void trackPyr(const vpImage<unsigned char> &I);
 };
@@ -103,6 +103,14 @@ public:
   virtual void dWarpCompo(const vpColVector &X1, const vpColVector &X2, const vpColVector &p, const double *dwdp0,
                           vpMatrix &dM) = 0;
 
+  /*!
+   * Create a copy of the warping function, used by the template trackers to warp several parts of the template in
+   * parallel.
+   * \return A copy allocated with new that has to be deleted by the caller, or nullptr if the warping function
+   * cannot be copied. In that case the template trackers process the template points sequentially.
+   */
+  virtual vpTemplateTrackerWarp *duplicate() const { return nullptr; }
+
   /*!
    * Compute the derivative of the image with relation to the warping function parameters.
    * \param v : Coordinate (along the image rows axis) of the point to consider in the image.
@@ -81,6 +81,8 @@ public:
   void dWarp(const vpColVector &, const vpColVector &X, const vpColVector &, vpMatrix &dW);
   void dWarpCompo(const vpColVector &X, const vpColVector &, const vpColVector &p, const double *dwdp0, vpMatrix &dW);
 
+  vpTemplateTrackerWarpHomography *duplicate() const { return new vpTemplateTrackerWarpHomography(*this); }
+
   void getdW0(const int &v, const int &u, const double &dv, const double &du, double *dIdW);
   void getdWdp0(const int &v, const int &u, double *dIdW);
 
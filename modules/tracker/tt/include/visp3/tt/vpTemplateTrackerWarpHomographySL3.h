@@ -67,6 +67,8 @@ public:
   void dWarp(const vpColVector &X1, const vpColVector &X2, const vpColVector &, vpMatrix &dW);
   void dWarpCompo(const vpColVector &, const vpColVector &X, const vpColVector &, const double *dwdp0, vpMatrix &dW);
 
+  vpTemplateTrackerWarpHomographySL3 *duplicate() const { return new vpTemplateTrackerWarpHomographySL3(*this); }
+
   void findWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt, vpColVector &p);
 
   void getdW0(const int &v, const int &u, const double &dv, const double &du, double *dIdW);
@@ -78,6 +78,8 @@ public:
   void dWarp(const vpColVector &X, const vpColVector &, const vpColVector &p, vpMatrix &dM);
   void dWarpCompo(const vpColVector &, const vpColVector &, const vpColVector &p, const double *dwdp0, vpMatrix &dM);
 
+  vpTemplateTrackerWarpSRT *duplicate() const { return new vpTemplateTrackerWarpSRT(*this); }
+
   void getdW0(const int &v, const int &u, const double &dv, const double &du, double *dIdW);
   void getdWdp0(const int &v, const int &u, double *dIdW);
 
@@ -78,6 +78,8 @@ public:
   void dWarp(const vpColVector &, const vpColVector &, const vpColVector &, vpMatrix &dM);
   void dWarpCompo(const vpColVector &, const vpColVector &, const vpColVector &, const double *dwdp0, vpMatrix &dM);
 
+  vpTemplateTrackerWarpTranslation *duplicate() const { return new vpTemplateTrackerWarpTranslation(*this); }
+
   void getdW0(const int &, const int &, const double &dv, const double &du, double *dIdW);
   void getdWdp0(const int &, const int &, double *dIdW);
 
@@ -56,31 +56,35 @@ vpTemplateTrackerSSD::vpTemplateTrackerSSD(vpTemplateTrackerWarp *warp) : vpTemp
 
 double vpTemplateTrackerSSD::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
 {
-  double erreur = 0;
-  double IW;
-  int Nbpoint = 0;
+  initPartitions(tp);
+  parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+    vpTemplatePartialSums &sums = m_partialSums[partition];
+    vpColVector X1_(2), X2_(2);
+    double IW;
+    for (unsigned int point = begin; point < end; point++) {
+      int i = ptTemplate[point].y;
+      int j = ptTemplate[point].x;
+      X1_[0] = j;
+      X1_[1] = i;
+      warp.computeDenom(X1_, tp);
+      warp.warpX(X1_, X2_, tp);
 
-  Warp->computeCoeff(tp);
-  for (unsigned int point = 0; point < templateSize; point++) {
-    int i = ptTemplate[point].y;
-    int j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    double j2 = X2[0];
-    double i2 = X2[1];
-    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-      double Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-      erreur += (Tij - IW) * (Tij - IW);
-      Nbpoint++;
+      double j2 = X2_[0];
+      double i2 = X2_[1];
+      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+        double Tij = ptTemplate[point].val;
+        if (!blur)
+          IW = I.getValue(i2, j2);
+        else
+          IW = BI.getValue(i2, j2);
+        sums.sum[0] += (Tij - IW) * (Tij - IW);
+        sums.nbPoints++;
+      }
     }
-  }
+  });
+  const vpTemplatePartialSums &sums = reducePartialSums();
+  double erreur = sums.sum[0];
+  int Nbpoint = static_cast<int>(sums.nbPoints);
   ratioPixelIn = static_cast<double>(Nbpoint) / static_cast<double>(templateSize);
 
   if (Nbpoint == 0)
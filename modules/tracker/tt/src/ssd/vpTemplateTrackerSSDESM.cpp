@@ -97,11 +97,7 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  double IW, dIWx, dIWy;
-  double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
 
   initPosEvalRMS(p);
@@ -109,72 +105,72 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
-  double *tempt = new double[nbParam];
 
   do {
-    unsigned int Nbpoint = 0;
-    double erreur = 0;
     dp = 0;
-    HDir = 0;
-    GDir = 0;
-    GInv = 0;
-    Warp->computeCoeff(p);
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        // INVERSE
-        Tij = ptTemplate[point].val;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-        Nbpoint++;
-        double er = (Tij - IW);
-        for (unsigned int it = 0; it < nbParam; it++)
-          GInv[it] += er * ptTemplate[point].dW[it];
-
-        erreur += er * er;
-
-        dIWx = dIx.getValue(i2, j2) + ptTemplate[point].dx;
-        dIWy = dIy.getValue(i2, j2) + ptTemplate[point].dy;
-
-        // Calcul du Hessien
-        Warp->dWarpCompo(X1, X2, p, ptTemplateCompo[point].dW, dW);
-
-        for (unsigned int it = 0; it < nbParam; it++)
-          tempt[it] = dW[0][it] * dIWx + dW[1][it] * dIWy;
-
-        for (unsigned int it = 0; it < nbParam; it++)
-          for (unsigned int jt = 0; jt < nbParam; jt++)
-            HDir[it][jt] += tempt[it] * tempt[jt];
-
-        for (unsigned int it = 0; it < nbParam; it++)
-          GDir[it] += er * tempt[it];
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      vpMatrix dW_(2, nbParam);
+      std::vector<double> tempt(nbParam);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          // INVERSE
+          double Tij = ptTemplate[point].val;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+          sums.nbPoints++;
+          double er = (Tij - IW);
+          for (unsigned int it = 0; it < nbParam; it++)
+            sums.G2[it] += er * ptTemplate[point].dW[it];
+
+          sums.sum[0] += er * er;
+
+          double dIWx = dIx.getValue(i2, j2) + ptTemplate[point].dx;
+          double dIWy = dIy.getValue(i2, j2) + ptTemplate[point].dy;
+
+          // Calcul du Hessien
+          warp.dWarpCompo(X1_, X2_, p, ptTemplateCompo[point].dW, dW_);
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            tempt[it] = dW_[0][it] * dIWx + dW_[1][it] * dIWy;
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            for (unsigned int jt = 0; jt < nbParam; jt++)
+              sums.H[it][jt] += tempt[it] * tempt[jt];
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            sums.G[it] += er * tempt[it];
+        }
       }
-    }
+    });
+    const vpTemplatePartialSums &sums = reducePartialSums();
+    unsigned int Nbpoint = sums.nbPoints;
+    double erreur = sums.sum[0];
+    HDir = sums.H;
+    GDir = sums.G;
+    GInv = sums.G2;
     if (Nbpoint == 0) {
-      delete[] tempt;
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     }
 
     vpMatrix::computeHLM(HDir, lambdaDep, HLMDir);
 
-    try {
-      dp = (HLMDir).inverseByLU() * (GDir);
-    }
-    catch (const vpException &e) {
-      delete[] tempt;
-      throw(e);
-    }
+    dp = (HLMDir).inverseByLU() * (GDir);
 
     dp = gain * dp;
     if (useBrent) {
@@ -197,7 +193,6 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
     evolRMS_prec = evolRMS;
 
   } while ((iteration < iterationMax) && (evolRMS_delta > std::fabs(evolRMS_init) * evolRMS_eps));
-  delete[] tempt;
 
   nbIteration = iteration;
 }
@@ -72,14 +72,8 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  dW = 0;
-
   double lambda = lambdaDep;
-  double IW, dIWx, dIWy;
-  double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
 
   initPosEvalRMS(p);
@@ -87,65 +81,65 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
-  double *tempt = new double[nbParam];
 
   do {
-    unsigned int Nbpoint = 0;
-    double erreur = 0;
-    G = 0;
-    H = 0;
-    Warp->computeCoeff(p);
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Tij = ptTemplate[point].val;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-        dIWx = dIx.getValue(i2, j2);
-        dIWy = dIy.getValue(i2, j2);
-        Nbpoint++;
-
-        Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
-
-        for (unsigned int it = 0; it < nbParam; it++)
-          tempt[it] = dW[0][it] * dIWx + dW[1][it] * dIWy;
-
-        for (unsigned int it = 0; it < nbParam; it++)
-          for (unsigned int jt = 0; jt < nbParam; jt++)
-            H[it][jt] += tempt[it] * tempt[jt];
-
-        double er = (Tij - IW);
-        for (unsigned int it = 0; it < nbParam; it++)
-          G[it] += er * tempt[it];
-
-        erreur += (er * er);
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      vpMatrix dW_(2, nbParam);
+      std::vector<double> tempt(nbParam);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          double Tij = ptTemplate[point].val;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+          double dIWx = dIx.getValue(i2, j2);
+          double dIWy = dIy.getValue(i2, j2);
+          sums.nbPoints++;
+
+          warp.dWarpCompo(X1_, X2_, p, ptTemplate[point].dW, dW_);
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            tempt[it] = dW_[0][it] * dIWx + dW_[1][it] * dIWy;
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            for (unsigned int jt = 0; jt < nbParam; jt++)
+              sums.H[it][jt] += tempt[it] * tempt[jt];
+
+          double er = (Tij - IW);
+          for (unsigned int it = 0; it < nbParam; it++)
+            sums.G[it] += er * tempt[it];
+
+          sums.sum[0] += (er * er);
+        }
       }
-    }
+    });
+    const vpTemplatePartialSums &sums = reducePartialSums();
+    unsigned int Nbpoint = sums.nbPoints;
+    double erreur = sums.sum[0];
+    H = sums.H;
+    G = sums.G;
     if (Nbpoint == 0) {
-      delete[] tempt;
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     }
 
     vpMatrix::computeHLM(H, lambda, HLM);
 
-    try {
-      dp = HLM.inverseByLU() * G;
-    }
-    catch (const vpException &e) {
-      delete[] tempt;
-      throw(e);
-    }
+    dp = HLM.inverseByLU() * G;
 
     dp = gain * dp;
     if (useBrent) {
@@ -166,7 +160,6 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
     evolRMS_prec = evolRMS;
 
   } while ((iteration < iterationMax) && (evolRMS_delta > std::fabs(evolRMS_init) * evolRMS_eps));
-  delete[] tempt;
 
   nbIteration = iteration;
 }
@@ -97,52 +97,52 @@ void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned
     vpImageFilter::filter(I, BI, fgG, taillef);
 
   vpColVector dpinv(nbParam);
-  double IW;
-  double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
   initPosEvalRMS(p);
 
-  vpTemplateTrackerPoint *pt;
-
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
 
   do {
-    unsigned int Nbpoint = 0;
-    double erreur = 0;
-    dp = 0;
-    Warp->computeCoeff(p);
-    for (unsigned int point = 0; point < templateSize; point++) {
-      if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
-        pt = &ptTemplate[point];
-        i = pt->y;
-        j = pt->x;
-        X1[0] = j;
-        X1[1] = i;
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-        j2 = X2[0];
-        i2 = X2[1];
-
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Tij = pt->val;
-          if (!blur)
-            IW = I.getValue(i2, j2);
-          else
-            IW = BI.getValue(i2, j2);
-          Nbpoint++;
-          double er = (Tij - IW);
-          for (unsigned int it = 0; it < nbParam; it++)
-            dp[it] += er * pt->HiG[it];
-
-          erreur += er * er;
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      for (unsigned int point = begin; point < end; point++) {
+        if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
+          const vpTemplateTrackerPoint *pt = &ptTemplate[point];
+          int i = pt->y;
+          int j = pt->x;
+          X1_[0] = j;
+          X1_[1] = i;
+          warp.computeDenom(X1_, p);
+          warp.warpX(X1_, X2_, p);
+          double j2 = X2_[0];
+          double i2 = X2_[1];
+
+          if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+            double Tij = pt->val;
+            double IW;
+            if (!blur)
+              IW = I.getValue(i2, j2);
+            else
+              IW = BI.getValue(i2, j2);
+            sums.nbPoints++;
+            double er = (Tij - IW);
+            for (unsigned int it = 0; it < nbParam; it++)
+              sums.G[it] += er * pt->HiG[it];
+
+            sums.sum[0] += er * er;
+          }
         }
       }
-    }
+    });
+    const vpTemplatePartialSums &sums = reducePartialSums();
+    unsigned int Nbpoint = sums.nbPoints;
+    double erreur = sums.sum[0];
+    dp = sums.G;
     if (Nbpoint == 0) {
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     }
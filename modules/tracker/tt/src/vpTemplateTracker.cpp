@@ -31,6 +31,7 @@
  * Template tracker.
  */
 
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
 
@@ -44,7 +45,8 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
   HLMdesireInversePyr(), G(), gain(1.), thresholdGradient(40), costFunctionVerification(false), blur(true),
   useBrent(false), nbIterBrent(3), taillef(7), fgG(nullptr), fgdG(nullptr), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0),
   lambdaDep(0.001), iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(true),
-  useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+  useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_(), m_nbPartitions(1),
+  m_partialSums(), m_warps()
 {
   nbParam = Warp->getNbParam();
   p.resize(nbParam);
@@ -141,6 +143,10 @@ vpTemplateTracker::~vpTemplateTracker()
   delete[] fgG;
   delete[] fgdG;
 
+  for (size_t i = 0; i < m_warps.size(); ++i) {
+    delete m_warps[i];
+  }
+
   resetTracker();
 }
 
@@ -842,4 +848,112 @@ void vpTemplateTracker::initPosEvalRMS(const vpColVector &param)
     }
   }
 }
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of template points of a partition. It does not depend on the number of threads, so that the template points
+// are summed in the same order, and the trackers give the same results, whatever the size of the thread pool.
+const unsigned int templatePointsBlockSize = 2048;
+}
+
+/*!
+  Split the template points in partitions of a fixed number of points, compute the coefficients of the warping
+  functions used to process the partitions and reset the partial sums of the partitions.
+
+  The partitions do not depend on the number of threads of vpThreadPool. Up to one copy of the warping function per
+  thread is created, see vpTemplateTrackerWarp::duplicate(). When the warping function cannot be duplicated, the
+  partitions are processed sequentially, with the same results.
+
+  \param tp : Parameters of the warping function.
+  \return The number of partitions.
+*/
+unsigned int vpTemplateTracker::initPartitions(const vpColVector &tp)
+{
+  const unsigned int nbPartitions =
+    std::max<unsigned int>((templateSize + templatePointsBlockSize - 1) / templatePointsBlockSize, 1);
+  m_nbPartitions = nbPartitions;
+
+  const unsigned int nbWarps = std::min<unsigned int>(vpThreadPool::getInstance().getNbThreads(), nbPartitions);
+  while (m_warps.size() + 1 < nbWarps) {
+    vpTemplateTrackerWarp *warp = Warp->duplicate();
+    if (warp == nullptr) {
+      break;
+    }
+    m_warps.push_back(warp);
+  }
+
+  Warp->computeCoeff(tp);
+  for (size_t k = 0; k < m_warps.size(); ++k) {
+    m_warps[k]->computeCoeff(tp);
+  }
+
+  if (m_partialSums.size() < nbPartitions) {
+    m_partialSums.resize(nbPartitions);
+  }
+  for (unsigned int k = 0; k < nbPartitions; ++k) {
+    vpTemplatePartialSums &sums = m_partialSums[k];
+    sums.H.resize(nbParam, nbParam);
+    sums.G.resize(nbParam);
+    sums.G2.resize(nbParam);
+    sums.sum[0] = sums.sum[1] = sums.sum[2] = 0.;
+    sums.nbPoints = 0;
+  }
+
+  return nbPartitions;
+}
+
+/*!
+  Run a task on each partition of the template points defined by the last call to initPartitions(). The partitions
+  are shared between as many tasks as there are warping functions, the task \e t processing the partitions
+  \e t, \e t + T, \e t + 2T... with its own warping function, the first one being the warping function of the
+  tracker.
+
+  \param task : Function processing the points of a partition.
+*/
+void vpTemplateTracker::parallelForPartitions(const vpTemplatePointsTask &task)
+{
+  const unsigned int nbPartitions = m_nbPartitions;
+  const unsigned int nbTasks = std::min<unsigned int>(static_cast<unsigned int>(m_warps.size()) + 1, nbPartitions);
+  const unsigned int nbPoints = templateSize;
+  vpThreadPool::vpRangeTask processPartitions = [&](unsigned int begin, unsigned int end) {
+    for (unsigned int t = begin; t < end; ++t) {
+      vpTemplateTrackerWarp &warp = (t == 0) ? *Warp : *m_warps[t - 1];
+      for (unsigned int k = t; k < nbPartitions; k += nbTasks) {
+        const unsigned int first = k * templatePointsBlockSize;
+        const unsigned int last = std::min<unsigned int>(nbPoints, first + templatePointsBlockSize);
+        task(k, first, last, warp);
+      }
+    }
+  };
+
+  if (nbTasks <= 1) {
+    processPartitions(0, 1);
+  }
+  else {
+    vpThreadPool::getInstance().parallelFor(0, nbTasks, processPartitions, 1);
+  }
+}
+
+/*!
+  Add the partial sums of the partitions, in the order of the partitions so that the result does not depend on the
+  scheduling of the tasks.
+
+  \return The partial sums of the first partition, that contain the total.
+*/
+vpTemplateTracker::vpTemplatePartialSums &vpTemplateTracker::reducePartialSums()
+{
+  vpTemplatePartialSums &total = m_partialSums[0];
+  for (unsigned int k = 1; k < m_nbPartitions; ++k) {
+    const vpTemplatePartialSums &sums = m_partialSums[k];
+    total.H += sums.H;
+    total.G += sums.G;
+    total.G2 += sums.G2;
+    for (unsigned int i = 0; i < 3; ++i) {
+      total.sum[i] += sums.sum[i];
+    }
+    total.nbPoints += sums.nbPoints;
+  }
+  return total;
+}
+#endif
 END_VISP_NAMESPACE
@@ -55,69 +55,73 @@ vpTemplateTrackerZNCC::vpTemplateTrackerZNCC(vpTemplateTrackerWarp *warp) : vpTe
 
 double vpTemplateTrackerZNCC::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
 {
-  double IW, Tij;
-  int i, j;
-  double i2, j2;
-  int Nbpoint = 0;
+  initPartitions(tp);
+  parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+    vpTemplatePartialSums &sums = m_partialSums[partition];
+    vpColVector X1_(2), X2_(2);
+    for (unsigned int point = begin; point < end; point++) {
+      int i = ptTemplate[point].y;
+      int j = ptTemplate[point].x;
+      X1_[0] = j;
+      X1_[1] = i;
+      warp.computeDenom(X1_, tp);
+      warp.warpX(X1_, X2_, tp);
 
-  Warp->computeCoeff(tp);
-
-  double moyTij = 0;
-  double moyIW = 0;
-  for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    j2 = X2[0];
-    i2 = X2[1];
-    if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
-      Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-      moyTij += Tij;
-      moyIW += IW;
-      Nbpoint++;
+      double j2 = X2_[0];
+      double i2 = X2_[1];
+      if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
+        double Tij = ptTemplate[point].val;
+        double IW;
+        if (!blur)
+          IW = I.getValue(i2, j2);
+        else
+          IW = BI.getValue(i2, j2);
+        sums.sum[0] += Tij;
+        sums.sum[1] += IW;
+        sums.nbPoints++;
+      }
     }
-  }
+  });
+  const vpTemplatePartialSums &means = reducePartialSums();
+  int Nbpoint = static_cast<int>(means.nbPoints);
   ratioPixelIn = static_cast<double>(Nbpoint) / static_cast<double>(templateSize);
   if (!Nbpoint) {
     throw(vpException(vpException::divideByZeroError, "Cannot get cost: size = 0"));
   }
 
-  moyTij = moyTij / Nbpoint;
-  moyIW = moyIW / Nbpoint;
+  double moyTij = means.sum[0] / Nbpoint;
+  double moyIW = means.sum[1] / Nbpoint;
 
-  double nom = 0;
-  double var1 = 0, var2 = 0;
-  for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
+  initPartitions(tp);
+  parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+    vpTemplatePartialSums &sums = m_partialSums[partition];
+    vpColVector X1_(2), X2_(2);
+    for (unsigned int point = begin; point < end; point++) {
+      int i = ptTemplate[point].y;
+      int j = ptTemplate[point].x;
+      X1_[0] = j;
+      X1_[1] = i;
+      warp.computeDenom(X1_, tp);
+      warp.warpX(X1_, X2_, tp);
 
-    j2 = X2[0];
-    i2 = X2[1];
-    if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
-      Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-      nom += (Tij - moyTij) * (IW - moyIW);
-      var1 += (IW - moyIW) * (IW - moyIW);
-      var2 += (Tij - moyTij) * (Tij - moyTij);
-
-      Nbpoint++;
+      double j2 = X2_[0];
+      double i2 = X2_[1];
+      if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
+        double Tij = ptTemplate[point].val;
+        double IW;
+        if (!blur)
+          IW = I.getValue(i2, j2);
+        else
+          IW = BI.getValue(i2, j2);
+        sums.sum[0] += (Tij - moyTij) * (IW - moyIW);
+        sums.sum[1] += (IW - moyIW) * (IW - moyIW);
+        sums.sum[2] += (Tij - moyTij) * (Tij - moyTij);
+      }
     }
-  }
+  });
+  const vpTemplatePartialSums &sums = reducePartialSums();
+  double nom = sums.sum[0];
+  double var1 = sums.sum[1], var2 = sums.sum[2];
   return -nom / sqrt(var1 * var2);
 }
 END_VISP_NAMESPACE
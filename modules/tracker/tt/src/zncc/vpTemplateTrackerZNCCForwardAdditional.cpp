@@ -156,13 +156,7 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  dW = 0;
-
-  double IW, dIWx, dIWy;
-  double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
 
   initPosEvalRMS(p);
@@ -170,94 +164,98 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
-  double *tempt = new double[nbParam];
 
   do {
-    int Nbpoint = 0;
-    double erreur = 0;
-    G = 0;
-    H = 0;
-    Warp->computeCoeff(p);
-    double moyTij = 0;
-    double moyIW = 0;
-    double denom = 0;
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Tij = ptTemplate[point].val;
-
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        Nbpoint++;
-        moyTij += Tij;
-        moyIW += IW;
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          double Tij = ptTemplate[point].val;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+
+          sums.nbPoints++;
+          sums.sum[0] += Tij;
+          sums.sum[1] += IW;
+        }
       }
-    }
+    });
+    const vpTemplatePartialSums &means = reducePartialSums();
+    int Nbpoint = static_cast<int>(means.nbPoints);
 
     if (!Nbpoint) {
-      delete[] tempt;
       throw(vpException(vpException::divideByZeroError, "Cannot track the template: no point"));
     }
 
-    moyTij = moyTij / Nbpoint;
-    moyIW = moyIW / Nbpoint;
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Tij = ptTemplate[point].val;
-
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        dIWx = dIx.getValue(i2, j2);
-        dIWy = dIy.getValue(i2, j2);
-        // Calcul du Hessien
-        Warp->dWarp(X1, X2, p, dW);
-        for (unsigned int it = 0; it < nbParam; it++)
-          tempt[it] = dW[0][it] * dIWx + dW[1][it] * dIWy;
-
-        double prod = (Tij - moyTij);
-        for (unsigned int it = 0; it < nbParam; it++)
-          G[it] += prod * tempt[it];
-
-        double er = (Tij - IW);
-        erreur += (er * er);
-        denom += (Tij - moyTij) * (Tij - moyTij) * (IW - moyIW) * (IW - moyIW);
+    double moyTij = means.sum[0] / Nbpoint;
+    double moyIW = means.sum[1] / Nbpoint;
+
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      vpMatrix dW_(2, nbParam);
+      std::vector<double> tempt(nbParam);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          double Tij = ptTemplate[point].val;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+
+          double dIWx = dIx.getValue(i2, j2);
+          double dIWy = dIy.getValue(i2, j2);
+          // Calcul du Hessien
+          warp.dWarp(X1_, X2_, p, dW_);
+          for (unsigned int it = 0; it < nbParam; it++)
+            tempt[it] = dW_[0][it] * dIWx + dW_[1][it] * dIWy;
+
+          double prod = (Tij - moyTij);
+          for (unsigned int it = 0; it < nbParam; it++)
+            sums.G[it] += prod * tempt[it];
+
+          double er = (Tij - IW);
+          sums.sum[0] += (er * er);
+          sums.sum[1] += (Tij - moyTij) * (Tij - moyTij) * (IW - moyIW) * (IW - moyIW);
+        }
       }
-    }
+    });
+    const vpTemplatePartialSums &sums = reducePartialSums();
+    double erreur = sums.sum[0];
+    double denom = sums.sum[1];
+    G = sums.G;
+    H = 0;
     G = G / sqrt(denom);
     H = H / sqrt(denom);
 
-    try {
-      dp = HLMdesireInverse * G;
-    }
-    catch (const vpException &e) {
-      delete[] tempt;
-      throw(e);
-    }
+    dp = HLMdesireInverse * G;
 
     dp = gain * dp;
     if (useBrent) {
@@ -278,7 +276,6 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     evolRMS_prec = evolRMS;
 
   } while ((iteration < iterationMax) && (evolRMS_delta > std::fabs(evolRMS_init) * evolRMS_eps));
-  delete[] tempt;
 
   nbIteration = iteration;
 }
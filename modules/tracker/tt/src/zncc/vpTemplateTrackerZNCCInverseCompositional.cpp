@@ -237,11 +237,7 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
     vpImageFilter::filter(I, BI, fgG, taillef);
 
   vpColVector dpinv(nbParam);
-  double Ic;
-  double Iref;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   initPosEvalRMS(p);
 
   double evolRMS_init = 0;
@@ -249,75 +245,84 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
   double evolRMS_delta;
 
   do {
-    unsigned int Nbpoint = 0;
     G = 0;
-    Warp->computeCoeff(p);
-    double moyIref = 0;
-    double moyIc = 0;
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Iref = ptTemplate[point].val;
-
-        if (!blur)
-          Ic = I.getValue(i2, j2);
-        else
-          Ic = BI.getValue(i2, j2);
-
-        Nbpoint++;
-        moyIref += Iref;
-        moyIc += Ic;
-      }
-    }
-    if (Nbpoint > 0) {
-      moyIref = moyIref / Nbpoint;
-      moyIc = moyIc / Nbpoint;
-      double sIcIref = 0;
-      double covarIref = 0, covarIc = 0;
-      vpColVector sIcdIref(nbParam);
-      sIcdIref = 0;
-      vpColVector sIrefdIref(nbParam);
-      sIrefdIref = 0;
-
-      for (unsigned int point = 0; point < templateSize; point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-
-        j2 = X2[0];
-        i2 = X2[1];
+    initPartitions(p);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+      vpTemplatePartialSums &sums = m_partialSums[partition];
+      vpColVector X1_(2), X2_(2);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
         if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Iref = ptTemplate[point].val;
-
+          double Iref = ptTemplate[point].val;
+          double Ic;
           if (!blur)
             Ic = I.getValue(i2, j2);
           else
             Ic = BI.getValue(i2, j2);
 
-          double prod = (Ic - moyIc);
-          for (unsigned int it = 0; it < nbParam; it++)
-            sIcdIref[it] += prod * (ptTemplate[point].dW[it] - moydIrefdp[it]);
-          for (unsigned int it = 0; it < nbParam; it++)
-            sIrefdIref[it] += (Iref - moyIref) * (ptTemplate[point].dW[it] - moydIrefdp[it]);
-
-          covarIref += (Iref - moyIref) * (Iref - moyIref);
-          covarIc += (Ic - moyIc) * (Ic - moyIc);
-          sIcIref += (Iref - moyIref) * (Ic - moyIc);
+          sums.nbPoints++;
+          sums.sum[0] += Iref;
+          sums.sum[1] += Ic;
         }
       }
+    });
+    const vpTemplatePartialSums &means = reducePartialSums();
+    unsigned int Nbpoint = means.nbPoints;
+    if (Nbpoint > 0) {
+      double moyIref = means.sum[0] / Nbpoint;
+      double moyIc = means.sum[1] / Nbpoint;
+
+      initPartitions(p);
+      parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                                vpTemplateTrackerWarp &warp) {
+        vpTemplatePartialSums &sums = m_partialSums[partition];
+        vpColVector X1_(2), X2_(2);
+        for (unsigned int point = begin; point < end; point++) {
+          int i = ptTemplate[point].y;
+          int j = ptTemplate[point].x;
+          X1_[0] = j;
+          X1_[1] = i;
+
+          warp.computeDenom(X1_, p);
+          warp.warpX(X1_, X2_, p);
+
+          double j2 = X2_[0];
+          double i2 = X2_[1];
+          if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+            double Iref = ptTemplate[point].val;
+            double Ic;
+            if (!blur)
+              Ic = I.getValue(i2, j2);
+            else
+              Ic = BI.getValue(i2, j2);
+
+            double prod = (Ic - moyIc);
+            for (unsigned int it = 0; it < nbParam; it++)
+              sums.G[it] += prod * (ptTemplate[point].dW[it] - moydIrefdp[it]);
+            for (unsigned int it = 0; it < nbParam; it++)
+              sums.G2[it] += (Iref - moyIref) * (ptTemplate[point].dW[it] - moydIrefdp[it]);
+
+            sums.sum[0] += (Iref - moyIref) * (Iref - moyIref);
+            sums.sum[1] += (Ic - moyIc) * (Ic - moyIc);
+            sums.sum[2] += (Iref - moyIref) * (Ic - moyIc);
+          }
+        }
+      });
+      const vpTemplatePartialSums &sums = reducePartialSums();
+      vpColVector sIcdIref = sums.G;
+      vpColVector sIrefdIref = sums.G2;
+      double covarIref = sums.sum[0];
+      double covarIc = sums.sum[1];
+      double sIcIref = sums.sum[2];
       covarIref = sqrt(covarIref);
       covarIc = sqrt(covarIc);
       double denom = covarIref * covarIc;
@@ -109,6 +109,10 @@ protected:
   std::vector<std::vector<double> > m_d2v;
   std::vector<std::vector<double> > m_dA;
 
+  // Histograms filled by the partitions 1 to m_nbPartitions-1 of the template points, the first partition filling
+  // the histograms of the tracker
+  std::vector<std::vector<double> > m_partitionHistograms;
+
 protected:
   void computeGradient();
   void computeHessien(vpMatrix &H);
@@ -121,6 +125,11 @@ protected:
   double getNormalizedCost(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getNormalizedCost(const vpImage<unsigned char> &I) { return getNormalizedCost(I, p); }
   void zeroProbabilities();
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  double *getPartitionHistogram(unsigned int partition, double *histogram, unsigned int offset = 0);
+  void initPartitionHistograms(unsigned int size);
+  void reducePartitionHistograms(double *histogram, unsigned int size, unsigned int offset = 0);
+#endif
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -154,7 +163,7 @@ public:
     Prt(nullptr), dPrt(nullptr), Pt(nullptr), Pr(nullptr), d2Prt(nullptr), PrtTout(nullptr), dprtemp(nullptr), PrtD(nullptr), dPrtD(nullptr),
     influBspline(0), bspline(0), Nc(0), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
     NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false), m_du(), m_dv(), m_A(),
-    m_dB(), m_d2u(), m_d2v(), m_dA()
+    m_dB(), m_d2u(), m_d2v(), m_dA(), m_partitionHistograms()
   { }
   VP_EXPLICIT vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp);
   virtual ~vpTemplateTrackerMI() VP_OVERRIDE;
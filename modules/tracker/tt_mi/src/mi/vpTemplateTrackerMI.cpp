@@ -148,7 +148,6 @@ double vpTemplateTrackerMI::getCost(const vpImage<unsigned char> &I, const vpCol
 {
   double MI = 0;
   int Nbpoint = 0;
-  double IW;
 
   unsigned int Ncb_ = static_cast<unsigned int>(Ncb);
   unsigned int Nc_ = static_cast<unsigned int>(Nc);
@@ -157,38 +156,47 @@ double vpTemplateTrackerMI::getCost(const vpImage<unsigned char> &I, const vpCol
   memset(Prt, 0, Ncb_ * Ncb_ * sizeof(double));
   memset(PrtD, 0, Nc_ * Nc_ * influBspline_ * sizeof(double));
 
-  Warp->computeCoeff(tp);
-  for (unsigned int point = 0; point < templateSize; point++) {
-    X1[0] = ptTemplate[point].x;
-    X1[1] = ptTemplate[point].y;
-
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-    double j2 = X2[0];
-    double i2 = X2[1];
-
-    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-      Nbpoint++;
-
-      double Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-
-      double Nc_1 = (Nc - 1.) / 255.;
-      double IW_Nc = IW * Nc_1;
-      double Tij_Nc = Tij * Nc_1;
-      int cr = static_cast<int>(IW_Nc);
-      int ct = static_cast<int>(Tij_Nc);
-      double er = IW_Nc - cr;
-      double et = Tij_Nc - ct;
-
-      // Calcul de l'histogramme joint par interpolation bilineaire
-      // (Bspline ordre 1)
-      vpTemplateTrackerMIBSpline::PutPVBsplineD(PrtD, cr, er, ct, et, Nc, 1., bspline);
+  initPartitions(tp);
+  initPartitionHistograms(Nc_ * Nc_ * influBspline_);
+  parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end, vpTemplateTrackerWarp &warp) {
+    unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+    double *histogram = getPartitionHistogram(partition, PrtD);
+    vpColVector X1_(2), X2_(2);
+    for (unsigned int point = begin; point < end; point++) {
+      X1_[0] = ptTemplate[point].x;
+      X1_[1] = ptTemplate[point].y;
+
+      warp.computeDenom(X1_, tp);
+      warp.warpX(X1_, X2_, tp);
+      double j2 = X2_[0];
+      double i2 = X2_[1];
+
+      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+        nbPoints++;
+
+        double Tij = ptTemplate[point].val;
+        double IW;
+        if (!blur)
+          IW = I.getValue(i2, j2);
+        else
+          IW = BI.getValue(i2, j2);
+
+        double Nc_1 = (Nc - 1.) / 255.;
+        double IW_Nc = IW * Nc_1;
+        double Tij_Nc = Tij * Nc_1;
+        int cr = static_cast<int>(IW_Nc);
+        int ct = static_cast<int>(Tij_Nc);
+        double er = IW_Nc - cr;
+        double et = Tij_Nc - ct;
+
+        // Calcul de l'histogramme joint par interpolation bilineaire
+        // (Bspline ordre 1)
+        vpTemplateTrackerMIBSpline::PutPVBsplineD(histogram, cr, er, ct, et, Nc, 1., bspline);
+      }
     }
-  }
+  });
+  Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+  reducePartitionHistograms(PrtD, Nc_ * Nc_ * influBspline_);
 
   ratioPixelIn = static_cast<double>(Nbpoint) / static_cast<double>(templateSize);
 
@@ -586,6 +594,58 @@ void vpTemplateTrackerMI::zeroProbabilities()
   memset(PrtTout, 0, Nc_ * Nc_ * influBspline_ * (1 + nbParam + nbParam * nbParam) * sizeof(double));
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Allocate and reset the histograms of the partitions of the template points defined by the last call to
+  initPartitions(), except the first one that fills the histograms of the tracker.
+
+  \param size : Number of bins of the histograms.
+*/
+void vpTemplateTrackerMI::initPartitionHistograms(unsigned int size)
+{
+  if (m_partitionHistograms.size() + 1 < m_nbPartitions) {
+    m_partitionHistograms.resize(m_nbPartitions - 1);
+  }
+  for (unsigned int k = 1; k < m_nbPartitions; ++k) {
+    m_partitionHistograms[k - 1].assign(size, 0.);
+  }
+}
+
+/*!
+  Get the histogram filled by a partition of the template points.
+
+  \param partition : Index of the partition.
+  \param histogram : Histogram of the tracker, filled by the first partition.
+  \param offset : Offset of the histogram in the bins of the partitions allocated by initPartitionHistograms(), when
+  several histograms are filled at the same time.
+  \return The histogram to fill.
+*/
+double *vpTemplateTrackerMI::getPartitionHistogram(unsigned int partition, double *histogram, unsigned int offset)
+{
+  if (partition == 0) {
+    return histogram;
+  }
+  return m_partitionHistograms[partition - 1].data() + offset;
+}
+
+/*!
+  Add the histograms of the partitions to the histogram of the tracker, in the order of the partitions.
+
+  \param histogram : Histogram of the tracker, filled by the first partition.
+  \param size : Number of bins of the histogram.
+  \param offset : Offset of the histogram in the bins of the partitions.
+*/
+void vpTemplateTrackerMI::reducePartitionHistograms(double *histogram, unsigned int size, unsigned int offset)
+{
+  for (unsigned int k = 1; k < m_nbPartitions; ++k) {
+    const double *partitionHistogram = m_partitionHistograms[k - 1].data() + offset;
+    for (unsigned int i = 0; i < size; ++i) {
+      histogram[i] += partitionHistogram[i];
+    }
+  }
+}
+#endif
+
 double vpTemplateTrackerMI::getMI(const vpImage<unsigned char> &I, int &nc, const int &bspline_, vpColVector &tp)
 {
   unsigned int tNcb = static_cast<unsigned int>(nc + bspline_);
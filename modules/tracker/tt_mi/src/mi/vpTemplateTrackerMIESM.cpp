@@ -39,10 +39,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 BEGIN_VISP_NAMESPACE
 vpTemplateTrackerMIESM::vpTemplateTrackerMIESM(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), CompoInitialised(false), HDirect(), HInverse(),
@@ -231,24 +227,17 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  int point;
-
   MI_preEstimation = -getCost(I, p);
 
   lambda = lambdaDep;
 
-  double i2, j2;
-  double IW;
-  int cr, ct;
-  double er, et;
-
   vpColVector dpinv(nbParam);
 
   double alpha = 2.;
 
-  int i, j;
   unsigned int iteration = 0;
-  vpColVector tptemp(nbParam);
+  const unsigned int sizePrtTout =
+    static_cast<unsigned int>(Nc * Nc * influBspline) * (1 + nbParam + nbParam * nbParam);
 
   do {
     int Nbpoint = 0;
@@ -258,37 +247,47 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 
     /////////////////////////////////////////////////////////////////////////
     // Inverse
-    Warp->computeCoeff(p);
-    for (point = 0; point < static_cast<int>(templateSize); point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Nbpoint++;
-
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        ct = ptTemplateSupp[point].ct;
-        et = ptTemplateSupp[point].et;
-        cr = static_cast<int>((IW * (Nc - 1)) / 255.);
-        er = (IW * (Nc - 1)) / 255. - cr;
-
-        vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,
-                                                         bspline, ApproxHessian,
-                                                         hessianComputation == USE_HESSIEN_DESIRE);
+    initPartitions(p);
+    initPartitionHistograms(sizePrtTout);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                              vpTemplateTrackerWarp &warp) {
+      unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+      double *histogram = getPartitionHistogram(partition, PrtTout);
+      vpColVector X1_(2), X2_(2);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          nbPoints++;
+
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+
+          int ct = ptTemplateSupp[point].ct;
+          double et = ptTemplateSupp[point].et;
+          int cr = static_cast<int>((IW * (Nc - 1)) / 255.);
+          double er = (IW * (Nc - 1)) / 255. - cr;
+
+          vpTemplateTrackerMIBSpline::computeProbabilities(histogram, cr, er, ct, et, Nc, ptTemplate[point].dW,
+                                                           nbParam, bspline, ApproxHessian,
+                                                           hessianComputation == USE_HESSIEN_DESIRE);
+        }
       }
-    }
+    });
+    Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+    reducePartitionHistograms(PrtTout, sizePrtTout);
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -307,53 +306,59 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
       /////////////////////////////////////////////////////////////////////////
       // DIRECT
 
-      Nbpoint = 0;
       MI = 0;
 
       zeroProbabilities();
 
-      Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-      int nthreads = omp_get_num_procs();
-      // std::cout << "file: " __FILE__ << " line: " << __LINE__ << "
-      // function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-      omp_set_num_threads(nthreads);
-#pragma omp parallel for private(i, j, i2, j2) default(shared)
-#endif
-      for (point = 0; point < static_cast<int>(templateSize); point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-        Warp->computeDenom(X1, p);
-        Warp->warpX(i, j, i2, j2, p);
-        X2[0] = j2;
-        X2[1] = i2;
-
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Nbpoint++;
-
-          if (!blur)
-            IW = I.getValue(i2, j2);
-          else
-            IW = BI.getValue(i2, j2);
-
-          double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-          double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-          ct = static_cast<int>((IW * (Nc - 1)) / 255.);
-          et = (IW * (Nc - 1)) / 255. - ct;
-          cr = ptTemplateSupp[point].ct;
-          er = ptTemplateSupp[point].et;
-          Warp->dWarpCompo(X1, X2, p, ptTemplateCompo[point].dW, dW);
-
-          for (unsigned int it = 0; it < nbParam; it++)
-            tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
-
-          vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, tptemp.data, nbParam, bspline,
-                                                           ApproxHessian, hessianComputation == USE_HESSIEN_DESIRE);
+      initPartitions(p);
+      initPartitionHistograms(sizePrtTout);
+      parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                                vpTemplateTrackerWarp &warp) {
+        unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+        double *histogram = getPartitionHistogram(partition, PrtTout);
+        vpColVector X1_(2), X2_(2);
+        vpMatrix dW_(2, nbParam);
+        vpColVector tptemp(nbParam);
+        for (unsigned int point = begin; point < end; point++) {
+          int i = ptTemplate[point].y;
+          int j = ptTemplate[point].x;
+          X1_[0] = j;
+          X1_[1] = i;
+          double i2, j2;
+          warp.computeDenom(X1_, p);
+          warp.warpX(i, j, i2, j2, p);
+          X2_[0] = j2;
+          X2_[1] = i2;
+
+          if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+            nbPoints++;
+
+            double IW;
+            if (!blur)
+              IW = I.getValue(i2, j2);
+            else
+              IW = BI.getValue(i2, j2);
+
+            double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
+            double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
+
+            int ct = static_cast<int>((IW * (Nc - 1)) / 255.);
+            double et = (IW * (Nc - 1)) / 255. - ct;
+            int cr = ptTemplateSupp[point].ct;
+            double er = ptTemplateSupp[point].et;
+            warp.dWarpCompo(X1_, X2_, p, ptTemplateCompo[point].dW, dW_);
+
+            for (unsigned int it = 0; it < nbParam; it++)
+              tptemp[it] = dW_[0][it] * dx + dW_[1][it] * dy;
+
+            vpTemplateTrackerMIBSpline::computeProbabilities(histogram, cr, er, ct, et, Nc, tptemp.data, nbParam,
+                                                             bspline, ApproxHessian,
+                                                             hessianComputation == USE_HESSIEN_DESIRE);
+          }
         }
-      }
+      });
+      Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+      reducePartitionHistograms(PrtTout, sizePrtTout);
 
       computeProba(Nbpoint);
       computeMI(MI);
@@ -39,10 +39,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 BEGIN_VISP_NAMESPACE
 vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), p_prec(), G_prec(), KQuasiNewton()
@@ -147,6 +143,8 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
   double alpha = 2.;
 
   unsigned int iteration = 0;
+  const unsigned int sizePrtTout =
+    static_cast<unsigned int>(Nc * Nc * influBspline) * (1 + nbParam + nbParam * nbParam);
 
   initPosEvalRMS(p);
   double evolRMS_init = 0;
@@ -156,63 +154,64 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
   do {
     if (iteration % 5 == 0)
       initHessienDesired(I);
-    Nbpoint = 0;
     MIprec = MI;
     MI = 0;
     // erreur=0;
 
     zeroProbabilities();
 
-    Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-    int nthreads = omp_get_num_procs();
-    // std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function:
-    // " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-    omp_set_num_threads(nthreads);
-#pragma omp parallel for default(shared)
-#endif
-    for (int point = 0; point < static_cast<int>(templateSize); point++) {
-      int i = ptTemplate[point].y;
-      int j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      double j2 = X2[0];
-      double i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Nbpoint++;
-        double Tij = ptTemplate[point].val;
-        double IW;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-        double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-        int ct = static_cast<int>((IW * (Nc - 1)) / 255.);
-        int cr = static_cast<int>((Tij * (Nc - 1)) / 255.);
-        double et = (IW * (Nc - 1)) / 255. - ct;
-        double er = (static_cast<double>(Tij) * (Nc - 1)) / 255. - cr;
-
-        Warp->dWarp(X1, X2, p, dW);
-
-        double *tptemp = new double[nbParam];
-        for (unsigned int it = 0; it < nbParam; it++)
-          tptemp[it] = (dW[0][it] * dx + dW[1][it] * dy);
-        if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-        else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+    initPartitions(p);
+    initPartitionHistograms(sizePrtTout);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                              vpTemplateTrackerWarp &warp) {
+      unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+      double *histogram = getPartitionHistogram(partition, PrtTout);
+      vpColVector X1_(2), X2_(2);
+      vpMatrix dW_(2, nbParam);
+      std::vector<double> tptemp(nbParam);
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          nbPoints++;
+          double Tij = ptTemplate[point].val;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+
+          double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
+          double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
+
+          int ct = static_cast<int>((IW * (Nc - 1)) / 255.);
+          int cr = static_cast<int>((Tij * (Nc - 1)) / 255.);
+          double et = (IW * (Nc - 1)) / 255. - ct;
+          double er = (static_cast<double>(Tij) * (Nc - 1)) / 255. - cr;
+
+          warp.dWarp(X1_, X2_, p, dW_);
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            tptemp[it] = (dW_[0][it] * dx + dW_[1][it] * dy);
+          if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+            vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(histogram, cr, er, ct, et, Nc, tptemp.data(), nbParam,
+                                                                bspline);
+          else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+            vpTemplateTrackerMIBSpline::PutTotPVBspline(histogram, cr, er, ct, et, Nc, tptemp.data(), nbParam, bspline);
+        }
       }
-    }
+    });
+    Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+    reducePartitionHistograms(PrtTout, sizePrtTout);
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -160,70 +160,81 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
   initPosEvalRMS(p);
 
-  double i2, j2;
-  double IW;
-  int cr, ct;
-  double er, et;
-  double dx, dy;
-
   vpColVector dpinv(nbParam);
   double alpha = 2.;
 
-  int i, j;
   unsigned int iteration = 0;
+  const unsigned int sizePrtTout =
+    static_cast<unsigned int>(Nc * Nc * influBspline) * (1 + nbParam + nbParam * nbParam);
 
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
 
   do {
-    int Nbpoint = 0;
     MIprec = MI;
     MI = 0;
 
     zeroProbabilities();
 
-    Warp->computeCoeff(p);
-
-    for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-      Warp->warpX(i, j, i2, j2, p);
-      X2[0] = j2;
-      X2[1] = i2;
-
-      Warp->computeDenom(X1, p);
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Nbpoint++;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-        dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-        ct = static_cast<int>((IW * (Nc - 1)) / 255.);
-        et = (static_cast<double>(IW) * (Nc - 1)) / 255. - ct;
-        cr = ptTemplateSupp[point].ct;
-        er = ptTemplateSupp[point].et;
-
-        Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
-
-        double *tptemp = new double[nbParam];
-        for (unsigned int it = 0; it < nbParam; it++)
-          tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
-
-        if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-        else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+    initPartitions(p);
+    initPartitionHistograms(sizePrtTout);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                              vpTemplateTrackerWarp &warp) {
+      unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+      double *histogram = getPartitionHistogram(partition, PrtTout);
+      vpColVector X1_(2), X2_(2);
+      vpMatrix dW_(2, nbParam);
+      std::vector<double> tptemp(nbParam);
+      if (begin > 0) {
+        // warpX() below uses the denominator computed for the previous point. It is computed here for the last point
+        // of the previous partition, as in a sequential loop, so that the result does not depend on the threads.
+        X1_[0] = ptTemplate[begin - 1].x;
+        X1_[1] = ptTemplate[begin - 1].y;
+        warp.computeDenom(X1_, p);
       }
-    }
+      for (unsigned int point = begin; point < end; point++) {
+        int i = ptTemplate[point].y;
+        int j = ptTemplate[point].x;
+        X1_[0] = j;
+        X1_[1] = i;
+        double i2, j2;
+        warp.warpX(i, j, i2, j2, p);
+        X2_[0] = j2;
+        X2_[1] = i2;
+
+        warp.computeDenom(X1_, p);
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+          nbPoints++;
+          double IW;
+          if (!blur)
+            IW = I.getValue(i2, j2);
+          else
+            IW = BI.getValue(i2, j2);
+
+          double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
+          double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
+
+          int ct = static_cast<int>((IW * (Nc - 1)) / 255.);
+          double et = (static_cast<double>(IW) * (Nc - 1)) / 255. - ct;
+          int cr = ptTemplateSupp[point].ct;
+          double er = ptTemplateSupp[point].et;
+
+          warp.dWarpCompo(X1_, X2_, p, ptTemplate[point].dW, dW_);
+
+          for (unsigned int it = 0; it < nbParam; it++)
+            tptemp[it] = dW_[0][it] * dx + dW_[1][it] * dy;
+
+          if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+            vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(histogram, cr, er, ct, et, Nc, tptemp.data(), nbParam,
+                                                                bspline);
+          else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+            vpTemplateTrackerMIBSpline::PutTotPVBspline(histogram, cr, er, ct, et, Nc, tptemp.data(), nbParam, bspline);
+        }
+      }
+    });
+    int Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+    reducePartitionHistograms(PrtTout, sizePrtTout);
     if (Nbpoint == 0) {
       diverge = true;
       MI = 0;
@@ -231,60 +231,75 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
   vpColVector dpinv_test_LMA(nbParam);
   vpColVector p_test_LMA(nbParam);
 
+  const unsigned int sizePrt = static_cast<unsigned int>(Ncb * Ncb);
+  const unsigned int sizedPrt = sizePrt * nbParam;
+  const unsigned int sized2Prt = sizedPrt * nbParam;
+
   do {
-    int Nbpoint = 0;
     MIprec = MI;
     MI = 0;
 
     zeroProbabilities();
 
-    Warp->computeCoeff(p);
-
-    for (int point = 0; point < static_cast<int>(templateSize); point++) {
-      X1[0] = static_cast<double>(ptTemplate[point].x);
-      X1[1] = static_cast<double>(ptTemplate[point].y);
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      double j2 = X2[0];
-      double i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-
-        Nbpoint++;
-        double IW;
-        if (!blur)
-          IW = static_cast<double>(I.getValue(i2, j2));
-        else
-          IW = BI.getValue(i2, j2);
+    initPartitions(p);
+    initPartitionHistograms(sizePrt + sizedPrt + sized2Prt);
+    parallelForPartitions([&](unsigned int partition, unsigned int begin, unsigned int end,
+                              vpTemplateTrackerWarp &warp) {
+      unsigned int &nbPoints = m_partialSums[partition].nbPoints;
+      double *Prt_ = getPartitionHistogram(partition, Prt);
+      double *dPrt_ = getPartitionHistogram(partition, dPrt, sizePrt);
+      double *d2Prt_ = getPartitionHistogram(partition, d2Prt, sizePrt + sizedPrt);
+      vpColVector X1_(2), X2_(2);
+      for (unsigned int point = begin; point < end; point++) {
+        X1_[0] = static_cast<double>(ptTemplate[point].x);
+        X1_[1] = static_cast<double>(ptTemplate[point].y);
+
+        warp.computeDenom(X1_, p);
+        warp.warpX(X1_, X2_, p);
+
+        double j2 = X2_[0];
+        double i2 = X2_[1];
+
+        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+
+          nbPoints++;
+          double IW;
+          if (!blur)
+            IW = static_cast<double>(I.getValue(i2, j2));
+          else
+            IW = BI.getValue(i2, j2);
 
-        int ct = ptTemplateSupp[point].ct;
-        double et = ptTemplateSupp[point].et;
-        double tmp = IW * (static_cast<double>(Nc) - 1.) / 255.;
-        int cr = static_cast<int>(tmp);
-        double er = tmp - static_cast<double>(cr);
+          int ct = ptTemplateSupp[point].ct;
+          double et = ptTemplateSupp[point].et;
+          double tmp = IW * (static_cast<double>(Nc) - 1.) / 255.;
+          int cr = static_cast<int>(tmp);
+          double er = tmp - static_cast<double>(cr);
 
-        if ((ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE) &&
-            (ptTemplateSelect[point] || !useTemplateSelect)) {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                              nbParam, bspline);
-        }
-        else if (ptTemplateSelect[point] || !useTemplateSelect) {
-          if (bspline == 3) {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline3(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                         nbParam);
+          if ((ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE) &&
+              (ptTemplateSelect[point] || !useTemplateSelect)) {
+            vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(Prt_, dPrt_, cr, er, ct, et, Ncb, ptTemplate[point].dW,
+                                                                nbParam, bspline);
+          }
+          else if (ptTemplateSelect[point] || !useTemplateSelect) {
+            if (bspline == 3) {
+              vpTemplateTrackerMIBSpline::PutTotPVBspline3(Prt_, dPrt_, d2Prt_, cr, er, ct, et, Ncb,
+                                                           ptTemplate[point].dW, nbParam);
+            }
+            else {
+              vpTemplateTrackerMIBSpline::PutTotPVBspline4(Prt_, dPrt_, d2Prt_, cr, er, ct, et, Ncb,
+                                                           ptTemplate[point].dW, nbParam);
+            }
           }
           else {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline4(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                         nbParam);
+            vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(Prt_, cr, er, ct, et, Ncb, nbParam, bspline);
           }
         }
-        else {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(Prt, cr, er, ct, et, Ncb, nbParam, bspline);
-        }
       }
-    }
+    });
+    int Nbpoint = static_cast<int>(reducePartialSums().nbPoints);
+    reducePartitionHistograms(Prt, sizePrt);
+    reducePartitionHistograms(dPrt, sizedPrt, sizePrt);
+    reducePartitionHistograms(d2Prt, sized2Prt, sizePrt + sizedPrt);
 
     if (Nbpoint == 0) {
       diverge = true;
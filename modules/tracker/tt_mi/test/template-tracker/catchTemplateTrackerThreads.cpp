@@ -0,0 +1,228 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test that the template trackers give the same results whatever the number of threads.
+ */
+
+/*!
+ * \example catchTemplateTrackerThreads.cpp
+ *
+ * Test that the SSD, ZNCC and MI template trackers estimate exactly the same warp parameters with one thread and
+ * with several threads of vpThreadPool.
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/tt/vpTemplateTrackerSSDESM.h>
+#include <visp3/tt/vpTemplateTrackerSSDForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerSSDForwardCompositional.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt/vpTemplateTrackerZNCCForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerZNCCInverseCompositional.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardCompositional.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIInverseCompositional.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int nbFrames = 3;
+
+// Smooth random texture, warped by a small rotation, scaling and translation at each frame
+class vpSyntheticSequence
+{
+public:
+  vpSyntheticSequence() : m_texture()
+  {
+    vpImage<double> noise(300, 400);
+    unsigned int seed = 12345;
+    for (unsigned int k = 0; k < noise.getSize(); ++k) {
+      seed = (seed * 1103515245u) + 12345u;
+      noise.bitmap[k] = static_cast<double>((seed >> 16) % 256);
+    }
+    vpImageFilter::gaussianBlur(noise, m_texture, 15, 2.5);
+  }
+
+  void getFrame(unsigned int k, vpImage<unsigned char> &I) const
+  {
+    const double a = 0.003 * k, tx = 0.8 * k, ty = -0.6 * k, s = 1. + (0.003 * k);
+    I.resize(240, 320);
+    for (unsigned int i = 0; i < I.getHeight(); ++i) {
+      for (unsigned int j = 0; j < I.getWidth(); ++j) {
+        const double u = static_cast<double>(j) - 160., v = static_cast<double>(i) - 120.;
+        const double u0 = ((((std::cos(a) * u) + (std::sin(a) * v)) / s) - tx) + 200.;
+        const double v0 = ((((-std::sin(a) * u) + (std::cos(a) * v)) / s) - ty) + 150.;
+        const double val = 128. + (3. * (m_texture.getValue(v0, u0) - 128.));
+        I[i][j] = static_cast<unsigned char>(std::max(0., std::min(255., val)));
+      }
+    }
+  }
+
+private:
+  vpImage<double> m_texture;
+};
+
+// Track the sequence and return the warp parameters estimated at each frame
+template <class Tracker, class Warp>
+std::vector<vpColVector> track(const vpSyntheticSequence &sequence, unsigned int nbThreads)
+{
+  vpThreadPool::getInstance().setNbThreads(nbThreads);
+
+  Warp warp;
+  Tracker tracker(&warp);
+  tracker.setSampling(2, 2);
+  tracker.setLambda(0.001);
+  tracker.setIterationMax(10);
+
+  // The template has enough points to be split in several partitions
+  std::vector<vpImagePoint> corners;
+  corners.push_back(vpImagePoint(30, 60));
+  corners.push_back(vpImagePoint(30, 260));
+  corners.push_back(vpImagePoint(210, 260));
+  corners.push_back(vpImagePoint(30, 60));
+  corners.push_back(vpImagePoint(210, 260));
+  corners.push_back(vpImagePoint(210, 60));
+
+  vpImage<unsigned char> I;
+  sequence.getFrame(0, I);
+  tracker.initFromPoints(I, corners, false);
+
+  std::vector<vpColVector> params;
+  for (unsigned int k = 1; k <= nbFrames; ++k) {
+    sequence.getFrame(k, I);
+    tracker.track(I);
+    params.push_back(tracker.getp());
+  }
+  return params;
+}
+
+template <class Tracker, class Warp> void checkSameResults(const vpSyntheticSequence &sequence)
+{
+  const unsigned int nbThreads = vpThreadPool::getInstance().getNbThreads();
+  const std::vector<vpColVector> params1 = track<Tracker, Warp>(sequence, 1);
+  const std::vector<vpColVector> params4 = track<Tracker, Warp>(sequence, 4);
+  vpThreadPool::getInstance().setNbThreads(nbThreads);
+
+  REQUIRE(params1.size() == params4.size());
+  for (size_t k = 0; k < params1.size(); ++k) {
+    REQUIRE(params1[k].size() == params4[k].size());
+    for (unsigned int i = 0; i < params1[k].size(); ++i) {
+      // Bit-identical, not only close
+      CHECK(params1[k][i] == params4[k][i]);
+    }
+  }
+  // The tracked motion is not null, so that the comparison is meaningful
+  CHECK(params1.back().frobeniusNorm() > 1e-3);
+}
+} // namespace
+
+TEST_CASE("SSD template trackers do not depend on the number of threads", "[template_tracker]")
+{
+  const vpSyntheticSequence sequence;
+  SECTION("ESM") { checkSameResults<vpTemplateTrackerSSDESM, vpTemplateTrackerWarpHomographySL3>(sequence); }
+  SECTION("Forward additional")
+  {
+    checkSameResults<vpTemplateTrackerSSDForwardAdditional, vpTemplateTrackerWarpAffine>(sequence);
+  }
+  SECTION("Forward compositional")
+  {
+    checkSameResults<vpTemplateTrackerSSDForwardCompositional, vpTemplateTrackerWarpHomographySL3>(sequence);
+  }
+  SECTION("Inverse compositional")
+  {
+    checkSameResults<vpTemplateTrackerSSDInverseCompositional, vpTemplateTrackerWarpHomography>(sequence);
+  }
+}
+
+TEST_CASE("ZNCC template trackers do not depend on the number of threads", "[template_tracker]")
+{
+  const vpSyntheticSequence sequence;
+  SECTION("Forward additional")
+  {
+    checkSameResults<vpTemplateTrackerZNCCForwardAdditional, vpTemplateTrackerWarpHomography>(sequence);
+  }
+  SECTION("Inverse compositional")
+  {
+    checkSameResults<vpTemplateTrackerZNCCInverseCompositional, vpTemplateTrackerWarpHomography>(sequence);
+  }
+}
+
+TEST_CASE("MI template trackers do not depend on the number of threads", "[template_tracker]")
+{
+  const vpSyntheticSequence sequence;
+  SECTION("ESM") { checkSameResults<vpTemplateTrackerMIESM, vpTemplateTrackerWarpHomographySL3>(sequence); }
+  SECTION("Forward additional")
+  {
+    checkSameResults<vpTemplateTrackerMIForwardAdditional, vpTemplateTrackerWarpAffine>(sequence);
+  }
+  SECTION("Forward compositional")
+  {
+    checkSameResults<vpTemplateTrackerMIForwardCompositional, vpTemplateTrackerWarpHomographySL3>(sequence);
+  }
+  SECTION("Inverse compositional")
+  {
+    checkSameResults<vpTemplateTrackerMIInverseCompositional, vpTemplateTrackerWarpHomography>(sequence);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
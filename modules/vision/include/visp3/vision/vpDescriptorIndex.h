@@ -0,0 +1,204 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Approximate nearest neighbour index of keypoint descriptors.
+ */
+
+/*!
+ * \file vpDescriptorIndex.h
+ * \brief Approximate nearest neighbour index of keypoint descriptors.
+ */
+
+#ifndef VP_DESCRIPTOR_INDEX_H
+#define VP_DESCRIPTOR_INDEX_H
+
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpDescriptorIndex
+ * \ingroup group_vision_keypoints
+ *
+ * \brief Approximate nearest neighbour index of a set of keypoint descriptors, that can be saved with the
+ * descriptors and used in place from a memory-mapped file.
+ *
+ * Two kinds of index are available:
+ * - a multi-probe locality sensitive hashing (LSH) index for binary descriptors (ORB, BRISK, AKAZE...), built with
+ *   buildLsh(). Each of the hash tables groups the descriptors by the values of a random subset of their bits. A
+ *   query is compared, with the Hamming distance, to the descriptors of the buckets whose key differs from its own
+ *   key by at most the multi-probe level bits.
+ * - a forest of randomized k-d trees for floating point descriptors (SIFT, SURF, KAZE...), built with
+ *   buildKdForest(). The trees are explored together in best bin first order until getMaxChecks() descriptors
+ *   have been compared to the query, with the euclidean distance.
+ *
+ * These are the indexes built by the FLANN based matcher of OpenCV, with the same default parameters. The index
+ * does not copy the descriptors: they must stay unchanged in memory as long as the index is used. The searches of
+ * several queries run in parallel on the threads of vpThreadPool::getInstance().
+ *
+ * The index is serialized by save() in a little-endian format made of 32-bit words. load() uses the serialized
+ * arrays in place when the buffer is aligned on 4 bytes, so that an index stored in a file opened with
+ * vpMemoryMappedFile is available without being built nor copied.
+ *
+ * \code
+ * #include <visp3/vision/vpDescriptorIndex.h>
+ *
+ * #ifdef ENABLE_VISP_NAMESPACE
+ * using namespace VISP_NAMESPACE_NAME;
+ * #endif
+ *
+ * int main()
+ * {
+ *   // 1000 ORB descriptors of 32 bytes
+ *   std::vector<unsigned char> train(1000 * 32), query(10 * 32);
+ *   // ...
+ *   vpDescriptorIndex index;
+ *   index.buildLsh(&train[0], 1000, 32);
+ *
+ *   // Two nearest neighbours of each query descriptor
+ *   std::vector<int> indices;
+ *   std::vector<float> distances;
+ *   index.knnSearch(&query[0], 10, 2, indices, distances);
+ * }
+ * \endcode
+ *
+ * \sa vpKeyPoint::saveLearningDatabase()
+ */
+class VISP_EXPORT vpDescriptorIndex
+{
+public:
+  //! Kind of index
+  typedef enum
+  {
+    INDEX_NONE, //!< No index has been built or loaded
+    INDEX_LSH, //!< Multi-probe LSH index of binary descriptors
+    INDEX_KD_FOREST //!< Forest of randomized k-d trees of floating point descriptors
+  } vpIndexType;
+
+  vpDescriptorIndex();
+  vpDescriptorIndex(const vpDescriptorIndex &index);
+
+  void buildKdForest(const float *descriptors, unsigned int nbDescriptors, unsigned int dimension);
+  void buildLsh(const unsigned char *descriptors, unsigned int nbDescriptors, unsigned int descriptorSize);
+
+  void clear();
+
+  /*!
+   * Return the size of the indexed descriptors: their number of bytes for a LSH index, their number of floats
+   * for a k-d forest.
+   */
+  unsigned int getDescriptorSize() const { return m_descriptorSize; }
+  //! Return the number of random bits of the keys of the LSH hash tables.
+  unsigned int getLshKeySize() const { return m_lshKeySize; }
+  //! Return the maximum number of bits that differ between the key of a query and a probed bucket.
+  unsigned int getLshMultiProbeLevel() const { return m_lshMultiProbeLevel; }
+  //! Return the number of hash tables of the LSH index.
+  unsigned int getLshNbTables() const { return m_lshNbTables; }
+  //! Return the maximum number of descriptors of a leaf of the k-d trees.
+  unsigned int getKdLeafSize() const { return m_kdLeafSize; }
+  //! Return the number of randomized trees of the k-d forest.
+  unsigned int getKdNbTrees() const { return m_kdNbTrees; }
+  //! Return the number of descriptors compared to a query in a k-d forest before the search stops.
+  unsigned int getMaxChecks() const { return m_maxChecks; }
+  //! Return the number of indexed descriptors.
+  unsigned int getNbDescriptors() const { return m_nbDescriptors; }
+  //! Return the kind of index that has been built or loaded.
+  vpIndexType getType() const { return m_type; }
+
+  void knnSearch(const float *queries, unsigned int nbQueries, unsigned int k, std::vector<int> &indices,
+                 std::vector<float> &distances) const;
+  void knnSearch(const unsigned char *queries, unsigned int nbQueries, unsigned int k, std::vector<int> &indices,
+                 std::vector<float> &distances) const;
+
+  size_t load(const unsigned char *buffer, size_t size, const void *descriptors);
+  void save(std::ostream &os) const;
+
+  vpDescriptorIndex &operator=(const vpDescriptorIndex &index);
+
+  void setKdForestParameters(unsigned int nbTrees, unsigned int leafSize = 4);
+  void setLshParameters(unsigned int nbTables, unsigned int keySize, unsigned int multiProbeLevel);
+  void setMaxChecks(unsigned int maxChecks);
+  /*!
+   * Set the seed of the random generator used to draw the bits of the LSH keys and the split dimensions of the
+   * k-d trees, to build reproducible indexes.
+   */
+  void setSeed(uint64_t seed) { m_seed = seed; }
+
+private:
+  void checkContents() const;
+  void initPointers();
+  void initProbeMasks();
+
+  vpIndexType m_type;
+  unsigned int m_nbDescriptors;
+  unsigned int m_descriptorSize;
+  const unsigned char *m_binaryDescriptors; //!< Indexed binary descriptors, not owned
+  const float *m_floatDescriptors; //!< Indexed floating point descriptors, not owned
+
+  unsigned int m_lshNbTables;
+  unsigned int m_lshKeySize;
+  unsigned int m_lshMultiProbeLevel;
+  unsigned int m_kdNbTrees;
+  unsigned int m_kdLeafSize;
+  unsigned int m_maxChecks;
+  uint64_t m_seed;
+
+  //! Arrays of the index, built or copied from a buffer
+  std::vector<uint32_t> m_ownedData;
+  //! Arrays of the index: m_ownedData, or the buffer given to load()
+  const uint32_t *m_data;
+  size_t m_dataSize;
+
+  //! Arrays of a LSH hash table, in m_data
+  struct vpLshTable
+  {
+    const uint32_t *bits; //!< Positions of the bits of the key in the descriptors
+    uint32_t nbBuckets;
+    const uint32_t *keys; //!< Sorted keys of the buckets
+    const uint32_t *offsets; //!< Position in ids of the first descriptor of each bucket
+    const uint32_t *ids; //!< Descriptors, sorted by key
+  };
+  //! Arrays of a k-d tree, in m_data
+  struct vpKdTree
+  {
+    uint32_t nbNodes;
+    const uint32_t *nodes; //!< Split dimension, split value, left and right children (or first and last descriptors)
+    const uint32_t *ids; //!< Descriptors, in the order of the leaves
+  };
+  std::vector<vpLshTable> m_lshTables;
+  std::vector<vpKdTree> m_kdTrees;
+  std::vector<uint32_t> m_probeMasks; //!< Differences with the key of a query of the probed buckets
+};
+END_VISP_NAMESPACE
+
+#endif
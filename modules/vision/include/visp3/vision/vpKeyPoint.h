@@ -44,6 +44,7 @@
 #include <fstream>   // std::ofstream
 #include <limits>
 #include <map>      // std::map
+#include <memory>   // std::shared_ptr
 #include <numeric>  // std::accumulate
 #include <stdlib.h> // srand, rand
 #include <time.h>   // time
@@ -51,10 +52,12 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpMemoryMappedFile.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpDescriptorIndex.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #include <visp3/io/vpImageIo.h>
@@ -1075,6 +1078,12 @@ public:
     return m_covarianceMatrix;
   }
 
+  /*!
+   * Get the index of the train descriptors used for the matching when setUseDescriptorIndex() is enabled. It is
+   * built at the first matching after the train descriptors have changed, or loaded by loadLearningDatabase().
+   */
+  inline const vpDescriptorIndex &getDescriptorIndex() const { return m_descriptorIndex; }
+
   /*!
    * Get the elapsed time to compute the keypoint detection.
    *
@@ -1405,6 +1414,14 @@ public:
    */
   void loadLearningData(const std::string &filename, bool binaryMode = false, bool append = false);
 
+  /*!
+   * Load a learning database saved with saveLearningDatabase(). The file is mapped in memory and the train
+   * descriptors and their index are used in place, without being read nor built.
+   *
+   * \param filename : Path of the learning database.
+   */
+  void loadLearningDatabase(const std::string &filename);
+
   /*!
    * Match keypoints based on distance between their descriptors.
    *
@@ -1621,6 +1638,14 @@ public:
    */
   void saveLearningData(const std::string &filename, bool binaryMode = false, bool saveTrainingImages = true);
 
+  /*!
+   * Save the train keypoints, their 3D points, their descriptors and the index of the descriptors in a binary file
+   * that can be loaded in place with loadLearningDatabase(). The training images are not saved.
+   *
+   * \param filename : Path of the save file.
+   */
+  void saveLearningDatabase(const std::string &filename);
+
   /*!
    * Set if the covariance matrix has to be computed in the Virtual Visual
    * Servoing approach.
@@ -1927,6 +1952,14 @@ public:
    */
   inline void setRansacParallelNbThreads(unsigned int nthreads) { m_ransacParallelNbThreads = nthreads; }
 
+  /*!
+   * Use or not the PROSAC sampling in the Ransac pose estimation. The matches are then ranked by the distance
+   * between their descriptors, and the Ransac samples are first drawn among the best matches.
+   *
+   * \sa vpPose::setRansacScores()
+   */
+  inline void setRansacProsac(bool prosac) { m_ransacProsac = prosac; }
+
   /*!
    * Set the maximum reprojection error (in pixel) to determine if a point is
    * an inlier or not.
@@ -2008,6 +2041,17 @@ public:
   }
 #endif
 
+  /*!
+   * Set if the query descriptors are matched to the train descriptors with a vpDescriptorIndex instead of the
+   * OpenCV matcher: a LSH index for binary descriptors, a k-d forest for floating point descriptors. The matches
+   * are approximate. The index is not used when the train keypoints are matched to the query keypoints.
+   *
+   * \param useDescriptorIndex : True to use the descriptor index.
+   *
+   * \sa saveLearningDatabase(), loadLearningDatabase()
+   */
+  inline void setUseDescriptorIndex(bool useDescriptorIndex) { m_useDescriptorIndex = useDescriptorIndex; }
+
   /*!
    * Set if we want to match the train keypoints to the query keypoints.
    *
@@ -2050,6 +2094,10 @@ private:
   vpMatrix m_covarianceMatrix;
   //! Current id associated to the training image used for the learning.
   int m_currentImageId;
+  //! Learning database mapped in memory, referred by the train descriptors and their index
+  std::shared_ptr<vpMemoryMappedFile> m_databaseFile;
+  //! Index of the train descriptors
+  vpDescriptorIndex m_descriptorIndex;
   //! Method (based on descriptor distances) to decide if the object is
   //! present or not.
   vpDetectionMethodType m_detectionMethod;
@@ -2137,6 +2185,10 @@ private:
   bool m_ransacParallel;
   //! Number of threads (if 0, try to determine the number of CPU threads)
   unsigned int m_ransacParallelNbThreads;
+  //! If true, use the PROSAC sampling with the matching distances as scores
+  bool m_ransacProsac;
+  //! Scores of the points given to computePose() for the PROSAC sampling
+  std::vector<double> m_ransacScores;
   //! Maximum reprojection error (in pixel for the OpenCV method) to decide if
   //! a point is an inlier or not.
   double m_ransacReprojectionError;
@@ -2167,6 +2219,8 @@ private:
   //! Flag set if a percentage value is used to determine the number of
   //! inliers for the Ransac method.
   bool m_useConsensusPercentage;
+  //! Flag set if the query descriptors are matched with m_descriptorIndex
+  bool m_useDescriptorIndex;
   //! Flag set if a knn matching method must be used.
   bool m_useKnn;
   //! Flag set if we want to match the train keypoints to the query keypoints,
@@ -2257,6 +2311,14 @@ private:
    */
   void initFeatureNames();
 
+  /*!
+   * Match the query descriptors to the train descriptors with the descriptor index, that is built if needed.
+   *
+   * \param[in] queryDescriptors : Query descriptors.
+   * \param[out] matches : Output list of matches.
+   */
+  void matchDescriptorIndex(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches);
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp)
   {
     size_t _val = 2166136261U, scale = 16777619U;
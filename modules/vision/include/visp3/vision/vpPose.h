@@ -410,6 +410,64 @@ public:
    */
   void setRansacMaxTrials(const int &rM) { ransacMaxTrials = rM; }
 
+  /*!
+   * Set the probability used to adapt the number of Ransac trials to the inlier ratio.
+   *
+   * Each time a larger consensus set is found, the number of trials is reduced to the one given by
+   * computeRansacIterations() for the current inlier ratio, so that at least one sample free from outliers is drawn
+   * with the given probability. The number of trials never exceeds the one set with setRansacMaxTrials(). With the
+   * parallel version, the threads share the trial counter and the best consensus set, so that they all stop once the
+   * number of trials is reached.
+   *
+   * \param probability : Probability in [0, 1[, typically 0.99. The default value 0 disables the adaptive number
+   * of trials.
+   */
+  void setRansacProbability(double probability)
+  {
+    if ((probability < 0.) || (probability >= 1.)) {
+      throw vpException(vpException::badValue, "The Ransac probability must be in [0, 1[.");
+    }
+    ransacProbability = probability;
+  }
+
+  /*!
+   * Get the probability used to adapt the number of Ransac trials, 0 if the number of trials is not adapted.
+   *
+   * \sa setRansacProbability()
+   */
+  double getRansacProbability() const { return ransacProbability; }
+
+  /*!
+   * Enable the local optimization step of the Ransac (LO-RANSAC). Each time a sample gives a larger consensus set,
+   * the pose is refined by virtual visual servoing on this consensus set and the inliers are counted again with the
+   * refined pose, as long as their number increases. This gives a larger consensus set earlier, which also lowers
+   * the number of trials when setRansacProbability() is used.
+   *
+   * \param localOptimization : True to enable the local optimization, false by default.
+   */
+  void setRansacLocalOptimization(bool localOptimization) { ransacLocalOptimization = localOptimization; }
+
+  /*!
+   * Return true if the local optimization step of the Ransac is enabled.
+   *
+   * \sa setRansacLocalOptimization()
+   */
+  bool getRansacLocalOptimization() const { return ransacLocalOptimization; }
+
+  /*!
+   * Set the quality scores of the points to use the PROSAC sampling in the Ransac.
+   *
+   * The samples are first drawn among the points with the highest scores, then progressively among all the points,
+   * so that a good model is found in a few trials when the scores are correlated with the correctness of the
+   * matches, e.g. the opposite of the distance between the matched descriptors.
+   *
+   * \param scores : Scores of the points, in the same order as the points added with addPoint(), the higher the
+   * better. An empty vector, the default, gives the uniform sampling.
+   *
+   * \note The number of scores must be equal to the number of points when the pose is computed.
+   */
+  void setRansacScores(const std::vector<double> &scores) { ransacScores = scores; }
+
   /*!
    * Get the number of inliers.
    */
@@ -474,8 +532,8 @@ public:
    * Set the number of threads for the parallel RANSAC implementation.
    *
    * \note You have to enable the parallel version with setUseParallelRansac().
-   * If the number of threads is 0, the number of threads to use is
-   * automatically determined with C++11.
+   * If the number of threads is 0, the number of threads of the shared
+   * vpThreadPool::getInstance() pool is used.
    * \sa setUseParallelRansac
    */
   inline void setNbParallelRansacThreads(int nb) { nbParallelRansacThreads = nb; }
@@ -825,10 +883,21 @@ private:
   bool useParallelRansac;
   //! Number of threads to spawn for the parallel RANSAC implementation
   int nbParallelRansacThreads;
+  //! Probability used to adapt the number of RANSAC trials, 0 to disable
+  double ransacProbability;
+  //! If true, refine the pose on each new best consensus set (LO-RANSAC)
+  bool ransacLocalOptimization;
+  //! Scores of the points for the PROSAC sampling, uniform sampling if empty
+  std::vector<double> ransacScores;
   //! Stop the optimization loop when the residual change (|r-r_prec|) <=
   //! epsilon
   double vvsEpsilon;
 
+  /*!
+   * State of a RANSAC shared by the threads: trial counter, best consensus set and parameters.
+   */
+  struct vpRansacSharedState;
+
   /*!
    * Class dedicated to parallelize RANSAC.
    */
@@ -838,58 +907,39 @@ private:
     /*!
      * Constructor.
      */
-    vpRansacFunctor(const vpHomogeneousMatrix &cMo_, unsigned int ransacNbInlierConsensus_, const int ransacMaxTrials_,
-      double ransacThreshold_, unsigned int initial_seed_, bool checkDegeneratePoints_,
-      const std::vector<vpPoint> &listOfUniquePoints_, FuncCheckValidityPose func_)
-      : m_best_consensus(), m_checkDegeneratePoints(checkDegeneratePoints_), m_cMo(cMo_), m_foundSolution(false),
-      m_func(func_), m_listOfUniquePoints(listOfUniquePoints_), m_nbInliers(0), m_ransacMaxTrials(ransacMaxTrials_),
-      m_ransacNbInlierConsensus(ransacNbInlierConsensus_), m_ransacThreshold(ransacThreshold_),
-      m_uniRand(initial_seed_)
+    vpRansacFunctor(unsigned int initial_seed_, bool checkDegeneratePoints_,
+      const std::vector<vpPoint> &listOfUniquePoints_, FuncCheckValidityPose func_, vpRansacSharedState *shared_)
+      : m_checkDegeneratePoints(checkDegeneratePoints_), m_func(func_), m_listOfUniquePoints(&listOfUniquePoints_),
+      m_shared(shared_), m_uniRand(initial_seed_)
     { }
 
     /*!
      * Operator() that calls Ransac.
      */
-    void operator()() { m_foundSolution = poseRansacImpl(); }
+    void operator()() { poseRansacImpl(); }
 
-    /*!
-     * Access the return value.
-     */
-    bool getResult() const { return m_foundSolution; }
-
-    /*!
-     * Get Ransac best consensus.
-     */
-    std::vector<unsigned int> getBestConsensus() const { return m_best_consensus; }
+  private:
+    bool m_checkDegeneratePoints; //!< Flag to check for degenerate points
+    FuncCheckValidityPose m_func; //!< Pointer to ransac function
+    const std::vector<vpPoint> *m_listOfUniquePoints; //!< List of unique points, shared by the threads
+    vpRansacSharedState *m_shared; //!< Trial counter and best consensus set, shared by the threads
+    vpUniRand m_uniRand; //!< Uniform random generator
 
     /*!
-     * Get Ransac estimated pose.
+     * Count the points whose reprojection error with the pose \e cMo is below the Ransac threshold.
      */
-    vpHomogeneousMatrix getEstimatedPose() const { return m_cMo; }
+    unsigned int computeConsensus(const vpHomogeneousMatrix &cMo, std::vector<unsigned int> &consensus) const;
 
     /*!
-     * Get Ransac number of inliers.
+     * Pick a minimal sample for the trial \e trial.
+     * \return false if a non degenerate sample cannot be found.
      */
-    unsigned int getNbInliers() const { return m_nbInliers; }
-
-  private:
-    std::vector<unsigned int> m_best_consensus; //!< Best consensus
-    bool m_checkDegeneratePoints; //!< Flag to check for degenerate points
-    vpHomogeneousMatrix m_cMo; //!< Estimated pose
-    bool m_foundSolution; //!< Solution found
-    FuncCheckValidityPose m_func; //!< Pointer to ransac function
-    std::vector<vpPoint> m_listOfUniquePoints; //!< List of unique points
-    unsigned int m_nbInliers; //!< Number of inliers
-    int m_ransacMaxTrials; //!< Ransac max trial number
-    unsigned int m_ransacNbInlierConsensus; //!< Number of inliers to check for a consensus
-    double m_ransacThreshold; //!< Residual threshold
-    vpUniRand m_uniRand; //!< Uniform random generator
+    bool pickSample(int trial, vpPose &poseMin);
 
     /*!
-     * Ransac implementation.
-     * \return true when a solution is found.
+     * Ransac implementation, runs trials until the shared number of trials is reached.
      */
-    bool poseRansacImpl();
+    void poseRansacImpl();
   };
 };
 
@@ -0,0 +1,876 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Approximate nearest neighbour index of keypoint descriptors.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <queue>
+
+#include <visp3/core/vpEndian.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpDescriptorIndex.h>
+
+BEGIN_VISP_NAMESPACE
+namespace
+{
+const uint32_t indexMagic = 0x49445056; // "VPDI"
+const uint32_t indexVersion = 1;
+const unsigned int headerWords = 10;
+const uint32_t leafNode = std::numeric_limits<uint32_t>::max();
+
+inline unsigned int popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned int>(__builtin_popcountll(x));
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<unsigned int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline unsigned int hammingDistance(const unsigned char *a, const unsigned char *b, unsigned int size)
+{
+  unsigned int dist = 0;
+  unsigned int i = 0;
+  for (; (i + 8) <= size; i += 8) {
+    uint64_t x, y;
+    memcpy(&x, a + i, sizeof(x));
+    memcpy(&y, b + i, sizeof(y));
+    dist += popcount64(x ^ y);
+  }
+  for (; i < size; ++i) {
+    dist += popcount64(static_cast<uint64_t>(a[i] ^ b[i]));
+  }
+  return dist;
+}
+
+inline float squaredDistance(const float *a, const float *b, unsigned int size)
+{
+  float dist = 0.f;
+  for (unsigned int i = 0; i < size; ++i) {
+    const float d = a[i] - b[i];
+    dist += d * d;
+  }
+  return dist;
+}
+
+inline float wordToFloat(uint32_t word)
+{
+  float value;
+  memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+inline uint32_t floatToWord(float value)
+{
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+// Write 32-bit words in little-endian
+void writeWords(std::ostream &os, const uint32_t *words, size_t nbWords)
+{
+#ifdef VISP_BIG_ENDIAN
+  for (size_t i = 0; i < nbWords; ++i) {
+    const uint32_t word = vpEndian::swap32bits(words[i]);
+    os.write(reinterpret_cast<const char *>(&word), sizeof(word));
+  }
+#else
+  os.write(reinterpret_cast<const char *>(words), static_cast<std::streamsize>(nbWords * sizeof(uint32_t)));
+#endif
+}
+
+inline uint32_t computeLshKey(const unsigned char *descriptor, const uint32_t *bits, unsigned int keySize)
+{
+  uint32_t key = 0;
+  for (unsigned int b = 0; b < keySize; ++b) {
+    const uint32_t pos = bits[b];
+    key |= static_cast<uint32_t>((descriptor[pos >> 3] >> (pos & 7)) & 1) << b;
+  }
+  return key;
+}
+
+// The k nearest neighbours found so far, sorted by increasing distance
+class vpKnnResult
+{
+public:
+  explicit vpKnnResult(unsigned int k) : m_k(k), m_size(0), m_indices(k, -1), m_distances(k, 0.f) { }
+
+  void add(int index, float distance)
+  {
+    if ((m_size == m_k) && (distance >= m_distances[m_k - 1])) {
+      return;
+    }
+    unsigned int pos = (m_size < m_k) ? m_size++ : (m_k - 1);
+    while ((pos > 0) && (m_distances[pos - 1] > distance)) {
+      m_distances[pos] = m_distances[pos - 1];
+      m_indices[pos] = m_indices[pos - 1];
+      --pos;
+    }
+    m_distances[pos] = distance;
+    m_indices[pos] = index;
+  }
+
+  bool full() const { return m_size == m_k; }
+  float worstDistance() const { return full() ? m_distances[m_k - 1] : std::numeric_limits<float>::max(); }
+
+  void clear() { m_size = 0; }
+
+  void copyTo(int *indices, float *distances, bool squared) const
+  {
+    for (unsigned int i = 0; i < m_k; ++i) {
+      if (i < m_size) {
+        indices[i] = m_indices[i];
+        distances[i] = squared ? std::sqrt(m_distances[i]) : m_distances[i];
+      }
+      else {
+        indices[i] = -1;
+        distances[i] = std::numeric_limits<float>::max();
+      }
+    }
+  }
+
+private:
+  unsigned int m_k;
+  unsigned int m_size;
+  std::vector<int> m_indices;
+  std::vector<float> m_distances;
+};
+
+// Branch of a k-d tree not explored yet, with a lower bound of the distance between the query and its descriptors
+struct vpKdBranch
+{
+  float minDist;
+  unsigned int tree;
+  uint32_t node;
+
+  vpKdBranch(float d, unsigned int t, uint32_t n) : minDist(d), tree(t), node(n) { }
+  bool operator<(const vpKdBranch &other) const { return minDist > other.minDist; }
+};
+
+void buildKdNode(const float *descriptors, unsigned int dimension, unsigned int leafSize, uint32_t *ids,
+                 unsigned int begin, unsigned int end, vpUniRand &rng, std::vector<uint32_t> &nodes,
+                 std::vector<double> &mean, std::vector<double> &var, std::vector<unsigned int> &dims)
+{
+  const size_t node = nodes.size() / 4;
+  nodes.resize(nodes.size() + 4);
+  const unsigned int count = end - begin;
+  if (count <= leafSize) {
+    nodes[4 * node] = leafNode;
+    nodes[(4 * node) + 1] = begin;
+    nodes[(4 * node) + 2] = end;
+    nodes[(4 * node) + 3] = 0;
+    return;
+  }
+
+  // Split dimension drawn among the ones with the highest variance, estimated on the first descriptors
+  const unsigned int nbSamples = std::min(count, 100u);
+  std::fill(mean.begin(), mean.end(), 0.);
+  std::fill(var.begin(), var.end(), 0.);
+  for (unsigned int n = 0; n < nbSamples; ++n) {
+    const float *d = descriptors + (static_cast<size_t>(ids[begin + n]) * dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+      mean[i] += d[i];
+    }
+  }
+  for (unsigned int i = 0; i < dimension; ++i) {
+    mean[i] /= nbSamples;
+  }
+  for (unsigned int n = 0; n < nbSamples; ++n) {
+    const float *d = descriptors + (static_cast<size_t>(ids[begin + n]) * dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+      const double diff = d[i] - mean[i];
+      var[i] += diff * diff;
+    }
+  }
+  for (unsigned int i = 0; i < dimension; ++i) {
+    dims[i] = i;
+  }
+  const unsigned int nbCandidates = std::min(dimension, 5u);
+  std::partial_sort(dims.begin(), dims.begin() + nbCandidates, dims.end(),
+                    [&var](unsigned int a, unsigned int b) { return var[a] > var[b]; });
+  const unsigned int dim = dims[rng.uniform(0, static_cast<int>(nbCandidates))];
+  float split = static_cast<float>(mean[dim]);
+
+  // Descriptors below the split value on the left, the others on the right. When the mean does not separate
+  // them, the split value is the median so that both children are smaller than the node.
+  uint32_t *middle = std::partition(ids + begin, ids + end, [descriptors, dimension, dim, split](uint32_t id) {
+    return descriptors[(static_cast<size_t>(id) * dimension) + dim] < split;
+  });
+  unsigned int mid = static_cast<unsigned int>(middle - ids);
+  if ((mid == begin) || (mid == end)) {
+    mid = begin + (count / 2);
+    std::nth_element(ids + begin, ids + mid, ids + end, [descriptors, dimension, dim](uint32_t a, uint32_t b) {
+      return descriptors[(static_cast<size_t>(a) * dimension) + dim] < descriptors[(static_cast<size_t>(b) * dimension) + dim];
+    });
+    split = descriptors[(static_cast<size_t>(ids[mid]) * dimension) + dim];
+  }
+
+  nodes[4 * node] = dim;
+  nodes[(4 * node) + 1] = floatToWord(split);
+  nodes[(4 * node) + 2] = static_cast<uint32_t>(nodes.size() / 4);
+  buildKdNode(descriptors, dimension, leafSize, ids, begin, mid, rng, nodes, mean, var, dims);
+  nodes[(4 * node) + 3] = static_cast<uint32_t>(nodes.size() / 4);
+  buildKdNode(descriptors, dimension, leafSize, ids, mid, end, rng, nodes, mean, var, dims);
+}
+} // namespace
+
+/*!
+ * Default constructor. The default parameters are those of the FLANN based matcher of OpenCV: 12 hash tables with
+ * 20 bits keys and a multi-probe level of 2 for the LSH index, 4 trees for the k-d forest, that stops after 32
+ * checks.
+ */
+vpDescriptorIndex::vpDescriptorIndex()
+  : m_type(INDEX_NONE), m_nbDescriptors(0), m_descriptorSize(0), m_binaryDescriptors(nullptr),
+  m_floatDescriptors(nullptr), m_lshNbTables(12), m_lshKeySize(20), m_lshMultiProbeLevel(2), m_kdNbTrees(4),
+  m_kdLeafSize(4), m_maxChecks(32), m_seed(0x2545F4914F6CDD1DULL), m_ownedData(), m_data(nullptr), m_dataSize(0),
+  m_lshTables(), m_kdTrees(), m_probeMasks()
+{ }
+
+/*!
+ * Copy constructor. The arrays of an index that has been built, or copied by load(), are duplicated. An index loaded
+ * in place keeps on referring to the buffer given to load().
+ */
+vpDescriptorIndex::vpDescriptorIndex(const vpDescriptorIndex &index)
+  : m_type(INDEX_NONE), m_nbDescriptors(0), m_descriptorSize(0), m_binaryDescriptors(nullptr),
+  m_floatDescriptors(nullptr), m_lshNbTables(12), m_lshKeySize(20), m_lshMultiProbeLevel(2), m_kdNbTrees(4),
+  m_kdLeafSize(4), m_maxChecks(32), m_seed(0x2545F4914F6CDD1DULL), m_ownedData(), m_data(nullptr), m_dataSize(0),
+  m_lshTables(), m_kdTrees(), m_probeMasks()
+{
+  *this = index;
+}
+
+/*!
+ * Copy operator. The arrays of an index that has been built, or copied by load(), are duplicated. An index loaded
+ * in place keeps on referring to the buffer given to load().
+ */
+vpDescriptorIndex &vpDescriptorIndex::operator=(const vpDescriptorIndex &index)
+{
+  if (this == &index) {
+    return *this;
+  }
+  m_type = index.m_type;
+  m_nbDescriptors = index.m_nbDescriptors;
+  m_descriptorSize = index.m_descriptorSize;
+  m_binaryDescriptors = index.m_binaryDescriptors;
+  m_floatDescriptors = index.m_floatDescriptors;
+  m_lshNbTables = index.m_lshNbTables;
+  m_lshKeySize = index.m_lshKeySize;
+  m_lshMultiProbeLevel = index.m_lshMultiProbeLevel;
+  m_kdNbTrees = index.m_kdNbTrees;
+  m_kdLeafSize = index.m_kdLeafSize;
+  m_maxChecks = index.m_maxChecks;
+  m_seed = index.m_seed;
+  m_ownedData = index.m_ownedData;
+  m_dataSize = index.m_dataSize;
+  m_probeMasks = index.m_probeMasks;
+  const bool ownsData = !index.m_ownedData.empty() && (index.m_data == index.m_ownedData.data());
+  m_data = ownsData ? m_ownedData.data() : index.m_data;
+  m_lshTables.clear();
+  m_kdTrees.clear();
+  if (m_type != INDEX_NONE) {
+    initPointers();
+  }
+  return *this;
+}
+
+/*!
+ * Build a forest of randomized k-d trees of floating point descriptors, with the parameters set by
+ * setKdForestParameters().
+ *
+ * \param descriptors : The descriptors, stored contiguously. They are not copied and must stay unchanged as long
+ * as the index is used.
+ * \param nbDescriptors : Number of descriptors.
+ * \param dimension : Number of floats of a descriptor.
+ */
+void vpDescriptorIndex::buildKdForest(const float *descriptors, unsigned int nbDescriptors, unsigned int dimension)
+{
+  if ((descriptors == nullptr) || (nbDescriptors == 0) || (dimension == 0)) {
+    throw vpException(vpException::badValue, "Cannot build a k-d forest without descriptors");
+  }
+  clear();
+
+  vpUniRand rng(m_seed);
+  std::vector<double> mean(dimension), var(dimension);
+  std::vector<unsigned int> dims(dimension);
+  for (unsigned int t = 0; t < m_kdNbTrees; ++t) {
+    std::vector<uint32_t> ids(nbDescriptors);
+    for (unsigned int n = 0; n < nbDescriptors; ++n) {
+      ids[n] = n;
+    }
+    std::vector<uint32_t> nodes;
+    buildKdNode(descriptors, dimension, m_kdLeafSize, &ids[0], 0, nbDescriptors, rng, nodes, mean, var, dims);
+    m_ownedData.push_back(static_cast<uint32_t>(nodes.size() / 4));
+    m_ownedData.insert(m_ownedData.end(), nodes.begin(), nodes.end());
+    m_ownedData.insert(m_ownedData.end(), ids.begin(), ids.end());
+  }
+
+  m_type = INDEX_KD_FOREST;
+  m_nbDescriptors = nbDescriptors;
+  m_descriptorSize = dimension;
+  m_floatDescriptors = descriptors;
+  m_data = &m_ownedData[0];
+  m_dataSize = m_ownedData.size();
+  initPointers();
+}
+
+/*!
+ * Build a multi-probe LSH index of binary descriptors, with the parameters set by setLshParameters().
+ *
+ * \param descriptors : The descriptors, stored contiguously. They are not copied and must stay unchanged as long
+ * as the index is used.
+ * \param nbDescriptors : Number of descriptors.
+ * \param descriptorSize : Number of bytes of a descriptor.
+ */
+void vpDescriptorIndex::buildLsh(const unsigned char *descriptors, unsigned int nbDescriptors,
+                                 unsigned int descriptorSize)
+{
+  if ((descriptors == nullptr) || (nbDescriptors == 0) || (descriptorSize == 0)) {
+    throw vpException(vpException::badValue, "Cannot build a LSH index without descriptors");
+  }
+  if (m_lshKeySize > (8 * descriptorSize)) {
+    throw vpException(vpException::badValue, "LSH key size (%u) is larger than the number of bits of the descriptors (%u)",
+                      m_lshKeySize, 8 * descriptorSize);
+  }
+  clear();
+
+  vpUniRand rng(m_seed);
+  std::vector<uint32_t> allBits(8 * descriptorSize);
+  std::vector<std::pair<uint32_t, uint32_t> > keys(nbDescriptors);
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  for (unsigned int t = 0; t < m_lshNbTables; ++t) {
+    // Random subset of the bits of the descriptors
+    for (uint32_t b = 0; b < allBits.size(); ++b) {
+      allBits[b] = b;
+    }
+    for (unsigned int b = 0; b < m_lshKeySize; ++b) {
+      const int j = rng.uniform(static_cast<int>(b), static_cast<int>(allBits.size()));
+      std::swap(allBits[b], allBits[static_cast<size_t>(j)]);
+    }
+    const uint32_t *bits = &allBits[0];
+    const unsigned int keySize = m_lshKeySize;
+    pool.parallelFor(0, nbDescriptors, [&keys, descriptors, descriptorSize, bits, keySize](unsigned int begin, unsigned int end) {
+      for (unsigned int n = begin; n < end; ++n) {
+        keys[n] = std::make_pair(computeLshKey(descriptors + (static_cast<size_t>(n) * descriptorSize), bits, keySize), n);
+      }
+    });
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<uint32_t> bucketKeys, offsets;
+    for (unsigned int n = 0; n < nbDescriptors; ++n) {
+      if ((n == 0) || (keys[n].first != keys[n - 1].first)) {
+        bucketKeys.push_back(keys[n].first);
+        offsets.push_back(n);
+      }
+    }
+    offsets.push_back(nbDescriptors);
+
+    m_ownedData.insert(m_ownedData.end(), allBits.begin(), allBits.begin() + m_lshKeySize);
+    m_ownedData.push_back(static_cast<uint32_t>(bucketKeys.size()));
+    m_ownedData.insert(m_ownedData.end(), bucketKeys.begin(), bucketKeys.end());
+    m_ownedData.insert(m_ownedData.end(), offsets.begin(), offsets.end());
+    for (unsigned int n = 0; n < nbDescriptors; ++n) {
+      m_ownedData.push_back(keys[n].second);
+    }
+  }
+
+  m_type = INDEX_LSH;
+  m_nbDescriptors = nbDescriptors;
+  m_descriptorSize = descriptorSize;
+  m_binaryDescriptors = descriptors;
+  m_data = &m_ownedData[0];
+  m_dataSize = m_ownedData.size();
+  initPointers();
+}
+
+/*!
+ * Check that the indices stored in the arrays of a loaded index are within the descriptors and the arrays, so that
+ * a search cannot read outside of them.
+ */
+void vpDescriptorIndex::checkContents() const
+{
+  const uint32_t n = m_nbDescriptors;
+  for (size_t t = 0; t < m_lshTables.size(); ++t) {
+    const vpLshTable &table = m_lshTables[t];
+    for (uint32_t b = 0; b < table.nbBuckets; ++b) {
+      if ((table.offsets[b] > table.offsets[b + 1]) || ((b > 0) && (table.keys[b - 1] >= table.keys[b]))) {
+        throw vpException(vpException::ioError, "Corrupted LSH index");
+      }
+    }
+    if (table.offsets[table.nbBuckets] > n) {
+      throw vpException(vpException::ioError, "Corrupted LSH index");
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      if (table.ids[i] >= n) {
+        throw vpException(vpException::ioError, "Corrupted LSH index");
+      }
+    }
+  }
+  for (size_t t = 0; t < m_kdTrees.size(); ++t) {
+    const vpKdTree &tree = m_kdTrees[t];
+    if (tree.nbNodes == 0) {
+      throw vpException(vpException::ioError, "Corrupted k-d forest");
+    }
+    for (uint32_t node = 0; node < tree.nbNodes; ++node) {
+      const uint32_t *nd = tree.nodes + (4 * static_cast<size_t>(node));
+      // The children are stored after their parent, so that a search cannot loop
+      const bool valid = (nd[0] == leafNode) ? ((nd[1] <= nd[2]) && (nd[2] <= n))
+        : ((nd[0] < m_descriptorSize) && (nd[2] > node) && (nd[2] < tree.nbNodes) &&
+           (nd[3] > node) && (nd[3] < tree.nbNodes));
+      if (!valid) {
+        throw vpException(vpException::ioError, "Corrupted k-d forest");
+      }
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      if (tree.ids[i] >= n) {
+        throw vpException(vpException::ioError, "Corrupted k-d forest");
+      }
+    }
+  }
+}
+
+/*!
+ * Remove the index. The parameters are kept.
+ */
+void vpDescriptorIndex::clear()
+{
+  m_type = INDEX_NONE;
+  m_nbDescriptors = 0;
+  m_descriptorSize = 0;
+  m_binaryDescriptors = nullptr;
+  m_floatDescriptors = nullptr;
+  m_ownedData.clear();
+  m_data = nullptr;
+  m_dataSize = 0;
+  m_lshTables.clear();
+  m_kdTrees.clear();
+  m_probeMasks.clear();
+}
+
+/*!
+ * Compute the pointers to the arrays of the hash tables or of the trees in m_data, checking that they are within
+ * the data.
+ */
+void vpDescriptorIndex::initPointers()
+{
+  m_lshTables.clear();
+  m_kdTrees.clear();
+  size_t pos = 0;
+  const size_t n = m_nbDescriptors;
+  if (m_type == INDEX_LSH) {
+    for (unsigned int t = 0; t < m_lshNbTables; ++t) {
+      vpLshTable table;
+      if ((pos + m_lshKeySize + 1) > m_dataSize) {
+        throw vpException(vpException::ioError, "Corrupted LSH index");
+      }
+      table.bits = m_data + pos;
+      pos += m_lshKeySize;
+      table.nbBuckets = m_data[pos++];
+      if ((table.nbBuckets > n) || ((pos + (2 * static_cast<size_t>(table.nbBuckets)) + 1 + n) > m_dataSize)) {
+        throw vpException(vpException::ioError, "Corrupted LSH index");
+      }
+      table.keys = m_data + pos;
+      pos += table.nbBuckets;
+      table.offsets = m_data + pos;
+      pos += table.nbBuckets + 1;
+      table.ids = m_data + pos;
+      pos += n;
+      for (unsigned int b = 0; b < m_lshKeySize; ++b) {
+        if (table.bits[b] >= (8 * m_descriptorSize)) {
+          throw vpException(vpException::ioError, "Corrupted LSH index");
+        }
+      }
+      m_lshTables.push_back(table);
+    }
+    initProbeMasks();
+  }
+  else if (m_type == INDEX_KD_FOREST) {
+    for (unsigned int t = 0; t < m_kdNbTrees; ++t) {
+      vpKdTree tree;
+      if ((pos + 1) > m_dataSize) {
+        throw vpException(vpException::ioError, "Corrupted k-d forest");
+      }
+      tree.nbNodes = m_data[pos++];
+      if ((pos + (4 * static_cast<size_t>(tree.nbNodes)) + n) > m_dataSize) {
+        throw vpException(vpException::ioError, "Corrupted k-d forest");
+      }
+      tree.nodes = m_data + pos;
+      pos += 4 * static_cast<size_t>(tree.nbNodes);
+      tree.ids = m_data + pos;
+      pos += n;
+      m_kdTrees.push_back(tree);
+    }
+  }
+  if (pos != m_dataSize) {
+    throw vpException(vpException::ioError, "Corrupted descriptor index");
+  }
+}
+
+/*!
+ * Compute the differences between the key of a query and the keys of the probed buckets: all the combinations of at
+ * most getLshMultiProbeLevel() bits, by increasing number of bits.
+ */
+void vpDescriptorIndex::initProbeMasks()
+{
+  m_probeMasks.assign(1, 0);
+  size_t levelBegin = 0;
+  for (unsigned int level = 1; level <= m_lshMultiProbeLevel; ++level) {
+    const size_t levelEnd = m_probeMasks.size();
+    for (size_t m = levelBegin; m < levelEnd; ++m) {
+      // Add a bit above the highest bit of the mask, to enumerate each combination once
+      unsigned int firstBit = 0;
+      for (unsigned int b = 0; b < m_lshKeySize; ++b) {
+        if ((m_probeMasks[m] >> b) & 1) {
+          firstBit = b + 1;
+        }
+      }
+      for (unsigned int b = firstBit; b < m_lshKeySize; ++b) {
+        m_probeMasks.push_back(m_probeMasks[m] | (1u << b));
+      }
+    }
+    levelBegin = levelEnd;
+  }
+}
+
+/*!
+ * Search the k nearest neighbours of floating point descriptors in a k-d forest. The distance is the euclidean
+ * distance.
+ *
+ * \param queries : Query descriptors, stored contiguously, with getDescriptorSize() floats each.
+ * \param nbQueries : Number of query descriptors.
+ * \param k : Number of neighbours to search.
+ * \param indices : Indices of the neighbours of the i-th query, by increasing distance, in
+ * [i * k, (i + 1) * k[. The index is -1 when less than k descriptors have been found.
+ * \param distances : Distances between the queries and their neighbours, std::numeric_limits<float>::max() for
+ * missing neighbours.
+ */
+void vpDescriptorIndex::knnSearch(const float *queries, unsigned int nbQueries, unsigned int k,
+                                  std::vector<int> &indices, std::vector<float> &distances) const
+{
+  if (m_type != INDEX_KD_FOREST) {
+    throw vpException(vpException::notInitialized, "No k-d forest of floating point descriptors has been built");
+  }
+  if (k == 0) {
+    throw vpException(vpException::badValue, "The number of neighbours should be greater than 0");
+  }
+  indices.resize(static_cast<size_t>(nbQueries) * k);
+  distances.resize(static_cast<size_t>(nbQueries) * k);
+
+  vpThreadPool::getInstance().parallelFor(0, nbQueries, [this, queries, k, &indices, &distances](unsigned int begin, unsigned int end) {
+    // Descriptors already compared to the current query, in any tree
+    std::vector<uint32_t> visited(m_nbDescriptors, 0);
+    uint32_t stamp = 0;
+    vpKnnResult result(k);
+    std::priority_queue<vpKdBranch> branches;
+    for (unsigned int q = begin; q < end; ++q) {
+      const float *query = queries + (static_cast<size_t>(q) * m_descriptorSize);
+      result.clear();
+      branches = std::priority_queue<vpKdBranch>();
+      ++stamp;
+      unsigned int checks = 0;
+
+      // Descend from a node to a leaf, saving the other branches, then compare the descriptors of the leaf
+      auto explore = [&](unsigned int t, uint32_t node, float minDist) {
+        const vpKdTree &tree = m_kdTrees[t];
+        while (tree.nodes[4 * node] != leafNode) {
+          const uint32_t *n = tree.nodes + (4 * node);
+          const float diff = query[n[0]] - wordToFloat(n[1]);
+          const uint32_t closest = (diff < 0.f) ? n[2] : n[3];
+          const uint32_t other = (diff < 0.f) ? n[3] : n[2];
+          // The descriptors of the other branch are at least at |diff| from the query
+          const float otherDist = std::max(minDist, diff * diff);
+          if (otherDist < result.worstDistance()) {
+            branches.push(vpKdBranch(otherDist, t, other));
+          }
+          node = closest;
+        }
+        const uint32_t *n = tree.nodes + (4 * node);
+        for (uint32_t i = n[1]; i < n[2]; ++i) {
+          const uint32_t id = tree.ids[i];
+          if (visited[id] == stamp) {
+            continue;
+          }
+          visited[id] = stamp;
+          ++checks;
+          result.add(static_cast<int>(id), squaredDistance(query, m_floatDescriptors + (static_cast<size_t>(id) * m_descriptorSize), m_descriptorSize));
+        }
+      };
+
+      for (unsigned int t = 0; t < m_kdTrees.size(); ++t) {
+        explore(t, 0, 0.f);
+      }
+      while (!branches.empty() && ((checks < m_maxChecks) || !result.full())) {
+        const vpKdBranch branch = branches.top();
+        branches.pop();
+        if (branch.minDist >= result.worstDistance()) {
+          break;
+        }
+        explore(branch.tree, branch.node, branch.minDist);
+      }
+      result.copyTo(&indices[static_cast<size_t>(q) * k], &distances[static_cast<size_t>(q) * k], true);
+    }
+  });
+}
+
+/*!
+ * Search the k nearest neighbours of binary descriptors in a LSH index. The distance is the Hamming distance.
+ *
+ * \param queries : Query descriptors, stored contiguously, with getDescriptorSize() bytes each.
+ * \param nbQueries : Number of query descriptors.
+ * \param k : Number of neighbours to search.
+ * \param indices : Indices of the neighbours of the i-th query, by increasing distance, in
+ * [i * k, (i + 1) * k[. The index is -1 when less than k descriptors share a probed bucket with the query.
+ * \param distances : Distances between the queries and their neighbours, std::numeric_limits<float>::max() for
+ * missing neighbours.
+ */
+void vpDescriptorIndex::knnSearch(const unsigned char *queries, unsigned int nbQueries, unsigned int k,
+                                  std::vector<int> &indices, std::vector<float> &distances) const
+{
+  if (m_type != INDEX_LSH) {
+    throw vpException(vpException::notInitialized, "No LSH index of binary descriptors has been built");
+  }
+  if (k == 0) {
+    throw vpException(vpException::badValue, "The number of neighbours should be greater than 0");
+  }
+  indices.resize(static_cast<size_t>(nbQueries) * k);
+  distances.resize(static_cast<size_t>(nbQueries) * k);
+
+  vpThreadPool::getInstance().parallelFor(0, nbQueries, [this, queries, k, &indices, &distances](unsigned int begin, unsigned int end) {
+    // Descriptors already compared to the current query, in any table
+    std::vector<uint32_t> visited(m_nbDescriptors, 0);
+    uint32_t stamp = 0;
+    vpKnnResult result(k);
+    for (unsigned int q = begin; q < end; ++q) {
+      const unsigned char *query = queries + (static_cast<size_t>(q) * m_descriptorSize);
+      result.clear();
+      ++stamp;
+      for (size_t t = 0; t < m_lshTables.size(); ++t) {
+        const vpLshTable &table = m_lshTables[t];
+        const uint32_t key = computeLshKey(query, table.bits, m_lshKeySize);
+        for (size_t m = 0; m < m_probeMasks.size(); ++m) {
+          const uint32_t probe = key ^ m_probeMasks[m];
+          const uint32_t *it = std::lower_bound(table.keys, table.keys + table.nbBuckets, probe);
+          if ((it == (table.keys + table.nbBuckets)) || (*it != probe)) {
+            continue;
+          }
+          const size_t bucket = static_cast<size_t>(it - table.keys);
+          for (uint32_t i = table.offsets[bucket]; i < table.offsets[bucket + 1]; ++i) {
+            const uint32_t id = table.ids[i];
+            if (visited[id] == stamp) {
+              continue;
+            }
+            visited[id] = stamp;
+            result.add(static_cast<int>(id), static_cast<float>(hammingDistance(query, m_binaryDescriptors + (static_cast<size_t>(id) * m_descriptorSize), m_descriptorSize)));
+          }
+        }
+      }
+      result.copyTo(&indices[static_cast<size_t>(q) * k], &distances[static_cast<size_t>(q) * k], false);
+    }
+  });
+}
+
+/*!
+ * Load an index serialized by save().
+ *
+ * When the machine is little-endian and the buffer is aligned on 4 bytes, the arrays of the index are used in
+ * place: the buffer must stay unchanged in memory as long as the index is used, which is the case of the content of
+ * a vpMemoryMappedFile that stays opened. Otherwise, the arrays are copied.
+ *
+ * \param buffer : Serialized index.
+ * \param size : Number of bytes available in the buffer.
+ * \param descriptors : The indexed descriptors, unsigned char for a LSH index, float for a k-d forest, stored
+ * contiguously as when the index was built. They are not copied.
+ * \return The number of bytes of the serialized index.
+ */
+size_t vpDescriptorIndex::load(const unsigned char *buffer, size_t size, const void *descriptors)
+{
+  clear();
+  if ((buffer == nullptr) || (size < (headerWords * sizeof(uint32_t)))) {
+    throw vpException(vpException::ioError, "Buffer is too small to contain a descriptor index");
+  }
+  uint32_t header[headerWords];
+  memcpy(header, buffer, sizeof(header));
+#ifdef VISP_BIG_ENDIAN
+  for (unsigned int i = 0; i < headerWords; ++i) {
+    header[i] = vpEndian::swap32bits(header[i]);
+  }
+#endif
+  if (header[0] != indexMagic) {
+    throw vpException(vpException::ioError, "Buffer does not contain a descriptor index");
+  }
+  if (header[1] != indexVersion) {
+    throw vpException(vpException::ioError, "Unsupported descriptor index version %u", header[1]);
+  }
+  const uint64_t dataWords = static_cast<uint64_t>(header[8]) | (static_cast<uint64_t>(header[9]) << 32);
+  const size_t dataOffset = headerWords * sizeof(uint32_t);
+  if ((dataWords > ((size - dataOffset) / sizeof(uint32_t))) || (descriptors == nullptr)) {
+    throw vpException(vpException::ioError, "Truncated descriptor index");
+  }
+
+  const vpIndexType type = static_cast<vpIndexType>(header[2]);
+  if (type == INDEX_LSH) {
+    if ((header[6] == 0) || (header[6] > 32) || (header[7] > header[6])) {
+      throw vpException(vpException::ioError, "Invalid LSH index parameters");
+    }
+    m_lshNbTables = header[5];
+    m_lshKeySize = header[6];
+    m_lshMultiProbeLevel = header[7];
+    m_binaryDescriptors = static_cast<const unsigned char *>(descriptors);
+  }
+  else if (type == INDEX_KD_FOREST) {
+    m_kdNbTrees = header[5];
+    m_kdLeafSize = header[6];
+    m_maxChecks = header[7];
+    m_floatDescriptors = static_cast<const float *>(descriptors);
+  }
+  else {
+    throw vpException(vpException::ioError, "Unknown descriptor index type %u", header[2]);
+  }
+  m_type = type;
+  m_nbDescriptors = header[3];
+  m_descriptorSize = header[4];
+  m_dataSize = static_cast<size_t>(dataWords);
+
+  const unsigned char *data = buffer + dataOffset;
+#ifdef VISP_BIG_ENDIAN
+  m_ownedData.resize(m_dataSize);
+  memcpy(m_ownedData.data(), data, m_dataSize * sizeof(uint32_t));
+  for (size_t i = 0; i < m_dataSize; ++i) {
+    m_ownedData[i] = vpEndian::swap32bits(m_ownedData[i]);
+  }
+  m_data = m_ownedData.data();
+#else
+  if ((reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t)) == 0) {
+    m_data = reinterpret_cast<const uint32_t *>(data);
+  }
+  else {
+    m_ownedData.resize(m_dataSize);
+    memcpy(m_ownedData.data(), data, m_dataSize * sizeof(uint32_t));
+    m_data = m_ownedData.data();
+  }
+#endif
+
+  try {
+    initPointers();
+    checkContents();
+  }
+  catch (...) {
+    clear();
+    throw;
+  }
+  return dataOffset + (m_dataSize * sizeof(uint32_t));
+}
+
+/*!
+ * Serialize the index, without the descriptors, in little-endian 32-bit words. The number of written bytes is a
+ * multiple of 4, so that an index written at an offset aligned on 4 bytes in a file can be loaded in place by
+ * load().
+ *
+ * \param os : Binary output stream.
+ */
+void vpDescriptorIndex::save(std::ostream &os) const
+{
+  if (m_type == INDEX_NONE) {
+    throw vpException(vpException::notInitialized, "No descriptor index to save");
+  }
+  const uint64_t dataWords = static_cast<uint64_t>(m_dataSize);
+  uint32_t header[headerWords] = { indexMagic, indexVersion, static_cast<uint32_t>(m_type), m_nbDescriptors,
+    m_descriptorSize, 0, 0, 0, static_cast<uint32_t>(dataWords & 0xFFFFFFFF), static_cast<uint32_t>(dataWords >> 32) };
+  if (m_type == INDEX_LSH) {
+    header[5] = m_lshNbTables;
+    header[6] = m_lshKeySize;
+    header[7] = m_lshMultiProbeLevel;
+  }
+  else {
+    header[5] = m_kdNbTrees;
+    header[6] = m_kdLeafSize;
+    header[7] = m_maxChecks;
+  }
+  writeWords(os, header, headerWords);
+  writeWords(os, m_data, m_dataSize);
+}
+
+/*!
+ * Set the parameters of the k-d forests built by buildKdForest().
+ *
+ * \param nbTrees : Number of randomized trees.
+ * \param leafSize : Maximum number of descriptors in a leaf.
+ */
+void vpDescriptorIndex::setKdForestParameters(unsigned int nbTrees, unsigned int leafSize)
+{
+  if ((nbTrees == 0) || (leafSize == 0)) {
+    throw vpException(vpException::badValue, "The number of trees and the leaf size should be greater than 0");
+  }
+  m_kdNbTrees = nbTrees;
+  m_kdLeafSize = leafSize;
+}
+
+/*!
+ * Set the parameters of the LSH indexes built by buildLsh().
+ *
+ * \param nbTables : Number of hash tables.
+ * \param keySize : Number of random bits of the descriptors that form the key of a bucket, at most 32.
+ * \param multiProbeLevel : Maximum number of bits that differ between the key of a query and the keys of the
+ * probed buckets. With 0, only the bucket of the query is probed.
+ */
+void vpDescriptorIndex::setLshParameters(unsigned int nbTables, unsigned int keySize, unsigned int multiProbeLevel)
+{
+  if ((nbTables == 0) || (keySize == 0) || (keySize > 32) || (multiProbeLevel > keySize)) {
+    throw vpException(vpException::badValue,
+                      "Invalid LSH parameters: %u tables, keys of %u bits, multi-probe level %u", nbTables, keySize,
+                      multiProbeLevel);
+  }
+  m_lshNbTables = nbTables;
+  m_lshKeySize = keySize;
+  m_lshMultiProbeLevel = multiProbeLevel;
+}
+
+/*!
+ * Set the number of descriptors compared to a query in a k-d forest before the search stops, once k neighbours
+ * have been found. The higher, the more accurate and the slower the search is. With at least getNbDescriptors()
+ * checks, the search is exact.
+ */
+void vpDescriptorIndex::setMaxChecks(unsigned int maxChecks)
+{
+  if (maxChecks == 0) {
+    throw vpException(vpException::badValue, "The number of checks should be greater than 0");
+  }
+  m_maxChecks = maxChecks;
+}
+END_VISP_NAMESPACE
@@ -38,9 +38,11 @@
     (((VISP_HAVE_OPENCV_VERSION < 0x050000) && defined(HAVE_OPENCV_CALIB3D) && defined(HAVE_OPENCV_FEATURES2D)) || \
      ((VISP_HAVE_OPENCV_VERSION >= 0x050000) && defined(HAVE_OPENCV_3D) && defined(HAVE_OPENCV_FEATURES)))
 
+#include <cstring>
 #include <iomanip>
 #include <limits>
 
+#include <visp3/core/vpEndian.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/vision/vpKeyPoint.h>
 
@@ -81,13 +83,58 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
   return vpImagePoint(pair.first.pt.y, pair.first.pt.x);
 }
 
+// Learning database: a header of 64 bytes followed by the sections of the keypoints, of the 3D points, of the
+// descriptors and of their index, each starting at an offset aligned on 64 bytes. All the values are little-endian.
+const char databaseMagic[8] = { 'V', 'P', 'K', 'P', 'D', 'B', '\0', '\0' };
+const uint32_t databaseVersion = 1;
+const uint32_t databaseHave3DPoints = 1;
+const uint32_t databaseHaveIndex = 2;
+const size_t databaseAlignment = 64;
+// u, v, size, angle, response, octave and class id of a keypoint
+const size_t databaseKeyPointWords = 7;
+
+inline uint32_t readWordLE(const unsigned char *data)
+{
+  uint32_t word;
+  memcpy(&word, data, sizeof(word));
+#ifdef VISP_BIG_ENDIAN
+  word = vpEndian::swap32bits(word);
+#endif
+  return word;
+}
+
+inline float readFloatLE(const unsigned char *data)
+{
+  const uint32_t word = readWordLE(data);
+  float value;
+  memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+inline uint64_t readOffsetLE(const unsigned char *data)
+{
+  return static_cast<uint64_t>(readWordLE(data)) | (static_cast<uint64_t>(readWordLE(data + 4)) << 32);
+}
+
+// Pad the file with zeros up to the next aligned offset, and return this offset
+uint64_t alignDatabaseFile(std::ofstream &file)
+{
+  const uint64_t pos = static_cast<uint64_t>(file.tellp());
+  const uint64_t aligned = ((pos + databaseAlignment - 1) / databaseAlignment) * databaseAlignment;
+  for (uint64_t i = pos; i < aligned; ++i) {
+    file.put('\0');
+  }
+  return aligned;
+}
+
 } // namespace
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatureDescriptorType &descriptorType,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_databaseFile(), m_descriptorIndex(),
+  m_detectionMethod(detectionScore),
   m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
   m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
   m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
@@ -95,13 +142,14 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
   m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
   m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
-  m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
+  m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacProsac(false), m_ransacScores(),
+  m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
   m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   m_useBruteForceCrossCheck(true),
 #endif
-  m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useConsensusPercentage(false), m_useDescriptorIndex(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+  m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
 
@@ -113,7 +161,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
 
 vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extractorName,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_databaseFile(), m_descriptorIndex(),
+  m_detectionMethod(detectionScore),
   m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
   m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
   m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
@@ -121,13 +170,14 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
   m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
   m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
-  m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
+  m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacProsac(false), m_ransacScores(),
+  m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
   m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   m_useBruteForceCrossCheck(true),
 #endif
-  m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useConsensusPercentage(false), m_useDescriptorIndex(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+  m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
 
@@ -139,7 +189,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
 
 vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std::vector<std::string> &extractorNames,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_databaseFile(), m_descriptorIndex(),
+  m_detectionMethod(detectionScore),
   m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
   m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
   m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
@@ -148,13 +199,14 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
   m_queryFilteredKeyPoints(), m_queryKeyPoints(), m_ransacConsensusPercentage(20.0),
   m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(), m_ransacParallel(false),
-  m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01), m_trainDescriptors(),
+  m_ransacParallelNbThreads(0), m_ransacProsac(false), m_ransacScores(), m_ransacReprojectionError(6.0),
+  m_ransacThreshold(0.01), m_trainDescriptors(),
   m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   m_useBruteForceCrossCheck(true),
 #endif
-  m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useConsensusPercentage(false), m_useDescriptorIndex(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+  m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
   init();
@@ -282,6 +334,8 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  // The index of the train descriptors is built again at the next matching
+  m_descriptorIndex.clear();
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -411,6 +465,8 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I,
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  // The index of the train descriptors is built again at the next matching
+  m_descriptorIndex.clear();
 
   m_reference_computed = true;
 
@@ -813,6 +869,9 @@ bool vpKeyPoint::computePose(const std::vector<vpPoint> &objectVpPoints, vpHomog
   pose.setRansacNbInliersToReachConsensus(nbInlierToReachConsensus);
   pose.setRansacThreshold(m_ransacThreshold);
   pose.setRansacMaxTrials(m_nbRansacIterations);
+  if (m_ransacProsac && (m_ransacScores.size() == objectVpPoints.size())) {
+    pose.setRansacScores(m_ransacScores);
+  }
 
   bool isRansacPoseEstimationOk = false;
   try {
@@ -2985,6 +3044,8 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  // The index of the train descriptors is built again at the next matching
+  m_descriptorIndex.clear();
 
   // Set m_reference_computed to true as we load a learning file
   m_reference_computed = true;
@@ -2993,6 +3054,96 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   m_currentImageId = static_cast<int>(m_mapOfImages.size());
 }
 
+void vpKeyPoint::loadLearningDatabase(const std::string &filename)
+{
+  std::shared_ptr<vpMemoryMappedFile> file = std::make_shared<vpMemoryMappedFile>(filename);
+  const unsigned char *data = file->data();
+  const size_t size = file->size();
+  if ((size < databaseAlignment) || (memcmp(data, databaseMagic, sizeof(databaseMagic)) != 0)) {
+    throw vpException(vpException::ioError, "%s is not a learning database", filename.c_str());
+  }
+  if (readWordLE(data + 8) != databaseVersion) {
+    throw vpException(vpException::ioError, "Unsupported version of the learning database %s", filename.c_str());
+  }
+  const uint32_t flags = readWordLE(data + 12);
+  const int nbKeyPoints = static_cast<int>(readWordLE(data + 16));
+  const int nbCols = static_cast<int>(readWordLE(data + 20));
+  const int descriptorType = static_cast<int>(readWordLE(data + 24));
+  const size_t descriptorSize = readWordLE(data + 28);
+  const uint64_t keyPointsOffset = readOffsetLE(data + 32);
+  const uint64_t pointsOffset = readOffsetLE(data + 40);
+  const uint64_t descriptorsOffset = readOffsetLE(data + 48);
+  const uint64_t indexOffset = readOffsetLE(data + 56);
+  const bool have3DPoints = (flags & databaseHave3DPoints) != 0;
+  const bool haveIndex = (flags & databaseHaveIndex) != 0;
+
+  const size_t n = static_cast<size_t>(nbKeyPoints);
+  if ((nbKeyPoints < 0) || (nbCols <= 0) || ((descriptorType != CV_8U) && (descriptorType != CV_32F)) ||
+      (descriptorSize != (static_cast<size_t>(nbCols) * CV_ELEM_SIZE(descriptorType))) ||
+      ((keyPointsOffset + (n * databaseKeyPointWords * 4)) > size) ||
+      (have3DPoints && ((pointsOffset + (n * 3 * 4)) > size)) ||
+      ((descriptorsOffset % databaseAlignment) != 0) || ((descriptorsOffset + (n * descriptorSize)) > size) ||
+      (haveIndex && (indexOffset > size))) {
+    throw vpException(vpException::ioError, "Corrupted learning database %s", filename.c_str());
+  }
+
+  m_trainKeyPoints.clear();
+  m_trainPoints.clear();
+  m_mapOfImageId.clear();
+  m_mapOfImages.clear();
+
+  m_trainKeyPoints.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const unsigned char *kp = data + keyPointsOffset + (i * databaseKeyPointWords * 4);
+    m_trainKeyPoints.push_back(cv::KeyPoint(cv::Point2f(readFloatLE(kp), readFloatLE(kp + 4)), readFloatLE(kp + 8),
+                                            readFloatLE(kp + 12), readFloatLE(kp + 16),
+                                            static_cast<int>(readWordLE(kp + 20)),
+                                            static_cast<int>(readWordLE(kp + 24))));
+  }
+  if (have3DPoints) {
+    m_trainPoints.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned char *pt = data + pointsOffset + (i * 3 * 4);
+      m_trainPoints.push_back(cv::Point3f(readFloatLE(pt), readFloatLE(pt + 4), readFloatLE(pt + 8)));
+    }
+  }
+
+  // The descriptors are used in place in the mapped file, which is read-only
+#ifdef VISP_BIG_ENDIAN
+  if (descriptorType == CV_32F) {
+    m_trainDescriptors = cv::Mat(nbKeyPoints, nbCols, CV_32F);
+    for (int i = 0; i < nbKeyPoints; ++i) {
+      for (int j = 0; j < nbCols; ++j) {
+        m_trainDescriptors.at<float>(i, j) = readFloatLE(data + descriptorsOffset + (i * descriptorSize) + (j * 4));
+      }
+    }
+  }
+  else
+#endif
+  {
+    m_trainDescriptors = cv::Mat(nbKeyPoints, nbCols, descriptorType,
+                                 const_cast<unsigned char *>(data + descriptorsOffset), descriptorSize);
+  }
+
+  // Convert OpenCV type to ViSP type for compatibility
+  vpConvert::convertFromOpenCV(m_trainKeyPoints, m_referenceImagePointsList);
+  vpConvert::convertFromOpenCV(m_trainPoints, m_trainVpPoints);
+
+  // Add train descriptors in matcher object
+  m_matcher->clear();
+  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+
+  m_descriptorIndex.clear();
+  if (haveIndex) {
+    m_descriptorIndex.load(data + indexOffset, size - static_cast<size_t>(indexOffset), m_trainDescriptors.data);
+    m_useDescriptorIndex = true;
+  }
+  m_databaseFile = file;
+
+  m_reference_computed = true;
+  m_currentImageId = 0;
+}
+
 void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
                        std::vector<cv::DMatch> &matches, double &elapsedTime)
 {
@@ -3020,6 +3171,9 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     }
+    else if (m_useDescriptorIndex) {
+      matchDescriptorIndex(queryDescriptors, matches);
+    }
     else {
    // Match query descriptors to train descriptors
       m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
@@ -3040,6 +3194,9 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
         matches.push_back(cv::DMatch(it->trainIdx, it->queryIdx, it->distance));
       }
     }
+    else if (m_useDescriptorIndex) {
+      matchDescriptorIndex(queryDescriptors, matches);
+    }
     else {
    // Match query descriptors to train descriptors
       m_matcher->match(queryDescriptors, matches);
@@ -3048,6 +3205,78 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
   elapsedTime = vpTime::measureTimeMs() - t;
 }
 
+void vpKeyPoint::matchDescriptorIndex(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches)
+{
+  if (queryDescriptors.type() != m_trainDescriptors.type() || queryDescriptors.cols != m_trainDescriptors.cols) {
+    throw vpException(vpException::badValue, "The query and train descriptors must have the same type and size");
+  }
+
+  const unsigned int nbTrain = static_cast<unsigned int>(m_trainDescriptors.rows);
+  if ((m_descriptorIndex.getType() == vpDescriptorIndex::INDEX_NONE) ||
+      (m_descriptorIndex.getNbDescriptors() != nbTrain)) {
+    if (!m_trainDescriptors.isContinuous()) {
+      m_trainDescriptors = m_trainDescriptors.clone();
+    }
+    if (m_trainDescriptors.type() == CV_8U) {
+      m_descriptorIndex.buildLsh(m_trainDescriptors.ptr<unsigned char>(0), nbTrain,
+                                 static_cast<unsigned int>(m_trainDescriptors.cols));
+    }
+    else if (m_trainDescriptors.type() == CV_32F) {
+      m_descriptorIndex.buildKdForest(m_trainDescriptors.ptr<float>(0), nbTrain,
+                                      static_cast<unsigned int>(m_trainDescriptors.cols));
+    }
+    else {
+      throw vpException(vpException::badValue, "The descriptor index needs CV_8U or CV_32F descriptors");
+    }
+  }
+
+  const cv::Mat queries = queryDescriptors.isContinuous() ? queryDescriptors : queryDescriptors.clone();
+  const unsigned int nbQueries = static_cast<unsigned int>(queries.rows);
+  const unsigned int k = m_useKnn ? 2 : 1;
+  std::vector<int> indices;
+  std::vector<float> distances;
+  if (queries.type() == CV_8U) {
+    m_descriptorIndex.knnSearch(queries.ptr<unsigned char>(0), nbQueries, k, indices, distances);
+  }
+  else {
+    m_descriptorIndex.knnSearch(queries.ptr<float>(0), nbQueries, k, indices, distances);
+  }
+
+  m_knnMatches.resize(nbQueries);
+  matches.clear();
+  for (unsigned int q = 0; q < nbQueries; ++q) {
+    std::vector<cv::DMatch> &knnMatches = m_knnMatches[q];
+    knnMatches.clear();
+    for (unsigned int i = 0; i < k; ++i) {
+      if (indices[(q * k) + i] >= 0) {
+        knnMatches.push_back(cv::DMatch(static_cast<int>(q), indices[(q * k) + i], distances[(q * k) + i]));
+      }
+    }
+    if (knnMatches.empty()) {
+      // No train descriptor in the probed buckets, use an exhaustive search for this query
+      std::vector<std::vector<cv::DMatch> > fallback;
+      m_matcher->knnMatch(queries.row(static_cast<int>(q)), fallback, static_cast<int>(k));
+      if (!fallback.empty()) {
+        knnMatches = fallback[0];
+      }
+      for (size_t i = 0; i < knnMatches.size(); ++i) {
+        knnMatches[i].queryIdx = static_cast<int>(q);
+      }
+    }
+    if (!m_useKnn && !knnMatches.empty()) {
+      matches.push_back(knnMatches[0]);
+    }
+  }
+
+  if (m_useKnn) {
+    matches.resize(m_knnMatches.size());
+    std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+  }
+  else {
+    m_knnMatches.clear();
+  }
+}
+
 unsigned int vpKeyPoint::matchPoint(const vpImage<unsigned char> &I) { return matchPoint(I, vpRect()); }
 
 unsigned int vpKeyPoint::matchPoint(const vpImage<vpRGBa> &I_color) { return matchPoint(I_color, vpRect()); }
@@ -3295,7 +3524,15 @@ bool vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpCameraParam
     std::vector<vpPoint> inliers;
     std::vector<unsigned int> inlierIndex;
 
+    if (m_ransacProsac) {
+      // The closest matches are the most likely to be correct
+      m_ransacScores.resize(m_filteredMatches.size());
+      for (size_t i = 0; i < m_filteredMatches.size(); ++i) {
+        m_ransacScores[i] = -static_cast<double>(m_filteredMatches[i].distance);
+      }
+    }
     bool res = computePose(objectVpPoints, cMo, inliers, inlierIndex, m_poseTime, func);
+    m_ransacScores.clear();
 
     std::map<unsigned int, bool> mapOfInlierIndex;
     m_matchRansacKeyPointsToPoints.clear();
@@ -3668,6 +3905,8 @@ void vpKeyPoint::reset()
   m_computeCovariance = false;
   m_covarianceMatrix = vpMatrix();
   m_currentImageId = 0;
+  m_databaseFile.reset();
+  m_descriptorIndex.clear();
   m_detectionMethod = detectionScore;
   m_detectionScore = 0.15;
   m_detectionThreshold = 100.0;
@@ -3714,6 +3953,7 @@ void vpKeyPoint::reset()
   m_useBruteForceCrossCheck = true;
 #endif
   m_useConsensusPercentage = false;
+  m_useDescriptorIndex = false;
   m_useKnn = true; // as m_filterType == ratioDistanceThreshold
   m_useMatchTrainToQuery = false;
   m_useRansacVVS = true;
@@ -4046,6 +4286,99 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 }
 
+void vpKeyPoint::saveLearningDatabase(const std::string &filename)
+{
+  if ((m_trainDescriptors.type() != CV_8U) && (m_trainDescriptors.type() != CV_32F)) {
+    throw vpException(vpException::badValue, "The learning database needs CV_8U or CV_32F descriptors");
+  }
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create the file %s", filename.c_str());
+  }
+
+  // Build the index if needed, to store it with the descriptors
+  vpDescriptorIndex index = m_descriptorIndex;
+  const cv::Mat descriptors = m_trainDescriptors.isContinuous() ? m_trainDescriptors : m_trainDescriptors.clone();
+  const unsigned int nbKeyPoints = static_cast<unsigned int>(descriptors.rows);
+  if ((index.getType() == vpDescriptorIndex::INDEX_NONE) || (index.getNbDescriptors() != nbKeyPoints)) {
+    if (descriptors.type() == CV_8U) {
+      index.buildLsh(descriptors.ptr<unsigned char>(0), nbKeyPoints, static_cast<unsigned int>(descriptors.cols));
+    }
+    else {
+      index.buildKdForest(descriptors.ptr<float>(0), nbKeyPoints, static_cast<unsigned int>(descriptors.cols));
+    }
+  }
+  if (m_trainKeyPoints.size() != nbKeyPoints) {
+    throw vpException(vpException::badValue, "The number of train keypoints and descriptors differ");
+  }
+  const bool have3DPoints = m_trainPoints.size() == m_trainKeyPoints.size() && !m_trainPoints.empty();
+
+  // The header is written at the end, once the offsets of the sections are known
+  for (size_t i = 0; i < databaseAlignment; ++i) {
+    file.put('\0');
+  }
+
+  const uint64_t keyPointsOffset = alignDatabaseFile(file);
+  for (std::vector<cv::KeyPoint>::const_iterator it = m_trainKeyPoints.begin(); it != m_trainKeyPoints.end(); ++it) {
+    vpIoTools::writeBinaryValueLE(file, it->pt.x);
+    vpIoTools::writeBinaryValueLE(file, it->pt.y);
+    vpIoTools::writeBinaryValueLE(file, it->size);
+    vpIoTools::writeBinaryValueLE(file, it->angle);
+    vpIoTools::writeBinaryValueLE(file, it->response);
+    vpIoTools::writeBinaryValueLE(file, static_cast<int32_t>(it->octave));
+    vpIoTools::writeBinaryValueLE(file, static_cast<int32_t>(it->class_id));
+  }
+
+  const uint64_t pointsOffset = alignDatabaseFile(file);
+  if (have3DPoints) {
+    for (std::vector<cv::Point3f>::const_iterator it = m_trainPoints.begin(); it != m_trainPoints.end(); ++it) {
+      vpIoTools::writeBinaryValueLE(file, it->x);
+      vpIoTools::writeBinaryValueLE(file, it->y);
+      vpIoTools::writeBinaryValueLE(file, it->z);
+    }
+  }
+
+  const uint64_t descriptorsOffset = alignDatabaseFile(file);
+  const size_t descriptorSize = descriptors.cols * descriptors.elemSize();
+  if (descriptors.type() == CV_8U) {
+    file.write(reinterpret_cast<const char *>(descriptors.data),
+               static_cast<std::streamsize>(nbKeyPoints * descriptorSize));
+  }
+  else {
+    for (int i = 0; i < descriptors.rows; ++i) {
+      for (int j = 0; j < descriptors.cols; ++j) {
+        vpIoTools::writeBinaryValueLE(file, descriptors.at<float>(i, j));
+      }
+    }
+  }
+
+  const uint64_t indexOffset = alignDatabaseFile(file);
+  index.save(file);
+
+  file.seekp(0);
+  file.write(databaseMagic, sizeof(databaseMagic));
+  vpIoTools::writeBinaryValueLE(file, databaseVersion);
+  vpIoTools::writeBinaryValueLE(file, databaseHaveIndex | (have3DPoints ? databaseHave3DPoints : 0));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(nbKeyPoints));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(descriptors.cols));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(descriptors.type()));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(descriptorSize));
+  const uint64_t offsets[4] = { keyPointsOffset, pointsOffset, descriptorsOffset, indexOffset };
+  for (unsigned int i = 0; i < 4; ++i) {
+    vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(offsets[i] & 0xFFFFFFFFULL));
+    vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(offsets[i] >> 32));
+  }
+  if (!file.good()) {
+    throw vpException(vpException::ioError, "Cannot write the learning database %s", filename.c_str());
+  }
+}
+
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 // From OpenCV 2.4.11 source code.
@@ -68,7 +68,7 @@ vpPose::vpPose()
   ransacNbInlierConsensus(def_ransacNbInlier), ransacMaxTrials(def_ransacMaxTrials), ransacInliers(), ransacInlierIndex(), ransacThreshold(0.0001),
   distToPlaneForCoplanarityTest(0.001), ransacFlag(vpPose::NO_FILTER), listOfPoints(), useParallelRansac(false),
   nbParallelRansacThreads(0), // 0 means that we use C++11 (if available) to get the number of threads
-  vvsEpsilon(1e-8)
+  ransacProbability(0.), ransacLocalOptimization(false), ransacScores(), vvsEpsilon(1e-8)
 { }
 
 vpPose::vpPose(const std::vector<vpPoint> &lP)
@@ -78,7 +78,7 @@ vpPose::vpPose(const std::vector<vpPoint> &lP)
   ransacInliers(), ransacInlierIndex(), ransacThreshold(0.0001), distToPlaneForCoplanarityTest(0.001),
   ransacFlag(vpPose::NO_FILTER), listOfPoints(lP), useParallelRansac(false),
   nbParallelRansacThreads(0), // 0 means that we use C++11 (if available) to get the number of threads
-  vvsEpsilon(1e-8)
+  ransacProbability(0.), ransacLocalOptimization(false), ransacScores(), vvsEpsilon(1e-8)
 { }
 
 vpPose::~vpPose()
@@ -36,21 +36,24 @@
   \brief function used to estimate a pose using the Ransac algorithm
 */
 
-#include <algorithm> // std::count
+#include <algorithm> // std::find_if
+#include <atomic>
 #include <cmath>     // std::fabs
 #include <float.h>   // DBL_MAX
 #include <iostream>
 #include <limits> // numeric_limits
+#include <functional>
 #include <map>
 
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRansac.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
 #if defined(VISP_HAVE_THREADS)
-#include <thread>
+#include <mutex>
 #endif
 
 #define EPS 1e-6
@@ -162,170 +165,289 @@ struct FindDegeneratePoint
 } // namespace
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
-bool vpPose::vpRansacFunctor::poseRansacImpl()
+struct vpPose::vpRansacSharedState
 {
-  const unsigned int size = static_cast<unsigned int>(m_listOfUniquePoints.size());
-  const unsigned int nbMinRandom = 4;
-  int nbTrials = 0;
-
-  vpPoint p; // Point used to project using the estimated pose
+  vpRansacSharedState(unsigned int nbPoints, unsigned int nbInlierConsensus, int maxTrials, double threshold,
+                      double probability, bool localOptimization)
+    : m_nbPoints(nbPoints), m_nbInlierConsensus(nbInlierConsensus), m_maxTrialsBound(maxTrials),
+    m_threshold(threshold), m_probability(probability), m_localOptimization(localOptimization), m_prosacOrder(),
+    m_prosacGrowth(), m_nbTrials(0), m_maxTrials(maxTrials), m_nbInliers(0), m_foundSolution(false),
+    m_bestConsensus()
+#if defined(VISP_HAVE_THREADS)
+    , m_mutex()
+#endif
+  { }
 
-  bool foundSolution = false;
-  while ((nbTrials < m_ransacMaxTrials) && (m_nbInliers < m_ransacNbInlierConsensus)) {
-    // Hold the list of the index of the inliers (points in the consensus set)
-    std::vector<unsigned int> cur_consensus;
-    // Hold the list of the index of the outliers
-    std::vector<unsigned int> cur_outliers;
-    // Hold the list of the index of the points randomly picked
-    std::vector<unsigned int> cur_randoms;
-    // Hold the list of the current inliers points to avoid to add a
-    // degenerate point if the flag is set
-    std::vector<vpPoint> cur_inliers;
+  /*!
+   * Sort the points by decreasing score and compute the PROSAC growth function: the samples of the trial t are
+   * drawn among the n best points, where n is the largest size such that m_prosacGrowth[n] <= t + 1.
+   */
+  void initProsac(const std::vector<double> &scores, unsigned int sampleSize)
+  {
+    m_prosacOrder.resize(m_nbPoints);
+    for (unsigned int i = 0; i < m_nbPoints; ++i) {
+      m_prosacOrder[i] = i;
+    }
+    std::stable_sort(m_prosacOrder.begin(), m_prosacOrder.end(),
+                     [&scores](unsigned int a, unsigned int b) { return scores[a] > scores[b]; });
+
+    // Chum and Matas, "Matching with PROSAC - progressive sample consensus", CVPR 2005
+    m_prosacGrowth.assign(m_nbPoints + 1, 0);
+    double Tn = std::max<double>(static_cast<double>(m_maxTrialsBound), 1.);
+    for (unsigned int i = 0; i < sampleSize; ++i) {
+      Tn *= static_cast<double>(sampleSize - i) / static_cast<double>(m_nbPoints - i);
+    }
+    int TnPrime = 1;
+    m_prosacGrowth[sampleSize] = TnPrime;
+    for (unsigned int n = sampleSize; n < m_nbPoints; ++n) {
+      double Tn1 = (Tn * static_cast<double>(n + 1)) / static_cast<double>(n + 1 - sampleSize);
+      TnPrime += static_cast<int>(std::ceil(Tn1 - Tn));
+      m_prosacGrowth[n + 1] = TnPrime;
+      Tn = Tn1;
+    }
+  }
 
-    // Use a temporary variable because if not, the cMo passed in parameters
-    // will be modified when
-    // we compute the pose for the minimal sample sets but if the pose is not
-    // correct when we pass a function pointer we do not want to modify the
-    // cMo passed in parameters
-    vpHomogeneousMatrix cMo_tmp;
+  //! Number of points among which the samples of the trial \e trial are drawn.
+  unsigned int getProsacSubsetSize(int trial, unsigned int sampleSize) const
+  {
+    std::vector<int>::const_iterator it =
+      std::upper_bound(m_prosacGrowth.begin() + sampleSize, m_prosacGrowth.end(), trial + 1);
+    return static_cast<unsigned int>(it - m_prosacGrowth.begin()) - 1;
+  }
 
-    // Vector of used points, initialized at false for all points
-    std::vector<bool> usedPt(size, false);
+  /*!
+   * Reserve a new trial.
+   * \return false when the number of trials or the size of the consensus set is reached.
+   */
+  bool nextTrial(int &trial)
+  {
+    if (m_nbInliers >= m_nbInlierConsensus) {
+      return false;
+    }
+    trial = m_nbTrials++;
+    return trial < m_maxTrials;
+  }
 
-    vpPose poseMin;
-    unsigned int i = 0;
-    bool stop_loop = false;
-    while ((i < nbMinRandom) && (stop_loop == false)) {
-      if (static_cast<size_t>(std::count(usedPt.begin(), usedPt.end(), true)) == usedPt.size()) {
-        // All points were picked once, break otherwise we stay in an infinite loop
-        stop_loop = true;
+  /*!
+   * Keep \e consensus if it is larger than the best one, and adapt the number of trials to the inlier ratio.
+   */
+  void update(const std::vector<unsigned int> &consensus)
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    const unsigned int nbInliers = static_cast<unsigned int>(consensus.size());
+    if (nbInliers > m_nbInliers) {
+      m_bestConsensus = consensus;
+      m_nbInliers = nbInliers;
+      m_foundSolution = true;
+
+      if (m_probability > 0.) {
+        const int sampleSize = 4;
+        double outlierRatio = 1. - (static_cast<double>(nbInliers) / static_cast<double>(m_nbPoints));
+        int nbTrials = vpPose::computeRansacIterations(m_probability, outlierRatio, sampleSize, m_maxTrialsBound);
+        if ((nbTrials > 0) && (nbTrials < m_maxTrials)) {
+          m_maxTrials = nbTrials;
+        }
       }
-      if (!stop_loop) {
-        // Pick a point randomly
-        unsigned int r_ = m_uniRand.uniform(0, size);
+    }
+  }
 
-        while (usedPt[r_]) {
-          // If already picked, pick another point randomly
-          r_ = m_uniRand.uniform(0, size);
-        }
-        // Mark this point as already picked
-        usedPt[r_] = true;
-        vpPoint pt = m_listOfUniquePoints[r_];
+  const unsigned int m_nbPoints;          //!< Number of unique points
+  const unsigned int m_nbInlierConsensus; //!< Number of inliers to reach a consensus
+  const int m_maxTrialsBound;             //!< Maximum number of trials set by the user
+  const double m_threshold;               //!< Residual threshold
+  const double m_probability;             //!< Probability used to adapt the number of trials, 0 to disable
+  const bool m_localOptimization;         //!< If true, refine each new best consensus set
+  std::vector<unsigned int> m_prosacOrder; //!< Points sorted by decreasing score, empty for uniform sampling
+  std::vector<int> m_prosacGrowth;         //!< PROSAC growth function
+
+  std::atomic<int> m_nbTrials;             //!< Number of trials started by all the threads
+  std::atomic<int> m_maxTrials;            //!< Current number of trials, lowered when a larger consensus is found
+  std::atomic<unsigned int> m_nbInliers;   //!< Size of the best consensus set
+  bool m_foundSolution;                    //!< True if a consensus set has been found
+  std::vector<unsigned int> m_bestConsensus; //!< Best consensus set
+#if defined(VISP_HAVE_THREADS)
+  std::mutex m_mutex; //!< Protects the best consensus set
+#endif
+};
 
-        bool degenerate = false;
-        if (m_checkDegeneratePoints) {
-          if (std::find_if(poseMin.listOfPoints.begin(), poseMin.listOfPoints.end(), FindDegeneratePoint(pt)) !=
-              poseMin.listOfPoints.end()) {
-            degenerate = true;
-          }
+unsigned int vpPose::vpRansacFunctor::computeConsensus(const vpHomogeneousMatrix &cMo,
+                                                        std::vector<unsigned int> &consensus) const
+{
+  // Hold the list of the current inliers points to avoid to add a
+  // degenerate point if the flag is set
+  std::vector<vpPoint> cur_inliers;
+  vpPoint p; // Point used to project using the estimated pose
+
+  consensus.clear();
+  unsigned int iter = 0;
+  std::vector<vpPoint>::const_iterator listofuniquepoints_end = m_listOfUniquePoints->end();
+  for (std::vector<vpPoint>::const_iterator it = m_listOfUniquePoints->begin(); it != listofuniquepoints_end;
+       ++it, ++iter) {
+    p.setWorldCoordinates(it->get_oX(), it->get_oY(), it->get_oZ());
+    p.track(cMo);
+
+    double error = sqrt(vpMath::sqr(p.get_x() - it->get_x()) + vpMath::sqr(p.get_y() - it->get_y()));
+    if (error < m_shared->m_threshold) {
+      bool degenerate = false;
+      if (m_checkDegeneratePoints) {
+        if (std::find_if(cur_inliers.begin(), cur_inliers.end(), FindDegeneratePoint(*it)) != cur_inliers.end()) {
+          degenerate = true;
         }
+      }
 
-        if (!degenerate) {
-          poseMin.addPoint(pt);
-          cur_randoms.push_back(r_);
-          // Increment the number of points picked
-          ++i;
+      if (!degenerate) {
+        // the point is considered as inlier if the error is below the
+        // threshold
+        consensus.push_back(iter);
+        if (m_checkDegeneratePoints) {
+          cur_inliers.push_back(*it);
         }
       }
     }
+  }
 
-    bool stop_for_loop = false;
-    if (poseMin.npt < nbMinRandom) {
-      ++nbTrials;
-      stop_for_loop = true;
-    }
+  return static_cast<unsigned int>(consensus.size());
+}
 
-    if (!stop_for_loop) {
-      bool is_pose_valid = false;
-      double r_min = DBL_MAX;
+bool vpPose::vpRansacFunctor::pickSample(int trial, vpPose &poseMin)
+{
+  const unsigned int nbMinRandom = 4;
+  const bool prosac = !m_shared->m_prosacOrder.empty();
+  // With PROSAC, the samples are drawn among the best points, the last one of the subset being always picked
+  unsigned int subsetSize = prosac ? m_shared->getProsacSubsetSize(trial, nbMinRandom) : m_shared->m_nbPoints;
+  bool pickLastPoint = prosac && (subsetSize > nbMinRandom);
+
+  // Vector of used points, initialized at false for all points
+  std::vector<bool> usedPt(subsetSize, false);
+  unsigned int nbUsedPt = 0;
+
+  unsigned int i = 0;
+  while (i < nbMinRandom) {
+    if (nbUsedPt == subsetSize) {
+      // All points were picked once, break otherwise we stay in an infinite loop
+      return false;
+    }
 
-      try {
-        is_pose_valid = poseMin.computePose(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, cMo_tmp);
-        r_min = poseMin.computeResidual(cMo_tmp);
+    unsigned int r_;
+    if (pickLastPoint) {
+      r_ = subsetSize - 1;
+      pickLastPoint = false;
+    }
+    else {
+      // Pick a point randomly
+      r_ = m_uniRand.uniform(0, subsetSize);
+      while (usedPt[r_]) {
+        // If already picked, pick another point randomly
+        r_ = m_uniRand.uniform(0, subsetSize);
       }
-      catch (...) {
-        // no need to take action
+    }
+    // Mark this point as already picked
+    usedPt[r_] = true;
+    ++nbUsedPt;
+    const vpPoint &pt = (*m_listOfUniquePoints)[prosac ? m_shared->m_prosacOrder[r_] : r_];
+
+    bool degenerate = false;
+    if (m_checkDegeneratePoints) {
+      if (std::find_if(poseMin.listOfPoints.begin(), poseMin.listOfPoints.end(), FindDegeneratePoint(pt)) !=
+          poseMin.listOfPoints.end()) {
+        degenerate = true;
       }
+    }
 
-      // If residual returned is not a number (NAN), set valid to false
-      if (vpMath::isNaN(r_min)) {
-        is_pose_valid = false;
-      }
+    if (!degenerate) {
+      poseMin.addPoint(pt);
+      // Increment the number of points picked
+      ++i;
+    }
+  }
 
-      // If at pose computation is OK we can continue, otherwise pick another random set
-      if (is_pose_valid) {
-        double r = sqrt(r_min) / static_cast<double>(nbMinRandom); // FS should be r = sqrt(r_min / (double)nbMinRandom);
-        // Filter the pose using some criterion (orientation angles,
-        // translations, etc.)
-        bool isPoseValid = true;
-        if (m_func != nullptr) {
-          isPoseValid = m_func(cMo_tmp);
-          if (isPoseValid) {
-            m_cMo = cMo_tmp;
-          }
-        }
-        else {
-          // No post filtering on pose, so copy cMo_temp to cMo
-          m_cMo = cMo_tmp;
-        }
+  return true;
+}
 
-        if (isPoseValid && (r < m_ransacThreshold)) {
-          unsigned int nbInliersCur = 0;
-          unsigned int iter = 0;
-          std::vector<vpPoint>::const_iterator m_listofuniquepoints_end = m_listOfUniquePoints.end();
-          for (std::vector<vpPoint>::const_iterator it = m_listOfUniquePoints.begin(); it != m_listofuniquepoints_end;
-               ++it, ++iter) {
-            p.setWorldCoordinates(it->get_oX(), it->get_oY(), it->get_oZ());
-            p.track(m_cMo);
-
-            double error = sqrt(vpMath::sqr(p.get_x() - it->get_x()) + vpMath::sqr(p.get_y() - it->get_y()));
-            if (error < m_ransacThreshold) {
-              bool degenerate = false;
-              if (m_checkDegeneratePoints) {
-                if (std::find_if(cur_inliers.begin(), cur_inliers.end(), FindDegeneratePoint(*it)) != cur_inliers.end()) {
-                  degenerate = true;
-                }
-              }
-
-              if (!degenerate) {
-                // the point is considered as inlier if the error is below the
-                // threshold
-                ++nbInliersCur;
-                cur_consensus.push_back(iter);
-                cur_inliers.push_back(*it);
-              }
-              else {
-                cur_outliers.push_back(iter);
-              }
-            }
-            else {
-              cur_outliers.push_back(iter);
-            }
-          }
+void vpPose::vpRansacFunctor::poseRansacImpl()
+{
+  const unsigned int nbMinRandom = 4;
+  // Maximum number of refinements of a consensus set with the local optimization
+  const unsigned int nbMaxLocalOptimizations = 4;
+  std::vector<unsigned int> cur_consensus, lo_consensus;
 
-          if (nbInliersCur > m_nbInliers) {
-            foundSolution = true;
-            m_best_consensus = cur_consensus;
-            m_nbInliers = nbInliersCur;
-          }
+  int trial = 0;
+  while (m_shared->nextTrial(trial)) {
+    vpPose poseMin;
+    if (!pickSample(trial, poseMin)) {
+      continue;
+    }
+
+    // Use a temporary variable because if not, the cMo passed in parameters
+    // will be modified when
+    // we compute the pose for the minimal sample sets but if the pose is not
+    // correct when we pass a function pointer we do not want to modify the
+    // cMo passed in parameters
+    vpHomogeneousMatrix cMo_tmp;
+    bool is_pose_valid = false;
+    double r_min = DBL_MAX;
+
+    try {
+      is_pose_valid = poseMin.computePose(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, cMo_tmp);
+      r_min = poseMin.computeResidual(cMo_tmp);
+    }
+    catch (...) {
+      // no need to take action
+    }
+
+    // If residual returned is not a number (NAN), set valid to false
+    if (vpMath::isNaN(r_min)) {
+      is_pose_valid = false;
+    }
 
-          ++nbTrials;
+    // If at pose computation is OK we can continue, otherwise pick another random set
+    if (!is_pose_valid) {
+      continue;
+    }
+
+    double r = sqrt(r_min) / static_cast<double>(nbMinRandom); // FS should be r = sqrt(r_min / (double)nbMinRandom);
+    // Filter the pose using some criterion (orientation angles,
+    // translations, etc.)
+    bool isPoseValid = true;
+    if (m_func != nullptr) {
+      isPoseValid = m_func(cMo_tmp);
+    }
 
-          if (nbTrials >= m_ransacMaxTrials) {
-            foundSolution = true;
+    if (isPoseValid && (r < m_shared->m_threshold)) {
+      unsigned int nbInliersCur = computeConsensus(cMo_tmp, cur_consensus);
+
+      if (nbInliersCur > m_shared->m_nbInliers) {
+        if (m_shared->m_localOptimization) {
+          // Refine the pose on the consensus set while it grows
+          vpHomogeneousMatrix cMo_lo = cMo_tmp;
+          for (unsigned int lo = 0; (lo < nbMaxLocalOptimizations) && (nbInliersCur >= nbMinRandom); ++lo) {
+            vpPose poseLo;
+            for (size_t k = 0; k < cur_consensus.size(); ++k) {
+              poseLo.addPoint((*m_listOfUniquePoints)[cur_consensus[k]]);
+            }
+            try {
+              poseLo.computePose(vpPose::VIRTUAL_VS, cMo_lo);
+            }
+            catch (...) {
+              break;
+            }
+            if ((m_func != nullptr) && (!m_func(cMo_lo))) {
+              break;
+            }
+            if (computeConsensus(cMo_lo, lo_consensus) <= nbInliersCur) {
+              break;
+            }
+            cur_consensus.swap(lo_consensus);
+            nbInliersCur = static_cast<unsigned int>(cur_consensus.size());
           }
         }
-        else {
-          ++nbTrials;
-        }
-      }
-      else {
-        ++nbTrials;
+
+        m_shared->update(cur_consensus);
       }
     }
   }
-
-  return foundSolution;
 }
 
 bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func)
@@ -398,6 +520,21 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func)
     throw(vpPoseException(vpPoseException::notInitializedError, "Not enough point to compute the pose"));
   }
 
+  if ((!ransacScores.empty()) && (ransacScores.size() != listOfPoints.size())) {
+    throw(vpPoseException(vpPoseException::poseError, "The number of Ransac scores (%d) differs from the number of points (%d)",
+                          static_cast<int>(ransacScores.size()), static_cast<int>(listOfPoints.size())));
+  }
+
+  vpRansacSharedState sharedState(static_cast<unsigned int>(listOfUniquePoints.size()), ransacNbInlierConsensus,
+                                  ransacMaxTrials, ransacThreshold, ransacProbability, ransacLocalOptimization);
+  if (!ransacScores.empty()) {
+    std::vector<double> uniqueScores(listOfUniquePoints.size());
+    for (size_t i = 0; i < listOfUniquePoints.size(); ++i) {
+      uniqueScores[i] = ransacScores[mapOfUniquePointIndex[i]];
+    }
+    sharedState.initProsac(uniqueScores, minNbUniquePts);
+  }
+
 #if defined(VISP_HAVE_THREADS)
   unsigned int nbThreads = 1;
   bool executeParallelVersion = useParallelRansac;
@@ -408,8 +545,8 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func)
   if (executeParallelVersion) {
 #if defined(VISP_HAVE_THREADS)
     if (nbParallelRansacThreads <= 0) {
-      // Get number of CPU threads
-      nbThreads = std::thread::hardware_concurrency();
+      // Get number of threads of the shared pool
+      nbThreads = vpThreadPool::getInstance().getNbThreads();
       if (nbThreads <= 1) {
         nbThreads = 1;
         executeParallelVersion = false;
@@ -421,65 +558,35 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, FuncCheckValidityPose func)
 #endif
   }
 
-  bool foundSolution = false;
-
   if (executeParallelVersion) {
 #if defined(VISP_HAVE_THREADS)
-    std::vector<std::thread> threadpool;
+    // The tasks share the trial counter and the best consensus set, and stop together
+    vpThreadPool::vpTaskGroup group(vpThreadPool::getInstance());
     std::vector<vpRansacFunctor> ransacWorkers;
 
-    int splitTrials = ransacMaxTrials / nbThreads;
     for (size_t i = 0; i < static_cast<size_t>(nbThreads); ++i) {
       unsigned int initial_seed = static_cast<unsigned int>(i);
-      if (i < static_cast<size_t>(nbThreads) - 1) {
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, splitTrials, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      }
-      else {
-        int maxTrialsRemainder = ransacMaxTrials - splitTrials * (nbThreads - 1);
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, maxTrialsRemainder, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      }
+      ransacWorkers.emplace_back(initial_seed, checkDegeneratePoints, listOfUniquePoints, func, &sharedState);
     }
 
     for (auto &worker : ransacWorkers) {
-      threadpool.emplace_back(&vpRansacFunctor::operator(), &worker);
+      group.run(std::bind(&vpRansacFunctor::operator(), &worker));
     }
-
-    for (auto &th : threadpool) {
-      th.join();
-    }
-
-    bool successRansac = false;
-    size_t best_consensus_size = 0;
-
-    for (auto &worker : ransacWorkers) {
-      if (worker.getResult()) {
-        successRansac = true;
-
-        if (worker.getBestConsensus().size() > best_consensus_size) {
-          nbInliers = worker.getNbInliers();
-          best_consensus = worker.getBestConsensus();
-          best_consensus_size = worker.getBestConsensus().size();
-        }
-      }
-    }
-
-    foundSolution = successRansac;
+    group.wait();
 #endif
   }
   else {
     // Sequential RANSAC
-    vpRansacFunctor sequentialRansac(cMo, ransacNbInlierConsensus, ransacMaxTrials, ransacThreshold, 0,
-                                     checkDegeneratePoints, listOfUniquePoints, func);
+    vpRansacFunctor sequentialRansac(0, checkDegeneratePoints, listOfUniquePoints, func, &sharedState);
     sequentialRansac();
-    foundSolution = sequentialRansac.getResult();
+  }
 
-    if (foundSolution) {
-      nbInliers = sequentialRansac.getNbInliers();
-      best_consensus = sequentialRansac.getBestConsensus();
-    }
+  bool foundSolution = sharedState.m_foundSolution;
+  if (foundSolution) {
+    nbInliers = sharedState.m_nbInliers;
+    best_consensus = sharedState.m_bestConsensus;
   }
+
   if (foundSolution) {
     const unsigned int nbMinRandom = 4;
 
@@ -0,0 +1,372 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test approximate nearest neighbour index of keypoint descriptors.
+ */
+
+/*!
+  \file catchDescriptorIndex.cpp
+
+  Test the LSH index and the k-d forest of vpDescriptorIndex against a brute-force search, and their loading in place
+  from a memory-mapped file.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMemoryMappedFile.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpDescriptorIndex.h>
+
+#include <catch_amalgamated.hpp>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int nbTrain = 5000, nbQueries = 200;
+
+// Random binary descriptors, and queries that are train descriptors with a few flipped bits
+void createBinaryDescriptors(std::vector<unsigned char> &train, std::vector<unsigned char> &queries,
+                             std::vector<unsigned int> &queryOrigins, unsigned int size)
+{
+  vpUniRand rng(42);
+  train.resize(nbTrain * size);
+  for (size_t i = 0; i < train.size(); ++i) {
+    train[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  queries.resize(nbQueries * size);
+  queryOrigins.resize(nbQueries);
+  for (unsigned int q = 0; q < nbQueries; ++q) {
+    queryOrigins[q] = static_cast<unsigned int>(rng.uniform(0, static_cast<int>(nbTrain)));
+    std::copy(train.begin() + (queryOrigins[q] * size), train.begin() + ((queryOrigins[q] + 1) * size),
+              queries.begin() + (q * size));
+    for (unsigned int f = 0; f < 8; ++f) {
+      const int bit = rng.uniform(0, static_cast<int>(8 * size));
+      queries[(q * size) + (bit / 8)] ^= static_cast<unsigned char>(1 << (bit % 8));
+    }
+  }
+}
+
+// Random float descriptors, and queries close to train descriptors
+void createFloatDescriptors(std::vector<float> &train, std::vector<float> &queries,
+                            std::vector<unsigned int> &queryOrigins, unsigned int dimension)
+{
+  vpUniRand rng(43);
+  train.resize(nbTrain * dimension);
+  for (size_t i = 0; i < train.size(); ++i) {
+    train[i] = rng.uniform(0.f, 1.f);
+  }
+  queries.resize(nbQueries * dimension);
+  queryOrigins.resize(nbQueries);
+  for (unsigned int q = 0; q < nbQueries; ++q) {
+    queryOrigins[q] = static_cast<unsigned int>(rng.uniform(0, static_cast<int>(nbTrain)));
+    for (unsigned int i = 0; i < dimension; ++i) {
+      queries[(q * dimension) + i] = train[(queryOrigins[q] * dimension) + i] + rng.uniform(-0.02f, 0.02f);
+    }
+  }
+}
+
+// Words of a serialized index, that are little-endian
+uint32_t getWord(const std::string &buffer, size_t word)
+{
+  uint32_t value = 0;
+  for (size_t b = 0; b < 4; ++b) {
+    value |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[(4 * word) + b])) << (8 * b);
+  }
+  return value;
+}
+
+void setWord(std::string &buffer, size_t word, uint32_t value)
+{
+  for (size_t b = 0; b < 4; ++b) {
+    buffer[(4 * word) + b] = static_cast<char>((value >> (8 * b)) & 0xFF);
+  }
+}
+
+float bruteForceDistance(const std::vector<float> &train, const float *query, unsigned int dimension,
+                         unsigned int &nearest)
+{
+  float best = std::numeric_limits<float>::max();
+  for (unsigned int n = 0; n < nbTrain; ++n) {
+    float d = 0.f;
+    for (unsigned int i = 0; i < dimension; ++i) {
+      const float diff = query[i] - train[(n * dimension) + i];
+      d += diff * diff;
+    }
+    if (d < best) {
+      best = d;
+      nearest = n;
+    }
+  }
+  return std::sqrt(best);
+}
+} // namespace
+
+TEST_CASE("LSH index of binary descriptors", "[descriptor_index]")
+{
+  const unsigned int size = 32;
+  std::vector<unsigned char> train, queries;
+  std::vector<unsigned int> origins;
+  createBinaryDescriptors(train, queries, origins, size);
+
+  vpDescriptorIndex index;
+  index.buildLsh(&train[0], nbTrain, size);
+  REQUIRE(index.getType() == vpDescriptorIndex::INDEX_LSH);
+  REQUIRE(index.getNbDescriptors() == nbTrain);
+
+  std::vector<int> indices;
+  std::vector<float> distances;
+  index.knnSearch(&queries[0], nbQueries, 2, indices, distances);
+  REQUIRE(indices.size() == 2 * nbQueries);
+
+  unsigned int found = 0;
+  for (unsigned int q = 0; q < nbQueries; ++q) {
+    if (indices[2 * q] == static_cast<int>(origins[q])) {
+      ++found;
+      CHECK(distances[2 * q] <= 8.f);
+    }
+    CHECK(distances[2 * q] <= distances[(2 * q) + 1]);
+  }
+  // Descriptors with 8 flipped bits out of 256 share a probed bucket with the original in almost all the tables
+  CHECK(found >= (95 * nbQueries) / 100);
+
+  SECTION("Exact queries")
+  {
+    std::vector<int> exactIndices;
+    std::vector<float> exactDistances;
+    index.knnSearch(&train[0], 100, 1, exactIndices, exactDistances);
+    for (unsigned int q = 0; q < 100; ++q) {
+      CHECK(exactIndices[q] == static_cast<int>(q));
+      CHECK(exactDistances[q] == 0.f);
+    }
+  }
+
+  SECTION("Copy")
+  {
+    std::vector<int> copyIndices;
+    std::vector<float> copyDistances;
+    vpDescriptorIndex copy(index);
+    index.clear();
+    copy.knnSearch(&queries[0], nbQueries, 2, copyIndices, copyDistances);
+    CHECK(copyIndices == indices);
+    CHECK(copyDistances == distances);
+  }
+
+  SECTION("Invalid use")
+  {
+    std::vector<float> floatQueries(size);
+    CHECK_THROWS(index.knnSearch(&floatQueries[0], 1, 1, indices, distances));
+    CHECK_THROWS(index.knnSearch(&queries[0], 1, 0, indices, distances));
+    CHECK_THROWS(index.setLshParameters(12, 33, 2));
+  }
+}
+
+TEST_CASE("K-d forest of float descriptors", "[descriptor_index]")
+{
+  const unsigned int dimension = 32;
+  std::vector<float> train, queries;
+  std::vector<unsigned int> origins;
+  createFloatDescriptors(train, queries, origins, dimension);
+
+  vpDescriptorIndex index;
+  index.buildKdForest(&train[0], nbTrain, dimension);
+  REQUIRE(index.getType() == vpDescriptorIndex::INDEX_KD_FOREST);
+
+  SECTION("Approximate search")
+  {
+    index.setMaxChecks(256);
+    std::vector<int> indices;
+    std::vector<float> distances;
+    index.knnSearch(&queries[0], nbQueries, 1, indices, distances);
+    unsigned int found = 0;
+    for (unsigned int q = 0; q < nbQueries; ++q) {
+      found += (indices[q] == static_cast<int>(origins[q])) ? 1 : 0;
+    }
+    CHECK(found >= (90 * nbQueries) / 100);
+  }
+
+  SECTION("Exact search with enough checks")
+  {
+    index.setMaxChecks(nbTrain);
+    std::vector<int> indices;
+    std::vector<float> distances;
+    index.knnSearch(&queries[0], nbQueries, 2, indices, distances);
+    for (unsigned int q = 0; q < nbQueries; ++q) {
+      unsigned int nearest = 0;
+      const float d = bruteForceDistance(train, &queries[q * dimension], dimension, nearest);
+      CHECK(indices[2 * q] == static_cast<int>(nearest));
+      CHECK(distances[2 * q] == Catch::Approx(d));
+    }
+  }
+}
+
+TEST_CASE("Descriptor index serialization", "[descriptor_index]")
+{
+  const unsigned int size = 32;
+  std::vector<unsigned char> train, queries;
+  std::vector<unsigned int> origins;
+  createBinaryDescriptors(train, queries, origins, size);
+
+  vpDescriptorIndex index;
+  index.setLshParameters(8, 16, 1);
+  index.buildLsh(&train[0], nbTrain, size);
+  std::vector<int> indices;
+  std::vector<float> distances;
+  index.knnSearch(&queries[0], nbQueries, 2, indices, distances);
+
+  std::stringstream ss;
+  index.save(ss);
+  const std::string buffer = ss.str();
+  REQUIRE((buffer.size() % 4) == 0);
+
+  SECTION("Memory-mapped file")
+  {
+    const std::string tempDir = vpIoTools::makeTempDirectory("visp_test_descriptor_index");
+    const std::string filename = vpIoTools::createFilePath(tempDir, "index.bin");
+    {
+      std::ofstream file(filename.c_str(), std::ios::binary);
+      file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+    {
+      vpMemoryMappedFile file(filename);
+      REQUIRE(file.isOpen());
+      REQUIRE(file.size() == buffer.size());
+
+      vpDescriptorIndex loaded;
+      REQUIRE(loaded.load(file.data(), file.size(), &train[0]) == buffer.size());
+      CHECK(loaded.getLshNbTables() == 8);
+      CHECK(loaded.getLshKeySize() == 16);
+      CHECK(loaded.getLshMultiProbeLevel() == 1);
+
+      std::vector<int> loadedIndices;
+      std::vector<float> loadedDistances;
+      loaded.knnSearch(&queries[0], nbQueries, 2, loadedIndices, loadedDistances);
+      CHECK(loadedIndices == indices);
+      CHECK(loadedDistances == distances);
+    }
+    vpIoTools::remove(tempDir);
+  }
+
+  SECTION("Unaligned buffer")
+  {
+    std::vector<unsigned char> unaligned(buffer.size() + 1);
+    std::copy(buffer.begin(), buffer.end(), unaligned.begin() + 1);
+    vpDescriptorIndex loaded;
+    REQUIRE(loaded.load(&unaligned[1], buffer.size(), &train[0]) == buffer.size());
+    std::vector<int> loadedIndices;
+    std::vector<float> loadedDistances;
+    loaded.knnSearch(&queries[0], nbQueries, 2, loadedIndices, loadedDistances);
+    CHECK(loadedIndices == indices);
+  }
+
+  SECTION("Corrupted buffers")
+  {
+    vpDescriptorIndex loaded;
+    CHECK_THROWS(loaded.load(reinterpret_cast<const unsigned char *>(buffer.data()), buffer.size() - 4, &train[0]));
+    std::string corrupted = buffer;
+    corrupted[0] = 'X';
+    CHECK_THROWS(loaded.load(reinterpret_cast<const unsigned char *>(corrupted.data()), corrupted.size(), &train[0]));
+    CHECK(loaded.getType() == vpDescriptorIndex::INDEX_NONE);
+  }
+
+  SECTION("Corrupted LSH tables")
+  {
+    // After the 10 words of the header: the 16 bits of the key of the first table, its number of buckets, its keys
+    // and the offsets of its buckets. The ids of the last table end the buffer.
+    const size_t nbBucketsWord = 10 + 16;
+    const size_t offsetsWord = nbBucketsWord + 1 + getWord(buffer, nbBucketsWord);
+    const size_t lastWord = (buffer.size() / 4) - 1;
+    const size_t words[] = { offsetsWord, offsetsWord + getWord(buffer, nbBucketsWord), lastWord };
+    for (size_t w = 0; w < sizeof(words) / sizeof(words[0]); ++w) {
+      std::string corrupted = buffer;
+      setWord(corrupted, words[w], nbTrain + 1);
+      vpDescriptorIndex loaded;
+      CHECK_THROWS_AS(loaded.load(reinterpret_cast<const unsigned char *>(corrupted.data()), corrupted.size(), &train[0]),
+                      vpException);
+      CHECK(loaded.getType() == vpDescriptorIndex::INDEX_NONE);
+    }
+  }
+}
+
+TEST_CASE("Corrupted k-d forest serialization", "[descriptor_index]")
+{
+  const unsigned int dimension = 8;
+  std::vector<float> train, queries;
+  std::vector<unsigned int> origins;
+  createFloatDescriptors(train, queries, origins, dimension);
+
+  vpDescriptorIndex index;
+  index.buildKdForest(&train[0], nbTrain, dimension);
+  std::stringstream ss;
+  index.save(ss);
+  const std::string buffer = ss.str();
+
+  // After the 10 words of the header: the number of nodes of the first tree, then its nodes, whose first one splits
+  // the descriptors along a dimension (word 11) between two children (words 13 and 14). The ids of the last tree end
+  // the buffer.
+  const size_t lastWord = (buffer.size() / 4) - 1;
+  const size_t words[] = { 10, 11, 13, 14, lastWord };
+  const uint32_t values[] = { 0, dimension, 0, getWord(buffer, 10), nbTrain };
+  for (size_t w = 0; w < sizeof(words) / sizeof(words[0]); ++w) {
+    std::string corrupted = buffer;
+    setWord(corrupted, words[w], values[w]);
+    vpDescriptorIndex loaded;
+    CHECK_THROWS_AS(loaded.load(reinterpret_cast<const unsigned char *>(corrupted.data()), corrupted.size(), &train[0]),
+                    vpException);
+  }
+
+  vpDescriptorIndex loaded;
+  CHECK(loaded.load(reinterpret_cast<const unsigned char *>(buffer.data()), buffer.size(), &train[0]) == buffer.size());
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+int main() { return EXIT_SUCCESS; }
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the adaptive, PROSAC and locally optimized modes of the RANSAC pose estimation.
+ */
+
+/*!
+  \example catchPoseRansac.cpp
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || defined(VISP_HAVE_OPENCV))
+
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPoseVector.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpPose.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const unsigned int nbPoints = 2000;
+const double outlierRatio = 0.4;
+
+// Correspondences between 3D points and their noisy projections, with a proportion of wrong matches. The scores
+// are higher for the correct matches, as the opposite of a descriptor distance would be.
+void generateCorrespondences(const vpHomogeneousMatrix &cMo, std::vector<vpPoint> &points,
+                             std::vector<double> &scores, std::vector<bool> &isOutlier)
+{
+  vpUniRand rand(42);
+  vpGaussRand noise(1e-4, 0., 17);
+  points.resize(nbPoints);
+  scores.resize(nbPoints);
+  isOutlier.resize(nbPoints);
+  for (unsigned int i = 0; i < nbPoints; ++i) {
+    vpPoint &pt = points[i];
+    pt.setWorldCoordinates(rand.uniform(-0.3, 0.3), rand.uniform(-0.3, 0.3), rand.uniform(-0.1, 0.1));
+    pt.project(cMo);
+    isOutlier[i] = rand.uniform(0., 1.) < outlierRatio;
+    if (isOutlier[i]) {
+      pt.set_x(rand.uniform(-0.5, 0.5));
+      pt.set_y(rand.uniform(-0.5, 0.5));
+      scores[i] = rand.uniform(0., 0.7);
+    }
+    else {
+      pt.set_x(pt.get_x() + noise());
+      pt.set_y(pt.get_y() + noise());
+      scores[i] = rand.uniform(0.3, 1.);
+    }
+  }
+}
+
+void checkPose(vpPose &pose, const vpHomogeneousMatrix &cMo_ref, const std::vector<bool> &isOutlier)
+{
+  vpHomogeneousMatrix cMo;
+  REQUIRE(pose.computePose(vpPose::RANSAC, cMo));
+
+  vpPoseVector pose_ref(cMo_ref), pose_est(cMo);
+  for (unsigned int i = 0; i < 6; ++i) {
+    CHECK(std::fabs(pose_ref[i] - pose_est[i]) < 1e-3);
+  }
+
+  // Almost all the correct matches are found, and only a few wrong matches fall below the threshold by chance
+  std::vector<unsigned int> inlierIndex = pose.getRansacInlierIndex();
+  unsigned int nbTrueInliers = 0;
+  for (size_t i = 0; i < inlierIndex.size(); ++i) {
+    if (!isOutlier[inlierIndex[i]]) {
+      ++nbTrueInliers;
+    }
+  }
+  const unsigned int nbExpectedInliers =
+    static_cast<unsigned int>(std::count(isOutlier.begin(), isOutlier.end(), false));
+  CHECK(nbTrueInliers > (0.95 * nbExpectedInliers));
+  CHECK((inlierIndex.size() - nbTrueInliers) < (0.01 * nbPoints));
+}
+} // namespace
+
+TEST_CASE("RANSAC modes", "[pose_ransac]")
+{
+  vpHomogeneousMatrix cMo_ref(0.05, -0.02, 1.2, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+  std::vector<vpPoint> points;
+  std::vector<double> scores;
+  std::vector<bool> isOutlier;
+  generateCorrespondences(cMo_ref, points, scores, isOutlier);
+
+  vpPose pose(points);
+  pose.setRansacThreshold(1e-3);
+  // Never reached, the number of trials stops the RANSAC
+  pose.setRansacNbInliersToReachConsensus(nbPoints);
+  pose.setRansacMaxTrials(300);
+
+  SECTION("Fixed number of trials") { checkPose(pose, cMo_ref, isOutlier); }
+
+  SECTION("Adaptive number of trials")
+  {
+    pose.setRansacProbability(0.99);
+    checkPose(pose, cMo_ref, isOutlier);
+  }
+
+  SECTION("Local optimization")
+  {
+    pose.setRansacProbability(0.99);
+    pose.setRansacLocalOptimization(true);
+    checkPose(pose, cMo_ref, isOutlier);
+  }
+
+  SECTION("PROSAC")
+  {
+    pose.setRansacProbability(0.99);
+    pose.setRansacScores(scores);
+    checkPose(pose, cMo_ref, isOutlier);
+  }
+
+  SECTION("PROSAC with prefiltering")
+  {
+    pose.setRansacScores(scores);
+    pose.setRansacFilterFlag(vpPose::PREFILTER_DEGENERATE_POINTS);
+    checkPose(pose, cMo_ref, isOutlier);
+  }
+
+  SECTION("Parallel")
+  {
+    pose.setUseParallelRansac(true);
+    pose.setNbParallelRansacThreads(4);
+    pose.setRansacProbability(0.99);
+    pose.setRansacLocalOptimization(true);
+    pose.setRansacScores(scores);
+    checkPose(pose, cMo_ref, isOutlier);
+  }
+
+  SECTION("Wrong parameters")
+  {
+    CHECK_THROWS_AS(pose.setRansacProbability(1.), vpException);
+    pose.setRansacScores(std::vector<double>(nbPoints - 1, 1.));
+    vpHomogeneousMatrix cMo;
+    CHECK_THROWS_AS(pose.computePose(vpPose::RANSAC, cMo), vpException);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -126,6 +126,8 @@ public:
   unsigned int getDimension(unsigned int select = FEATURE_ALL) const;
   //! Compute the interaction matrix from a subset of the possible features.
   virtual vpMatrix interaction(unsigned int select = FEATURE_ALL) = 0;
+  virtual void interactionNormalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte,
+                                          unsigned int select = FEATURE_ALL);
   //! Return element \e i in the state vector  (usage : x = s[i] )
   virtual inline double operator[](unsigned int i) const { return s[i]; }
   vpBasicFeature &operator=(const vpBasicFeature &f);
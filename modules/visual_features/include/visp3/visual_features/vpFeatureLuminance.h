@@ -117,6 +117,8 @@ public:
   void init() VP_OVERRIDE;
   vpMatrix interaction(unsigned int select = FEATURE_ALL) VP_OVERRIDE;
   void interaction(vpMatrix &L);
+  void interactionNormalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte,
+                                  unsigned int select = FEATURE_ALL) VP_OVERRIDE;
   void print(unsigned int select = FEATURE_ALL) const VP_OVERRIDE;
 
   vpFeatureLuminance &operator=(const vpFeatureLuminance &f);
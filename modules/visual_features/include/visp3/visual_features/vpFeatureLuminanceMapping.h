@@ -382,6 +382,11 @@ protected:
  * The mapping \f$ f \f$ is applied to the center crop of the image,
  * where the interaction matrix of the pixels can be computed (see vpFeatureLuminance::getBorder).
  *
+ * Since \f$ \mathbf{s} \f$ has a low dimension, the normal equations used by
+ * vpServo::computeControlLawNormalEquations() are obtained from its interaction matrix with
+ * vpBasicFeature::interactionNormalEquations(). The photometric interaction matrix
+ * \f$ \mathbf{L_I} \f$ is only computed once per call to interaction().
+ *
  * \see vpLuminanceDCT, vpLuminancePCA, vpFeatureLuminance
  */
 class VISP_EXPORT vpFeatureLuminanceMapping : public vpBasicFeature
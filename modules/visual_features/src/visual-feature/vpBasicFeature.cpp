@@ -41,6 +41,7 @@
   \brief Class that defines what is a visual feature.
 */
 
+#include <visp3/core/vpException.h>
 #include <visp3/visual_features/vpBasicFeature.h>
 
 BEGIN_VISP_NAMESPACE
@@ -169,6 +170,34 @@ vpColVector vpBasicFeature::error(const vpBasicFeature &s_star, unsigned int sel
 
   return e;
 }
+
+/*!
+  Compute the normal equations \f$ {\bf L}^\top {\bf L} \f$ and \f$ {\bf L}^\top {\bf e} \f$ of a subset of the
+  possible features, where \f$ \bf L \f$ is the interaction matrix of the feature.
+
+  This default implementation computes the interaction matrix with interaction() and then the two products.
+  Features with a large dimension, such as vpFeatureLuminance, override it to accumulate both terms without building
+  \f$ \bf L \f$.
+
+  \param[in] e : Error vector associated to the selected features, usually obtained with error().
+  \param[out] LtL : The 6 by 6 matrix \f$ {\bf L}^\top {\bf L} \f$.
+  \param[out] Lte : The 6-dimension vector \f$ {\bf L}^\top {\bf e} \f$.
+  \param[in] select : Subset of features to consider.
+
+  \exception vpException::dimensionError : When the size of \e e does not match the number of rows of the interaction
+  matrix.
+*/
+void vpBasicFeature::interactionNormalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte,
+                                                unsigned int select)
+{
+  vpMatrix L = interaction(select);
+  if (L.getRows() != e.getRows()) {
+    throw vpException(vpException::dimensionError, "The error vector (%d) does not match the interaction matrix (%d)",
+                      e.getRows(), L.getRows());
+  }
+  LtL = L.AtA();
+  Lte = L.t() * e;
+}
 END_VISP_NAMESPACE
 /*
  * Local variables:
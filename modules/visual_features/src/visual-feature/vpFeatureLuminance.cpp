@@ -38,6 +38,10 @@
   For more details see \cite Collewet08c.
 */
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpException.h>
@@ -46,11 +50,71 @@
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpThreadPool.h>
 
 #include <visp3/visual_features/vpFeatureLuminance.h>
 
 BEGIN_VISP_NAMESPACE
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of features summed by a single task. It does not depend on the number of threads, so that the normal
+// equations are the same whatever the size of the thread pool.
+const unsigned int normalEquationsBlockSize = 4096;
+// Number of independent partial sums kept while accumulating. Features are interleaved between them so that the
+// compiler can map them onto SIMD registers without reordering the floating-point additions.
+const unsigned int normalEquationsLanes = 4;
+// The 21 terms of the upper triangle of L^T L, followed by the 6 terms of L^T e
+const unsigned int normalEquationsSize = 27;
+
+typedef std::array<double, normalEquationsSize> vpNormalEquationsSums;
+
+inline void accumulateFeature(const vpLuminance &info, double e, double *acc, unsigned int stride)
+{
+  const double Zinv = 1. / info.Z;
+  const double x = info.x, y = info.y, Ix = info.Ix, Iy = info.Iy;
+  const double l[6] = { Ix * Zinv,
+                        Iy * Zinv,
+                        -(x * Ix + y * Iy) * Zinv,
+                        -Ix * x * y - (1 + y * y) * Iy,
+                        (1 + x * x) * Ix + Iy * x * y,
+                        Iy * x - Ix * y };
+  unsigned int k = 0;
+  for (unsigned int i = 0; i < 6; ++i) {
+    for (unsigned int j = i; j < 6; ++j) {
+      acc[(k++) * stride] += l[i] * l[j];
+    }
+  }
+  for (unsigned int i = 0; i < 6; ++i) {
+    acc[(k++) * stride] += l[i] * e;
+  }
+}
+
+void accumulateNormalEquations(const vpLuminance *pixInfo, const double *e, unsigned int begin, unsigned int end,
+                               vpNormalEquationsSums &sums)
+{
+  double acc[normalEquationsSize][normalEquationsLanes] = { };
+  unsigned int m = begin;
+  for (; (m + normalEquationsLanes) <= end; m += normalEquationsLanes) {
+    for (unsigned int lane = 0; lane < normalEquationsLanes; ++lane) {
+      accumulateFeature(pixInfo[m + lane], e[m + lane], &acc[0][lane], normalEquationsLanes);
+    }
+  }
+  for (unsigned int lane = 0; m < end; ++m, ++lane) {
+    accumulateFeature(pixInfo[m], e[m], &acc[0][lane], normalEquationsLanes);
+  }
+  for (unsigned int k = 0; k < normalEquationsSize; ++k) {
+    double sum = 0.;
+    for (unsigned int lane = 0; lane < normalEquationsLanes; ++lane) {
+      sum += acc[k][lane];
+    }
+    sums[k] = sum;
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 const int vpFeatureLuminance::DEFAULT_BORDER = 10;
 
 /*!
@@ -250,6 +314,62 @@ void vpFeatureLuminance::interaction(vpMatrix &L)
   }
 }
 
+/*!
+  Compute the normal equations \f$ L_I^\top L_I \f$ and \f$ L_I^\top e \f$ used by Gauss-Newton or
+  Levenberg-Marquardt photometric visual servoing, without building the interaction matrix \f$ L_I \f$.
+
+  The rows of \f$ L_I \f$ are computed and accumulated in a single pass over the features. This pass is split into
+  fixed-size blocks that are processed in parallel by vpThreadPool. The result therefore does not depend on the
+  number of threads, but may differ from \f$ L_I^\top L_I \f$ computed with interaction() by rounding errors.
+
+  \param[in] e : Error vector \f$ (I-I^*) \f$, usually computed with error().
+  \param[out] LtL : The 6 by 6 matrix \f$ L_I^\top L_I \f$.
+  \param[out] Lte : The 6-dimension vector \f$ L_I^\top e \f$.
+  \param[in] select : Not used.
+
+  \exception vpException::dimensionError : When the size of \e e is not the dimension of the feature.
+
+  \sa vpServo::computeControlLawNormalEquations()
+*/
+void vpFeatureLuminance::interactionNormalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte,
+                                                    unsigned int /* select */)
+{
+  if (e.getRows() != dim_s) {
+    throw vpException(vpException::dimensionError, "The error vector (%d) does not match the luminance feature (%d)",
+                      e.getRows(), dim_s);
+  }
+
+  const unsigned int nbBlocks = (dim_s + normalEquationsBlockSize - 1) / normalEquationsBlockSize;
+  std::vector<vpNormalEquationsSums> blockSums(nbBlocks);
+  const vpLuminance *info = pixInfo;
+  const double *error = e.data;
+  vpThreadPool::getInstance().parallelFor(0, nbBlocks, [&](unsigned int begin, unsigned int end) {
+    for (unsigned int b = begin; b < end; ++b) {
+      accumulateNormalEquations(info, error, b * normalEquationsBlockSize,
+                                std::min(dim_s, (b + 1) * normalEquationsBlockSize), blockSums[b]);
+    }
+  }, 1);
+
+  LtL.resize(6, 6, false, false);
+  Lte.resize(6, false);
+  vpNormalEquationsSums sums = { };
+  for (unsigned int b = 0; b < nbBlocks; ++b) {
+    for (unsigned int k = 0; k < normalEquationsSize; ++k) {
+      sums[k] += blockSums[b][k];
+    }
+  }
+  unsigned int k = 0;
+  for (unsigned int i = 0; i < 6; ++i) {
+    for (unsigned int j = i; j < 6; ++j, ++k) {
+      LtL[i][j] = sums[k];
+      LtL[j][i] = sums[k];
+    }
+  }
+  for (unsigned int i = 0; i < 6; ++i, ++k) {
+    Lte[i] = sums[k];
+  }
+}
+
 /*!
   Compute and return the interaction matrix \f$ L_I \f$. The computation is
   made thanks to the values of the luminance features \f$ I \f$
@@ -555,7 +555,6 @@ vpFeatureLuminanceMapping *vpFeatureLuminanceMapping::duplicate() const
 void vpFeatureLuminanceMapping::buildFrom(vpImage<unsigned char> &I)
 {
   m_featI.buildFrom(I);
-  m_featI.interaction(m_LI);
   m_mapping->map(I, s);
 }
 
@@ -479,6 +479,44 @@ public:
    */
   vpColVector computeControlLaw(double t, const vpColVector &e_dot_init);
 
+  /*!
+   * Compute the control law specified using setServo() with a Gauss-Newton
+   * or a Levenberg-Marquardt step obtained from the normal equations of the
+   * task Jacobian:
+   *
+   * \f[
+   * {\bf \dot q} = - \lambda \left({{\bf \widehat J}_e}^\top {\bf \widehat J}_e
+   * + \mu_{LM} \, diag\left({{\bf \widehat J}_e}^\top {\bf \widehat J}_e\right)\right)^+
+   * {{\bf \widehat J}_e}^\top {\bf e}
+   * \f]
+   *
+   * where \f$\mu_{LM}\f$ is set with setNormalEquationsDamping(). With
+   * \f$\mu_{LM} = 0\f$ (the default), this is the Gauss-Newton step and
+   * leads to the same velocity as computeControlLaw() when the task Jacobian
+   * is full rank.
+   *
+   * The terms \f${\widehat {\bf L}}_e^\top {\widehat {\bf L}}_e\f$ and
+   * \f${\widehat {\bf L}}_e^\top {\bf e}\f$ are summed over the features
+   * with vpBasicFeature::interactionNormalEquations(), so that the features
+   * that override it, such as vpFeatureLuminance, never build their
+   * interaction matrix. Only the small matrix above is pseudo-inverted, using
+   * the square of the threshold given to setPseudoInverseThreshold() since
+   * its singular values are the squares of those of the task Jacobian.
+   *
+   * When the interaction matrix type is vpServo::MEAN or
+   * vpServo::USER_DEFINED (see setInteractionMatrixType()), the interaction
+   * matrix is built with computeInteractionMatrix() and the normal equations
+   * are computed from it. The inversion type given to
+   * setInteractionMatrixType() is ignored.
+   *
+   * The task Jacobian \f${\bf \widehat J}_e\f$ and its pseudo-inverse are
+   * not updated by this function, so that secondaryTask() cannot be used
+   * after it.
+   *
+   * \return Velocity skew vector.
+   */
+  vpColVector computeControlLawNormalEquations();
+
   /*!
    * Compute the error \f$\bf e =(s - s^*)\f$ between the current set of visual
    * features \f$\bf s\f$ and the desired set of visual features \f$\bf s^*\f$.
@@ -673,6 +711,13 @@ public:
    */
   double getPseudoInverseThreshold() const { return m_pseudo_inverse_threshold; }
 
+  /*!
+   * Return the damping factor used by computeControlLawNormalEquations().
+   *
+   * \sa setNormalEquationsDamping()
+   */
+  double getNormalEquationsDamping() const { return m_normal_equations_damping; }
+
   /*!
    * Task destruction. Kill the current and desired visual feature lists.
    *
@@ -1029,6 +1074,18 @@ public:
    */
   void setMu(double mu_) { this->mu = mu_; }
 
+  /*!
+   * Set the damping factor \f$\mu_{LM}\f$ of the Levenberg-Marquardt step
+   * computed by computeControlLawNormalEquations(). Setting it to 0 leads to
+   * a Gauss-Newton step. A common strategy for photometric visual servoing
+   * is to start with a large value, e.g. 0.01, and to decrease it once the
+   * error is small.
+   *
+   * \param damping : Positive damping factor. Default value is 0.
+   * \sa getNormalEquationsDamping()
+   */
+  void setNormalEquationsDamping(double damping) { m_normal_equations_damping = damping; }
+
   /*!
    * Set the visual servoing control law.
    * \param servo_type : Control law that will be considered.
@@ -1347,6 +1404,7 @@ protected:
   bool m_first_iteration; //!< True until first call of computeControlLaw() is achieved
 
   double m_pseudo_inverse_threshold; //!< Threshold used in the pseudo inverse
+  double m_normal_equations_damping; //!< Levenberg-Marquardt damping used in computeControlLawNormalEquations()
 };
 END_VISP_NAMESPACE
 #endif
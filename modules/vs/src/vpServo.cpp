@@ -51,7 +51,7 @@ vpServo::vpServo()
   fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false), errorComputed(false),
   interactionMatrixComputed(false), dim_task(0), taskWasKilled(false), forceInteractionMatrixComputation(false),
   WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(), iscJcIdentity(true), cJc(6, 6), m_first_iteration(true),
-  m_pseudo_inverse_threshold(1e-6)
+  m_pseudo_inverse_threshold(1e-6), m_normal_equations_damping(0.)
 {
   cJc.eye();
 }
@@ -62,7 +62,8 @@ vpServo::vpServo(vpServoType servo_type)
   inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false), cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(),
   init_eJe(false), fJe(), init_fJe(false), errorComputed(false), interactionMatrixComputed(false), dim_task(0),
   taskWasKilled(false), forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4), e1_initial(),
-  iscJcIdentity(true), cJc(6, 6), m_first_iteration(true)
+  iscJcIdentity(true), cJc(6, 6), m_first_iteration(true), m_pseudo_inverse_threshold(1e-6),
+  m_normal_equations_damping(0.)
 {
   cJc.eye();
 }
@@ -449,6 +450,40 @@ static void computeInteractionMatrixFromList(const std::list<vpBasicFeature *> &
   return;
 }
 
+static void computeNormalEquationsFromList(const std::list<vpBasicFeature *> &featureList,
+  const std::list<unsigned int> &featureSelectionList, const vpColVector &error,
+  vpMatrix &LtL, vpColVector &Lte)
+{
+  if (featureList.empty()) {
+    vpERROR_TRACE("feature list empty, cannot compute Ls");
+    throw(vpServoException(vpServoException::noFeatureError, "feature list empty, cannot compute Ls"));
+  }
+
+  LtL.resize(6, 6);
+  Lte.resize(6);
+
+  vpMatrix LtLTmp;
+  vpColVector LteTmp;
+
+  /* The error vector is the concatenation of the errors of the features,
+   * in the same order as the feature list. */
+  unsigned int cursorError = 0;
+
+  std::list<vpBasicFeature *>::const_iterator it;
+  std::list<unsigned int>::const_iterator it_select;
+
+  for (it = featureList.begin(), it_select = featureSelectionList.begin(); it != featureList.end(); ++it, ++it_select) {
+    unsigned int dim = (*it)->getDimension(*it_select);
+    if (cursorError + dim > error.getRows()) {
+      throw(vpServoException(vpServoException::servoError, "The error vector does not match the features"));
+    }
+    (*it)->interactionNormalEquations(error.extract(cursorError, dim), LtLTmp, LteTmp, *it_select);
+    LtL += LtLTmp;
+    Lte += LteTmp;
+    cursorError += dim;
+  }
+}
+
 vpMatrix vpServo::computeInteractionMatrix()
 {
   try {
@@ -746,9 +781,9 @@ vpColVector vpServo::computeControlLaw()
 
   // compute  task Jacobian
   if (iscJcIdentity)
-    J1 = L * cVa * aJe;
+    J1 = L * (cVa * aJe);
   else
-    J1 = L * cJc * cVa * aJe;
+    J1 = L * (cJc * cVa * aJe);
 
   // handle the eye-in-hand eye-to-hand case
   J1 *= signInteractionMatrix;
@@ -794,7 +829,7 @@ vpColVector vpServo::computeControlLaw()
     J1.print(std::cout, 10, "J1");
     J1p.print(std::cout, 10, "J1p");
 #endif
-    e1 = WpW * J1p * error;
+    e1 = WpW * (J1p * error);
   }
   e = -lambda(e1) * e1;
 
@@ -857,7 +892,7 @@ vpColVector vpServo::computeControlLaw(double t)
   computeError();
 
   // compute  task Jacobian
-  J1 = L * cVa * aJe;
+  J1 = L * (cVa * aJe);
 
   // handle the eye-in-hand eye-to-hand case
   J1 *= signInteractionMatrix;
@@ -903,7 +938,7 @@ vpColVector vpServo::computeControlLaw(double t)
     std::cout << "J1" << std::endl << J1;
     std::cout << "J1p" << std::endl << J1p;
 #endif
-    e1 = WpW * J1p * error;
+    e1 = WpW * (J1p * error);
   }
 
   // memorize the initial e1 value if the function is called the first time
@@ -976,7 +1011,7 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
   computeError();
 
   // compute  task Jacobian
-  J1 = L * cVa * aJe;
+  J1 = L * (cVa * aJe);
 
   // handle the eye-in-hand eye-to-hand case
   J1 *= signInteractionMatrix;
@@ -1022,7 +1057,7 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
     std::cout << "J1" << std::endl << J1;
     std::cout << "J1p" << std::endl << J1p;
 #endif
-    e1 = WpW * J1p * error;
+    e1 = WpW * (J1p * error);
   }
 
   // memorize the initial e1 value if the function is called the first time
@@ -1046,6 +1081,117 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
   return e;
 }
 
+vpColVector vpServo::computeControlLawNormalEquations()
+{
+  vpVelocityTwistMatrix cVa; // Twist transformation matrix
+  vpMatrix aJe;              // Jacobian
+
+  if (m_first_iteration) {
+    if (testInitialization() == false) {
+      vpERROR_TRACE("All the matrices are not correctly initialized");
+      throw(vpServoException(vpServoException::servoError, "Cannot compute control law. "
+                             "All the matrices are not correctly"
+                             "initialized."));
+    }
+  }
+  if (testUpdated() == false) {
+    vpERROR_TRACE("All the matrices are not correctly updated");
+  }
+
+  // test if all the required initialization have been done
+  switch (servoType) {
+  case NONE:
+    vpERROR_TRACE("No control law have been yet defined");
+    throw(vpServoException(vpServoException::servoError, "No control law have been yet defined"));
+  case EYEINHAND_CAMERA:
+  case EYEINHAND_L_cVe_eJe:
+  case EYETOHAND_L_cVe_eJe:
+
+    cVa = cVe;
+    aJe = eJe;
+
+    init_cVe = false;
+    init_eJe = false;
+    break;
+  case EYETOHAND_L_cVf_fVe_eJe:
+    cVa = cVf * fVe;
+    aJe = eJe;
+    init_fVe = false;
+    init_eJe = false;
+    break;
+  case EYETOHAND_L_cVf_fJe:
+    cVa = cVf;
+    aJe = fJe;
+    init_fJe = false;
+    break;
+  }
+
+  computeError();
+
+  // normal equations of the interaction matrix, without building it when the features allow it
+  vpMatrix LtL;
+  vpColVector Lte;
+  switch (interactionMatrixType) {
+  case CURRENT:
+    computeNormalEquationsFromList(this->featureList, this->featureSelectionList, error, LtL, Lte);
+    break;
+  case DESIRED:
+    computeNormalEquationsFromList(this->desiredFeatureList, this->featureSelectionList, error, LtL, Lte);
+    break;
+  case MEAN:
+  case USER_DEFINED:
+    computeInteractionMatrix();
+    if (L.getRows() != error.getRows()) {
+      throw(vpServoException(vpServoException::servoError, "The interaction matrix does not match the error vector"));
+    }
+    LtL = L.AtA();
+    Lte = L.t() * error;
+    break;
+  }
+
+  // normal equations of the task Jacobian J1 = L aJa with aJa = cJc cVa aJe
+  vpMatrix aJa;
+  if (iscJcIdentity)
+    aJa = cVa * aJe;
+  else
+    aJa = cJc * cVa * aJe;
+
+  vpMatrix aJat = aJa.t();
+  vpMatrix H = aJat * LtL * aJa;
+  // handle the eye-in-hand eye-to-hand case
+  vpColVector g = aJat * Lte * static_cast<double>(signInteractionMatrix);
+
+  // Levenberg-Marquardt damping
+  vpMatrix Hlm = H;
+  for (unsigned int i = 0; i < H.getRows(); ++i) {
+    Hlm[i][i] += m_normal_equations_damping * H[i][i];
+  }
+
+  // the singular values of H are the squares of the ones of J1
+  vpMatrix Hp, imH, imHt;
+  rankJ1 = Hlm.pseudoInverse(Hp, sv, m_pseudo_inverse_threshold * m_pseudo_inverse_threshold, imH, imHt);
+
+  if (rankJ1 == H.getCols()) {
+    e1 = Hp * g; // primary task
+
+    WpW.eye(H.getCols(), H.getCols());
+  }
+  else {
+    // J1 and H share the same row space
+    WpW = imHt.AAt();
+    e1 = WpW * (Hp * g);
+  }
+  e = -lambda(e1) * e1;
+
+  I.eye(H.getCols());
+
+  // Compute classical projection operator
+  I_WpW = (I - WpW);
+
+  m_first_iteration = false;
+  return e;
+}
+
 void vpServo::computeProjectionOperators(const vpMatrix &J1_, const vpMatrix &I_, const vpMatrix &I_WpW_,
                                          const vpColVector &error_, vpMatrix &P_) const
 {
@@ -0,0 +1,267 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2025 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the normal equations of the visual features and the associated control law.
+ */
+
+/*!
+ * \example catchServoNormalEquations.cpp
+ *
+ * Test vpBasicFeature::interactionNormalEquations() and vpServo::computeControlLawNormalEquations()
+ * against the control laws that build the interaction matrix.
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <memory>
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/visual_features/vpFeatureLuminance.h>
+#include <visp3/visual_features/vpFeatureLuminanceMapping.h>
+#include <visp3/vs/vpServo.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width, double phase)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      double v = 128. + 60. * std::sin(0.05 * i + phase) * std::cos(0.07 * j) + 30. * std::cos(0.11 * (i + j) + phase);
+      I[i][j] = static_cast<unsigned char>(v);
+    }
+  }
+  return I;
+}
+
+double maxAbsDifference(const vpArray2D<double> &A, const vpArray2D<double> &B)
+{
+  REQUIRE(A.getRows() == B.getRows());
+  REQUIRE(A.getCols() == B.getCols());
+  double maxDiff = 0.;
+  for (unsigned int k = 0; k < A.size(); ++k) {
+    maxDiff = std::max(maxDiff, std::fabs(A.data[k] - B.data[k]));
+  }
+  return maxDiff;
+}
+
+double maxAbs(const vpArray2D<double> &A)
+{
+  double m = 0.;
+  for (unsigned int k = 0; k < A.size(); ++k) {
+    m = std::max(m, std::fabs(A.data[k]));
+  }
+  return m;
+}
+} // namespace
+
+TEST_CASE("Normal equations of the luminance feature", "[visual_features]")
+{
+  const vpCameraParameters cam(600., 600., 80., 60.);
+  vpImage<unsigned char> I = createImage(120, 160, 0.);
+  vpImage<unsigned char> Id = createImage(120, 160, 0.3);
+
+  vpFeatureLuminance sI, sId;
+  sI.init(I.getHeight(), I.getWidth(), 1.);
+  sI.setCameraParameters(cam);
+  sI.buildFrom(I);
+  sId.init(Id.getHeight(), Id.getWidth(), 1.);
+  sId.setCameraParameters(cam);
+  sId.buildFrom(Id);
+
+  vpMatrix L;
+  sI.interaction(L);
+  vpColVector e;
+  sI.error(sId, e);
+  const vpMatrix LtL_ref = L.AtA();
+  const vpColVector Lte_ref = L.t() * e;
+
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  const unsigned int nbThreads = pool.getNbThreads();
+
+  pool.setNbThreads(1);
+  vpMatrix LtL1;
+  vpColVector Lte1;
+  sI.interactionNormalEquations(e, LtL1, Lte1);
+  CHECK(maxAbsDifference(LtL1, LtL_ref) <= 1e-10 * maxAbs(LtL_ref));
+  CHECK(maxAbsDifference(Lte1, Lte_ref) <= 1e-10 * maxAbs(Lte_ref));
+
+  pool.setNbThreads(3);
+  vpMatrix LtL3;
+  vpColVector Lte3;
+  sI.interactionNormalEquations(e, LtL3, Lte3);
+  CHECK(maxAbsDifference(LtL3, LtL1) == 0.);
+  CHECK(maxAbsDifference(Lte3, Lte1) == 0.);
+
+  vpColVector e_wrong(e.getRows() - 1);
+  CHECK_THROWS_AS(sI.interactionNormalEquations(e_wrong, LtL3, Lte3), vpException);
+
+  pool.setNbThreads(nbThreads);
+}
+
+TEST_CASE("Control law from the normal equations", "[vs]")
+{
+  const vpCameraParameters cam(600., 600., 80., 60.);
+  vpImage<unsigned char> I = createImage(120, 160, 0.);
+  vpImage<unsigned char> Id = createImage(120, 160, 0.3);
+
+  vpFeatureLuminance sI, sId;
+  sI.init(I.getHeight(), I.getWidth(), 1.);
+  sI.setCameraParameters(cam);
+  sI.buildFrom(I);
+  sId.init(Id.getHeight(), Id.getWidth(), 1.);
+  sId.setCameraParameters(cam);
+  sId.buildFrom(Id);
+
+  SECTION("Gauss-Newton step equals the pseudo-inverse control law")
+  {
+    vpServo::vpServoIteractionMatrixType types[] = { vpServo::CURRENT, vpServo::DESIRED, vpServo::MEAN };
+    for (vpServo::vpServoIteractionMatrixType type : types) {
+      vpServo task, taskNE;
+      task.setServo(vpServo::EYEINHAND_CAMERA);
+      task.setInteractionMatrixType(type);
+      task.setLambda(0.5);
+      task.addFeature(sI, sId);
+      taskNE.setServo(vpServo::EYEINHAND_CAMERA);
+      taskNE.setInteractionMatrixType(type);
+      taskNE.setLambda(0.5);
+      taskNE.addFeature(sI, sId);
+
+      const vpColVector v = task.computeControlLaw();
+      const vpColVector vNE = taskNE.computeControlLawNormalEquations();
+      CHECK(maxAbsDifference(vNE, v) <= 1e-6 * maxAbs(v));
+      CHECK(taskNE.getTaskRank() == 6);
+    }
+  }
+
+  SECTION("Levenberg-Marquardt step")
+  {
+    const double damping = 0.01;
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(vpServo::CURRENT);
+    task.setLambda(0.5);
+    task.setNormalEquationsDamping(damping);
+    task.addFeature(sI, sId);
+    const vpColVector v = task.computeControlLawNormalEquations();
+
+    vpMatrix L = sI.interaction();
+    vpColVector e = sI.error(sId);
+    vpMatrix H = L.AtA();
+    for (unsigned int i = 0; i < 6; ++i) {
+      H[i][i] *= 1. + damping;
+    }
+    const vpColVector v_ref = -0.5 * H.inverseByLU() * L.t() * e;
+    CHECK(maxAbsDifference(v, v_ref) <= 1e-6 * maxAbs(v_ref));
+  }
+
+  SECTION("Robot Jacobian")
+  {
+    vpUniRand rand(42);
+    vpMatrix eJe(6, 6);
+    for (unsigned int k = 0; k < eJe.size(); ++k) {
+      eJe.data[k] = rand.uniform(-1., 1.);
+    }
+    for (unsigned int i = 0; i < 6; ++i) {
+      eJe[i][i] += 3.;
+    }
+    vpVelocityTwistMatrix cVe(vpHomogeneousMatrix(0.1, 0., 0.2, 0., 0.3, 0.));
+
+    vpServo task, taskNE;
+    task.setServo(vpServo::EYEINHAND_L_cVe_eJe);
+    task.setInteractionMatrixType(vpServo::CURRENT);
+    task.setLambda(0.5);
+    task.set_cVe(cVe);
+    task.set_eJe(eJe);
+    task.addFeature(sI, sId);
+    taskNE.setServo(vpServo::EYEINHAND_L_cVe_eJe);
+    taskNE.setInteractionMatrixType(vpServo::CURRENT);
+    taskNE.setLambda(0.5);
+    taskNE.set_cVe(cVe);
+    taskNE.set_eJe(eJe);
+    taskNE.addFeature(sI, sId);
+
+    const vpColVector qdot = task.computeControlLaw();
+    const vpColVector qdotNE = taskNE.computeControlLawNormalEquations();
+    CHECK(maxAbsDifference(qdotNE, qdot) <= 1e-6 * maxAbs(qdot));
+  }
+
+  SECTION("Luminance mapping")
+  {
+    std::shared_ptr<vpLuminanceMapping> mapping = std::make_shared<vpLuminanceDCT>(32);
+    std::shared_ptr<vpLuminanceMapping> mappingd = std::make_shared<vpLuminanceDCT>(32);
+    vpFeatureLuminanceMapping sM(cam, I.getHeight(), I.getWidth(), 1., mapping);
+    vpFeatureLuminanceMapping sMd(cam, Id.getHeight(), Id.getWidth(), 1., mappingd);
+    sM.buildFrom(I);
+    sMd.buildFrom(Id);
+
+    vpServo task, taskNE;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(vpServo::CURRENT);
+    task.setLambda(0.5);
+    task.addFeature(sM, sMd);
+    taskNE.setServo(vpServo::EYEINHAND_CAMERA);
+    taskNE.setInteractionMatrixType(vpServo::CURRENT);
+    taskNE.setLambda(0.5);
+    taskNE.addFeature(sM, sMd);
+
+    const vpColVector v = task.computeControlLaw();
+    const vpColVector vNE = taskNE.computeControlLawNormalEquations();
+    CHECK(maxAbsDifference(vNE, v) <= 1e-6 * maxAbs(v));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+  return numFailed;
+}
+
+#else
+
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+
+#endif